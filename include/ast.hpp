@@ -618,6 +618,8 @@ namespace NG::ast
     struct IdExpression : Expression
     {
         const Str id; ///< The ID of the expression.
+        std::optional<bool> readMayDrop; ///< Whether a local read here may hold a value with a destructor.
+        Map<Str, bool> readMayDropByInstance; ///< Per-instantiation `readMayDrop` for generic bodies.
 
         explicit IdExpression(Str _id) : id(std::move(_id)) {}
 
@@ -637,6 +639,8 @@ namespace NG::ast
         ASTRef<Expression> primaryExpression = nullptr; ///< The primary expression of the accessor.
         ASTRef<Expression> accessor = nullptr;          ///< The accessor of the expression.
         Vec<ASTRef<Expression>> arguments;              ///< The arguments of the accessor.
+        bool receiverByRef = false;                     ///< Whether the member called edits its receiver in place.
+        Map<Str, bool> receiverByRefByInstance;         ///< Per-instantiation `receiverByRef` for generic bodies.
 
         void accept(AstVisitor *visitor) override;
 
@@ -8,6 +8,7 @@
 #include <functional>
 #include <memory>
 #include <runtime/buffer_runtime.hpp>
+#include <string_view>
 #include <utility>
 
 namespace NG::runtime
@@ -98,6 +99,7 @@ namespace NG::runtime
         bool dropArmed = true;
         bool lifecycleDropped = false;
         bool dropInProgress = false;
+        bool uniquelyOwned = false; // A temporary holding a value taken from its last owner; never copied along.
     };
 
     struct CallFrame
@@ -144,6 +146,7 @@ namespace NG::runtime
         std::function<RuntimeRef<StorageCell>(const RuntimeRef<StorageCell> &self, const RuntimeRef<StorageCell> &other)>;
     using NGCellOrderOperatorHandler =
         std::function<Orders(const RuntimeRef<StorageCell> &self, const RuntimeRef<StorageCell> &other)>;
+    using NGCellHashHandler = std::function<uint64_t(const RuntimeRef<StorageCell> &cell)>;
     using NGCellDropHandler = std::function<void(const RuntimeRef<StorageCell> &cell)>;
 
     /**
@@ -166,7 +169,9 @@ namespace NG::runtime
         NGCellRespondHandler respondCellHandler; ///< Optional cell-native member resolution before materialization.
         Map<RuntimeBinaryOperator, NGCellBinaryOperatorHandler> cellBinaryOperators; ///< Optional cell-native binary ops.
         NGCellOrderOperatorHandler cellOrderHandler; ///< Optional cell-native ordering/equality handler.
+        NGCellHashHandler hashCellHandler; ///< Optional cell-native hash, consistent with `cellOrderHandler`.
         NGCellDropHandler dropCellHandler; ///< Optional native Drop implementation.
+        bool sharesOpaqueRefs = false; ///< Clones share `opaqueRefs`; the type copies them before changing them.
 
         auto operator==(const NGType &other) const -> bool
         {
@@ -279,6 +284,31 @@ namespace NG::runtime
     [[nodiscard]] auto runtime_is_array_value(const RuntimeRef<StorageCell> &cell) -> bool;
     [[nodiscard]] auto runtime_array_length(const RuntimeRef<StorageCell> &cell) -> size_t;
     [[nodiscard]] auto runtime_array_slots(const RuntimeRef<StorageCell> &cell) -> Vec<RuntimeRef<StorageCell>>;
+    /**
+     * @brief Whether an array stores its elements as contiguous primitive bytes instead of element slots.
+     *
+     * Arrays whose elements all share one numeral or `bool` type are packed: the cell bytes hold the
+     * elements back to back under an `Array.packed` layout. Element reads materialize fresh cells,
+     * writes of the same type land in place, and anything that needs an element slot (a reference,
+     * a value of another type) converts the array back with `runtime_array_unpack`.
+     */
+    [[nodiscard]] auto runtime_array_is_packed(const RuntimeRef<StorageCell> &cell) -> bool;
+    [[nodiscard]] auto runtime_array_element(const RuntimeRef<StorageCell> &cell, size_t index)
+        -> RuntimeRef<StorageCell>;
+    void runtime_array_write_element(const RuntimeRef<StorageCell> &cell, size_t index,
+                                     const RuntimeRef<StorageCell> &value);
+    void runtime_array_unpack(const RuntimeRef<StorageCell> &cell);
+    /**
+     * @brief Returns the element type of a packed array, or null when `cell` is not packed.
+     */
+    [[nodiscard]] auto runtime_array_packed_type(const RuntimeRef<StorageCell> &cell) -> RuntimeRef<NGType>;
+    /**
+     * @brief Makes a packed array of `elementType` from raw element bytes.
+     * @throws RuntimeException if `elementType` cannot be packed or `bytes` is not a whole number of elements.
+     */
+    [[nodiscard]] auto make_runtime_packed_array_cell(const RuntimeRef<NGType> &elementType, Vec<uint8_t> bytes,
+                                                      StorageClass storageClass = StorageClass::TEMPORARY)
+        -> RuntimeRef<StorageCell>;
 
     [[nodiscard]] auto tuple_runtime_type() -> RuntimeRef<NGType>;
     [[nodiscard]] auto make_runtime_tuple_cell(const Vec<RuntimeRef<StorageCell>> &slots,
@@ -321,6 +351,17 @@ namespace NG::runtime
                                            StorageClass storageClass = StorageClass::TEMPORARY) -> RuntimeRef<StorageCell>;
     [[nodiscard]] auto runtime_is_string_value(const RuntimeRef<StorageCell> &cell) -> bool;
     [[nodiscard]] auto runtime_string_value(const RuntimeRef<StorageCell> &cell) -> Str;
+    /**
+     * @brief Borrows the payload of a string cell without copying it.
+     *
+     * The view is valid while `cell` is alive and unchanged and no string is appended to its shared buffer, such as
+     * for the duration of a native call that receives `cell` as an argument.
+     */
+    [[nodiscard]] auto runtime_string_view(const RuntimeRef<StorageCell> &cell) -> std::string_view;
+    /**
+     * @brief Reserves room for `capacity` payload bytes, so appending to the string up to that size does not reallocate.
+     */
+    void runtime_string_reserve(const RuntimeRef<StorageCell> &cell, size_t capacity);
 
     [[nodiscard]] auto make_runtime_structural_cell(const RuntimeRef<NGType> &type,
                                                     const Vec<RuntimeRef<StorageCell>> &fields = {},
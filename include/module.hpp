@@ -4,6 +4,8 @@
 #include <intp/runtime.hpp>
 #include <typecheck/typecheck.hpp>
 
+#include <mutex>
+
 namespace NG::orgasm
 {
     struct BytecodeModule;
@@ -134,7 +136,7 @@ namespace NG::module
     {
         Str moduleId;                                    ///< The unique ID of the module.
         Str moduleName;                                  ///< The name of the module.
-        Str moduleSource;                                ///< The source code of the module.
+        Str moduleSourceHash;                            ///< `bytecode_source_hash` of the module source, if any.
         ASTRef<NG::ast::ASTNode> moduleAst;              ///< The AST of the module.
         Str moduleAbsolutePath;                          ///< The absolute path to the module.
         Str moduleLoadingLocation;                       ///< The location from which the module was loaded.
@@ -145,10 +147,11 @@ namespace NG::module
     };
 
     /**
-     * @brief A registry for modules.
+     * @brief A registry for modules. It is safe to use from several threads.
      */
     class ModuleRegistry : NonCopyable
     {
+        mutable std::recursive_mutex mutex;       ///< Guards the maps; native registration nests calls.
         Map<Str, RuntimeRef<ModuleInfo>> modules; ///< The modules in the registry.
         Map<Str, RuntimeRef<ModuleArtifact>> artifacts; ///< Shared module artifacts by canonical ID.
         Map<Str, RuntimeRef<NativeModuleDescriptor>> nativeDescriptors; ///< Native modules by canonical ID.
@@ -233,6 +236,18 @@ namespace NG::module
      */
     ModuleRegistry &get_module_registry() noexcept;
 
+    /**
+     * @brief Reads and parses the not-yet-cached modules imported by `ast`, transitively.
+     *
+     * Dependencies are loaded concurrently on a thread pool into the file-based loader cache and
+     * then added to the global module registry. Modules that fail to load are skipped so the
+     * importing site reports the error when it loads them on demand.
+     *
+     * @param ast A parsed compile unit.
+     * @param basePaths The base paths for module resolution.
+     */
+    void prefetch_module_imports(const ASTRef<ASTNode> &ast, const Vec<Str> &basePaths);
+
     /**
      * @brief Clears the file-based module loader cache.
      */
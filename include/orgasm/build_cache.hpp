@@ -0,0 +1,53 @@
+#pragma once
+
+#include <module.hpp>
+#include <orgasm/module.hpp>
+
+#include <optional>
+
+namespace NG::orgasm
+{
+    /**
+     * @brief Returns the build cache directory (`$NG_CACHE_DIR`), or an empty string when the cache is
+     * disabled.
+     */
+    auto build_cache_dir() -> Str;
+
+    /**
+     * @brief Returns the build cache key of a source module, or an empty string if it cannot be cached.
+     *
+     * The key hashes everything the compiled module depends on: the module source, the compiler
+     * (format versions and the running executable), the prelude sources, and the keys of the modules it
+     * imports. Imported modules are loaded into the registry as needed. Modules in an import cycle,
+     * and modules importing one, cannot be cached.
+     *
+     * Imports contribute their key rather than their interface because monomorphized generic bodies
+     * are compiled into the importer.
+     *
+     * @param knownKeys Keys by module ID from earlier calls, reused and extended by this one.
+     */
+    auto module_build_key(const NG::module::ModuleInfo &moduleInfo, const Vec<Str> &modulePaths,
+                          Map<Str, Str> *knownKeys = nullptr) -> Str;
+
+    /**
+     * @brief Loads the module stored under `key`, or returns nothing if it is missing or unreadable.
+     */
+    auto load_cached_module(const Str &key) -> std::optional<BytecodeModule>;
+
+    /**
+     * @brief Stores `module` under `key`. Failures are ignored: the cache is only an optimization.
+     */
+    void store_cached_module(const Str &key, const BytecodeModule &module);
+
+    /**
+     * @brief Compiles an imported source module, reusing the prelude snapshot and the build cache when
+     * they are enabled.
+     *
+     * A module of the prelude snapshot has its bytecode stored in the snapshot image after it is compiled.
+     *
+     * @throws RuntimeException if the module has no compile unit.
+     */
+    auto compile_source_module(const NG::module::ModuleInfo &moduleInfo, const Vec<Str> &modulePaths)
+        -> BytecodeModule;
+
+} // namespace NG::orgasm
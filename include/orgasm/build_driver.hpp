@@ -0,0 +1,56 @@
+#pragma once
+
+#include <ast.hpp>
+#include <orgasm/module.hpp>
+
+namespace NG::orgasm
+{
+    /**
+     * @brief Time spent building one module of a program.
+     */
+    struct ModuleBuildTiming
+    {
+        Str moduleId;           ///< The module ID, or the source path of the entry program.
+        double cacheMs = 0;     ///< Looking the module up in the build cache.
+        double compileMs = 0;   ///< Type checking and compiling it on a cache miss, without waiting for other checks.
+        double writeMs = 0;     ///< Writing its `.ngo` file and cache entry.
+        bool cached = false;    ///< Whether the build cache held the module.
+    };
+
+    /**
+     * @brief The result of `build_program`.
+     */
+    struct BuildReport
+    {
+        Vec<ModuleBuildTiming> modules; ///< Built modules, in completion order; the entry program is last.
+        Vec<Str> outputs;               ///< The written `.ngo` files, in the same order.
+        double loadMs = 0;              ///< Reading and parsing imported modules.
+        double totalMs = 0;             ///< The whole build.
+        size_t workers = 0;             ///< Worker threads of the build.
+    };
+
+    /**
+     * @brief Compiles a program and every source module it imports ahead of time.
+     *
+     * Imports are parsed concurrently and ordered into a dependency graph; each module is scheduled
+     * on a thread pool as soon as the modules it imports are built. Build cache lookups, compiling and
+     * output writes run concurrently, while type checking, which uses the global checker state, runs one
+     * module at a time and never alongside compiling. Checks of importers take the artifacts of the modules checked before instead of
+     * checking them again.
+     *
+     * Imported modules are written to `<outputDir>/<module path>.ngo` and the entry program to
+     * `<outputDir>/<file stem>.ngo`, which `ngi --run-bytecode` runs.
+     *
+     * @param entry The parsed entry program.
+     * @param entrySource The entry program source.
+     * @param entryPath The entry program path.
+     * @param modulePaths The base paths for module resolution.
+     * @param nativeFunctions Native functions callable from the entry program.
+     * @param outputDir The output directory.
+     * @throws RuntimeException if the imports form a cycle or a module cannot be loaded.
+     */
+    auto build_program(NG::ast::ASTRef<NG::ast::ASTNode> entry, std::string_view entrySource, const Str &entryPath,
+                       const Vec<Str> &modulePaths, const Vec<Str> &nativeFunctions, const Str &outputDir)
+        -> BuildReport;
+
+} // namespace NG::orgasm
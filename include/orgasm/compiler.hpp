@@ -4,6 +4,11 @@
 #include <orgasm/module.hpp>
 #include <visitor.hpp>
 
+namespace NG::typecheck
+{
+    struct GenericFunctionInstance;
+}
+
 namespace NG::orgasm
 {
     /**
@@ -23,6 +28,38 @@ namespace NG::orgasm
          */
         auto compile(ast::ASTRef<ast::CompileUnit> compileUnit) -> BytecodeModule;
 
+        /**
+         * @brief Type checks a compile unit for `compile_checked`.
+         *
+         * Only the check uses the global type checker state, so one unit can be compiled while
+         * another is checked.
+         *
+         * @param compileUnit The compile unit to check.
+         */
+        void check(ast::ASTRef<ast::CompileUnit> compileUnit);
+
+        /**
+         * @brief Compiles a compile unit `check` accepted to a bytecode module.
+         *
+         * @param compileUnit The checked compile unit.
+         * @return The compiled bytecode module.
+         */
+        auto compile_checked(ast::ASTRef<ast::CompileUnit> compileUnit) -> BytecodeModule;
+
+        /**
+         * @brief Compiles a compile unit into the module built by earlier increments.
+         *
+         * Definitions are appended to the module and top-level code is compiled into a new
+         * function named `entryName`. Globals, functions and types from earlier increments stay
+         * visible. The compile unit must already be type checked.
+         *
+         * @param compileUnit The compile unit to compile.
+         * @param entryName The name of the function receiving the top-level code.
+         * @return The module built so far; it lives as long as the compiler.
+         */
+        auto compile_increment(ast::ASTRef<ast::CompileUnit> compileUnit, const Str &entryName)
+            -> const BytecodeModule &;
+
         void visit(ast::Module *mod) override;
         void visit(ast::FunctionDef *funDef) override;
         void visit(ast::FunCallExpression *funCallExpr) override;
@@ -99,14 +136,16 @@ namespace NG::orgasm
         Map<Str, int32_t> locals;
         Map<Str, Str> localTraitObjectTypes;
         Map<Str, Str> localValueTypes;
+        Set<const ast::IdExpression *> lastUseLoads; ///< Reads of locals that move the value (`TAKE_LOCAL`).
         Map<Str, int32_t> globals;
         Map<Str, Str> globalTraitObjectTypes;
         Map<Str, Str> globalValueTypes;
         Map<Str, ImportedSymbol> imported_symbols;
         Map<Str, Map<Str, ImportedSymbol>> qualified_import_symbols;
         Map<Str, ast::FunctionDef*> functionDefs;
-        Map<Str, ast::FunctionDef*> genericFunctionDefs;
+        Set<ast::FunctionDef*> genericFunctionDefs;
         Vec<ast::Definition*> importedDefinitions;
+        Vec<std::shared_ptr<typecheck::GenericFunctionInstance>> checkedGenericInstances; ///< Instances the type checker recorded for this unit.
         Vec<Str> genericFunctionInstances;
         Set<Str> genericFunctionInstanceSet;
         Map<Str, ast::TraitDef*> traitDefs;
@@ -117,6 +156,8 @@ namespace NG::orgasm
         Str current_type_name;  // Current type being compiled (for member functions)
         Str activeTraitMethodOrigin; // Trait whose default method body is currently being lowered.
         Str activeGenericInstanceName;
+        Str entryFunctionName = "__start__"; // Function receiving top-level code.
+        size_t entryFunctionIndex = 0;
         bool last_emit_was_return = false;
 
         // Tagged union tracking: variant name -> (union type name, variant index)
@@ -132,6 +173,8 @@ namespace NG::orgasm
         void emit_u8(uint8_t val);
         void emit_u16(uint16_t val);
         void emit_reference(ast::ASTRef<ast::Expression> expr);
+        auto is_reference_place(const ast::Expression *expr) const -> bool;
+        void emit_member_receiver(ast::IdAccessorExpression *member);
         auto trait_ref_name(const ast::TypeAnnotation *annotation) const -> Str;
         auto trait_ref_name_from_type_repr(const Str &typeName) const -> Str;
         auto specialize_type_repr(const Str &typeName, const Map<Str, Str> &typeBindings) const -> Str;
@@ -141,9 +184,6 @@ namespace NG::orgasm
         auto emit_trait_ref_if_needed(const ast::TypeAnnotation *annotation) -> bool;
         void emit_move_place(ast::ASTRef<ast::Expression> expr);
         void register_generic_function_instance(const Str &symbolName, ast::FunctionDef *funDef);
-        void collect_generic_function_instances(ast::ASTRef<ast::Definition> def, const Str &instanceContext = "");
-        void collect_generic_function_instances(ast::ASTRef<ast::Statement> stmt, const Str &instanceContext = "");
-        void collect_generic_function_instances(ast::ASTRef<ast::Expression> expr, const Str &instanceContext = "");
         void compile_function_body(ast::FunctionDef *funDef, Function &targetFunction, bool allowImplicitSelf);
 
         // Phases of visit(Module*) — extracted for readability
@@ -153,6 +193,7 @@ namespace NG::orgasm
 
         // Helpers for visit(FunCallExpression)
         void compileFoldCall(ast::FunCallExpression *funCallExpr, ast::IdExpression *target);
+        auto compileSortCall(ast::FunCallExpression *funCallExpr, ast::IdExpression *target) -> bool;
         void compileTaggedConstructor(ast::FunCallExpression *funCallExpr, const Str &variantName);
 
         auto find_function(const Str &name) -> Function *;
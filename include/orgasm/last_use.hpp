@@ -0,0 +1,21 @@
+#pragma once
+
+#include <ast.hpp>
+
+namespace NG::orgasm
+{
+    /**
+     * @brief Finds the reads of locals in a function body that may move the value instead of copying it.
+     *
+     * A read qualifies when it is the last read of its local in program order and the only one in its
+     * statement, so evaluation order inside an expression does not matter. The analysis is conservative:
+     * locals that are borrowed with `ref` or `&`, reads inside a loop of locals declared outside it, place
+     * expressions (assignment targets, `move` operands, receivers of index assignments), spreads, folds
+     * and `self` are never moved.
+     *
+     * @param funDef The function whose body is analysed; nested definitions are not visited.
+     * @return The qualifying identifier expressions.
+     */
+    auto collect_last_uses(ast::FunctionDef *funDef) -> Set<const ast::IdExpression *>;
+
+} // namespace NG::orgasm
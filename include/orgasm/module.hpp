@@ -4,11 +4,13 @@
 #include <fwd.hpp>
 #include <orgasm/opcode.hpp>
 
+#include <string_view>
+
 namespace NG::orgasm
 {
     // Bump the format/ABI whenever OpCode numeric values or operand layouts change.
     constexpr uint32_t NGO_FORMAT_VERSION = 2;
-    constexpr uint32_t NGO_ABI_VERSION = 2;
+    constexpr uint32_t NGO_ABI_VERSION = 6;
     constexpr uint32_t NGO_METADATA_SCHEMA_VERSION = 2;
 
     /**
@@ -161,5 +163,8 @@ namespace NG::orgasm
     // Non-empty overrideSourceHash is written instead of BytecodeModule::sourceHash.
     void write_bytecode_module(const BytecodeModule &module, const Str &path, const Str &overrideSourceHash = {});
     auto read_bytecode_module(const Str &path, const Str &expectedModuleId = {}) -> BytecodeModule;
-    auto bytecode_source_hash(const Str &source) -> Str;
+    // The same `.ngo` bytes as write_bytecode_module and read_bytecode_module, kept in memory.
+    auto encode_bytecode_module(const BytecodeModule &module, const Str &overrideSourceHash = {}) -> Str;
+    auto decode_bytecode_module(std::string_view bytes, const Str &expectedModuleId = {}) -> BytecodeModule;
+    auto bytecode_source_hash(std::string_view source) -> Str;
 } // namespace NG::orgasm
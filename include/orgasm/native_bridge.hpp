@@ -4,6 +4,7 @@
 #include <intp/runtime_numerals.hpp>
 #include <runtime/value_access.hpp>
 #include <functional>
+#include <string_view>
 #include <tuple>
 #include <utility>
 
@@ -88,6 +89,13 @@ namespace NG::orgasm
         return runtime_string_value(cell);
     }
 
+    // Borrows the argument's bytes; the argument cells outlive the native call.
+    template <>
+    inline auto from_ng<std::string_view>(const RuntimeRef<StorageCell> &cell) -> std::string_view
+    {
+        return runtime_string_view(cell);
+    }
+
     template <>
     inline auto from_ng<RuntimeRef<StorageCell>>(const RuntimeRef<StorageCell> &cell) -> RuntimeRef<StorageCell>
     {
@@ -110,6 +118,7 @@ namespace NG::orgasm
     inline auto to_ng(const Str &val) -> RuntimeRef<StorageCell> { return make_runtime_string(val); }
     inline auto to_ng(Str &&val) -> RuntimeRef<StorageCell> { return make_runtime_string(std::move(val)); }
     inline auto to_ng(const char *val) -> RuntimeRef<StorageCell> { return make_runtime_string(Str(val)); }
+    inline auto to_ng(std::string_view val) -> RuntimeRef<StorageCell> { return make_runtime_string(Str(val)); }
     inline auto to_ng(RuntimeRef<StorageCell> val) -> RuntimeRef<StorageCell> { return std::move(val); }
 
     // --- Argument extraction from stack ---
@@ -108,6 +108,15 @@ namespace NG::orgasm
         GET_PAYLOAD,        // GET_PAYLOAD field_idx — push payload[field_idx] from tagged value on stack
         SWITCH_TAG,         // SWITCH_TAG count [tag0:addr] [tag1:addr] ... — jump based on variant tag
 
+        // Ownership
+        TAKE_LOCAL,         // TAKE_LOCAL idx — push a local's value and leave it moved (last use of a local without a destructor)
+
+        // Lowered folds
+        FOLD_KERNEL_CALL,   // FOLD_KERNEL_CALL kernel fromRight funIndex — fold with a builtin reduction, calling funIndex when it does not apply
+
+        // Lowered sorts
+        SORT_CALL,          // SORT_CALL kernel funIndex — sortBy/sortWith over funIndex; the kernel says how to use it
+
         HALT = 0xFF
     };
 } // namespace NG::orgasm
@@ -0,0 +1,54 @@
+#pragma once
+
+#include <ast.hpp>
+#include <orgasm/compiler.hpp>
+#include <orgasm/vm.hpp>
+#include <typecheck/typecheck.hpp>
+
+namespace NG::orgasm
+{
+    /**
+     * @brief An incremental type check / compile / run session for the REPL.
+     *
+     * Each input is type checked against the types accumulated from earlier inputs, compiled
+     * into a new entry function appended to one growing bytecode module, and run on a VM whose
+     * globals persist between inputs.
+     */
+    class ReplSession : NonCopyable
+    {
+      public:
+        ReplSession(Vec<Str> modulePaths, Vec<Str> nativeFunctions);
+        ~ReplSession();
+
+        /**
+         * @brief Returns the VM, e.g. to register native functions.
+         */
+        auto vm() -> VM & { return machine; }
+
+        /**
+         * @brief Type checks, compiles and runs one parsed input.
+         *
+         * The input's types are kept only if it runs to the end; a type, compile or runtime error
+         * leaves the accumulated types untouched.
+         *
+         * @param input A compile unit parsed from the input.
+         * @return The value returned by the input's entry function.
+         * @throws TypeCheckingException on type errors.
+         * @throws RuntimeException on compile or runtime errors.
+         */
+        auto evaluate(ast::ASTRef<ast::ASTNode> input) -> RuntimeRef<StorageCell>;
+
+        /**
+         * @brief Returns the types accumulated so far.
+         */
+        [[nodiscard]] auto types() const -> const typecheck::TypeIndex & { return typeIndex; }
+
+      private:
+        Vec<Str> modulePaths;
+        typecheck::TypeIndex typeIndex;
+        Compiler compiler;
+        VM machine;
+        Vec<ast::ASTRef<ast::ASTNode>> histories; ///< Compiled definitions point into these ASTs.
+        size_t inputCount = 0;
+    };
+} // namespace NG::orgasm
@@ -27,6 +27,19 @@ namespace NG::orgasm
          */
         auto run(const BytecodeModule &module) -> RuntimeRef<StorageCell>;
 
+        /**
+         * @brief Executes one function of a module, keeping VM state from earlier calls.
+         *
+         * Globals, root symbols and registered types persist between calls, so a caller may
+         * append functions and types to `module` and run each new entry point against the
+         * state left behind by the previous ones.
+         *
+         * @param module The bytecode module to execute from.
+         * @param entryName The name of the function to execute.
+         * @return The return value of the function.
+         */
+        auto run_function(const BytecodeModule &module, const Str &entryName) -> RuntimeRef<StorageCell>;
+
         /**
          * @brief Registers a native function with auto-marshaling.
          *
@@ -72,12 +85,27 @@ namespace NG::orgasm
         Vec<Frame> call_stack;
         Vec<Str> modulePaths;
         Map<Str, NativeFunction> native_functions;
+        size_t gcRootProviderId = 0;
         size_t gcFinalizerId = 0;
 
+        struct GcHooksGuard;
+
+        void install_gc_hooks(const BytecodeModule &module);
+        void remove_gc_hooks();
+        void install_root_symbols();
+        void install_module_types(const BytecodeModule &module, bool replaceExisting);
+
+        /**
+         * @param reusedLocals Local cells kept across many calls of one function, as a sort comparator
+         *                     makes; the first call fills it and later calls reuse its cells instead of
+         *                     allocating new ones.
+         */
         void push_frame(const BytecodeModule &module, const Function &fun,
-                        const Vec<RuntimeRef<StorageCell>> &argSlots);
+                        const Vec<RuntimeRef<StorageCell>> &argSlots,
+                        Vec<RuntimeRef<StorageCell>> *reusedLocals = nullptr);
         auto execute_slots(const BytecodeModule &module, const Function &fun,
-                           const Vec<RuntimeRef<StorageCell>> &argSlots) -> RuntimeRef<StorageCell>;
+                           const Vec<RuntimeRef<StorageCell>> &argSlots,
+                           Vec<RuntimeRef<StorageCell>> *reusedLocals = nullptr) -> RuntimeRef<StorageCell>;
 
         // Stack helpers
         auto pop_slot() -> RuntimeRef<StorageCell>;
@@ -3,6 +3,9 @@
 #include <ast.hpp>
 #include <fwd.hpp>
 #include <token.hpp>
+#include <deque>
+#include <memory>
+#include <string_view>
 #include <utility>
 
 namespace NG::parsing
@@ -23,16 +26,33 @@ namespace NG::parsing
      */
     struct LexState
     {
-        Str source;   ///< The source code.
+        Str source;   ///< The source code (empty while lexing a borrowed view).
         size_t size;  ///< The size of the source code.
         size_t index; ///< The current index in the source code.
 
         size_t line; ///< The current line number.
         size_t col;  ///< The current column number.
         Vec<size_t> lineStarts = {0}; ///< Offsets of line starts, for O(log n) revert.
+        std::string_view borrowed{};  ///< Source owned elsewhere (e.g. a memory-mapped file).
 
         explicit LexState(const Str &_source);
 
+        /**
+         * @brief Creates a lex state over source owned by the caller, without copying it.
+         *
+         * @param source The source code; must outlive the lex state.
+         * @return The lex state.
+         */
+        static auto borrowing(std::string_view source) -> LexState;
+
+        /**
+         * @brief Returns the source code being lexed.
+         */
+        [[nodiscard]] auto text() const -> std::string_view
+        {
+            return borrowed.data() != nullptr ? borrowed : std::string_view{source};
+        }
+
         /**
          * @brief Returns the current character.
          *
@@ -69,6 +89,8 @@ namespace NG::parsing
         /**
          * @brief Extends the source code with more source code.
          *
+         * A borrowed source is copied into `source` first.
+         *
          * @param source The source code to append.
          */
         void extend(const Str &source);
@@ -86,8 +108,7 @@ namespace NG::parsing
      */
     class Lexer : NonCopyable
     {
-        LexState state;      ///< The state of the lexer.
-        Vec<Token> tokens{}; ///< The tokens that have been lexed.
+        LexState state; ///< The state of the lexer.
 
       public:
         explicit Lexer(LexState state) : state(std::move(state)) {}
@@ -102,9 +123,9 @@ namespace NG::parsing
         auto lex() -> Vec<Token>;
 
         /**
-         * @brief Returns the next token.
+         * @brief Returns the next token without buffering it.
          *
-         * @return The next token.
+         * @return The next token, or a `TokenType::NONE` token at end of input.
          */
         auto next() -> Token;
     };
@@ -116,15 +137,29 @@ namespace NG::parsing
 
     /**
      * @brief Represents the state of the parser.
+     *
+     * Tokens are either supplied up front or pulled on demand from a `Lexer`. Only a window of
+     * tokens is buffered: it starts at the last `commit()` point and extends to the furthest
+     * token looked at, so `revert` works for any index inside the window.
      */
     struct ParseState
     {
-        Vec<Token> tokens; ///< The tokens to parse.
-        size_t size;       ///< The number of tokens.
-        size_t index;      ///< The current index in the tokens.
+        mutable std::deque<Token> tokens; ///< Buffered tokens; `tokens.front()` has absolute index `base`.
+        mutable size_t size;              ///< Number of tokens produced so far (the total once drained).
+        size_t index;                     ///< The current absolute index in the tokens.
+        size_t base = 0;                  ///< Absolute index of the first buffered token.
+        mutable std::shared_ptr<Lexer> lexer; ///< Token source when streaming; null once drained.
+        mutable Token lastToken{};        ///< The last token produced, for end-of-file diagnostics.
 
         explicit ParseState(const Vec<Token> &tokens);
 
+        /**
+         * @brief Creates a parse state that lexes tokens on demand.
+         *
+         * @param lexer The token source.
+         */
+        explicit ParseState(std::shared_ptr<Lexer> lexer);
+
         /**
          * @brief Returns the current token.
          *
@@ -134,6 +169,15 @@ namespace NG::parsing
 
         auto operator->() -> const Token * { return &current(); }
 
+        /**
+         * @brief Returns the token at absolute index `n`, lexing up to it if necessary.
+         *
+         * @param n The absolute token index.
+         * @return The token, or `nullptr` past the end of input.
+         * @throws ParseException if `n` lies before the committed window.
+         */
+        [[nodiscard]] auto at(size_t n) const -> const Token *;
+
         /**
          * @brief Returns whether the end of the tokens has been reached.
          *
@@ -152,9 +196,25 @@ namespace NG::parsing
          * @brief Reverts the parser to absolute token index `n`.
          *
          * @param n The absolute token index to revert to.
+         * @throws ParseException if `n` lies before the committed window.
          */
         void revert(size_t n);
 
+        /**
+         * @brief Releases buffered tokens before the current index.
+         *
+         * The parser calls this at points it never backtracks across.
+         */
+        void commit();
+
+        /**
+         * @brief Replaces the current token with `head` followed by `tail`.
+         *
+         * @param head The token taking the current position.
+         * @param tail The token inserted right after it.
+         */
+        void splitCurrent(Token head, Token tail);
+
         /**
          * @brief Creates a parsing error.
          *
@@ -173,10 +233,7 @@ namespace NG::parsing
             {
                 tok.repr = "<eof>";
                 // Keep position stable if possible.
-                if (!tokens.empty())
-                {
-                    tok.position = tokens.back().position;
-                }
+                tok.position = lastToken.position;
             }
             return ParseError{
                 .token = std::move(tok),
@@ -184,6 +241,12 @@ namespace NG::parsing
                 .expected = std::move(expected),
             };
         }
+
+      private:
+        /**
+         * @brief Lexes tokens until absolute index `n` is buffered or input ends.
+         */
+        auto fill(size_t n) const -> bool;
     };
 
     /**
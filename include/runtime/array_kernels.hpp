@@ -0,0 +1,128 @@
+#pragma once
+
+#include <intp/runtime.hpp>
+#include <sysdep/cpu_features.hpp>
+
+#include <functional>
+
+namespace NG::runtime::kernels
+{
+  /**
+   * @brief A fold whose function the compiler recognized as a builtin reduction of its two parameters.
+   */
+  enum class FoldKernel : uint8_t
+  {
+    Sum = 1, ///< `a + b`
+    Min = 2, ///< `if (a < b) { return a; } return b;` and its variants
+    Max = 3, ///< `if (a > b) { return a; } return b;` and its variants
+  };
+
+  /**
+   * @brief The comparison an element-wise comparison kernel applies.
+   */
+  enum class Comparison : uint8_t
+  {
+    Equal,
+    Less,
+    Greater,
+  };
+
+  /**
+   * @brief How the compiler lowered a `sortBy` or `sortWith` call to a named function.
+   */
+  enum class SortKernel : uint8_t
+  {
+    Key = 1,        ///< `sortBy`: the function computes each element's sort key once
+    Compare = 2,    ///< `sortWith` with a comparator called for each comparison
+    Ascending = 3,  ///< `sortWith` over `a < b`, sorted without calling it
+    Descending = 4, ///< `sortWith` over `a > b`, sorted without calling it
+  };
+
+  using SortComparator = std::function<bool(const RuntimeRef<StorageCell> &, const RuntimeRef<StorageCell> &)>;
+
+  /**
+   * @brief Returns the SIMD level the kernels run at, the detected one unless overridden.
+   */
+  [[nodiscard]] auto active_simd_level() -> System::Cpu::SimdLevel;
+
+  /**
+   * @brief Overrides the SIMD level, clamped to what the CPU supports; used by tests and benchmarks.
+   */
+  void set_simd_level(System::Cpu::SimdLevel level);
+
+  /*
+   * The kernels below work on arrays of one numeral type (comparisons for equality, `count`,
+   * `indexOf` and `fill` also accept `bool`). Slot-backed arrays are repacked first, and anything
+   * else throws a RuntimeException naming the std.array function. Integer kernels check for
+   * overflow of the result, as the arithmetic operators do. Floating-point sums accumulate in eight
+   * interleaved lanes at every SIMD level, so results do not depend on the CPU.
+   */
+
+  [[nodiscard]] auto array_sum(const RuntimeRef<StorageCell> &array) -> RuntimeRef<StorageCell>;
+  [[nodiscard]] auto array_min(const RuntimeRef<StorageCell> &array) -> RuntimeRef<StorageCell>;
+  [[nodiscard]] auto array_max(const RuntimeRef<StorageCell> &array) -> RuntimeRef<StorageCell>;
+  [[nodiscard]] auto array_dot(const RuntimeRef<StorageCell> &left, const RuntimeRef<StorageCell> &right)
+      -> RuntimeRef<StorageCell>;
+  [[nodiscard]] auto array_scale(const RuntimeRef<StorageCell> &array, const RuntimeRef<StorageCell> &factor)
+      -> RuntimeRef<StorageCell>;
+  [[nodiscard]] auto array_add(const RuntimeRef<StorageCell> &left, const RuntimeRef<StorageCell> &right)
+      -> RuntimeRef<StorageCell>;
+  [[nodiscard]] auto array_fill(const RuntimeRef<StorageCell> &array, const RuntimeRef<StorageCell> &value)
+      -> RuntimeRef<StorageCell>;
+  [[nodiscard]] auto array_index_of(const RuntimeRef<StorageCell> &array, const RuntimeRef<StorageCell> &value)
+      -> int32_t;
+  [[nodiscard]] auto array_count(const RuntimeRef<StorageCell> &array, const RuntimeRef<StorageCell> &value)
+      -> int32_t;
+  [[nodiscard]] auto array_prefix_sum(const RuntimeRef<StorageCell> &array) -> RuntimeRef<StorageCell>;
+  [[nodiscard]] auto array_compare(const RuntimeRef<StorageCell> &left, const RuntimeRef<StorageCell> &right,
+                                   Comparison comparison) -> RuntimeRef<StorageCell>;
+
+  /*
+   * Sorting accepts arrays of any elements that order. Arrays of one number or boolean type sort
+   * packed: integers of 64 or more elements with an LSD radix sort, other numbers with introsort
+   * or, when stable, a merge sort. Other elements compare like B-tree keys, tuples and arrays
+   * element by element, and elements that do not order, including NaN, throw a RuntimeException.
+   */
+
+  [[nodiscard]] auto array_sort(const RuntimeRef<StorageCell> &array, bool stable, bool descending = false)
+      -> RuntimeRef<StorageCell>;
+
+  /**
+   * @brief Returns the `count` smallest elements in ascending order, or all of them if there are fewer.
+   */
+  [[nodiscard]] auto array_partial_sort(const RuntimeRef<StorageCell> &array, int32_t count)
+      -> RuntimeRef<StorageCell>;
+
+  /**
+   * @brief Returns the element at `index` of the sorted array, in linear time on average.
+   */
+  [[nodiscard]] auto array_nth_element(const RuntimeRef<StorageCell> &array, int32_t index)
+      -> RuntimeRef<StorageCell>;
+
+  /**
+   * @brief Stably sorts `array` by `keys`, where `keys[i]` is the key of element `i`.
+   */
+  [[nodiscard]] auto array_sort_by_keys(const RuntimeRef<StorageCell> &array, const Vec<RuntimeRef<StorageCell>> &keys)
+      -> RuntimeRef<StorageCell>;
+
+  /**
+   * @brief Stably sorts `array` with a comparator, calling it once per comparison.
+   *
+   * The merge sort stays in bounds even if `less` is not a strict weak order.
+   */
+  [[nodiscard]] auto array_sort_with(const RuntimeRef<StorageCell> &array, const SortComparator &less)
+      -> RuntimeRef<StorageCell>;
+
+  /**
+   * @brief Runs a recognized fold over a packed array without calling the fold function.
+   *
+   * Integer sums keep the fold's overflow behavior, floating-point sums add in fold order, and
+   * minimum and maximum are only lowered for integers, where the order of comparisons cannot matter.
+   *
+   * @return The folded value, or null when `sequence` is not a packed array of `init`'s type or the
+   *         kernel does not apply; the caller then falls back to calling the fold function.
+   */
+  [[nodiscard]] auto fold_with_kernel(FoldKernel kernel, const RuntimeRef<StorageCell> &init,
+                                      const RuntimeRef<StorageCell> &sequence, bool fromRight)
+      -> RuntimeRef<StorageCell>;
+} // namespace NG::runtime::kernels
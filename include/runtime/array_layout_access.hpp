@@ -11,27 +11,22 @@ namespace NG::runtime
     return runtime_array_length(array);
   }
 
+  /**
+   * Returns the slot of an element, for places that alias it; packed arrays are unpacked first.
+   */
   inline auto array_element_slot(const RuntimeRef<StorageCell> &array, size_t index) -> RuntimeRef<StorageCell>
   {
-    if (index >= array_length(array))
-    {
-      throw RuntimeException("Index out of bounds: " + std::to_string(index));
-    }
-    if (auto slot = runtime_cell_slot_ref(array, index))
-    {
-      return slot;
-    }
-    throw RuntimeException("Array element slot is missing: " + std::to_string(index));
+    runtime_array_unpack(array);
+    return runtime_array_element(array, index);
   }
 
   inline auto array_read_element(const RuntimeRef<StorageCell> &array, size_t index) -> RuntimeRef<StorageCell>
   {
-    return array_element_slot(array, index);
+    return runtime_array_element(array, index);
   }
 
   inline void array_write_element(const RuntimeRef<StorageCell> &array, size_t index, const RuntimeRef<StorageCell> &value)
   {
-    auto slot = array_element_slot(array, index);
-    runtime_copy_storage_cell(slot, value);
+    runtime_array_write_element(array, index, value);
   }
 } // namespace NG::runtime
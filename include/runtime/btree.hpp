@@ -0,0 +1,90 @@
+#pragma once
+
+#include <intp/runtime.hpp>
+
+#include <optional>
+
+namespace NG::runtime
+{
+  /*
+   * A B-tree cell keeps its root node in `opaqueRefs[0]`. Each node is a cell whose `bytes` hold
+   * its entry count, whether it is a leaf and the number of entries below it, and whose
+   * `opaqueRefs` hold its entries back to back (`key, value` pairs for maps, bare keys for sets)
+   * followed by its children. Nodes hold up to 31 entries, so lookups touch few nodes, and the
+   * subtree counts make `btree_key(cell, i)` and `btree_rank` O(log n).
+   *
+   * Keys compare with `value_order`, and tuples and arrays compare element by element. Keys
+   * that do not order throw a RuntimeException.
+   *
+   * Copies of a tree and range cells over it share its root node instead of copying it. A tree
+   * whose root is shared copies its nodes before the next change, so copies and ranges keep the
+   * entries they were created over.
+   */
+
+  [[nodiscard]] auto btree_runtime_type() -> RuntimeRef<NGType>;
+  [[nodiscard]] auto btree_range_runtime_type() -> RuntimeRef<NGType>;
+
+  /**
+   * @brief Creates an empty tree; `withValues` selects a map over a set.
+   */
+  [[nodiscard]] auto make_runtime_btree_cell(bool withValues, StorageClass storageClass = StorageClass::TEMPORARY)
+      -> RuntimeRef<StorageCell>;
+
+  [[nodiscard]] auto runtime_is_btree_value(const RuntimeRef<StorageCell> &cell) -> bool;
+  [[nodiscard]] auto runtime_is_btree_range_value(const RuntimeRef<StorageCell> &cell) -> bool;
+  [[nodiscard]] auto btree_size(const RuntimeRef<StorageCell> &cell) -> size_t;
+
+  /**
+   * @brief Returns the sorted position of `key`, if present.
+   */
+  [[nodiscard]] auto btree_find(const RuntimeRef<StorageCell> &cell, const RuntimeRef<StorageCell> &key)
+      -> std::optional<size_t>;
+
+  /**
+   * @brief Returns the number of keys less than `key`.
+   */
+  [[nodiscard]] auto btree_rank(const RuntimeRef<StorageCell> &cell, const RuntimeRef<StorageCell> &key) -> size_t;
+
+  /**
+   * @brief Inserts `key`, or replaces the value of an equal key already present.
+   *
+   * @param value The value to store; ignored for sets.
+   * @return Whether the key was new.
+   */
+  auto btree_insert(const RuntimeRef<StorageCell> &cell, const RuntimeRef<StorageCell> &key,
+                    const RuntimeRef<StorageCell> &value) -> bool;
+
+  /**
+   * @brief Removes `key`.
+   *
+   * @return Whether the key was present.
+   */
+  auto btree_remove(const RuntimeRef<StorageCell> &cell, const RuntimeRef<StorageCell> &key) -> bool;
+
+  void btree_clear(const RuntimeRef<StorageCell> &cell);
+
+  /**
+   * @brief Returns the key at sorted position `index`.
+   *
+   * @throws RuntimeException if `index` is out of range.
+   */
+  [[nodiscard]] auto btree_key(const RuntimeRef<StorageCell> &cell, size_t index) -> RuntimeRef<StorageCell>;
+
+  /**
+   * @brief Returns the value slot at sorted position `index` of a map.
+   *
+   * @throws RuntimeException if `index` is out of range or the tree is a set.
+   */
+  [[nodiscard]] auto btree_value(const RuntimeRef<StorageCell> &cell, size_t index) -> RuntimeRef<StorageCell>;
+
+  /**
+   * @brief Creates a view of the entries whose keys lie in `[low, high)`, in O(log n).
+   */
+  [[nodiscard]] auto make_runtime_btree_range_cell(const RuntimeRef<StorageCell> &cell,
+                                                   const RuntimeRef<StorageCell> &low,
+                                                   const RuntimeRef<StorageCell> &high) -> RuntimeRef<StorageCell>;
+
+  [[nodiscard]] auto btree_range_size(const RuntimeRef<StorageCell> &range) -> size_t;
+  [[nodiscard]] auto btree_range_key(const RuntimeRef<StorageCell> &range, size_t index) -> RuntimeRef<StorageCell>;
+  [[nodiscard]] auto btree_range_value(const RuntimeRef<StorageCell> &range, size_t index) -> RuntimeRef<StorageCell>;
+} // namespace NG::runtime
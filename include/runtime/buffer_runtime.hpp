@@ -160,6 +160,8 @@ namespace NG::buffer_runtime
   [[nodiscard]] auto make_byte_buffer_layout(size_t size, Str name = "bytes") -> TypeLayout;
   [[nodiscard]] auto make_array_header_layout(Str name = "Array") -> TypeLayout;
   [[nodiscard]] auto make_string_header_layout(Str name = "String") -> TypeLayout;
+  [[nodiscard]] auto make_packed_array_layout(const TypeLayout &element, Str name = "Array") -> TypeLayout;
+  [[nodiscard]] auto packed_array_element_field(const TypeLayout &layout) -> const FieldLayout *;
   [[nodiscard]] auto find_field(const TypeLayout &layout, const Str &name) -> const FieldLayout *;
   void write_u64_field(HeapStore &heap, CellRef ref, const FieldLayout &field, uint64_t value);
   [[nodiscard]] auto read_u64_field(const HeapStore &heap, CellRef ref, const FieldLayout &field) -> uint64_t;
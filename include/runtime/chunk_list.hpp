@@ -0,0 +1,58 @@
+#pragma once
+
+#include <intp/runtime.hpp>
+
+namespace NG::runtime
+{
+  /*
+   * A chunk list cell backs `std.list`. Its `opaqueRefs[0]` is a spine cell whose `opaqueRefs` hold
+   * chunks of 32 element slots, and its `bytes` hold the size, the first live chunk and the offset of
+   * the first element in it. Element `i` is at `front + i` counted across the chunks from the first
+   * one, so `chunk_list_get` is O(1), and pushing or popping at either end touches one chunk. The spine
+   * keeps free chunk slots before the first chunk, so pushing to the front is amortized O(1).
+   *
+   * Copies of a list share its spine, so copying is O(1). A list whose spine or chunk is shared
+   * copies it before the next change: the spine once, O(n / 32), and each chunk it changes, O(32).
+   */
+
+  [[nodiscard]] auto chunk_list_runtime_type() -> RuntimeRef<NGType>;
+
+  [[nodiscard]] auto make_runtime_chunk_list_cell(StorageClass storageClass = StorageClass::TEMPORARY)
+      -> RuntimeRef<StorageCell>;
+
+  [[nodiscard]] auto runtime_is_chunk_list_value(const RuntimeRef<StorageCell> &cell) -> bool;
+  [[nodiscard]] auto chunk_list_size(const RuntimeRef<StorageCell> &cell) -> size_t;
+
+  /**
+   * @brief Returns the element slot at `index`.
+   *
+   * @throws RuntimeException if `index` is out of range.
+   */
+  [[nodiscard]] auto chunk_list_get(const RuntimeRef<StorageCell> &cell, size_t index) -> RuntimeRef<StorageCell>;
+
+  /**
+   * @brief Replaces the element at `index` with a copy of `value`.
+   *
+   * @throws RuntimeException if `index` is out of range.
+   */
+  void chunk_list_set(const RuntimeRef<StorageCell> &cell, size_t index, const RuntimeRef<StorageCell> &value);
+
+  void chunk_list_push_front(const RuntimeRef<StorageCell> &cell, const RuntimeRef<StorageCell> &value);
+  void chunk_list_push_back(const RuntimeRef<StorageCell> &cell, const RuntimeRef<StorageCell> &value);
+
+  /**
+   * @brief Removes and returns the first element.
+   *
+   * @throws RuntimeException if the list is empty.
+   */
+  auto chunk_list_pop_front(const RuntimeRef<StorageCell> &cell) -> RuntimeRef<StorageCell>;
+
+  /**
+   * @brief Removes and returns the last element.
+   *
+   * @throws RuntimeException if the list is empty.
+   */
+  auto chunk_list_pop_back(const RuntimeRef<StorageCell> &cell) -> RuntimeRef<StorageCell>;
+
+  void chunk_list_clear(const RuntimeRef<StorageCell> &cell);
+} // namespace NG::runtime
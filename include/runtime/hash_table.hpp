@@ -0,0 +1,73 @@
+#pragma once
+
+#include <intp/runtime.hpp>
+
+#include <optional>
+
+namespace NG::runtime
+{
+  /*
+   * A hash table cell keeps its entries densely in `opaqueRefs`: `key, value` pairs for maps and
+   * bare keys for sets. Its `bytes` hold an open-addressing index in the style of a Swiss table:
+   * one control byte per slot, holding seven bits of the key hash or an empty/deleted marker, probed
+   * sixteen at a time, and the entry index of each full slot. Removing an entry moves the last one
+   * into its place, so entries stay dense and `hash_table_key(cell, i)` is O(1).
+   *
+   * Keys hash with `value_hash` and compare with `value_equals`. Copying the cell copies the table,
+   * like any other value.
+   */
+
+  [[nodiscard]] auto hash_table_runtime_type() -> RuntimeRef<NGType>;
+
+  /**
+   * @brief Creates an empty table; `withValues` selects a map over a set.
+   */
+  [[nodiscard]] auto make_runtime_hash_table_cell(bool withValues, StorageClass storageClass = StorageClass::TEMPORARY)
+      -> RuntimeRef<StorageCell>;
+
+  [[nodiscard]] auto runtime_is_hash_table_value(const RuntimeRef<StorageCell> &cell) -> bool;
+  [[nodiscard]] auto hash_table_size(const RuntimeRef<StorageCell> &cell) -> size_t;
+
+  /**
+   * @brief Returns the entry index of `key`, if present.
+   */
+  [[nodiscard]] auto hash_table_find(const RuntimeRef<StorageCell> &cell, const RuntimeRef<StorageCell> &key)
+      -> std::optional<size_t>;
+
+  /**
+   * @brief Inserts `key`, or replaces the value of an equal key already present.
+   *
+   * @param value The value to store; ignored for sets.
+   * @return Whether the key was new.
+   */
+  auto hash_table_insert(const RuntimeRef<StorageCell> &cell, const RuntimeRef<StorageCell> &key,
+                         const RuntimeRef<StorageCell> &value) -> bool;
+
+  /**
+   * @brief Removes `key`; the last entry takes its index.
+   *
+   * @return Whether the key was present.
+   */
+  auto hash_table_remove(const RuntimeRef<StorageCell> &cell, const RuntimeRef<StorageCell> &key) -> bool;
+
+  void hash_table_clear(const RuntimeRef<StorageCell> &cell);
+
+  /**
+   * @brief Sizes the index for at least `entries` entries without rehashing as they are inserted.
+   */
+  void hash_table_reserve(const RuntimeRef<StorageCell> &cell, size_t entries);
+
+  /**
+   * @brief Returns the key of entry `index`.
+   *
+   * @throws RuntimeException if `index` is out of range.
+   */
+  [[nodiscard]] auto hash_table_key(const RuntimeRef<StorageCell> &cell, size_t index) -> RuntimeRef<StorageCell>;
+
+  /**
+   * @brief Returns the value slot of entry `index` of a map.
+   *
+   * @throws RuntimeException if `index` is out of range or the table is a set.
+   */
+  [[nodiscard]] auto hash_table_value(const RuntimeRef<StorageCell> &cell, size_t index) -> RuntimeRef<StorageCell>;
+} // namespace NG::runtime
@@ -7,8 +7,8 @@
 
 namespace NG::runtime
 {
-  inline auto runtime_index_slot(const RuntimeRef<StorageCell> &container, const RuntimeRef<StorageCell> &index)
-      -> RuntimeRef<StorageCell>
+  inline auto runtime_index_offset(const RuntimeRef<StorageCell> &container, const RuntimeRef<StorageCell> &index)
+      -> size_t
   {
     int32_t indexValue = 0;
     if (runtime_is_from_end_index(index))
@@ -42,7 +42,13 @@ namespace NG::runtime
       }
     }
 
-    auto offset = static_cast<size_t>(indexValue);
+    return static_cast<size_t>(indexValue);
+  }
+
+  inline auto runtime_index_slot(const RuntimeRef<StorageCell> &container, const RuntimeRef<StorageCell> &index)
+      -> RuntimeRef<StorageCell>
+  {
+    auto offset = runtime_index_offset(container, index);
     try
     {
       return runtime_sequence_slot(container, offset);
@@ -56,12 +62,23 @@ namespace NG::runtime
   inline auto runtime_index_read(const RuntimeRef<StorageCell> &container, const RuntimeRef<StorageCell> &index)
       -> RuntimeRef<StorageCell>
   {
+    if (runtime_is_array_value(container))
+    {
+      return array_read_element(container, runtime_index_offset(container, index));
+    }
     return runtime_index_slot(container, index);
   }
 
   inline auto runtime_index_write(const RuntimeRef<StorageCell> &container, const RuntimeRef<StorageCell> &index,
                                   const RuntimeRef<StorageCell> &value) -> RuntimeRef<StorageCell>
   {
+    if (runtime_is_array_value(container))
+    {
+      // Packed arrays take the value in place, so the written element is read back.
+      auto offset = runtime_index_offset(container, index);
+      array_write_element(container, offset, value);
+      return array_read_element(container, offset);
+    }
     auto slot = runtime_index_slot(container, index);
     runtime_copy_storage_cell(slot, value);
     return slot;
@@ -105,8 +105,11 @@ namespace NG::runtime::native
     return slot;
   }
 
-  inline auto require_string_arg(const Str &functionName, const NativeArgsView &args, size_t index,
-                                 const Str &expectedType = "a string") -> Str
+  /**
+   * Borrows a string argument; the view is valid until the native returns.
+   */
+  inline auto require_string_view_arg(const Str &functionName, const NativeArgsView &args, size_t index,
+                                      const Str &expectedType = "a string") -> std::string_view
   {
     auto slot = require_arg_slot(functionName, args, index, expectedType);
     if (!runtime_is_string_value(slot))
@@ -114,7 +117,13 @@ namespace NG::runtime::native
       throw RuntimeException(functionName + "() requires " + expectedType + " at argument " +
                              std::to_string(index + 1));
     }
-    return runtime_string_value(slot);
+    return runtime_string_view(slot);
+  }
+
+  inline auto require_string_arg(const Str &functionName, const NativeArgsView &args, size_t index,
+                                 const Str &expectedType = "a string") -> Str
+  {
+    return Str(require_string_view_arg(functionName, args, index, expectedType));
   }
 
   inline auto require_array_arg_slot(const Str &functionName, const NativeArgsView &args, size_t index,
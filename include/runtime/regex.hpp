@@ -0,0 +1,63 @@
+#pragma once
+
+#include <intp/runtime.hpp>
+
+namespace NG::runtime
+{
+  /*
+   * A regex cell holds its pattern string in `opaqueRefs[0]` and its compiled program in `opaqueRefs[1]`.
+   * Patterns use the ECMAScript syntax `std::regex` accepted, without backreferences and lookaround:
+   * literals, `.`, classes, `\d \w \s \b` and their negations, groups, `(?:...)`, alternation, anchors,
+   * and greedy or lazy `* + ? {n,m}`. Matching runs the program as a Pike VM, which steps every live
+   * thread once per byte, so it takes time linear in the text for a given pattern. Like `std::regex`
+   * over `char`, it matches bytes, and the leftmost match wins, preferring earlier alternatives.
+   *
+   * Programs never change after they are compiled, so copies share them, and the 64 patterns compiled
+   * most recently are cached for the whole process.
+   */
+
+  [[nodiscard]] auto regex_runtime_type() -> RuntimeRef<NGType>;
+
+  /**
+   * @brief Compiles `pattern`, reusing the cached program if it was compiled recently.
+   *
+   * @throws RuntimeException if `pattern` is not a valid regex.
+   */
+  [[nodiscard]] auto make_runtime_regex_cell(std::string_view pattern) -> RuntimeRef<StorageCell>;
+
+  [[nodiscard]] auto runtime_is_regex_value(const RuntimeRef<StorageCell> &cell) -> bool;
+
+  /**
+   * @brief Number of capture groups, not counting the whole match.
+   */
+  [[nodiscard]] auto regex_group_count(const RuntimeRef<StorageCell> &cell) -> size_t;
+
+  /**
+   * @brief Whether the regex matches anywhere in `text`.
+   */
+  [[nodiscard]] auto regex_matches(const RuntimeRef<StorageCell> &cell, std::string_view text) -> bool;
+
+  /**
+   * @brief Finds the leftmost match starting at or after `from`.
+   *
+   * Assertions such as `^` and `\b` see the text before `from`.
+   *
+   * @return Empty if there is no match; otherwise the start and end offsets of the whole match and
+   *         then of each group, with -1 for groups that took no part in the match.
+   */
+  [[nodiscard]] auto regex_search(const RuntimeRef<StorageCell> &cell, std::string_view text, size_t from = 0)
+      -> Vec<int64_t>;
+
+  /**
+   * @brief Replaces every match; `$&` or `$0` is the match, `$1` to `$99` a group and `$$` a `$`.
+   */
+  [[nodiscard]] auto regex_replace_all(const RuntimeRef<StorageCell> &cell, std::string_view text,
+                                       std::string_view replacement) -> Str;
+
+  /**
+   * @brief Whether `pattern` matches anywhere in `text`, compiling it through the process-wide cache.
+   *
+   * @throws RuntimeException if `pattern` is not a valid regex.
+   */
+  [[nodiscard]] auto regex_match_cached(std::string_view text, std::string_view pattern) -> bool;
+} // namespace NG::runtime
@@ -7,12 +7,12 @@ namespace NG::runtime
 {
   inline auto string_length(const RuntimeRef<StorageCell> &string) -> size_t
   {
-    return runtime_string_value(string).size();
+    return runtime_string_view(string).size();
   }
 
   inline auto string_data_handle(const RuntimeRef<StorageCell> &string) -> NativeHandle
   {
-    auto payload = runtime_string_value(string);
+    auto payload = runtime_string_view(string);
     return NativeHandle{
         .typeName = "String.payload",
         .address = reinterpret_cast<uintptr_t>(payload.data()),
@@ -26,7 +26,7 @@ namespace NG::runtime
     {
       throw RuntimeException("Index out of bounds: " + std::to_string(index));
     }
-    auto payload = runtime_string_value(string);
+    auto payload = runtime_string_view(string);
     return numeral_cell_from_value<int32_t>(static_cast<unsigned char>(payload[index]));
   }
 } // namespace NG::runtime
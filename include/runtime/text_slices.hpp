@@ -0,0 +1,61 @@
+#pragma once
+
+#include <intp/runtime.hpp>
+
+namespace NG::runtime
+{
+  /*
+   * A text slices cell is a lazy sequence of the pieces of a text: the parts of a string between
+   * occurrences of a delimiter, the runs of a string between separator characters, the matches of a
+   * regex, or the lines of a file. Pieces are found on demand and each one becomes a string cell only
+   * when it is read. The cell keeps the position of the last piece it found, so reading the pieces in
+   * order scans the text once. A file is read in chunks of 64 KiB, and only the current chunk is held, grown to fit a
+   * longer line. Copies share the source string and the chunk.
+   */
+
+  [[nodiscard]] auto text_slices_runtime_type() -> RuntimeRef<NGType>;
+
+  /**
+   * @brief Pieces of `source` between occurrences of `delimiter`, like `split`; an empty delimiter yields each byte.
+   */
+  [[nodiscard]] auto make_runtime_split_slices_cell(const RuntimeRef<StorageCell> &source, std::string_view delimiter)
+      -> RuntimeRef<StorageCell>;
+
+  /**
+   * @brief Non-empty runs of `source` containing none of the bytes in `separators`.
+   */
+  [[nodiscard]] auto make_runtime_token_slices_cell(const RuntimeRef<StorageCell> &source,
+                                                    std::string_view separators) -> RuntimeRef<StorageCell>;
+
+  /**
+   * @brief Matches of `regex` in `source`, like `findAll`; after an empty match the next starts a byte later.
+   */
+  [[nodiscard]] auto make_runtime_regex_slices_cell(const RuntimeRef<StorageCell> &source,
+                                                    const RuntimeRef<StorageCell> &regex) -> RuntimeRef<StorageCell>;
+
+  /**
+   * @brief Lines of the file at `path`, without their `\n` or `\r\n`.
+   *
+   * @throws RuntimeException if the file cannot be opened.
+   */
+  [[nodiscard]] auto make_runtime_file_lines_cell(std::string_view path) -> RuntimeRef<StorageCell>;
+
+  [[nodiscard]] auto runtime_is_text_slices_value(const RuntimeRef<StorageCell> &cell) -> bool;
+
+  /**
+   * @brief Counts the pieces, scanning the rest of the text the first time.
+   */
+  [[nodiscard]] auto text_slices_size(const RuntimeRef<StorageCell> &cell) -> size_t;
+
+  /**
+   * @brief Whether piece `index` exists, scanning no further than that piece.
+   */
+  [[nodiscard]] auto text_slices_has(const RuntimeRef<StorageCell> &cell, size_t index) -> bool;
+
+  /**
+   * @brief Returns piece `index` as a new string.
+   *
+   * @throws RuntimeException if `index` is out of range.
+   */
+  [[nodiscard]] auto text_slices_get(const RuntimeRef<StorageCell> &cell, size_t index) -> RuntimeRef<StorageCell>;
+} // namespace NG::runtime
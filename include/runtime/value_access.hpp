@@ -568,10 +568,17 @@ namespace NG::runtime
     slot->lifecycleDropped = borrowOwningNativeHandle ? true : source->lifecycleDropped;
     slot->dropInProgress = false;
     slot->opaqueRefs.clear();
-    slot->opaqueRefs.reserve(source->opaqueRefs.size());
-    for (const auto &ref : source->opaqueRefs)
+    if (source->runtimeType && source->runtimeType->sharesOpaqueRefs)
     {
-      slot->opaqueRefs.push_back(ref ? clone_runtime_storage_cell(ref, storageClass, ref->name) : nullptr);
+      slot->opaqueRefs = source->opaqueRefs;
+    }
+    else
+    {
+      slot->opaqueRefs.reserve(source->opaqueRefs.size());
+      for (const auto &ref : source->opaqueRefs)
+      {
+        slot->opaqueRefs.push_back(ref ? clone_runtime_storage_cell(ref, storageClass, ref->name) : nullptr);
+      }
     }
     slot->namedRefs.clear();
     for (const auto &[refName, ref] : source->namedRefs)
@@ -116,8 +116,8 @@ namespace NG::runtime::ops
     auto rightType = runtime_value_type(right);
     if (leftType && rightType && leftType->name == "Array" && rightType->name == "Array")
     {
-      auto leftSlots = runtime_cell_slot_refs(left);
-      auto rightSlots = runtime_cell_slot_refs(right);
+      auto leftSlots = runtime_array_slots(left);
+      auto rightSlots = runtime_array_slots(right);
       return aggregate_slots_equal(leftSlots, rightSlots);
     }
     if (leftType && rightType && leftType->name == "Tuple" && rightType->name == "Tuple")
@@ -165,6 +165,153 @@ namespace NG::runtime::ops
     return false;
   }
 
+  /**
+   * Mixes `value` into `seed`; the finalizer is splitmix64's, so every input bit affects the result.
+   */
+  inline auto hash_combine(uint64_t seed, uint64_t value) -> uint64_t
+  {
+    uint64_t mixed = seed ^ (value + 0x9e3779b97f4a7c15ULL + (seed << 6U) + (seed >> 2U));
+    mixed = (mixed ^ (mixed >> 30U)) * 0xbf58476d1ce4e5b9ULL;
+    mixed = (mixed ^ (mixed >> 27U)) * 0x94d049bb133111ebULL;
+    return mixed ^ (mixed >> 31U);
+  }
+
+  inline auto value_hash(const RuntimeRef<StorageCell> &cell) -> uint64_t;
+
+  inline auto aggregate_slots_hash(uint64_t seed, const Vec<RuntimeRef<StorageCell>> &slots) -> uint64_t
+  {
+    seed = hash_combine(seed, slots.size());
+    for (const auto &slot : slots)
+    {
+      seed = hash_combine(seed, value_hash(slot));
+    }
+    return seed;
+  }
+
+  /**
+   * Hashes a value consistently with `value_equals`: numbers that compare equal hash alike whatever
+   * their type, and arrays, tuples, tagged values and objects hash their elements. Native values hash
+   * through their type's `hashCellHandler`.
+   *
+   * @throws RuntimeException for native values whose type cannot hash them, since a hash of the type
+   *         name alone would put every such key in one bucket.
+   */
+  inline auto value_hash(const RuntimeRef<StorageCell> &cell) -> uint64_t
+  {
+    auto type = runtime_value_type(cell);
+    if (!cell || !type)
+    {
+      return 0;
+    }
+    const auto &name = type->name;
+    if (name == "f32" || name == "float" || name == "f64" || name == "double")
+    {
+      auto value = read_numeric_cell_as<double>(cell);
+      // Integral values hash like the integer they equal; this also folds -0.0 into 0.
+      if (value == std::trunc(value) && value >= -0x1p63 && value < 0x1p63)
+      {
+        return hash_combine(0, static_cast<uint64_t>(static_cast<int64_t>(value)));
+      }
+      return hash_combine(0, std::bit_cast<uint64_t>(value));
+    }
+    if (name == "u64")
+    {
+      return hash_combine(0, read_inline_cell_bytes<uint64_t>(cell));
+    }
+    if (name == "i8" || name == "u8" || name == "i16" || name == "u16" || name == "i32" || name == "int" ||
+        name == "u32" || name == "uint" || name == "i64")
+    {
+      return hash_combine(0, static_cast<uint64_t>(read_numeric_cell_as<int64_t>(cell)));
+    }
+    if (runtime_is_string_value(cell))
+    {
+      return hash_combine(1, std::hash<std::string_view>{}(runtime_string_view(cell)));
+    }
+    auto seed = hash_combine(2, std::hash<Str>{}(name));
+    if (type->hashCellHandler)
+    {
+      return hash_combine(seed, type->hashCellHandler(cell));
+    }
+    if (name == "Bool")
+    {
+      return hash_combine(seed, runtime_value_bool(cell) ? 1 : 0);
+    }
+    if (name == "Array")
+    {
+      return aggregate_slots_hash(seed, runtime_array_slots(cell));
+    }
+    if (name == "Tuple")
+    {
+      return aggregate_slots_hash(seed, runtime_cell_slot_refs(cell));
+    }
+    if (type->layout.kind == LayoutKind::TAGGED_UNION)
+    {
+      return aggregate_slots_hash(hash_combine(seed, static_cast<uint64_t>(type->variantIndex)),
+                                  runtime_cell_slot_refs(cell));
+    }
+    if (!type->properties.empty())
+    {
+      seed = aggregate_slots_hash(seed, runtime_cell_slot_refs(cell));
+      // Named slots are unordered, so their hashes are combined with a commutative sum.
+      uint64_t named = 0;
+      for (const auto &[slotName, slot] : runtime_cell_named_slot_refs(cell))
+      {
+        named += hash_combine(std::hash<Str>{}(slotName), value_hash(slot));
+      }
+      return hash_combine(seed, named);
+    }
+    if (is_nominal_wrapper_cell(cell))
+    {
+      return hash_combine(seed, value_hash(runtime_cell_slot_ref(cell, 0)));
+    }
+    if (!cell->opaqueRefs.empty())
+    {
+      throw RuntimeException("values of type " + name + " cannot be hashed");
+    }
+    return seed;
+  }
+
+  /**
+   * Orders two values the way sorting and ordered collections do: values of one type order through its
+   * handler directly, and tuples and arrays compare element by element. Returns UNORDERED otherwise.
+   */
+  inline auto key_order(const RuntimeRef<StorageCell> &left, const RuntimeRef<StorageCell> &right) -> Orders
+  {
+    if (const auto &type = left->runtimeType; type && type == right->runtimeType && type->cellOrderHandler)
+    {
+      if (auto order = type->cellOrderHandler(left, right); order != Orders::UNORDERED)
+      {
+        return order;
+      }
+    }
+    auto leftType = runtime_value_type(left);
+    auto rightType = runtime_value_type(right);
+    auto isSequence = [](const RuntimeRef<NGType> &type) {
+      return type && (type->name == "Tuple" || type->name == "Array");
+    };
+    if (isSequence(leftType) && isSequence(rightType))
+    {
+      auto slotsOf = [](const RuntimeRef<StorageCell> &cell, const RuntimeRef<NGType> &type) {
+        return type->name == "Array" ? runtime_array_slots(cell) : runtime_cell_slot_refs(cell);
+      };
+      auto leftSlots = slotsOf(left, leftType);
+      auto rightSlots = slotsOf(right, rightType);
+      for (size_t i = 0; i < leftSlots.size() && i < rightSlots.size(); ++i)
+      {
+        if (auto order = key_order(leftSlots[i], rightSlots[i]); order != Orders::EQ)
+        {
+          return order;
+        }
+      }
+      if (leftSlots.size() == rightSlots.size())
+      {
+        return Orders::EQ;
+      }
+      return leftSlots.size() < rightSlots.size() ? Orders::LT : Orders::GT;
+    }
+    return value_order(left, right);
+  }
+
   inline auto value_less_than(const RuntimeRef<StorageCell> &left, const RuntimeRef<StorageCell> &right) -> bool
   {
     if (auto order = value_order(left, right); order != Orders::UNORDERED)
@@ -0,0 +1,29 @@
+#pragma once
+
+#include <common.hpp>
+
+namespace NG::System::Cpu
+{
+
+    /**
+     * @brief The vector instruction sets numeric kernels can be compiled for, weakest first.
+     */
+    enum class SimdLevel
+    {
+        Scalar, ///< Portable code without ISA-specific attributes.
+        Sse2,
+        Avx2,
+    };
+
+    /**
+     * @brief Returns the strongest level the running CPU supports.
+     *
+     * x86 builds query `cpuid` once; other targets always report `Scalar`.
+     */
+    auto detected_simd_level() -> SimdLevel;
+
+    /**
+     * @brief Returns a readable name for `level` ("scalar", "sse2" or "avx2").
+     */
+    auto simd_level_name(SimdLevel level) -> Str;
+} // namespace NG::System::Cpu
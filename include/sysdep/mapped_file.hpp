@@ -0,0 +1,43 @@
+#pragma once
+
+#include <common.hpp>
+#include <token.hpp>
+
+#include <string_view>
+
+namespace NG::System
+{
+
+    /**
+     * @brief A read-only view of a whole file backed by a memory mapping.
+     *
+     * POSIX platforms use `mmap(PROT_READ, MAP_PRIVATE)`; other platforms fall back to reading
+     * the file into an owned buffer. The view stays valid for the lifetime of the object.
+     */
+    class MappedFile : NonCopyable
+    {
+        const char *data = nullptr; ///< Start of the mapped (or buffered) bytes.
+        size_t length = 0;          ///< Number of bytes in the view.
+        bool mapped = false;        ///< Whether `data` must be released with `munmap`.
+        Str fallback;               ///< Owned storage when mapping is unavailable.
+
+      public:
+        /**
+         * @brief Maps `path` for reading.
+         *
+         * @param path The file to map.
+         * @throws RuntimeException if the file cannot be opened or mapped.
+         */
+        explicit MappedFile(const Str &path);
+
+        ~MappedFile();
+
+        /**
+         * @brief Returns the file contents.
+         */
+        [[nodiscard]] auto view() const -> std::string_view { return {data, length}; }
+
+        [[nodiscard]] auto size() const -> size_t { return length; }
+    };
+
+} // namespace NG::System
@@ -18,4 +18,17 @@ namespace NG::System::Process
      * @return Path to the current executable (absolute when available; empty string on failure).
      */
     NG::Str current_executable_path();
+
+    /**
+     * @brief Returns the id of the current process.
+     */
+    uint64_t current_process_id();
+
+    /**
+     * @brief Returns a file name suffix no other call in any process returns, e.g. `.tmp1234.7`.
+     *
+     * Made of the process id and a per-process counter, for temporary files that are renamed into
+     * place by writers that may run concurrently in several threads and processes.
+     */
+    NG::Str unique_temporary_suffix();
 } // namespace NG::System::Process
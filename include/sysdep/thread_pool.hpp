@@ -0,0 +1,68 @@
+#pragma once
+
+#include <common.hpp>
+#include <token.hpp>
+
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+namespace NG::System
+{
+
+    /**
+     * @brief A fixed-size pool of worker threads running queued tasks.
+     *
+     * Tasks may submit further tasks. `wait()` blocks until the queue is drained and no task is
+     * running, then rethrows the first exception a task let escape.
+     */
+    class ThreadPool : NonCopyable
+    {
+        Vec<std::thread> workers;
+        std::deque<std::function<void()>> tasks;
+        std::mutex mutex;
+        std::condition_variable taskReady;
+        std::condition_variable allDone;
+        size_t running = 0;           ///< Tasks currently executing.
+        bool stopping = false;        ///< Set by the destructor to release idle workers.
+        std::exception_ptr firstError; ///< First exception escaping a task, rethrown by `wait()`.
+
+        void work();
+
+      public:
+        /**
+         * @brief Starts `workerCount` worker threads (at least one).
+         */
+        explicit ThreadPool(size_t workerCount = default_concurrency());
+
+        /**
+         * @brief Finishes all queued tasks and joins the workers.
+         */
+        ~ThreadPool();
+
+        /**
+         * @brief Queues a task. Safe to call from inside a running task.
+         */
+        void submit(std::function<void()> task);
+
+        /**
+         * @brief Blocks until every queued and running task has finished.
+         *
+         * @throws The first exception thrown by a task since the last `wait()`.
+         */
+        void wait();
+
+        [[nodiscard]] auto size() const -> size_t { return workers.size(); }
+
+        /**
+         * @brief Returns the default worker count.
+         *
+         * Uses `NG_JOBS` when set to a positive number, otherwise the hardware concurrency.
+         */
+        static auto default_concurrency() -> size_t;
+    };
+
+} // namespace NG::System
@@ -0,0 +1,150 @@
+#pragma once
+
+#include <typecheck/typeinfo.hpp>
+
+#include <functional>
+#include <optional>
+#include <string_view>
+
+namespace NG::typecheck
+{
+    // Bump whenever the encoding, or what the type checker stores in an interface, changes.
+    constexpr uint32_t NGI_FORMAT_VERSION = 1;
+
+    /**
+     * @brief Locates a definition by position: index in `Module::definitions` and, for trait methods,
+     * the index in `TraitDef::methods`.
+     */
+    struct InterfaceAstRef
+    {
+        static constexpr uint32_t NO_MEMBER = UINT32_MAX;
+
+        Str moduleId;                  ///< Module whose AST holds the definition.
+        uint32_t definition = 0;       ///< Index in the module definitions.
+        uint32_t member = NO_MEMBER;   ///< Method index inside a trait definition.
+    };
+
+    /**
+     * @brief A trait impl declared by the module, with its `ImplDef` given by definition index.
+     */
+    struct InterfaceImpl
+    {
+        Str traitName;
+        Str targetPattern;
+        Vec<Str> genericParamNames;
+        Vec<Str> whereBounds;
+        Map<Str, Str> methods;
+        uint32_t definition = 0;
+    };
+
+    /**
+     * @brief The checked interface of a source module (`.ngi`).
+     *
+     * Holds everything importers need from the module without checking it again: the types of all
+     * module-level bindings (private ones included, since generic bodies are checked at the call site),
+     * its trait impls, derived impls and auto traits. Generic and compile-time definitions refer back to
+     * the module AST by position, so their bodies stay available for monomorphization.
+     *
+     * An interface is valid while the module source hash and the interface hashes of its imports are
+     * unchanged. `interfaceHash` covers everything but the header, so editing a function body leaves the
+     * interfaces of importers valid as long as no signature changes.
+     */
+    struct ModuleInterface
+    {
+        Str moduleId;
+        Str sourceHash;                                     ///< `bytecode_source_hash` of the module source.
+        Vec<std::pair<Str, Str>> dependencies;              ///< Imported module ID and its interface hash.
+        Str interfaceHash;                                  ///< Hash of the encoded interface body.
+        Vec<std::pair<Str, CheckingRef<TypeInfo>>> symbols; ///< Bindings defined by the module.
+        Vec<InterfaceImpl> impls;                           ///< Trait impls declared by the module.
+        Vec<Str> derivedTraitImplKeys;
+        Vec<Str> autoTraits;
+    };
+
+    /**
+     * @brief Callbacks connecting a decoded interface to the current program.
+     */
+    struct ModuleInterfaceResolver
+    {
+        /// Returns the live type for a nominal type owned by another module, or null to decode the stored copy.
+        std::function<CheckingRef<TypeInfo>(typeinfo_tag tag, const Str &moduleId, const Str &name)> type;
+        /// Returns the definition at `ref`, or null if it does not exist.
+        std::function<NG::ast::ASTRef<NG::ast::ASTNode>(const InterfaceAstRef &ref)> definition;
+    };
+
+    /// Returns where `node` is defined, or nothing if it is not a module-level definition or trait method.
+    using InterfaceAstLocator = std::function<std::optional<InterfaceAstRef>(const NG::ast::ASTNode *node)>;
+
+    /**
+     * @brief Encodes `moduleInterface` and sets its `interfaceHash`.
+     *
+     * Nominal types owned by `moduleInterface.moduleId` are stored in full. Types owned by other modules are
+     * stored by name, with a copy used only when the importer cannot find them.
+     *
+     * @throws TypeCheckingException if a definition of the module cannot be located.
+     */
+    auto encode_module_interface(ModuleInterface &moduleInterface, const InterfaceAstLocator &locate) -> Str;
+
+    /**
+     * @brief Decodes the header fields (ID, hashes and dependencies) only.
+     *
+     * @throws RuntimeException if the bytes are not a current `.ngi` interface.
+     */
+    auto decode_module_interface_header(std::string_view bytes) -> ModuleInterface;
+
+    /**
+     * @brief Decodes a whole interface.
+     *
+     * @throws RuntimeException if the bytes are malformed or a referenced definition does not exist.
+     */
+    auto decode_module_interface(std::string_view bytes, const ModuleInterfaceResolver &resolver) -> ModuleInterface;
+
+    /**
+     * @brief Returns the interface path for the module at `sourcePath`, or an empty string when
+     * interfaces are disabled.
+     *
+     * Interfaces are kept in `$NG_INTERFACE_DIR`; the file name combines the module ID with a hash of
+     * the source path, so modules with the same ID under different roots do not evict each other.
+     */
+    auto module_interface_path(const Str &moduleId, const Str &sourcePath) -> Str;
+
+    /**
+     * @brief Writes `bytes` to `path` atomically (write to a temporary file, then rename).
+     *
+     * @return Whether the file was written. Failures are not errors: the interface is only a cache.
+     */
+    auto write_module_interface_file(const Str &path, std::string_view bytes) -> bool;
+
+    /**
+     * @brief Returns the prelude snapshot path (`$NG_PRELUDE_SNAPSHOT`), or an empty string when the
+     * snapshot is disabled.
+     */
+    auto prelude_snapshot_path() -> Str;
+
+    /**
+     * @brief One module in a prelude snapshot image.
+     */
+    struct PreludeSnapshotEntry
+    {
+        Str moduleId;
+        std::string_view interface; ///< Encoded module interface.
+        Str bytecodeKey;            ///< Build key `bytecode` was compiled under; empty until it is compiled.
+        std::string_view bytecode;  ///< Encoded `.ngo` module, or empty.
+    };
+
+    /**
+     * @brief Packs the interfaces, and any compiled bytecode, of the prelude and the modules it loads
+     * into one snapshot image.
+     *
+     * @param entries Entries in the order the modules were checked.
+     */
+    auto encode_prelude_snapshot(const Vec<PreludeSnapshotEntry> &entries) -> Str;
+
+    /**
+     * @brief Lists the entries of a snapshot image. The views point into `bytes`.
+     *
+     * @throws RuntimeException if the bytes are not a current snapshot image.
+     */
+    auto decode_prelude_snapshot(std::string_view bytes) -> Vec<PreludeSnapshotEntry>;
+
+} // namespace NG::typecheck
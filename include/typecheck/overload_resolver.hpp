@@ -2,6 +2,7 @@
 
 #include <typecheck/typeinfo.hpp>
 #include <typecheck/type_environment.hpp>
+#include <typecheck/trait_registry.hpp>
 #include <ast.hpp>
 #include <fwd.hpp>
 
@@ -72,7 +73,7 @@ namespace NG::typecheck
 
     /// Check if expected type matches actual type (including ref-trait coercion).
     auto typeMatches(const TypeInfo &expected, const TypeInfo &actual,
-                     const Map<Str, Vec<Str>> &trait_impls_by_type,
+                     const TraitImplIndex &trait_impls_by_type,
                      const Set<Str> &activeAutoTraits,
                      const Set<Str> &activeDerivedTraitImplKeys,
                      const TypeEnvironment &env) -> bool;
@@ -87,4 +88,17 @@ namespace NG::typecheck
     // ── Overload resolution utilities ───────────────────────────────────
 
     auto functionPatternSpecificity(const ast::FunctionDef &candidate) -> size_t;
+
+    /// Type constructor a parameter pattern requires of its argument, or "" if it accepts any.
+    auto typePatternHead(const ast::TypeAnnotation *pattern, const Set<Str> &genericParamNames) -> Str;
+
+    /// Type constructor of an argument type, comparable with `typePatternHead`.
+    auto typeHead(const CheckingRef<TypeInfo> &type) -> Str;
+
+    /// Adds overloads registered since the last call to the overload buckets of `genericDef`.
+    void indexGenericOverloads(GenericDefType &genericDef);
+
+    /// Overloads of `genericDef` that may accept `argumentTypes`, in declaration order.
+    auto genericOverloadCandidates(GenericDefType &genericDef, const Vec<CheckingRef<TypeInfo>> &argumentTypes)
+        -> Vec<ast::FunctionDef *>;
 } // namespace NG::typecheck
@@ -4,8 +4,156 @@
 #include <ast.hpp>
 #include <fwd.hpp>
 
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <mutex>
+
 namespace NG::typecheck
 {
+    /**
+     * @brief Trait impls indexed by head type name and by trait, with memoized impl queries.
+     *
+     * Copies share one table until either side registers an impl, so child checkers inherit the impls
+     * and the memoized answers of their parent in O(1). Registering an impl forgets the answers for
+     * its type; declaring a trait or changing its super-traits forgets all of them (see
+     * `traitGraphChanged`).
+     */
+    class TraitImplIndex
+    {
+        struct Table
+        {
+            Map<Str, Vec<Str>> traitsByType;         ///< Head type name -> traits, in registration order.
+            Map<Str, Set<Str>> typesByTrait;         ///< Trait name -> head type names with a direct impl.
+            Map<Str, Map<Str, bool>> implementsMemo; ///< Head type name -> trait name -> `implements` result.
+            uint64_t memoGeneration = 0;             ///< Trait graph generation `implementsMemo` was computed in.
+            mutable std::mutex memoMutex;            ///< Guards the memo; bodies may be checked in parallel.
+
+            Table() = default;
+            Table(const Table &other)
+                : traitsByType(other.traitsByType), typesByTrait(other.typesByTrait)
+            {
+                std::lock_guard lock{other.memoMutex};
+                implementsMemo = other.implementsMemo;
+                memoGeneration = other.memoGeneration;
+            }
+        };
+
+        static auto traitGraphGeneration() -> std::atomic<uint64_t> &
+        {
+            static std::atomic<uint64_t> generation{0};
+            return generation;
+        }
+
+        std::shared_ptr<Table> table = std::make_shared<Table>();
+
+        auto writable() -> Table &
+        {
+            if (table.use_count() > 1)
+            {
+                table = std::make_shared<Table>(*table);
+            }
+            return *table;
+        }
+
+    public:
+        using const_iterator = Map<Str, Vec<Str>>::const_iterator;
+
+        [[nodiscard]] auto find(const Str &typeName) const -> const_iterator { return table->traitsByType.find(typeName); }
+        [[nodiscard]] auto end() const -> const_iterator { return table->traitsByType.end(); }
+        [[nodiscard]] auto empty() const -> bool { return table->traitsByType.empty(); }
+
+        /// Traits with a direct impl for `typeName`.
+        [[nodiscard]] auto traitsOf(const Str &typeName) const -> const Vec<Str> &
+        {
+            static const Vec<Str> none{};
+            auto it = table->traitsByType.find(typeName);
+            return it != table->traitsByType.end() ? it->second : none;
+        }
+
+        /// Head type names with a direct impl of `traitName`.
+        [[nodiscard]] auto typesImplementing(const Str &traitName) const -> const Set<Str> &
+        {
+            static const Set<Str> none{};
+            auto it = table->typesByTrait.find(traitName);
+            return it != table->typesByTrait.end() ? it->second : none;
+        }
+
+        [[nodiscard]] auto hasDirectImpl(const Str &typeName, const Str &traitName) const -> bool
+        {
+            return typesImplementing(traitName).contains(typeName);
+        }
+
+        /// Registers an impl; returns false if it was already registered.
+        auto add(const Str &typeName, const Str &traitName) -> bool
+        {
+            if (hasDirectImpl(typeName, traitName))
+            {
+                return false;
+            }
+            auto &writableTable = writable();
+            writableTable.traitsByType[typeName].push_back(traitName);
+            writableTable.typesByTrait[traitName].insert(typeName);
+            writableTable.implementsMemo.erase(typeName);
+            return true;
+        }
+
+        /**
+         * @brief Returns whether `typeName` has an impl of `traitName` or of a trait implying it.
+         *
+         * `implies(candidate, required)` answers the super-trait question on a miss; the answer is
+         * memoized until an impl is registered for `typeName` or the trait graph changes.
+         */
+        template <class Implies>
+        [[nodiscard]] auto implements(const Str &typeName, const Str &traitName, Implies &&implies) const -> bool
+        {
+            if (hasDirectImpl(typeName, traitName))
+            {
+                return true;
+            }
+            auto typeIt = table->traitsByType.find(typeName);
+            if (typeIt == table->traitsByType.end())
+            {
+                return false;
+            }
+            const auto generation = traitGraphGeneration().load();
+            {
+                std::lock_guard lock{table->memoMutex};
+                if (table->memoGeneration != generation)
+                {
+                    table->implementsMemo.clear();
+                    table->memoGeneration = generation;
+                }
+                if (auto memo = table->implementsMemo.find(typeName); memo != table->implementsMemo.end())
+                {
+                    if (auto cached = memo->second.find(traitName); cached != memo->second.end())
+                    {
+                        return cached->second;
+                    }
+                }
+            }
+            const bool result = std::ranges::any_of(
+                typeIt->second, [&](const Str &implemented) { return implies(implemented, traitName); });
+            std::lock_guard lock{table->memoMutex};
+            // An answer computed while the graph changed is not kept.
+            if (table->memoGeneration == generation)
+            {
+                table->implementsMemo[typeName].emplace(traitName, result);
+            }
+            return result;
+        }
+
+        void clear() { table = std::make_shared<Table>(); }
+
+        /**
+         * @brief Invalidates the memoized answers of every index.
+         *
+         * Called whenever a trait is declared or its super-traits are set, since those answers depend
+         * on the super-trait graph rather than on the impls an index holds.
+         */
+        static void traitGraphChanged() { traitGraphGeneration().fetch_add(1); }
+    };
+
     /**
      * @brief Manages trait implementations, auto-trait derivation, and impl lookup.
      *
@@ -29,7 +177,7 @@ namespace NG::typecheck
         };
 
         // ── State ────────────────────────────────────────────────────────
-        Map<Str, Vec<Str>> trait_impls_by_type;  // typeName -> [traitName, ...]
+        TraitImplIndex trait_impls_by_type;
         Vec<TraitImplRecord> localTraitImpls;
         Map<Str, Vec<ast::UseImplDecl *>> selectedTraitImpls;
         Set<Str> matchedSelectedTraitImpls;
@@ -41,11 +189,7 @@ namespace NG::typecheck
         /// Register a trait implementation for a type.
         void registerImpl(const Str &typeName, const Str &traitName)
         {
-            auto &impls = trait_impls_by_type[typeName];
-            if (std::find(impls.begin(), impls.end(), traitName) == impls.end())
-            {
-                impls.push_back(traitName);
-            }
+            trait_impls_by_type.add(typeName, traitName);
         }
 
         /// Register a local trait implementation record.
@@ -65,9 +209,7 @@ namespace NG::typecheck
         /// Check if a type has a specific trait implementation registered.
         [[nodiscard]] auto hasImpl(const Str &typeName, const Str &traitName) const -> bool
         {
-            auto it = trait_impls_by_type.find(typeName);
-            if (it == trait_impls_by_type.end()) return false;
-            return std::find(it->second.begin(), it->second.end(), traitName) != it->second.end();
+            return trait_impls_by_type.hasDirectImpl(typeName, traitName);
         }
 
         /// Check if a derived trait impl exists.
@@ -85,16 +227,14 @@ namespace NG::typecheck
         /// Get all trait implementations for a type.
         [[nodiscard]] auto getImplsForType(const Str &typeName) const -> const Vec<Str> &
         {
-            static const Vec<Str> empty{};
-            auto it = trait_impls_by_type.find(typeName);
-            return it != trait_impls_by_type.end() ? it->second : empty;
+            return trait_impls_by_type.traitsOf(typeName);
         }
 
         // ── Super-trait resolution ───────────────────────────────────────
 
         /// Check if candidateName implies requiredName via super-trait chain.
         [[nodiscard]] auto traitImplies(const Str &candidateName, const Str &requiredName,
-                                         const Map<Str, CheckingRef<TypeInfo>> &locals) const -> bool
+                                         const TypeScope &locals) const -> bool
         {
             if (candidateName == requiredName) return true;
             auto it = locals.find(candidateName);
@@ -119,7 +259,7 @@ namespace NG::typecheck
     private:
         [[nodiscard]] auto traitImpliesRecursive(const TraitType &candidate, const Str &requiredName,
                                                   Set<Str> &seen,
-                                                  const Map<Str, CheckingRef<TypeInfo>> &locals) const -> bool
+                                                  const TypeScope &locals) const -> bool
         {
             if (!seen.insert(candidate.name).second) return false;
             for (auto &superTrait : candidate.superTraits)
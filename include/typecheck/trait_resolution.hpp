@@ -2,6 +2,7 @@
 
 #include <typecheck/typeinfo.hpp>
 #include <typecheck/type_environment.hpp>
+#include <typecheck/trait_registry.hpp>
 #include <ast.hpp>
 #include <fwd.hpp>
 
@@ -16,23 +17,27 @@ namespace NG::typecheck
 
     /// Check if a type satisfies a trait.
     auto typeSatisfiesTrait(const CheckingRef<TypeInfo> &type, const TraitType &trait,
-                            const Map<Str, Vec<Str>> &trait_impls_by_type,
+                            const TraitImplIndex &trait_impls_by_type,
                             const Set<Str> &activeAutoTraits,
                             const Set<Str> &activeDerivedTraitImplKeys,
                             const TypeEnvironment &env) -> bool;
 
     /// Check if a type satisfies an auto trait (structural check).
     auto typeSatisfiesAutoTrait(const CheckingRef<TypeInfo> &type, const TraitType &trait,
-                                const Map<Str, Vec<Str>> &trait_impls_by_type,
+                                const TraitImplIndex &trait_impls_by_type,
                                 const TypeEnvironment &env,
                                 Set<Str> &seen) -> bool;
 
     /// Check if a type can derive a trait.
     auto typeCanDeriveTrait(const CheckingRef<TypeInfo> &type, const Str &traitName,
-                            const Map<Str, Vec<Str>> &trait_impls_by_type,
+                            const TraitImplIndex &trait_impls_by_type,
                             const TypeEnvironment &env,
                             Set<Str> &seen) -> bool;
 
+    /// Check if a value of a type may hold a value with a destructor (`Drop`, a native handle or a reference).
+    auto typeMayNeedDrop(const CheckingRef<TypeInfo> &type, const TraitImplIndex &trait_impls_by_type,
+                         const TypeEnvironment &env, Set<Str> &seen) -> bool;
+
     /// Check if a trait is object-safe.
     auto isObjectSafeTrait(const TraitType &trait) -> bool;
 } // namespace NG::typecheck
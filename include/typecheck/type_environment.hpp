@@ -16,7 +16,7 @@ namespace NG::typecheck
     {
     public:
         // ── Variable bindings ────────────────────────────────────────────
-        Map<Str, CheckingRef<TypeInfo>> locals;
+        TypeScope locals;
 
         // ── Move tracking ────────────────────────────────────────────────
         Set<Str> movedBindings;
@@ -33,7 +33,7 @@ namespace NG::typecheck
         static constexpr const char *WILDCARD_IMPORT_KEY = "$$wildcard_import$$";
 
         TypeEnvironment() = default;
-        explicit TypeEnvironment(Map<Str, CheckingRef<TypeInfo>> locals,
+        explicit TypeEnvironment(TypeScope locals,
                                  Set<Str> movedBindings = {},
                                  bool allowMovedLvalueRead = false)
             : locals(std::move(locals)), movedBindings(std::move(movedBindings)),
@@ -51,7 +51,7 @@ namespace NG::typecheck
         /// Add or update a binding.
         void bind(const Str &name, CheckingRef<TypeInfo> type)
         {
-            locals[name] = std::move(type);
+            locals.insert_or_assign(name, std::move(type));
         }
 
         /// Check if a binding exists.
@@ -93,7 +93,7 @@ namespace NG::typecheck
         /// Enable wildcard imports.
         void enableWildcardImport()
         {
-            locals[WILDCARD_IMPORT_KEY] = nullptr;
+            locals.insert_or_assign(WILDCARD_IMPORT_KEY, nullptr);
         }
 
         /// Register an imported symbol name.
@@ -117,6 +117,7 @@ namespace NG::typecheck
         // ── Copy for child checkers ──────────────────────────────────────
 
         /// Create a copy of this environment for a child type checker scope.
+        /// The child's bindings are chained to this environment's, so the copy is O(1) in the symbol count.
         [[nodiscard]] auto childScope(Map<Str, CheckingRef<TypeInfo>> extraLocals = {}) const -> TypeEnvironment
         {
             TypeEnvironment child;
@@ -124,7 +125,7 @@ namespace NG::typecheck
             child.movedBindings = movedBindings;
             for (const auto &[k, v] : extraLocals)
             {
-                child.locals[k] = v;
+                child.locals.insert_or_assign(k, v);
                 child.movedBindings.erase(k);
             }
             child.allowMovedLvalueRead = allowMovedLvalueRead;
@@ -0,0 +1,58 @@
+#pragma once
+
+#include <typecheck/typeinfo.hpp>
+
+#include <mutex>
+#include <unordered_map>
+
+namespace NG::typecheck
+{
+
+    /**
+     * @brief Hash-conses structural type infos so that equal types share one node.
+     *
+     * Untyped, primitive, array, vector, span, range, tuple, reference, union, varargs, const value and
+     * type constructor application nodes are interned; their children are interned first. Function and
+     * nominal types are mutated during checking, so they are never interned and take part in a key by
+     * identity instead. Interned nodes carry a stable `internId` and are kept alive for the lifetime of
+     * the interner. All operations are thread safe.
+     */
+    class TypeInterner : NonCopyable
+    {
+        mutable std::mutex mutex;
+        std::unordered_map<Str, CheckingRef<TypeInfo>> table;
+        uint32_t nextId = 0;
+
+        auto canonicalize(const CheckingRef<TypeInfo> &type) -> CheckingRef<TypeInfo>;
+
+      public:
+        /**
+         * @brief Returns the canonical node structurally equal to `type`.
+         *
+         * Types that cannot be interned (and null) are returned unchanged. The result may be a fresh
+         * node; `type` itself is never modified.
+         */
+        [[nodiscard]] auto intern(const CheckingRef<TypeInfo> &type) -> CheckingRef<TypeInfo>;
+
+        /**
+         * @brief Returns the number of distinct interned types.
+         */
+        [[nodiscard]] auto size() const -> size_t;
+
+        /**
+         * @brief Returns whether `intern` would canonicalize a node with this tag.
+         */
+        [[nodiscard]] static auto internable(const TypeInfo &type) -> bool;
+
+        /**
+         * @brief Returns the process-wide interner used by the type checker.
+         */
+        static auto global() -> TypeInterner &;
+    };
+
+    /**
+     * @brief Interns `type` in the global `TypeInterner`.
+     */
+    [[nodiscard]] auto intern_type(const CheckingRef<TypeInfo> &type) -> CheckingRef<TypeInfo>;
+
+} // namespace NG::typecheck
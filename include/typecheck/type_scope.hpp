@@ -0,0 +1,116 @@
+#pragma once
+
+#include <common.hpp>
+
+#include <iterator>
+#include <memory>
+
+namespace NG::typecheck
+{
+    struct TypeInfo;
+
+    /**
+     * @brief A type-checking scope: name to type bindings chained to the scopes it was derived from.
+     *
+     * Copying a scope is O(1): the copy shares every frame with the original. The first write to a
+     * shared scope pushes a fresh frame on top, so a child scope only stores its own bindings and never
+     * changes what its parent sees. Lookups walk the chain from the innermost frame outwards; long chains
+     * are occasionally squashed so lookups stay cheap.
+     *
+     * The interface mirrors the subset of `Map<Str, CheckingRef<TypeInfo>>` the type checker uses.
+     */
+    class TypeScope
+    {
+      public:
+        using Binding = std::pair<const Str, std::shared_ptr<TypeInfo>>;
+
+      private:
+        struct Frame
+        {
+            Map<Str, std::shared_ptr<TypeInfo>> bindings;
+            std::shared_ptr<const Frame> parent;
+            size_t depth = 1; ///< Number of frames in the chain ending at this frame.
+        };
+
+        std::shared_ptr<Frame> top;
+
+        /**
+         * @brief Makes `top` exclusively owned by this scope, pushing a new frame if it is shared.
+         */
+        auto writableTop() -> Frame &;
+
+      public:
+        /**
+         * @brief Iterates over visible bindings, innermost frame first, skipping shadowed names.
+         */
+        class const_iterator
+        {
+            const Frame *innermost = nullptr;
+            const Frame *frame = nullptr; ///< Null at the end.
+            Map<Str, std::shared_ptr<TypeInfo>>::const_iterator entry;
+
+            friend class TypeScope;
+
+            const_iterator(const Frame *innermost, const Frame *frame,
+                           Map<Str, std::shared_ptr<TypeInfo>>::const_iterator entry)
+                : innermost(innermost), frame(frame), entry(entry) {}
+
+            [[nodiscard]] auto shadowed() const -> bool;
+            void settle();
+
+          public:
+            using iterator_category = std::forward_iterator_tag;
+            using value_type = Binding;
+            using difference_type = std::ptrdiff_t;
+            using pointer = const Binding *;
+            using reference = const Binding &;
+
+            const_iterator() = default;
+
+            auto operator*() const -> reference { return *entry; }
+            auto operator->() const -> pointer { return &*entry; }
+            auto operator++() -> const_iterator &;
+            auto operator++(int) -> const_iterator
+            {
+                auto previous = *this;
+                ++*this;
+                return previous;
+            }
+            auto operator==(const const_iterator &other) const -> bool
+            {
+                return frame == other.frame && (frame == nullptr || entry == other.entry);
+            }
+        };
+
+        TypeScope() = default;
+
+        /**
+         * @brief Creates a single-frame scope holding `bindings`.
+         */
+        TypeScope(Map<Str, std::shared_ptr<TypeInfo>> bindings);
+
+        [[nodiscard]] auto find(const Str &name) const -> const_iterator;
+        [[nodiscard]] auto contains(const Str &name) const -> bool { return find(name) != end(); }
+        [[nodiscard]] auto begin() const -> const_iterator;
+        [[nodiscard]] auto end() const -> const_iterator { return {}; }
+
+        /**
+         * @brief Returns the binding for `name` in this scope, creating it (null, or a copy of the visible
+         * outer binding) if this scope does not own one yet.
+         */
+        auto operator[](const Str &name) -> std::shared_ptr<TypeInfo> &;
+
+        void insert_or_assign(const Str &name, std::shared_ptr<TypeInfo> type);
+
+        /**
+         * @brief Returns the number of frames in the chain.
+         */
+        [[nodiscard]] auto depth() const -> size_t { return top ? top->depth : 0; }
+
+        /**
+         * @brief Copies all visible bindings into a flat map.
+         */
+        [[nodiscard]] auto flatten() const -> Map<Str, std::shared_ptr<TypeInfo>>;
+    };
+
+} // namespace NG::typecheck
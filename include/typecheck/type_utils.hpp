@@ -95,14 +95,15 @@ namespace NG::typecheck
         Str current;
         for (char c : inner)
         {
-            if (c == '<') depth++;
-            else if (c == '>') depth--;
+            if (c == '<' || c == '(' || c == '[') depth++;
+            else if (c == '>' || c == ')' || c == ']') depth--;
             else if (c == ',' && depth == 0)
             {
                 args.push_back(current);
                 current.clear();
                 continue;
             }
+            if (current.empty() && c == ' ') continue; // instance names separate arguments with ", "
             current += c;
         }
         if (!current.empty()) args.push_back(current);
@@ -27,6 +27,57 @@ namespace NG::typecheck
 
     CheckingRef<TypeInfo> type_from_repr(const Str &repr);
 
+    /**
+     * @brief Returns the generic function instances used by the program the latest `type_check` call
+     *        checked, each listed once, including instances reused from earlier calls.
+     */
+    const Vec<std::shared_ptr<GenericFunctionInstance>> &generic_function_instances();
+
+    /**
+     * @brief Lets later `type_check` calls take the module `moduleId` as the latest call left it.
+     *
+     * Checks importing the module then use its published artifacts instead of checking it again, until
+     * `clear_shared_module_checks`. Neither the module nor the modules it imports may change meanwhile.
+     */
+    void share_module_check(const Str &moduleId);
+
+    /**
+     * @brief Forgets the modules passed to `share_module_check`.
+     */
+    void clear_shared_module_checks();
+
+    /**
+     * @brief Type checks a prelude module and the modules it imports.
+     *
+     * When `$NG_PRELUDE_SNAPSHOT` is set, the modules are restored from the snapshot image there as long
+     * as it matches their sources, and the image is rewritten when it does not. The image also carries
+     * the bytecode of the modules compiled so far (see `store_prelude_snapshot_bytecode`).
+     *
+     * @param ast The parsed prelude.
+     * @param source The prelude source.
+     * @param path The prelude source path.
+     * @return A map from names to type information, as `type_check` returns it.
+     */
+    TypeIndex check_prelude(ASTRef<ASTNode> ast, const Str &source, const Str &path, Vec<Str> module_paths = {});
+
+    /**
+     * @brief Returns whether the current prelude snapshot has an entry for `moduleId`.
+     */
+    auto prelude_snapshot_contains(const Str &moduleId) -> bool;
+
+    /**
+     * @brief Returns the `.ngo` bytes the prelude snapshot holds for `moduleId` compiled under
+     *        `buildKey`, or an empty view. The view stays valid until the prelude is checked again.
+     */
+    auto prelude_snapshot_bytecode(const Str &moduleId, const Str &buildKey) -> std::string_view;
+
+    /**
+     * @brief Records the compiled bytecode of a snapshot module and rewrites the snapshot image.
+     *
+     * Does nothing when the snapshot is disabled or has no entry for `moduleId`.
+     */
+    void store_prelude_snapshot_bytecode(const Str &moduleId, const Str &buildKey, std::string_view bytecode);
+
     /**
      * @brief Loads and type-checks the standard library prelude module,
      *        returning a TypeIndex with all its exported symbols.
@@ -35,4 +86,10 @@ namespace NG::typecheck
      * If the prelude cannot be found or parsed, returns an empty TypeIndex.
      */
     TypeIndex build_prelude_type_index();
+
+    /**
+     * @brief Returns a hash of the sources of the prelude and the modules it loads, or an empty string
+     *        if there is no prelude. Builds the prelude type index first.
+     */
+    auto prelude_fingerprint() -> Str;
 } // namespace NG::typecheck
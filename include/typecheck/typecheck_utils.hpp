@@ -70,10 +70,10 @@ namespace NG::typecheck
         Vec<Str> payloadNames;
     };
 
-    auto findTaggedVariant(const Map<Str, CheckingRef<TypeInfo>> &locals, const Str &variantName)
+    auto findTaggedVariant(const TypeScope &locals, const Str &variantName)
         -> std::optional<TaggedVariantLookup>;
 
-    auto widenVariantToUnionType(const Map<Str, CheckingRef<TypeInfo>> &locals, CheckingRef<TypeInfo> type)
+    auto widenVariantToUnionType(const TypeScope &locals, CheckingRef<TypeInfo> type)
         -> CheckingRef<TypeInfo>;
 
     auto formatTypeInstanceName(const Str &baseName, const Vec<CheckingRef<TypeInfo>> &args) -> Str;
@@ -174,9 +174,6 @@ namespace NG::typecheck
 
     // ── Scope utilities ─────────────────────────────────────────────────
 
-    /// Get the set of names in a scope.
-    auto scopeNames(const Map<Str, CheckingRef<TypeInfo>> &scope) -> Set<Str>;
-
-    /// Filter moved bindings to only include those in the allowed set.
-    auto filterMovedBindings(const Set<Str> &moved, const Set<Str> &allowed) -> Set<Str>;
+    /// Filter moved bindings to only include those bound in the allowed scope.
+    auto filterMovedBindings(const Set<Str> &moved, const TypeScope &allowed) -> Set<Str>;
 } // namespace NG::typecheck
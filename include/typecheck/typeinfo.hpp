@@ -3,7 +3,10 @@
 
 #include <ast.hpp>
 #include <common.hpp>
+#include <typecheck/type_scope.hpp>
+#include <cstdint>
 #include <memory>
+#include <mutex>
 #include <utility>
 
 namespace NG::typecheck
@@ -88,6 +91,35 @@ namespace NG::typecheck
         [[nodiscard]] virtual auto canonicalName() const -> Str { return repr(); }
 
         virtual ~TypeInfo() = 0;
+
+        /**
+         * @brief Stable id assigned by `TypeInterner`, or 0 if this node is not interned.
+         *
+         * Two interned nodes are structurally equal exactly when they are the same object.
+         */
+        uint32_t internId = 0;
+
+      protected:
+        /**
+         * @brief Computes the repr once for interned nodes whose repr cannot change, then reuses it.
+         */
+        template <class Compute>
+        [[nodiscard]] auto memoizedRepr(Compute &&compute) const -> Str
+        {
+            if (!reprCacheable)
+            {
+                return compute();
+            }
+            std::call_once(reprOnce, [&] { reprCache = compute(); });
+            return reprCache;
+        }
+
+      private:
+        friend class TypeInterner;
+
+        bool reprCacheable = false;
+        mutable std::once_flag reprOnce;
+        mutable Str reprCache;
     };
 
     /**
@@ -487,9 +519,35 @@ namespace NG::typecheck
      * Stores the AST node and type parameter names so that a specialized copy
      * can be produced when concrete type arguments are known.
      */
+    /**
+     * @brief A checked instantiation of a generic function.
+     *
+     * The type checker records every instance a program uses; the compiler compiles exactly those.
+     */
+    struct GenericFunctionInstance
+    {
+        Str genericName;                             ///< Name of the generic function.
+        Str instanceName;                            ///< Instantiated name, e.g. `id<i32>`.
+        Str mangledName;                             ///< Symbol the instance is compiled under.
+        NG::ast::FunctionDef *definition = nullptr;  ///< Overload selected for the instance.
+        CheckingRef<TypeInfo> returnType;            ///< Instantiated return type.
+        Vec<std::shared_ptr<GenericFunctionInstance>> uses; ///< Instances instantiated by this instance's body.
+    };
+
+    /**
+     * @brief A cached mapping from the argument types of a call to the instance it produced.
+     */
+    struct GenericInstantiation
+    {
+        Vec<CheckingRef<TypeInfo>> keyTypes;          ///< Types the key was built from; keeps keyed addresses in use.
+        Map<Str, CheckingRef<TypeInfo>> substitution; ///< Type parameter bindings, for re-checking bounds.
+        Vec<CheckingRef<TypeInfo>> typeArguments;     ///< Interned type arguments in parameter order.
+        std::shared_ptr<GenericFunctionInstance> instance;
+    };
+
     struct GenericDefType : TypeInfo
     {
-        using TypeEnv = Map<Str, CheckingRef<TypeInfo>>;
+        using TypeEnv = TypeScope;
 
         Str name;                                   ///< The name of the generic definition
         Str moduleId;                               ///< Canonical module that owns this generic definition.
@@ -500,8 +558,17 @@ namespace NG::typecheck
         Vec<bool> typeParamKindVariadicTails;        ///< Which type params are variadic constructor kinds.
         NG::ast::ASTRef<NG::ast::FunctionDef> funcDef; ///< The original AST node (for generic functions)
         Vec<NG::ast::ASTRef<NG::ast::FunctionDef>> overloads; ///< Same-name generic overload candidates.
+        struct OverloadBuckets
+        {
+            Map<size_t, Map<Str, Vec<size_t>>> byArity; ///< Arity -> first parameter type constructor ("" for any) -> overloads.
+            Vec<size_t> variadic;                        ///< Overloads ending in a parameter pack.
+            size_t indexed = 0;                          ///< Number of `overloads` already bucketed.
+        };
+        OverloadBuckets overloadBuckets;
+        Map<Str, std::pair<NG::ast::FunctionDef *, Vec<CheckingRef<TypeInfo>>>> selectedOverloads; ///< Selections (and the types they were keyed by).
         TypeEnv capturedLocals;                     ///< Local type environment at definition site
-        Map<Str, CheckingRef<TypeInfo>> instances; ///< Monomorphized return types keyed by instantiated name.
+        Map<Str, std::shared_ptr<GenericFunctionInstance>> instances; ///< Instances keyed by instantiated name.
+        Map<Str, GenericInstantiation> instantiations; ///< Checked instances keyed by call argument types.
 
         GenericDefType(Str name, Vec<Str> typeParamNames, Vec<bool> typeParamIsPack,
                        NG::ast::ASTRef<NG::ast::FunctionDef> funcDef, TypeEnv capturedLocals, Str moduleId = "")
@@ -527,7 +594,7 @@ namespace NG::typecheck
 
     struct GenericTypeDef : TypeInfo
     {
-        using TypeEnv = Map<Str, CheckingRef<TypeInfo>>;
+        using TypeEnv = TypeScope;
 
         Str name;
         Str moduleId;
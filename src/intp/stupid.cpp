@@ -5,6 +5,7 @@
 #include <intp/runtime.hpp>
 #include <intp/runtime_numerals.hpp>
 #include <module.hpp>
+#include <runtime/array_kernels.hpp>
 #include <runtime/native_marshaling.hpp>
 #include <runtime/value_access.hpp>
 #include <runtime/array_layout_access.hpp>
@@ -134,6 +135,7 @@ namespace NG::intp
   static constexpr const char *COPY_TRAIT_NAME = "Copy";
   static constexpr const char *CLONE_TRAIT_NAME = "Clone";
   static constexpr const char *DROP_TRAIT_NAME = "Drop";
+  static constexpr const char *HASH_TRAIT_NAME = "Hash";
 
   static void install_builtin_lifecycle_traits(const NGSymbols &symbols,
                                                Map<Str, RuntimeTraitInfo> &runtimeTraits)
@@ -143,10 +145,12 @@ namespace NG::intp
       symbols->traitNames.insert(COPY_TRAIT_NAME);
       symbols->traitNames.insert(CLONE_TRAIT_NAME);
       symbols->traitNames.insert(DROP_TRAIT_NAME);
+      symbols->traitNames.insert(HASH_TRAIT_NAME);
     }
     runtimeTraits.try_emplace(COPY_TRAIT_NAME);
     runtimeTraits.try_emplace(CLONE_TRAIT_NAME);
     runtimeTraits.try_emplace(DROP_TRAIT_NAME);
+    runtimeTraits.try_emplace(HASH_TRAIT_NAME);
   }
 
   static auto resolve_trait_closure(const Str &traitName, const Map<Str, TraitDef *> &traitDefs,
@@ -1290,8 +1294,55 @@ namespace NG::intp
       set_result(make_runtime_tuple_cell(slots));
     }
 
+    /**
+     * Runs `sortBy(xs, key)` and `sortWith(xs, less)` from std.array whose second argument names a
+     * function, which the natives cannot reach since NG has no function values. Returns null for any
+     * other call.
+     */
+    [[nodiscard]] auto sort_call_slot(FunCallExpression *funCallExpr) -> RuntimeRef<StorageCell>
+    {
+      auto callee = dynamic_ast_cast<IdExpression>(funCallExpr->primaryExpression);
+      auto function =
+          funCallExpr->arguments.size() == 2 ? dynamic_ast_cast<IdExpression>(funCallExpr->arguments[1]) : nullptr;
+      if (!symbols || !callee || !function || (callee->id != "sortBy" && callee->id != "sortWith"))
+      {
+        return nullptr;
+      }
+      if (auto origin = symbols->importOrigins.find(callee->id);
+          origin == symbols->importOrigins.end() || origin->second != "std.array" ||
+          !symbols->functions.contains(function->id))
+      {
+        return nullptr;
+      }
+      auto arrayVisitor = child_expression_visitor();
+      funCallExpr->arguments[0]->accept(&arrayVisitor);
+      auto array = arrayVisitor.result_slot("sort.array");
+      if (!runtime_is_array_value(array))
+      {
+        throw RuntimeException(callee->id + "() requires an array", funCallExpr->pos);
+      }
+      if (callee->id == "sortBy")
+      {
+        Vec<RuntimeRef<StorageCell>> keys;
+        for (const auto &item : runtime_array_slots(array))
+        {
+          keys.push_back(call_function_by_name(function->id, {clone_argument_slot("sort.item", item)}, funCallExpr->pos));
+        }
+        return kernels::array_sort_by_keys(array, keys);
+      }
+      return kernels::array_sort_with(array, [&](const RuntimeRef<StorageCell> &left, const RuntimeRef<StorageCell> &right) {
+        NGArgs args{clone_argument_slot("sort.left", left), clone_argument_slot("sort.right", right)};
+        return runtime_value_bool(call_function_by_name(function->id, args, funCallExpr->pos));
+      });
+    }
+
     void visit(FunCallExpression *funCallExpr) override
     {
+      if (auto sorted = sort_call_slot(funCallExpr))
+      {
+        set_result(sorted);
+        return;
+      }
       auto foldIt = std::find_if(funCallExpr->arguments.begin(), funCallExpr->arguments.end(), [](const auto &arg) {
         return dynamic_ast_cast<PostfixFoldExpression>(arg) != nullptr;
       });
@@ -1819,7 +1870,8 @@ namespace NG::intp
 
         if (activeFrames)
         {
-          CallFrame objectFrame{};
+          // Initializers see the enclosing bindings as well as the fields before them.
+          auto objectFrame = activeFrames->empty() ? CallFrame{} : activeFrames->back();
           objectFrame.functionName = "<object-init>";
           activeFrames->push_back(objectFrame);
         }
@@ -1834,7 +1886,7 @@ namespace NG::intp
             }
           }
         } objectFrameGuard{activeFrames};
-        auto objectScopes = make_scope_chain();
+        auto objectScopes = fork_scope_chain(activeScopes);
         ExpressionVisitor visitor{symbols, activeFrames, objectScopes, false};
 
       for (auto &&[name, expr] : newObj->properties)
@@ -3003,11 +3055,6 @@ namespace NG::intp
         CallFrame callFrame{};
         callFrame.functionName = activeGenericInstance.empty() ? funDef->funName : activeGenericInstance;
         callFrame.receiver = dummy;
-        if (callFrame.receiver)
-        {
-          callFrame.receiver->name = "self";
-          callFrame.receiver->ownerScopeId = current_scope_id(scopeIds);
-        }
         auto returnTypeName = funDef->returnType ? funDef->returnType->repr() : "unit";
         auto returnRuntimeType = resolveRuntimeType(callSymbols, returnTypeName);
         callFrame.returnSlot =
@@ -3164,11 +3211,6 @@ namespace NG::intp
           CallFrame callFrame{};
           callFrame.functionName = memFn->funName;
           callFrame.receiver = dummy;
-          if (callFrame.receiver)
-          {
-            callFrame.receiver->name = "self";
-            callFrame.receiver->ownerScopeId = current_scope_id(scopeIds);
-          }
           auto returnTypeName = memFn->returnType ? memFn->returnType->repr() : "unit";
           auto returnRuntimeType = resolveRuntimeType(callSymbols, returnTypeName);
           callFrame.returnSlot =
@@ -3261,6 +3303,21 @@ namespace NG::intp
         }
       }
 
+      const bool derivesHash = std::ranges::any_of(typeDef->derivedTraits, [](const auto &trait) {
+        return trait && trait->repr() == HASH_TRAIT_NAME;
+      });
+      if (derivesHash)
+      {
+        NGCallable hashMember = [](const NGSelf &self, const NGEnv &, const NGArgs &) -> RuntimeRef<StorageCell> {
+          return numeral_cell_from_value<uint64_t>(value_hash(self));
+        };
+        type->memberFunctions[HASH_TRAIT_NAME + Str{"::hash"}] = hashMember;
+        if (!type->memberFunctions.contains("hash"))
+        {
+          type->memberFunctions["hash"] = std::move(hashMember);
+        }
+      }
+
       define_global_type(symbols, type->name, type);
     }
 
@@ -3307,11 +3364,6 @@ namespace NG::intp
         CallFrame callFrame{};
         callFrame.functionName = method->funName;
         callFrame.receiver = dummy;
-        if (callFrame.receiver)
-        {
-          callFrame.receiver->name = "self";
-          callFrame.receiver->ownerScopeId = current_scope_id(scopeIds);
-        }
         auto returnTypeName = method->returnType ? method->returnType->repr() : "unit";
         auto returnRuntimeType = resolveRuntimeType(callSymbols, returnTypeName);
         callFrame.returnSlot =
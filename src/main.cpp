@@ -3,9 +3,12 @@
 #include "ast.hpp"
 #include "intp/intp.hpp"
 #include "module.hpp"
+#include "orgasm/build_driver.hpp"
 #include "orgasm/compiler.hpp"
+#include "orgasm/session.hpp"
 #include "orgasm/vm.hpp"
 #include "parser.hpp"
+#include "sysdep/mapped_file.hpp"
 #include "token.hpp"
 #include "typecheck/typecheck.hpp"
 #include <algorithm>
@@ -15,6 +18,7 @@
 #include <filesystem>
 #include <fstream>
 #include <functional>
+#include <iomanip>
 #include <iostream>
 #include <memory>
 #include <streambuf>
@@ -33,9 +37,10 @@ using namespace NG::parsing;
 #include <unistd.h>
 #endif
 
-static inline auto parse(const Str &source, const Str &file = "[noname]") -> ASTRef<ASTNode>
+static inline auto parse(std::string_view source, const Str &file = "[noname]") -> ASTRef<ASTNode>
 {
-  return Parser(ParseState(Lexer(LexState{source}).lex())).parse(file);
+  // Tokens are lexed on demand, so the whole token vector never coexists with the AST.
+  return Parser(ParseState(std::make_shared<Lexer>(LexState::borrowing(source)))).parse(file);
 }
 
 // NOLINTNEXTLINE(bugprone-exception-escape)
@@ -45,7 +50,7 @@ auto showHint() -> bool
   return isatty(STDIN_FILENO);
 }
 
-auto repl() -> int
+auto repl(bool use_stupid) -> int
 {
 
   if (showHint())
@@ -57,7 +62,19 @@ auto repl() -> int
   std::string source{line};
   LexState state{source};
   Lexer lexer{LexState{line}};
-  NG::intp::Interpreter *stupid = NG::intp::stupid();
+  NG::intp::Interpreter *stupid = use_stupid ? NG::intp::stupid() : nullptr;
+  std::unique_ptr<NG::orgasm::ReplSession> session;
+  if (!use_stupid)
+  {
+    NG::library::prelude::do_register();
+    NG::library::imgui::do_register();
+    auto nativeNames = NG::library::prelude::native_function_names();
+    auto imguiNativeNames = NG::library::imgui::native_function_names();
+    nativeNames.insert(nativeNames.end(), imguiNativeNames.begin(), imguiNativeNames.end());
+    session = std::make_unique<NG::orgasm::ReplSession>(Vec<Str>{".", "lib", "../lib"}, nativeNames);
+    NG::library::prelude::register_vm_natives(session->vm());
+    NG::library::imgui::register_vm_natives(session->vm());
+  }
 
   Token current;
   Vec<Token> tokens;
@@ -126,6 +143,12 @@ auto repl() -> int
       ParseState parse_state{tokens};
       auto ast = Parser(parse_state).parse("[interpreter]");
       tokens.clear();
+      if (session)
+      {
+        // The session keeps the AST alive; compiled definitions point into it.
+        session->evaluate(ast);
+        continue;
+      }
       (ast)->accept(stupid);
       histories.push_back(ast);
     }
@@ -133,6 +156,10 @@ auto repl() -> int
     {
       debug_log("Syntax error:", ex.what());
     }
+    catch (const TypeCheckingException &ex)
+    {
+      debug_log("Type check error:", ex.what());
+    }
     catch (const NG::RuntimeException &ex)
     {
       debug_log("Runtime error", ex.what());
@@ -144,11 +171,68 @@ auto repl() -> int
     destroyast(ast);
   }
 }
+auto native_function_names() -> Vec<Str>
+{
+  auto nativeNames = NG::library::prelude::native_function_names();
+  auto imguiNativeNames = NG::library::imgui::native_function_names();
+  nativeNames.insert(nativeNames.end(), imguiNativeNames.begin(), imguiNativeNames.end());
+  return nativeNames;
+}
+
+auto build_program(const Str &filename, const Vec<Str> &modulePaths, const Str &outputDir) -> int
+{
+  try
+  {
+    NG::System::MappedFile source{filename};
+    auto ast = parse(source.view(), filename);
+
+    NG::library::prelude::do_register();
+    NG::library::imgui::do_register();
+    NG::typecheck::build_prelude_type_index();
+
+    auto report =
+        NG::orgasm::build_program(ast, source.view(), filename, modulePaths, native_function_names(), outputDir);
+    destroyast(ast);
+
+    size_t cached = 0;
+    std::cout << std::fixed << std::setprecision(2);
+    for (const auto &module : report.modules)
+    {
+      cached += module.cached ? 1 : 0;
+      std::cout << "  " << module.moduleId << (module.cached ? " (cached)" : "") << ": lookup " << module.cacheMs
+                << " ms, compile " << module.compileMs << " ms, write " << module.writeMs << " ms" << std::endl;
+    }
+    std::cout << "Built " << report.modules.size() << " modules (" << cached << " cached) into " << outputDir
+              << " in " << report.totalMs << " ms (loading " << report.loadMs << " ms) on " << report.workers
+              << " workers" << std::endl;
+    return 0;
+  }
+  catch (ParseException &ex)
+  {
+    std::cout << "Parse error: " << ex.what() << " at " << ex.pos.line << ":" << ex.pos.col << std::endl;
+  }
+  catch (TypeCheckingException &ex)
+  {
+    std::cout << "Type check error: " << ex.what() << " at " << ex.pos.line << ":" << ex.pos.col << std::endl;
+  }
+  catch (NG::RuntimeException &ex)
+  {
+    std::cout << "Runtime error: " << ex.what() << " at " << ex.pos.line << ":" << ex.pos.col << std::endl;
+  }
+  catch (const std::exception &ex)
+  {
+    std::cout << "Error: " << ex.what() << std::endl;
+  }
+  return -1;
+}
+
 auto main(int argc, char *argv[]) -> int
 {
   bool use_stupid = false;
   bool run_bytecode = false;
+  bool build = false;
   Str emit_ngo_path;
+  Str build_output_dir = "build/ngo";
   const char *filename_ptr = nullptr;
 
   for (int i = 1; i < argc; ++i)
@@ -170,6 +254,19 @@ auto main(int argc, char *argv[]) -> int
       }
       emit_ngo_path = argv[++i];
     }
+    else if (std::strcmp(argv[i], "--build") == 0)
+    {
+      build = true;
+    }
+    else if (std::strcmp(argv[i], "--out") == 0)
+    {
+      if (i + 1 >= argc)
+      {
+        std::cout << "--out expects an output directory" << std::endl;
+        return -1;
+      }
+      build_output_dir = argv[++i];
+    }
     else if (filename_ptr == nullptr)
     {
       filename_ptr = argv[i];
@@ -178,7 +275,7 @@ auto main(int argc, char *argv[]) -> int
 
   if (filename_ptr == nullptr)
   {
-    return repl();
+    return repl(use_stupid);
   }
 
   if (!std::filesystem::exists(filename_ptr))
@@ -225,16 +322,29 @@ auto main(int argc, char *argv[]) -> int
     }
   }
 
-  std::ifstream file{filename};
-  std::string source{std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>()};
+  if (build)
+  {
+    return build_program(filename, modulePaths, build_output_dir);
+  }
 
   try
   {
-    auto ast = parse(source, filename);
+    ASTRef<ASTNode> ast;
+    Str sourceHash;
+    {
+      NG::System::MappedFile source{filename};
+      ast = parse(source.view(), filename);
+      if (!emit_ngo_path.empty())
+      {
+        sourceHash = NG::orgasm::bytecode_source_hash(source.view());
+      }
+    }
 
     NG::library::prelude::do_register();
     NG::library::imgui::do_register();
 
+    NG::module::prefetch_module_imports(ast, modulePaths);
+
     using namespace NG::typecheck;
     TypeIndex prelude_types = build_prelude_type_index();
 
@@ -247,15 +357,11 @@ auto main(int argc, char *argv[]) -> int
     }
     else
     {
-      auto nativeNames = NG::library::prelude::native_function_names();
-      auto imguiNativeNames = NG::library::imgui::native_function_names();
-      nativeNames.insert(nativeNames.end(), imguiNativeNames.begin(), imguiNativeNames.end());
-
-      NG::orgasm::Compiler compiler{modulePaths, nativeNames};
+      NG::orgasm::Compiler compiler{modulePaths, native_function_names()};
       auto bytecode = compiler.compile(dynamic_ast_cast<CompileUnit>(ast));
       if (!emit_ngo_path.empty())
       {
-        NG::orgasm::write_bytecode_module(bytecode, emit_ngo_path, NG::orgasm::bytecode_source_hash(source));
+        NG::orgasm::write_bytecode_module(bytecode, emit_ngo_path, sourceHash);
         destroyast(ast);
         return 0;
       }
@@ -9,10 +9,13 @@
 #include <filesystem>
 #include <fstream>
 #include <iostream>
+#include <mutex>
 #include <numeric>
 #include <utility>
 
+#include <sysdep/mapped_file.hpp>
 #include <sysdep/process.hpp>
+#include <sysdep/thread_pool.hpp>
 
 namespace NG::module
 {
@@ -92,16 +95,6 @@ namespace NG::module
     }
   }
 
-  static auto read_text_file(const fs::path &path) -> Str
-  {
-    std::ifstream file{path};
-    if (!file)
-    {
-      throw RuntimeException("Failed to open module file: " + path.string());
-    }
-    return Str{std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>()};
-  }
-
   static auto bytecode_artifact_is_stale(const fs::path &base, const fs::path &modulePath,
                                          const NG::orgasm::BytecodeModule &bytecode) -> bool
   {
@@ -122,7 +115,8 @@ namespace NG::module
       {
         continue;
       }
-      return NG::orgasm::bytecode_source_hash(read_text_file(candidate)) != bytecode.sourceHash;
+      NG::System::MappedFile source{candidate.string()};
+      return NG::orgasm::bytecode_source_hash(source.view()) != bytecode.sourceHash;
     }
     return false;
   }
@@ -235,19 +229,23 @@ namespace NG::module
   ModuleLoader::~ModuleLoader() noexcept = default;
 
   static Map<Str, NG::runtime::RuntimeRef<ModuleInfo>> global_module_info_cache{};
+  static std::mutex global_module_info_cache_mutex; ///< Prefetch workers share the cache.
 
   static auto isCached(Str modulePath) -> bool
   {
+    std::lock_guard lock{global_module_info_cache_mutex};
     return global_module_info_cache.contains(modulePath);
   }
 
   static auto getCached(Str modulePath) -> RuntimeRef<ModuleInfo>
   {
+    std::lock_guard lock{global_module_info_cache_mutex};
     return global_module_info_cache[modulePath];
   }
 
   static void putCached(Str modulePath, RuntimeRef<ModuleInfo> moduleInfo)
   {
+    std::lock_guard lock{global_module_info_cache_mutex};
     global_module_info_cache[modulePath] = moduleInfo;
   }
 
@@ -263,10 +261,20 @@ namespace NG::module
 
   void clear_module_loader_cache() noexcept
   {
+    std::lock_guard lock{global_module_info_cache_mutex};
     global_module_info_cache.clear();
   }
 
-  auto FileBasedExternalModuleLoader::load(const Vec<Str> &module) -> RuntimeRef<ModuleInfo>
+  namespace
+  {
+    struct LoadedModule
+    {
+      RuntimeRef<ModuleInfo> moduleInfo;
+      bool parsed = false; ///< True when this call parsed the module source rather than hitting the cache.
+    };
+  } // namespace
+
+  static auto load_module_from_roots(const Vec<Str> &basePaths, const Vec<Str> &module) -> LoadedModule
   {
     const Str requestedModuleId = canonical_module_id(module);
     fs::path modulePath = std::accumulate(module.begin(), module.end(), fs::path{},
@@ -281,12 +289,12 @@ namespace NG::module
     relativeProbes.push_back({sourceProbe, ModuleFormat::SourceNg});
     relativeProbes.push_back({modulePath / "module.ng", ModuleFormat::SourceNg});
 
-    for (const auto &base : module_search_roots(this->basePaths))
+    for (const auto &base : module_search_roots(basePaths))
     {
       auto moduleKey = module_cache_key(base, requestedModuleId);
       if (isCached(moduleKey))
       {
-        return getCached(moduleKey);
+        return {getCached(moduleKey)};
       }
       for (const auto &[relative, format] : relativeProbes)
       {
@@ -303,7 +311,7 @@ namespace NG::module
           auto cached = getCached(absoluteKey);
           if (cached && cached->moduleId == requestedModuleId)
           {
-            return cached;
+            return {cached};
           }
         }
         if (format == ModuleFormat::BytecodeNgo)
@@ -383,10 +391,11 @@ namespace NG::module
           });
           putCached(moduleKey, moduleInfo);
           putCached(absoluteKey, moduleInfo);
-          return moduleInfo;
+          return {moduleInfo};
         }
-        std::string source = read_text_file(candidate);
-        auto result = Parser(ParseState(Lexer(LexState{source}).lex())).parse(candidate);
+        NG::System::MappedFile source{candidate.string()};
+        auto result =
+            Parser(ParseState(std::make_shared<Lexer>(LexState::borrowing(source.view())))).parse(candidate);
         if (!result)
         {
           throw RuntimeException("Failed to parse module '" + requestedModuleId + "' from: " + absolute);
@@ -410,7 +419,7 @@ namespace NG::module
           auto moduleInfo = runtime::makert<ModuleInfo>(ModuleInfo{
             .moduleId = requestedModuleId,
             .moduleName = module.empty() ? Str{} : module.back(),
-            .moduleSource = source,
+            .moduleSourceHash = NG::orgasm::bytecode_source_hash(source.view()),
             .moduleAst = result,
             .moduleAbsolutePath = absolute,
             .moduleLoadingLocation = base,
@@ -423,12 +432,103 @@ namespace NG::module
           });
           putCached(moduleKey, moduleInfo);
           putCached(absoluteKey, moduleInfo);
-          return moduleInfo;
+          return {moduleInfo, true};
         }
       }
     }
     throw RuntimeException("Module not found: " + requestedModuleId);
   }
 
+  static auto module_import_paths(const ASTRef<ASTNode> &ast) -> Vec<Vec<Str>>
+  {
+    Vec<Vec<Str>> paths;
+    auto compileUnit = dynamic_ast_cast<NG::ast::CompileUnit>(ast);
+    if (!compileUnit || !compileUnit->module)
+    {
+      return paths;
+    }
+    for (const auto &importDecl : compileUnit->module->imports)
+    {
+      if (importDecl && !importDecl->modulePath.empty())
+      {
+        paths.push_back(importDecl->modulePath);
+      }
+    }
+    return paths;
+  }
+
+  void prefetch_module_imports(const ASTRef<ASTNode> &ast, const Vec<Str> &basePaths)
+  {
+    auto roots = module_import_paths(ast);
+    if (roots.empty())
+    {
+      return;
+    }
+
+    std::mutex mutex;
+    Set<Str> seen;
+    Vec<RuntimeRef<ModuleInfo>> fetched;
+    NG::System::ThreadPool pool;
+
+    std::function<void(const Vec<Str> &)> fetch = [&](const Vec<Str> &module) {
+      {
+        std::lock_guard lock{mutex};
+        if (!seen.insert(canonical_module_id(module)).second)
+        {
+          return;
+        }
+      }
+      pool.submit([&, module] {
+        LoadedModule loaded;
+        try
+        {
+          loaded = load_module_from_roots(basePaths, module);
+        }
+        catch (const std::exception &)
+        {
+          // Left uncached: the demand load reports the failure at the importing site.
+          return;
+        }
+        if (!loaded.parsed)
+        {
+          return;
+        }
+        {
+          std::lock_guard lock{mutex};
+          fetched.push_back(loaded.moduleInfo);
+        }
+        for (const auto &dependency : module_import_paths(loaded.moduleInfo->moduleAst))
+        {
+          fetch(dependency);
+        }
+      });
+    };
+    for (const auto &module : roots)
+    {
+      fetch(module);
+    }
+    pool.wait();
+
+    // Registration stays on the calling thread; the registry itself is not synchronized.
+    auto &registry = get_module_registry();
+    for (const auto &moduleInfo : fetched)
+    {
+      if (!registry.queryModuleById(moduleInfo->moduleId))
+      {
+        registry.addModuleInfo(moduleInfo);
+      }
+    }
+  }
+
+  auto FileBasedExternalModuleLoader::load(const Vec<Str> &module) -> RuntimeRef<ModuleInfo>
+  {
+    auto loaded = load_module_from_roots(this->basePaths, module);
+    if (loaded.parsed)
+    {
+      prefetch_module_imports(loaded.moduleInfo->moduleAst, this->basePaths);
+    }
+    return loaded.moduleInfo;
+  }
+
   FileBasedExternalModuleLoader::~FileBasedExternalModuleLoader() = default;
 } // namespace NG::module
@@ -115,6 +115,7 @@ namespace NG::module
 
   void ModuleRegistry::addModuleInfo(RuntimeRef<ModuleInfo> moduleInfo)
   {
+    std::lock_guard lock{mutex};
     this->modules.insert_or_assign(moduleInfo->moduleId, moduleInfo);
     if (moduleInfo->artifact)
     {
@@ -124,6 +125,7 @@ namespace NG::module
 
   void ModuleRegistry::addModuleArtifact(RuntimeRef<ModuleArtifact> artifact)
   {
+    std::lock_guard lock{mutex};
     if (!artifact)
     {
       return;
@@ -133,6 +135,7 @@ namespace NG::module
 
   void ModuleRegistry::registerNativeModuleDescriptor(RuntimeRef<NativeModuleDescriptor> descriptor)
   {
+    std::lock_guard lock{mutex};
     if (!descriptor)
     {
       return;
@@ -192,6 +195,7 @@ namespace NG::module
 
   auto ModuleRegistry::queryModuleById(Str moduleId) const -> RuntimeRef<ModuleInfo>
   {
+    std::lock_guard lock{mutex};
     if (modules.contains(moduleId))
       return this->modules.at(moduleId);
     return {};
@@ -199,6 +203,7 @@ namespace NG::module
 
   auto ModuleRegistry::queryArtifactById(Str moduleId) const -> RuntimeRef<ModuleArtifact>
   {
+    std::lock_guard lock{mutex};
     if (artifacts.contains(moduleId))
       return this->artifacts.at(moduleId);
     return {};
@@ -206,6 +211,7 @@ namespace NG::module
 
   auto ModuleRegistry::queryNativeModuleDescriptor(Str moduleId) const -> RuntimeRef<NativeModuleDescriptor>
   {
+    std::lock_guard lock{mutex};
     if (nativeDescriptors.contains(moduleId))
       return this->nativeDescriptors.at(moduleId);
     return {};
@@ -213,6 +219,7 @@ namespace NG::module
 
   void ModuleRegistry::clear()
   {
+    std::lock_guard lock{mutex};
     modules.clear();
     artifacts.clear();
     nativeDescriptors.clear();
@@ -1,8 +1,13 @@
 #include <orgasm/compiler.hpp>
+#include <orgasm/build_cache.hpp>
+#include <orgasm/last_use.hpp>
+#include <runtime/array_kernels.hpp>
 #include <algorithm>
 #include <bit>
 #include <array>
 #include <limits>
+#include <optional>
+#include <utility>
 #include <module.hpp>
 #include <cstring>
 #include <token.hpp>
@@ -20,6 +25,7 @@ namespace NG::orgasm
         constexpr const char *COPY_TRAIT_NAME = "Copy";
         constexpr const char *CLONE_TRAIT_NAME = "Clone";
         constexpr const char *DROP_TRAIT_NAME = "Drop";
+        constexpr const char *HASH_TRAIT_NAME = "Hash";
 
         auto bare_type_name(Str typeName) -> Str
         {
@@ -35,6 +41,7 @@ namespace NG::orgasm
             runtimeTraits.try_emplace(COPY_TRAIT_NAME);
             runtimeTraits.try_emplace(CLONE_TRAIT_NAME);
             runtimeTraits.try_emplace(DROP_TRAIT_NAME);
+            runtimeTraits.try_emplace(HASH_TRAIT_NAME);
         }
 
         auto is_self_type_annotation(const TypeAnnotation *annotation) -> bool
@@ -60,6 +67,164 @@ namespace NG::orgasm
                    param->annotatedType->name.ends_with("...");
         }
 
+        auto is_parameter(const Expression *expr, const Str &name) -> bool
+        {
+            auto id = dynamic_cast<const IdExpression *>(expr);
+            return id && id->id == name;
+        }
+
+        /**
+         * Returns the expression `stmt` returns when it is `return e;` or `{ return e; }`.
+         */
+        auto returned_expression(const Statement *stmt) -> const Expression *
+        {
+            if (auto block = dynamic_cast<const CompoundStatement *>(stmt))
+            {
+                return block->statements.size() == 1 ? returned_expression(block->statements.front().get()) : nullptr;
+            }
+            auto returnStmt = dynamic_cast<const ReturnStatement *>(stmt);
+            return returnStmt ? returnStmt->expression.get() : nullptr;
+        }
+
+        /**
+         * Recognizes fold functions that reduce their two parameters with `+`, or pick the smaller or
+         * larger one with `if (a < b) { return a; } return b;` and its variants, so a fold over a
+         * packed array can run as an array kernel instead of one call per element.
+         */
+        auto recognize_fold_kernel(const FunctionDef *funDef) -> std::optional<runtime::kernels::FoldKernel>
+        {
+            using runtime::kernels::FoldKernel;
+            if (!funDef || funDef->native || !funDef->body || funDef->params.size() != 2)
+            {
+                return std::nullopt;
+            }
+            const auto &left = funDef->params[0]->paramName;
+            const auto &right = funDef->params[1]->paramName;
+            if (left == right)
+            {
+                return std::nullopt;
+            }
+            // Both operands and the result must share one type, or the fold converts as it goes.
+            Vec<const TypeAnnotation *> annotations{funDef->params[0]->annotatedType.get(),
+                                                    funDef->params[1]->annotatedType.get(), funDef->returnType.get()};
+            for (const auto *annotation : annotations)
+            {
+                if (annotation && (!annotations[0] || annotation->name != annotations[0]->name ||
+                                   !annotation->genericArgs.empty()))
+                {
+                    return std::nullopt;
+                }
+            }
+
+            if (auto sum = dynamic_cast<const BinaryExpression *>(returned_expression(funDef->body.get())))
+            {
+                bool operands = (is_parameter(sum->left.get(), left) && is_parameter(sum->right.get(), right)) ||
+                                (is_parameter(sum->left.get(), right) && is_parameter(sum->right.get(), left));
+                if (sum->optr && sum->optr->type == TokenType::PLUS && operands)
+                {
+                    return FoldKernel::Sum;
+                }
+                return std::nullopt;
+            }
+
+            // `if (l CMP r) { return c; } [else] return o;` with {c, o} = {l, r}.
+            const IfStatement *choice = nullptr;
+            const Statement *otherwise = nullptr;
+            if (auto block = dynamic_cast<const CompoundStatement *>(funDef->body.get()))
+            {
+                if (block->statements.size() == 1)
+                {
+                    choice = dynamic_cast<const IfStatement *>(block->statements[0].get());
+                    otherwise = choice ? choice->alternative.get() : nullptr;
+                }
+                else if (block->statements.size() == 2)
+                {
+                    choice = dynamic_cast<const IfStatement *>(block->statements[0].get());
+                    otherwise = choice && !choice->alternative ? block->statements[1].get() : nullptr;
+                }
+            }
+            auto test = choice ? dynamic_cast<const BinaryExpression *>(choice->testing.get()) : nullptr;
+            if (!test || !test->optr || choice->isConst || !otherwise)
+            {
+                return std::nullopt;
+            }
+            auto chosen = returned_expression(choice->consequence.get());
+            auto other = returned_expression(otherwise);
+            const Str *testLeft = nullptr;
+            const Str *testRight = nullptr;
+            for (const auto *name : {&left, &right})
+            {
+                if (is_parameter(test->left.get(), *name)) testLeft = name;
+                if (is_parameter(test->right.get(), *name)) testRight = name;
+            }
+            if (!testLeft || !testRight || testLeft == testRight || !chosen || !other)
+            {
+                return std::nullopt;
+            }
+            bool picksLeft = is_parameter(chosen, *testLeft) && is_parameter(other, *testRight);
+            bool picksRight = is_parameter(chosen, *testRight) && is_parameter(other, *testLeft);
+            if (!picksLeft && !picksRight)
+            {
+                return std::nullopt;
+            }
+            switch (test->optr->type)
+            {
+            case TokenType::LT:
+            case TokenType::LE:
+                return picksLeft ? FoldKernel::Min : FoldKernel::Max;
+            case TokenType::GT:
+            case TokenType::GE:
+                return picksLeft ? FoldKernel::Max : FoldKernel::Min;
+            default:
+                return std::nullopt;
+            }
+        }
+
+        /**
+         * Recognizes `sortWith` comparators that return `a < b` or `a > b` of two integer or string
+         * parameters, so the sort can compare elements natively instead of calling them. Floats are left
+         * out because `<` quietly answers false for NaN, where native sorting throws, and other types
+         * because `<` on them may be user-defined.
+         */
+        auto recognize_sort_comparator(const FunctionDef *funDef) -> runtime::kernels::SortKernel
+        {
+            using runtime::kernels::SortKernel;
+            if (!funDef || funDef->native || !funDef->body || funDef->params.size() != 2)
+            {
+                return SortKernel::Compare;
+            }
+            const auto &left = funDef->params[0]->paramName;
+            const auto &right = funDef->params[1]->paramName;
+            const auto *leftType = funDef->params[0]->annotatedType.get();
+            const auto *rightType = funDef->params[1]->annotatedType.get();
+            static const Set<Str> nativelyOrdered{"i8", "u8", "i16", "u16", "i32", "u32", "i64", "u64", "string"};
+            if (left == right || !leftType || !rightType || leftType->repr() != rightType->repr() ||
+                !nativelyOrdered.contains(leftType->name))
+            {
+                return SortKernel::Compare;
+            }
+            auto test = dynamic_cast<const BinaryExpression *>(returned_expression(funDef->body.get()));
+            if (!test || !test->optr)
+            {
+                return SortKernel::Compare;
+            }
+            bool inOrder = is_parameter(test->left.get(), left) && is_parameter(test->right.get(), right);
+            bool swapped = is_parameter(test->left.get(), right) && is_parameter(test->right.get(), left);
+            if (!inOrder && !swapped)
+            {
+                return SortKernel::Compare;
+            }
+            switch (test->optr->type)
+            {
+            case TokenType::LT:
+                return inOrder ? SortKernel::Ascending : SortKernel::Descending;
+            case TokenType::GT:
+                return inOrder ? SortKernel::Descending : SortKernel::Ascending;
+            default:
+                return SortKernel::Compare;
+            }
+        }
+
         auto append_function_if_missing(BytecodeModule &module, Map<Str, FunctionDef*> &functionDefs,
                                         const Str &functionName, FunctionDef *functionDef) -> void
         {
@@ -152,9 +317,21 @@ namespace NG::orgasm
     }
 
     auto Compiler::compile(ASTRef<CompileUnit> compileUnit) -> BytecodeModule
+    {
+        check(compileUnit);
+        return compile_checked(compileUnit);
+    }
+
+    void Compiler::check(ASTRef<CompileUnit> compileUnit)
     {
         auto preludeTypes = NG::typecheck::build_prelude_type_index();
         NG::typecheck::type_check(compileUnit, preludeTypes, modulePaths);
+        // Compiling imported modules type checks them too, which replaces the recorded instances.
+        checkedGenericInstances = NG::typecheck::generic_function_instances();
+    }
+
+    auto Compiler::compile_checked(ASTRef<CompileUnit> compileUnit) -> BytecodeModule
+    {
         current_function = nullptr;
         last_emit_was_return = false;
         locals.clear();
@@ -173,6 +350,7 @@ namespace NG::orgasm
         current_type_name.clear();
         activeGenericInstanceName.clear();
         variant_map.clear();
+        entryFunctionName = "__start__";
         module = BytecodeModule{};
         module.name = compileUnit->module && !compileUnit->module->name.empty()
                           ? compileUnit->module->name
@@ -243,6 +421,31 @@ namespace NG::orgasm
         return std::move(module);
     }
 
+    auto Compiler::compile_increment(ASTRef<CompileUnit> compileUnit, const Str &entryName) -> const BytecodeModule &
+    {
+        if (module.functions.empty())
+        {
+            module = BytecodeModule{};
+            module.name = compileUnit->module && !compileUnit->module->name.empty()
+                              ? compileUnit->module->name
+                              : compileUnit->fileName;
+            module.constants.push_back(0);
+            module.constants.push_back(1);
+            install_builtin_lifecycle_traits(runtimeTraits);
+        }
+        checkedGenericInstances = NG::typecheck::generic_function_instances();
+        current_function = nullptr;
+        last_emit_was_return = false;
+        current_type_name.clear();
+        activeGenericInstanceName.clear();
+        // Imported definitions from earlier increments are already registered and compiled.
+        importedDefinitions.clear();
+        entryFunctionName = entryName;
+        compileUnit->module->accept(this);
+        module.buildIndex();
+        return module;
+    }
+
     void Compiler::visit(Module *mod)
     {
         collectModuleDefinitions(mod);
@@ -253,9 +456,9 @@ namespace NG::orgasm
     void Compiler::collectModuleDefinitions(Module *mod)
     {
         Function startFun{};
-        startFun.name = "__start__";
+        startFun.name = entryFunctionName;
         startFun.num_params = 0;
-        module.addFunction(std::move(startFun));
+        entryFunctionIndex = module.addFunction(std::move(startFun));
 
         for (auto &&import : mod->imports) {
             import->accept(this);
@@ -295,7 +498,7 @@ namespace NG::orgasm
                 }
                 if (!funDef->genericParams.empty())
                 {
-                    genericFunctionDefs[funDef->funName] = funDef;
+                    genericFunctionDefs.insert(funDef);
                 }
                 return;
             }
@@ -375,9 +578,16 @@ namespace NG::orgasm
                 {
                     continue;
                 }
+                if (funDef->native && !funDef->genericParams.empty())
+                {
+                    // Source modules compile without the host's native list, and generic natives have
+                    // no instance to call; their declarations name the natives the module calls.
+                    nativeFnNames.insert(funDef->funName);
+                    continue;
+                }
                 if (!funDef->genericParams.empty())
                 {
-                    genericFunctionDefs[funDef->funName] = funDef.get();
+                    genericFunctionDefs.insert(funDef.get());
                     continue;
                 }
                 Function fun{};
@@ -534,21 +744,13 @@ namespace NG::orgasm
 
     void Compiler::compileModuleTopLevelCode(Module *mod)
     {
-        for (auto &&def : mod->definitions)
+        // The type checker already knows every instance the unit uses, including instances only reached
+        // from other instances and instances it reused from earlier checks.
+        for (const auto &instance : checkedGenericInstances)
         {
-            collect_generic_function_instances(def);
-        }
-        for (auto &&stmt : mod->statements)
-        {
-            collect_generic_function_instances(stmt);
-        }
-        for (size_t i = 0; i < genericFunctionInstances.size(); ++i)
-        {
-            const auto &instanceName = genericFunctionInstances[i];
-            auto *genericDef = functionDefs.contains(instanceName) ? functionDefs[instanceName] : nullptr;
-            if (genericDef)
+            if (genericFunctionDefs.contains(instance->definition))
             {
-                collect_generic_function_instances(genericDef->body, instanceName);
+                register_generic_function_instance(instance->mangledName, instance->definition);
             }
         }
 
@@ -579,8 +781,8 @@ namespace NG::orgasm
             }
         }
 
-        // Second pass: compile top-level code into __start__ (at index 0)
-        current_function = &module.functions[0];
+        // Second pass: compile top-level code into the entry function (__start__ at index 0)
+        current_function = &module.functions[entryFunctionIndex];
         last_emit_was_return = false;
         locals.clear();
         localValueTypes.clear();
@@ -627,7 +829,7 @@ namespace NG::orgasm
             stmt->accept(this);
         }
 
-        module.functions[0].num_locals = static_cast<int32_t>(locals.size());
+        module.functions[entryFunctionIndex].num_locals = static_cast<int32_t>(locals.size());
         emit(OpCode::PUSH_UNIT);
         emit(OpCode::RETURN);
     }
@@ -636,6 +838,21 @@ namespace NG::orgasm
     {
         for (auto *importedDef : importedDefinitions)
         {
+            if (auto *typeDef = dynamic_cast<TypeDef *>(importedDef))
+            {
+                // Member calls dispatch within the calling module, so imported members need bodies here.
+                current_type_name = typeDef->typeName;
+                for (auto &&memFn : typeDef->memberFunctions)
+                {
+                    auto *targetFunction = find_function(typeDef->typeName + "." + memFn->funName);
+                    if (targetFunction && targetFunction->code.empty())
+                    {
+                        compile_function_body(memFn.get(), *targetFunction, true);
+                    }
+                }
+                current_type_name.clear();
+                continue;
+            }
             auto *implDef = dynamic_cast<ImplDef *>(importedDef);
             if (!implDef)
             {
@@ -845,10 +1062,12 @@ namespace NG::orgasm
         }
         loop_stack.push_back(std::move(info));
 
+        auto outerLastUseLoads = std::exchange(lastUseLoads, collect_last_uses(funDef));
         if (funDef->body)
         {
             funDef->body->accept(this);
         }
+        lastUseLoads = std::move(outerLastUseLoads);
 
         loop_stack.pop_back();
         current_function->num_locals = static_cast<int32_t>(locals.size());
@@ -859,163 +1078,6 @@ namespace NG::orgasm
         }
     }
 
-    // Visitor that traverses the AST to find and register generic function instances.
-    // Replaces the three overloaded collect_generic_function_instances() functions.
-    class GenericInstanceCollector : public DummyVisitor
-    {
-        Compiler &compiler;
-        Str instanceContext;
-    public:
-        explicit GenericInstanceCollector(Compiler &compiler, const Str &ctx = "")
-            : compiler(compiler), instanceContext(ctx) {}
-
-        void visit(FunCallExpression *call) override
-        {
-            Str symbol = call->mangledCalleeName;
-            if (!instanceContext.empty())
-            {
-                if (auto it = call->mangledCalleeNameByInstance.find(instanceContext);
-                    it != call->mangledCalleeNameByInstance.end())
-                {
-                    symbol = it->second;
-                }
-            }
-            if (!symbol.empty())
-            {
-                if (auto id = dynamic_ast_cast<IdExpression>(call->primaryExpression))
-                {
-                    if (auto defIt = compiler.genericFunctionDefs.find(id->id); defIt != compiler.genericFunctionDefs.end())
-                    {
-                        compiler.register_generic_function_instance(symbol, defIt->second);
-                    }
-                }
-            }
-            call->primaryExpression->accept(this);
-            for (auto &arg : call->arguments) arg->accept(this);
-        }
-
-        // Recurse into container nodes
-        void visit(Module *mod) override
-        {
-            for (auto &def : mod->definitions) def->accept(this);
-            for (auto &stmt : mod->statements) stmt->accept(this);
-        }
-        void visit(CompoundStatement *stmt) override
-        {
-            for (auto &child : stmt->statements) child->accept(this);
-        }
-        void visit(SimpleStatement *stmt) override { if (stmt->expression) stmt->expression->accept(this); }
-        void visit(ReturnStatement *stmt) override { if (stmt->expression) stmt->expression->accept(this); }
-        void visit(IfStatement *stmt) override
-        {
-            stmt->testing->accept(this);
-            stmt->consequence->accept(this);
-            if (stmt->alternative) stmt->alternative->accept(this);
-        }
-        void visit(ValDefStatement *stmt) override { if (stmt->value) stmt->value->accept(this); }
-        void visit(ValueBindingStatement *stmt) override { if (stmt->value) stmt->value->accept(this); }
-        void visit(LoopStatement *stmt) override
-        {
-            for (auto &b : stmt->bindings) if (b.target) b.target->accept(this);
-            if (stmt->loopBody) stmt->loopBody->accept(this);
-        }
-        void visit(NextStatement *stmt) override
-        {
-            for (auto &e : stmt->expressions) e->accept(this);
-        }
-        void visit(SwitchStatement *stmt) override
-        {
-            stmt->scrutinee->accept(this);
-            for (auto &c : stmt->cases) c.body->accept(this);
-        }
-        void visit(FunctionDef *def) override { if (def->body) def->body->accept(this); }
-        void visit(ValDef *def) override { if (def->body) def->body->accept(this); }
-        void visit(TypeDef *def) override
-        {
-            for (auto &m : def->memberFunctions) if (m->body) m->body->accept(this);
-        }
-        void visit(ImplDef *def) override
-        {
-            for (auto &m : def->methods) if (m->body) m->body->accept(this);
-        }
-
-        // Recurse into expression nodes
-        void visit(IdAccessorExpression *expr) override
-        {
-            expr->primaryExpression->accept(this);
-            if (expr->accessor) expr->accessor->accept(this);
-            for (auto &a : expr->arguments) a->accept(this);
-        }
-        void visit(QualifiedTraitCallExpression *expr) override
-        {
-            if (expr->receiver) expr->receiver->accept(this);
-            for (auto &a : expr->arguments) a->accept(this);
-        }
-        void visit(IndexAccessorExpression *expr) override
-        {
-            expr->primary->accept(this);
-            if (expr->accessor) expr->accessor->accept(this);
-        }
-        void visit(IndexAssignmentExpression *expr) override
-        {
-            expr->primary->accept(this);
-            if (expr->accessor) expr->accessor->accept(this);
-            if (expr->value) expr->value->accept(this);
-        }
-        void visit(TypeCheckingExpression *expr) override { if (expr->value) expr->value->accept(this); }
-        void visit(AssignmentExpression *expr) override
-        {
-            expr->target->accept(this);
-            expr->value->accept(this);
-        }
-        void visit(UnaryExpression *expr) override { if (expr->operand) expr->operand->accept(this); }
-        void visit(BinaryExpression *expr) override
-        {
-            expr->left->accept(this);
-            expr->right->accept(this);
-        }
-        void visit(ArrayLiteral *expr) override
-        {
-            for (auto &e : expr->elements) e->accept(this);
-        }
-        void visit(TupleLiteral *expr) override
-        {
-            for (auto &e : expr->elements) e->accept(this);
-        }
-        void visit(TypeOfExpression *expr) override { if (expr->expression) expr->expression->accept(this); }
-        void visit(SpreadExpression *expr) override { if (expr->expression) expr->expression->accept(this); }
-        void visit(CastExpression *expr) override { if (expr->expression) expr->expression->accept(this); }
-        void visit(NewObjectExpression *expr) override
-        {
-            for (auto &[_, v] : expr->properties) v->accept(this);
-        }
-        void visit(TaggedValueExpression *expr) override
-        {
-            for (auto &p : expr->payload) p->accept(this);
-        }
-    };
-
-    void Compiler::collect_generic_function_instances(ASTRef<Definition> def, const Str &instanceContext)
-    {
-        if (!def) return;
-        GenericInstanceCollector collector(*this, instanceContext);
-        def->accept(&collector);
-    }
-
-    void Compiler::collect_generic_function_instances(ASTRef<Statement> stmt, const Str &instanceContext)
-    {
-        if (!stmt) return;
-        GenericInstanceCollector collector(*this, instanceContext);
-        stmt->accept(&collector);
-    }
-
-    void Compiler::collect_generic_function_instances(ASTRef<Expression> expr, const Str &instanceContext)
-    {
-        if (!expr) return;
-        GenericInstanceCollector collector(*this, instanceContext);
-        expr->accept(&collector);
-    }
-
     void Compiler::visit(ast::CastExpression *castExpr)
     {
         castExpr->expression->accept(this);
@@ -1106,12 +1168,9 @@ namespace NG::orgasm
             {
                 throw RuntimeException("Cyclic source module compilation detected: " + moduleId);
             }
-            Compiler inner(modulePaths);
-            auto cu = dynamic_ast_cast<CompileUnit>(moduleInfo->moduleAst);
             try
             {
-                if (!cu) throw RuntimeException("Failed to cast AST to CompileUnit for module " + moduleId);
-                auto bc = inner.compile(cu);
+                auto bc = compile_source_module(*moduleInfo, modulePaths);
                 moduleInfo->bytecodeModule = std::make_shared<BytecodeModule>(std::move(bc));
                 registry.addModuleInfo(moduleInfo);
                 compilingModules.erase(moduleId);
@@ -1242,15 +1301,54 @@ namespace NG::orgasm
         {
             fold->expression->accept(this);
             funCallExpr->arguments[1]->accept(this);
-            emit(OpCode::FOLD_RIGHT_CALL);
         }
         else
         {
             funCallExpr->arguments[0]->accept(this);
             fold->expression->accept(this);
-            emit(OpCode::FOLD_LEFT_CALL);
         }
+        auto funDef = functionDefs.find(target->id);
+        if (auto kernel = recognize_fold_kernel(funDef == functionDefs.end() ? nullptr : funDef->second))
+        {
+            emit(OpCode::FOLD_KERNEL_CALL);
+            emit_u8(static_cast<uint8_t>(*kernel));
+            emit_u8(foldIndex == 0 ? 1 : 0);
+        }
+        else
+        {
+            emit(foldIndex == 0 ? OpCode::FOLD_RIGHT_CALL : OpCode::FOLD_LEFT_CALL);
+        }
+        emit_u16(static_cast<uint16_t>(funIndex));
+    }
+
+    /**
+     * Compiles `sortBy(xs, key)` and `sortWith(xs, less)` from std.array to SORT_CALL when the second
+     * argument names a function of this module; NG has no function values to hand the natives.
+     */
+    auto Compiler::compileSortCall(ast::FunCallExpression *funCallExpr, ast::IdExpression *target) -> bool
+    {
+        using runtime::kernels::SortKernel;
+        bool sortBy = target->id == "sortBy";
+        if ((!sortBy && target->id != "sortWith") || !nativeFnNames.contains(target->id) ||
+            !imported_symbols.contains(target->id) || imported_symbols[target->id].moduleName != "std.array" ||
+            funCallExpr->arguments.size() != 2)
+        {
+            return false;
+        }
+        auto function = dynamic_ast_cast<IdExpression>(funCallExpr->arguments[1]);
+        int32_t funIndex = function ? find_function_index(function->id) : -1;
+        if (funIndex < 0)
+        {
+            throw NotImplementedException(target->id + "() requires the name of a function of this module");
+        }
+        funCallExpr->arguments[0]->accept(this);
+        auto funDef = functionDefs.find(function->id);
+        emit(OpCode::SORT_CALL);
+        emit_u8(static_cast<uint8_t>(
+            sortBy ? SortKernel::Key
+                   : recognize_sort_comparator(funDef == functionDefs.end() ? nullptr : funDef->second)));
         emit_u16(static_cast<uint16_t>(funIndex));
+        return true;
     }
 
     void Compiler::compileTaggedConstructor(ast::FunCallExpression *funCallExpr, const Str &variantName)
@@ -1290,6 +1388,10 @@ namespace NG::orgasm
 
         if (auto idExpr = dynamic_ast_cast<IdExpression>(funCallExpr->primaryExpression))
         {
+            if (compileSortCall(funCallExpr, idExpr.get()))
+            {
+                return;
+            }
             if (idExpr->id == "print")
             {
                 auto emittedArgs = emit_call_arguments(funCallExpr->arguments);
@@ -1343,6 +1445,17 @@ namespace NG::orgasm
             {
                 auto &funName = module.functions[funIndex].name;
                 FunctionDef *def = functionDefs.contains(funName) ? functionDefs[funName] : nullptr;
+                if (def && def->native)
+                {
+                    // A native declared in this module has no body; its stub only serves importers.
+                    auto emittedArgs = emit_call_arguments(funCallExpr->arguments);
+                    uint16_t nameIdx = static_cast<uint16_t>(module.strings.size());
+                    module.strings.push_back(idExpr->id);
+                    emit(OpCode::NATIVE_CALL);
+                    emit_u16(nameIdx);
+                    emit_u16(emittedArgs);
+                    return;
+                }
                 int32_t packIndex = -1;
                 if (def)
                 {
@@ -1514,7 +1627,7 @@ namespace NG::orgasm
                 }
             }
             auto emittedArgs = emit_call_arguments(funCallExpr->arguments);
-            idAcc->primaryExpression->accept(this);
+            emit_member_receiver(idAcc.get());
             uint16_t nameIndex = static_cast<uint16_t>(module.strings.size());
             auto memberName = idAcc->accessor->repr();
             if (!activeTraitMethodOrigin.empty() && runtimeTraits.contains(activeTraitMethodOrigin) &&
@@ -1550,7 +1663,7 @@ namespace NG::orgasm
                 return;
             }
         }
-        idAccExpr->primaryExpression->accept(this);
+        emit_member_receiver(idAccExpr);
         auto emittedArgs = emit_call_arguments(idAccExpr->arguments);
         uint16_t nameIndex = static_cast<uint16_t>(module.strings.size());
         module.strings.push_back(idAccExpr->accessor->repr());
@@ -1618,7 +1731,15 @@ namespace NG::orgasm
             emit(OpCode::SLICE_RANGE);
             return;
         }
-        idxAccExpr->primary->accept(this);
+        // Indexing a named collection borrows it rather than copying the whole collection first.
+        if (dynamic_ast_cast<IdExpression>(idxAccExpr->primary) && is_reference_place(idxAccExpr->primary.get()))
+        {
+            emit_reference(idxAccExpr->primary);
+        }
+        else
+        {
+            idxAccExpr->primary->accept(this);
+        }
         idxAccExpr->accessor->accept(this);
         emit(OpCode::GET_INDEX);
     }
@@ -1647,11 +1768,11 @@ namespace NG::orgasm
 
     void Compiler::visit(ast::IndexAssignmentExpression *idxAssignExpr)
     {
+        // SET_INDEX writes in place, so packed arrays keep their element bytes.
         emit_reference(idxAssignExpr->primary);
         idxAssignExpr->accessor->accept(this);
-        emit(OpCode::MAKE_INDEX_REF);
         idxAssignExpr->value->accept(this);
-        emit(OpCode::STORE_REF);
+        emit(OpCode::SET_INDEX);
     }
 
     void Compiler::visit(ast::CompoundStatement *compoundStmt)
@@ -2047,6 +2168,52 @@ namespace NG::orgasm
         throw NotImplementedException("Reference target not supported: " + expr->repr());
     }
 
+    auto Compiler::is_reference_place(const ast::Expression *expr) const -> bool
+    {
+        while (expr)
+        {
+            if (auto idExpr = dynamic_cast<const IdExpression *>(expr))
+            {
+                return locals.contains(idExpr->id) || globals.contains(idExpr->id) ||
+                       (locals.contains("self") && find_field_index(idExpr->id) >= 0);
+            }
+            if (auto idAcc = dynamic_cast<const IdAccessorExpression *>(expr); idAcc && idAcc->arguments.empty())
+            {
+                expr = idAcc->primaryExpression.get();
+            }
+            else if (auto idxAcc = dynamic_cast<const IndexAccessorExpression *>(expr))
+            {
+                expr = idxAcc->primary.get();
+            }
+            else
+            {
+                return false;
+            }
+        }
+        return false;
+    }
+
+    void Compiler::emit_member_receiver(ast::IdAccessorExpression *member)
+    {
+        // Members the type checker found edit their receiver (growable-vector members, `ref<Self>` receivers)
+        // get the place itself rather than a copy.
+        bool byRef = member->receiverByRef;
+        if (!activeGenericInstanceName.empty())
+        {
+            if (auto it = member->receiverByRefByInstance.find(activeGenericInstanceName);
+                it != member->receiverByRefByInstance.end())
+            {
+                byRef = it->second;
+            }
+        }
+        if (byRef && is_reference_place(member->primaryExpression.get()))
+        {
+            emit_reference(member->primaryExpression);
+            return;
+        }
+        member->primaryExpression->accept(this);
+    }
+
     auto Compiler::trait_ref_name(const ast::TypeAnnotation *annotation) const -> Str
     {
         if (!annotation || annotation->name != "ref" || annotation->genericArgs.size() != 1)
@@ -2418,9 +2585,8 @@ namespace NG::orgasm
         {
             emit_reference(idxAssign->primary);
             idxAssign->accessor->accept(this);
-            emit(OpCode::MAKE_INDEX_REF);
             assignExpr->value->accept(this);
-            emit(OpCode::STORE_REF);
+            emit(OpCode::SET_INDEX);
         }
         else if (auto derefExpr = dynamic_ast_cast<UnaryExpression>(assignExpr->target);
                  derefExpr && derefExpr->optr && derefExpr->optr->type == TokenType::TIMES)
@@ -2635,12 +2801,26 @@ namespace NG::orgasm
     {
         if (locals.contains(idExpr->id))
         {
-            emit(OpCode::LOAD_LOCAL);
+            auto traitObject = localTraitObjectTypes.find(idExpr->id);
+            auto mayDrop = idExpr->readMayDrop;
+            if (!activeGenericInstanceName.empty())
+            {
+                if (auto it = idExpr->readMayDropByInstance.find(activeGenericInstanceName);
+                    it != idExpr->readMayDropByInstance.end())
+                {
+                    mayDrop = it->second;
+                }
+            }
+            // Last reads move the value out of the local instead of copying it. Values the checker found may
+            // have a destructor, or did not see, are still copied, so drops run exactly as before.
+            const bool take = lastUseLoads.erase(idExpr) > 0 && traitObject == localTraitObjectTypes.end() &&
+                              !mayDrop.value_or(true);
+            emit(take ? OpCode::TAKE_LOCAL : OpCode::LOAD_LOCAL);
             emit_u16(static_cast<uint16_t>(locals[idExpr->id]));
-            if (auto it = localTraitObjectTypes.find(idExpr->id); it != localTraitObjectTypes.end())
+            if (traitObject != localTraitObjectTypes.end())
             {
                 uint16_t traitIndex = static_cast<uint16_t>(module.strings.size());
-                module.strings.push_back(it->second);
+                module.strings.push_back(traitObject->second);
                 emit(OpCode::MAKE_TRAIT_REF);
                 emit_u16(traitIndex);
             }
@@ -1,5 +1,6 @@
 #include <orgasm/vm.hpp>
 #include <orgasm/compiler.hpp>
+#include <orgasm/build_cache.hpp>
 #include <algorithm>
 #include <bit>
 #include <functional>
@@ -8,6 +9,7 @@
 #include <cstring>
 #include <limits>
 #include <module.hpp>
+#include <runtime/array_kernels.hpp>
 #include <runtime/array_layout_access.hpp>
 #include <runtime/index_layout_access.hpp>
 #include <runtime/struct_layout_access.hpp>
@@ -74,6 +76,31 @@ namespace NG::orgasm
             return moved;
         }
 
+        // Take a slot's value at its last use: like move_slot, but the contents are moved rather than copied,
+        // and the temporary is marked uniquely owned so the next owner can adopt it as is.
+        auto take_slot(const RuntimeRef<StorageCell> &source) -> RuntimeRef<StorageCell>
+        {
+            auto taken = make_storage_cell(source->layout, StorageClass::TEMPORARY, "stack", source->runtimeType);
+            taken->bytes = std::move(source->bytes);
+            taken->nativeHandles = std::move(source->nativeHandles);
+            taken->opaqueRefs = std::move(source->opaqueRefs);
+            taken->namedRefs = std::move(source->namedRefs);
+            taken->moduleState = source->moduleState;
+            taken->traitObjectName = source->traitObjectName;
+            taken->initialized = source->initialized;
+            taken->dropArmed = source->dropArmed;
+            taken->lifecycleDropped = source->lifecycleDropped;
+            taken->uniquelyOwned = true;
+            mark_moved_storage_cell(source);
+            return taken;
+        }
+
+        // Whether a value taken by the callee owns it: nobody else can observe a uniquely owned temporary.
+        auto adoptable_slot(const RuntimeRef<StorageCell> &slot) -> bool
+        {
+            return slot && slot->uniquelyOwned && slot.use_count() == 1;
+        }
+
         auto ensure_slot(Vec<RuntimeRef<StorageCell>> &slots, size_t index, const Str &prefix,
                          StorageClass storageClass = StorageClass::FRAME) -> RuntimeRef<StorageCell>
         {
@@ -123,11 +150,9 @@ namespace NG::orgasm
         native_functions[name] = std::move(func);
     }
 
-    auto VM::run(const BytecodeModule &module) -> RuntimeRef<StorageCell>
+    void VM::install_gc_hooks(const BytecodeModule &module)
     {
-        current_module = &module;
-        root_symbols = makert<RuntimeSymbolTable>();
-        auto gcRootProviderId = register_gc_root_provider([this]() {
+        gcRootProviderId = register_gc_root_provider([this]() {
             auto roots = enumerate_symbol_roots(root_symbols);
             append_slot_roots(roots, globals);
             append_slot_roots(roots, stack);
@@ -137,11 +162,6 @@ namespace NG::orgasm
             }
             return roots;
         });
-        struct RootProviderGuard
-        {
-            size_t id;
-            ~RootProviderGuard() { unregister_gc_root_provider(id); }
-        } rootProviderGuard{gcRootProviderId};
         gcFinalizerId = register_gc_finalizer([this, &module](const RuntimeRef<StorageCell> &cell) {
             std::function<void(const RuntimeRef<StorageCell> &)> finalizeCell;
             finalizeCell = [this, &module, &finalizeCell](const RuntimeRef<StorageCell> &targetCell) {
@@ -200,45 +220,40 @@ namespace NG::orgasm
             };
             finalizeCell(cell);
         });
-        struct FinalizerGuard
+    }
+
+    void VM::remove_gc_hooks()
+    {
+        if (gcFinalizerId != 0)
         {
-            size_t &id;
-            ~FinalizerGuard()
-            {
-                if (id != 0)
-                {
-                    unregister_gc_finalizer(id);
-                    id = 0;
-                }
-            }
-        } finalizerGuard{gcFinalizerId};
-        // Size globals dynamically based on module needs
-        size_t maxGlobal = 0;
-        for (const auto &fun : module.functions) {
-            for (size_t i = 0; i < fun.code.size(); ++i) {
-                OpCode op = static_cast<OpCode>(fun.code[i]);
-                if (op == OpCode::STORE_GLOBAL || op == OpCode::LOAD_GLOBAL) {
-                    if (i + 2 < fun.code.size()) {
-                        uint16_t idx = static_cast<uint16_t>(fun.code[i + 1]) | (static_cast<uint16_t>(fun.code[i + 2]) << 8);
-                        maxGlobal = std::max(maxGlobal, static_cast<size_t>(idx) + 1);
-                    }
-                }
-            }
+            unregister_gc_finalizer(gcFinalizerId);
+            gcFinalizerId = 0;
         }
-        globals.resize(std::max(maxGlobal, size_t{1}));
-        for (size_t i = 0; i < globals.size(); ++i)
+        if (gcRootProviderId != 0)
         {
-            ensure_slot(globals, i, "global:", StorageClass::GLOBAL);
+            unregister_gc_root_provider(gcRootProviderId);
+            gcRootProviderId = 0;
         }
-        
+    }
+
+    void VM::install_root_symbols()
+    {
+        root_symbols = makert<RuntimeSymbolTable>();
         // Register built-ins
         root_symbols->functions["not"] = [](const NGSelf &, const NGEnv &,
                                             const NGArgs &args) -> RuntimeRef<StorageCell> {
             if (args.empty()) throw RuntimeException("not expects 1 arg");
             return make_runtime_boolean(!runtime_value_bool(args[0]));
         };
+    }
 
+    void VM::install_module_types(const BytecodeModule &module, bool replaceExisting)
+    {
         for (const auto &type : module.types) {
+            if (!replaceExisting && root_types.contains(type.name))
+            {
+                continue;
+            }
             auto ngType = makert<NGType>();
             ngType->name = type.name;
             ngType->properties = type.properties;
@@ -251,9 +266,51 @@ namespace NG::orgasm
                 ngType->memberFunctions["Clone::clone"] = cloneMember;
                 ngType->memberFunctions["clone"] = std::move(cloneMember);
             }
+            if (std::ranges::find(type.derivedTraits, Str{"Hash"}) != type.derivedTraits.end())
+            {
+                NGCallable hashMember = [](const NGSelf &self, const NGEnv &, const NGArgs &) -> RuntimeRef<StorageCell> {
+                    return numeral_cell_from_value<uint64_t>(value_hash(self));
+                };
+                ngType->memberFunctions["Hash::hash"] = hashMember;
+                ngType->memberFunctions["hash"] = std::move(hashMember);
+            }
             root_types[type.name] = ngType;
             root_symbols->types[type.name] = ngType;
         }
+    }
+
+    struct VM::GcHooksGuard
+    {
+        VM &vm;
+        ~GcHooksGuard() { vm.remove_gc_hooks(); }
+    };
+
+    auto VM::run(const BytecodeModule &module) -> RuntimeRef<StorageCell>
+    {
+        current_module = &module;
+        install_root_symbols();
+        install_gc_hooks(module);
+        GcHooksGuard hooksGuard{*this};
+        // Size globals dynamically based on module needs
+        size_t maxGlobal = 0;
+        for (const auto &fun : module.functions) {
+            for (size_t i = 0; i < fun.code.size(); ++i) {
+                OpCode op = static_cast<OpCode>(fun.code[i]);
+                if (op == OpCode::STORE_GLOBAL || op == OpCode::LOAD_GLOBAL) {
+                    if (i + 2 < fun.code.size()) {
+                        uint16_t idx = static_cast<uint16_t>(fun.code[i + 1]) | (static_cast<uint16_t>(fun.code[i + 2]) << 8);
+                        maxGlobal = std::max(maxGlobal, static_cast<size_t>(idx) + 1);
+                    }
+                }
+            }
+        }
+        globals.resize(std::max(maxGlobal, size_t{1}));
+        for (size_t i = 0; i < globals.size(); ++i)
+        {
+            ensure_slot(globals, i, "global:", StorageClass::GLOBAL);
+        }
+
+        install_module_types(module, true);
 
         if (!module.functions.empty())
         {
@@ -272,20 +329,62 @@ namespace NG::orgasm
         return unit_cell();
     }
 
+    auto VM::run_function(const BytecodeModule &module, const Str &entryName) -> RuntimeRef<StorageCell>
+    {
+        auto entryIndex = module.findFunction(entryName);
+        if (entryIndex < 0)
+        {
+            throw RuntimeException("Unknown entry function: " + entryName);
+        }
+        current_module = &module;
+        if (!root_symbols)
+        {
+            install_root_symbols();
+        }
+        install_gc_hooks(module);
+        GcHooksGuard hooksGuard{*this};
+        // Globals grow on demand through ensure_slot; only types introduced since the last call are new.
+        install_module_types(module, false);
+        // A previous entry that threw may have left frames behind.
+        stack.clear();
+        call_stack.clear();
+        return execute_slots(module, module.functions[static_cast<size_t>(entryIndex)], {});
+    }
+
     void VM::push_frame(const BytecodeModule &module, const Function &fun,
-                        const Vec<RuntimeRef<StorageCell>> &args)
+                        const Vec<RuntimeRef<StorageCell>> &args, Vec<RuntimeRef<StorageCell>> *reusedLocals)
     {
         Frame frame;
         frame.module = &module;
         frame.function = &fun;
         frame.ip = 0;
-        frame.locals.resize(std::max(static_cast<int32_t>(fun.num_locals), fun.num_params));
-        for (size_t i = 0; i < frame.locals.size(); ++i)
+        if (reusedLocals && !reusedLocals->empty())
         {
-            ensure_slot(frame.locals, i, "local:");
+            frame.locals = *reusedLocals;
+        }
+        else
+        {
+            frame.locals.resize(std::max(static_cast<int32_t>(fun.num_locals), fun.num_params));
+            for (size_t i = 0; i < frame.locals.size(); ++i)
+            {
+                ensure_slot(frame.locals, i, "local:");
+            }
+            if (reusedLocals)
+            {
+                *reusedLocals = frame.locals;
+            }
         }
         for (size_t i = 0; i < args.size(); ++i)
         {
+            if (adoptable_slot(args[i]))
+            {
+                auto &param = frame.locals[i];
+                param = args[i];
+                param->uniquelyOwned = false;
+                param->storageClass = StorageClass::FRAME;
+                param->name = "param:" + std::to_string(i);
+                continue;
+            }
             auto target = ensure_slot(frame.locals, i, "param:");
             runtime_copy_storage_cell(target, clone_value_slot(args[i], "param:"));
         }
@@ -333,10 +432,11 @@ namespace NG::orgasm
     }
 
     auto VM::execute_slots(const BytecodeModule &module, const Function &fun,
-                           const Vec<RuntimeRef<StorageCell>> &args) -> RuntimeRef<StorageCell>
+                           const Vec<RuntimeRef<StorageCell>> &args, Vec<RuntimeRef<StorageCell>> *reusedLocals)
+        -> RuntimeRef<StorageCell>
     {
         const auto baseFrameDepth = call_stack.size();
-        push_frame(module, fun, args);
+        push_frame(module, fun, args, reusedLocals);
         struct CallStackGuard
         {
             Vec<Frame> &frames;
@@ -776,18 +876,36 @@ namespace NG::orgasm
                     {
                         return res;
                     }
+                    if (adoptable_slot(res))
+                    {
+                        stack.push_back(res);
+                        break;
+                    }
                     push_slot_copy(res);
                     break;
                 }
                 // ── Data access ──────────────────────────────────────────────
                 case OpCode::LOAD_LOCAL: { push_slot_copy(ensure_slot(frame.locals, read_u16(), "local:")); break; }
                 case OpCode::LOAD_PARAM: { push_slot_copy(ensure_slot(frame.locals, read_u16(), "param:")); break; }
+                case OpCode::TAKE_LOCAL:
+                {
+                    auto source = ensure_slot(frame.locals, read_u16(), "local:");
+                    if (runtime_cell_is_moved(source))
+                    {
+                        push_slot_copy(source);
+                        break;
+                    }
+                    stack.push_back(take_slot(source));
+                    break;
+                }
                 case OpCode::STORE_LOCAL:
                 {
                     uint16_t idx = read_u16();
                     auto target = ensure_slot(frame.locals, idx, "local:");
                     drop_cell_if_needed(activeModule, target);
                     runtime_copy_storage_cell(target, stack.back());
+                    // The stored value now shares its elements with the local.
+                    if (stack.back()) stack.back()->uniquelyOwned = false;
                     break;
                 }
                 case OpCode::LOAD_GLOBAL: { push_slot_copy(ensure_slot(globals, read_u16(), "global:", StorageClass::GLOBAL)); break; }
@@ -797,6 +915,7 @@ namespace NG::orgasm
                     auto target = ensure_slot(globals, idx, "global:", StorageClass::GLOBAL);
                     drop_cell_if_needed(activeModule, target);
                     runtime_copy_storage_cell(target, stack.back());
+                    if (stack.back()) stack.back()->uniquelyOwned = false;
                     break;
                 }
                 case OpCode::MAKE_LOCAL_REF:
@@ -864,11 +983,8 @@ namespace NG::orgasm
                         }
                         if (runtime_is_array_value(container))
                         {
-                            if (auto slot = runtime_cell_slot_ref(container, static_cast<size_t>(idx)))
-                            {
-                                return make_runtime_reference_cell(slot, "index");
-                            }
-                            throw RuntimeException("Array index reference is not slot-backed");
+                            // References need element slots, so this unpacks a packed array.
+                            return make_runtime_reference_cell(array_element_slot(container, static_cast<size_t>(idx)), "index");
                         }
                         throw RuntimeException("Cannot reference index on non-indexable value");
                     };
@@ -1013,13 +1129,7 @@ namespace NG::orgasm
                             }
                         };
                         CompileGuard guard{compilingModules, imp.moduleName};
-                        auto compileUnit = dynamic_ast_cast<NG::ast::CompileUnit>(moduleInfo->moduleAst);
-                        if (!compileUnit)
-                        {
-                            throw RuntimeException("Failed to cast AST to CompileUnit for module " + imp.moduleName);
-                        }
-                        Compiler compiler{modulePaths};
-                        auto bytecode = compiler.compile(compileUnit);
+                        auto bytecode = compile_source_module(*moduleInfo, modulePaths);
                         moduleInfo->bytecodeModule = std::make_shared<BytecodeModule>(std::move(bytecode));
                         registry.addModuleInfo(moduleInfo);
                     }
@@ -1157,7 +1267,17 @@ namespace NG::orgasm
                 {
                     auto idx = pop_slot();
                     auto obj = access_target_slot(pop_slot());
-                    push_slot_copy(runtime_index_slot(obj, idx));
+                    auto element = runtime_index_read(obj, idx);
+                    if (runtime_array_is_packed(obj))
+                    {
+                        // Packed reads already materialize a fresh temporary.
+                        element->name = "stack";
+                        stack.push_back(element);
+                    }
+                    else
+                    {
+                        push_slot_copy(element);
+                    }
                     break;
                 }
                 case OpCode::SET_INDEX:
@@ -1165,7 +1285,13 @@ namespace NG::orgasm
                     auto val = pop_slot();
                     auto idx = pop_slot();
                     auto obj = access_target_slot(pop_slot());
-                    push_slot_copy(runtime_index_write(obj, idx, val));
+                    if (!runtime_array_is_packed(obj))
+                    {
+                        // Packed elements are plain bytes; slot-backed ones may own resources.
+                        drop_cell_if_needed(activeModule, runtime_index_slot(obj, idx));
+                    }
+                    runtime_index_write(obj, idx, val);
+                    push_slot_copy(val);
                     break;
                 }
                 case OpCode::NEW_OBJECT:
@@ -1303,31 +1429,79 @@ namespace NG::orgasm
                     break;
                 }
                 case OpCode::FOLD_LEFT_CALL:
+                case OpCode::FOLD_RIGHT_CALL:
+                case OpCode::FOLD_KERNEL_CALL:
                 {
+                    uint8_t kernel = 0;
+                    bool fromRight = op == OpCode::FOLD_RIGHT_CALL;
+                    if (op == OpCode::FOLD_KERNEL_CALL) {
+                        kernel = read_byte_checked(code, ip);
+                        fromRight = read_byte_checked(code, ip) != 0;
+                    }
                     uint16_t funIndex = read_u16();
-                    auto sequence = access_target_slot(pop_slot());
-                    auto accumulator = pop_slot();
+                    RuntimeRef<StorageCell> accumulator;
+                    RuntimeRef<StorageCell> sequence;
+                    if (fromRight) {
+                        accumulator = pop_slot();
+                        sequence = access_target_slot(pop_slot());
+                    } else {
+                        sequence = access_target_slot(pop_slot());
+                        accumulator = pop_slot();
+                    }
+                    if (kernel != 0) {
+                        auto folded = runtime::kernels::fold_with_kernel(
+                            static_cast<runtime::kernels::FoldKernel>(kernel), access_target_slot(accumulator),
+                            sequence, fromRight);
+                        if (folded) {
+                            push_slot_copy(folded);
+                            break;
+                        }
+                    }
                     auto items = sequence_slots(activeModule, sequence);
-                    for (const auto &item : items) {
-                        accumulator = execute_slots(*current_module, current_module->functions[funIndex],
-                                                    {clone_value_slot(accumulator, "fold.acc"),
-                                                     clone_value_slot(item, "fold.item")});
+                    if (fromRight) {
+                        for (auto it = items.rbegin(); it != items.rend(); ++it) {
+                            accumulator = execute_slots(*current_module, current_module->functions[funIndex],
+                                                        {clone_value_slot(*it, "fold.item"),
+                                                         clone_value_slot(accumulator, "fold.acc")});
+                        }
+                    } else {
+                        for (const auto &item : items) {
+                            accumulator = execute_slots(*current_module, current_module->functions[funIndex],
+                                                        {clone_value_slot(accumulator, "fold.acc"),
+                                                         clone_value_slot(item, "fold.item")});
+                        }
                     }
                     push_slot_copy(accumulator);
                     break;
                 }
-                case OpCode::FOLD_RIGHT_CALL:
+                case OpCode::SORT_CALL:
                 {
+                    using runtime::kernels::SortKernel;
+                    auto kernel = static_cast<SortKernel>(read_byte_checked(code, ip));
                     uint16_t funIndex = read_u16();
-                    auto accumulator = pop_slot();
-                    auto sequence = access_target_slot(pop_slot());
-                    auto items = sequence_slots(activeModule, sequence);
-                    for (auto it = items.rbegin(); it != items.rend(); ++it) {
-                        accumulator = execute_slots(*current_module, current_module->functions[funIndex],
-                                                    {clone_value_slot(*it, "fold.item"),
-                                                     clone_value_slot(accumulator, "fold.acc")});
+                    auto array = access_target_slot(pop_slot());
+                    if (!runtime_is_array_value(array)) throw RuntimeException("Sorting requires an array");
+                    const auto &function = current_module->functions[funIndex];
+                    if (kernel == SortKernel::Key) {
+                        Vec<RuntimeRef<StorageCell>> keys;
+                        for (const auto &item : runtime_array_slots(array)) {
+                            keys.push_back(access_target_slot(
+                                execute_slots(*current_module, function, {clone_value_slot(item, "sort.item")})));
+                        }
+                        push_slot_copy(runtime::kernels::array_sort_by_keys(array, keys));
+                    } else if (kernel == SortKernel::Compare) {
+                        // Every comparison runs in the same local cells; only the result, a bool, outlives a call.
+                        Vec<RuntimeRef<StorageCell>> comparatorLocals;
+                        auto less = [&](const RuntimeRef<StorageCell> &left, const RuntimeRef<StorageCell> &right) {
+                            return runtime_value_bool(execute_slots(*current_module, function,
+                                                                    {clone_value_slot(left, "sort.left"),
+                                                                     clone_value_slot(right, "sort.right")},
+                                                                    &comparatorLocals));
+                        };
+                        push_slot_copy(runtime::kernels::array_sort_with(array, less));
+                    } else {
+                        push_slot_copy(runtime::kernels::array_sort(array, true, kernel == SortKernel::Descending));
                     }
-                    push_slot_copy(accumulator);
                     break;
                 }
                 case OpCode::MAKE_RANGE:
@@ -0,0 +1,247 @@
+#include <orgasm/build_cache.hpp>
+#include <orgasm/compiler.hpp>
+#include <sysdep/process.hpp>
+#include <typecheck/typecheck.hpp>
+
+#include <cstdlib>
+#include <filesystem>
+
+namespace NG::orgasm
+{
+    using namespace NG::ast;
+
+    namespace
+    {
+        namespace fs = std::filesystem;
+
+        /**
+         * Identifies the compiler: the artifact format versions plus the size and timestamp of the running
+         * executable, so rebuilding `ngi` invalidates everything it cached.
+         */
+        auto compiler_identity() -> const Str &
+        {
+            static const Str identity = [] {
+                Str value = std::to_string(NGO_FORMAT_VERSION) + "." + std::to_string(NGO_ABI_VERSION) + "." +
+                            std::to_string(NGO_METADATA_SCHEMA_VERSION);
+                std::error_code error;
+                auto executable = NG::System::Process::current_executable_path();
+                if (!executable.empty())
+                {
+                    auto size = fs::file_size(executable, error);
+                    auto stamp = fs::last_write_time(executable, error);
+                    value += ":" + executable + ":" + std::to_string(size) + ":" +
+                             std::to_string(stamp.time_since_epoch().count());
+                }
+                return value;
+            }();
+            return identity;
+        }
+
+        auto compile_unit_of(const NG::module::ModuleInfo &moduleInfo) -> ASTRef<CompileUnit>
+        {
+            return dynamic_ast_cast<CompileUnit>(moduleInfo.moduleAst);
+        }
+
+        class BuildKeyHasher
+        {
+            const Vec<Str> &modulePaths;
+            Map<Str, Str> &keys;  ///< Keys computed so far; empty for modules that cannot be cached.
+            Set<Str> visiting;
+
+          public:
+            BuildKeyHasher(const Vec<Str> &modulePaths, Map<Str, Str> &keys) : modulePaths(modulePaths), keys(keys) {}
+
+            auto dependencyKey(const ImportDecl &importDecl) -> Str
+            {
+                auto moduleId = NG::module::canonical_module_id(importDecl.modulePath);
+                if (moduleId.empty())
+                {
+                    moduleId = importDecl.module;
+                }
+                if (auto known = keys.find(moduleId); known != keys.end())
+                {
+                    return known->second;
+                }
+                auto &registry = NG::module::get_module_registry();
+                auto moduleInfo = registry.queryModuleById(moduleId);
+                if (!moduleInfo)
+                {
+                    try
+                    {
+                        NG::module::FileBasedExternalModuleLoader loader{modulePaths};
+                        moduleInfo = loader.load(importDecl.modulePath);
+                    }
+                    catch (const std::exception &)
+                    {
+                        moduleInfo = nullptr;
+                    }
+                    if (auto artifact = registry.queryArtifactById(moduleId);
+                        artifact && artifact->format == NG::module::ModuleFormat::Native)
+                    {
+                        // Native functions are part of the executable, which the compiler identity covers; a
+                        // source file next to them is not registered, since importers use the native module.
+                        auto source = moduleInfo ? moduleInfo->moduleSourceHash : Str{};
+                        return keys[moduleId] = "native:" + moduleId + ":" + source;
+                    }
+                    if (!moduleInfo)
+                    {
+                        return keys[moduleId] = "";
+                    }
+                    registry.addModuleInfo(moduleInfo);
+                }
+                if (!moduleInfo->moduleAst && moduleInfo->bytecodeModule)
+                {
+                    const auto &sourceHash = moduleInfo->bytecodeModule->sourceHash;
+                    return keys[moduleId] = sourceHash.empty() ? "" : "ngo:" + sourceHash;
+                }
+                return keys[moduleId] = key(*moduleInfo, moduleId);
+            }
+
+            auto key(const NG::module::ModuleInfo &moduleInfo, const Str &moduleId) -> Str
+            {
+                auto compileUnit = compile_unit_of(moduleInfo);
+                if (!compileUnit || !compileUnit->module || !visiting.insert(moduleId).second)
+                {
+                    return "";
+                }
+                Str inputs = compiler_identity() + "\n" + typecheck::prelude_fingerprint() + "\n" + moduleId + "\n" +
+                             moduleInfo.moduleSourceHash;
+                for (const auto &importDecl : compileUnit->module->imports)
+                {
+                    auto dependency = dependencyKey(*importDecl);
+                    if (dependency.empty())
+                    {
+                        visiting.erase(moduleId);
+                        return "";
+                    }
+                    inputs += "\n" + importDecl->module + "=" + dependency;
+                }
+                visiting.erase(moduleId);
+                return bytecode_source_hash(inputs);
+            }
+        };
+
+        auto cached_module_path(const Str &key) -> fs::path
+        {
+            // Two-character fan-out keeps directories small in large caches.
+            return fs::path{build_cache_dir()} / key.substr(0, 2) / (key + ".ngo");
+        }
+    } // namespace
+
+    auto build_cache_dir() -> Str
+    {
+        const char *directory = std::getenv("NG_CACHE_DIR");
+        return directory == nullptr ? "" : directory;
+    }
+
+    auto module_build_key(const NG::module::ModuleInfo &moduleInfo, const Vec<Str> &modulePaths,
+                          Map<Str, Str> *knownKeys) -> Str
+    {
+        Map<Str, Str> keys;
+        BuildKeyHasher hasher{modulePaths, knownKeys ? *knownKeys : keys};
+        auto moduleId = moduleInfo.moduleId.empty() ? moduleInfo.moduleAbsolutePath : moduleInfo.moduleId;
+        auto key = hasher.key(moduleInfo, moduleId);
+        if (knownKeys)
+        {
+            knownKeys->insert_or_assign(moduleId, key);
+        }
+        return key;
+    }
+
+    auto load_cached_module(const Str &key) -> std::optional<BytecodeModule>
+    {
+        if (key.empty() || build_cache_dir().empty())
+        {
+            return std::nullopt;
+        }
+        auto path = cached_module_path(key);
+        std::error_code error;
+        if (!fs::exists(path, error))
+        {
+            return std::nullopt;
+        }
+        try
+        {
+            auto module = read_bytecode_module(path.string());
+            if (module.sourceHash != key)
+            {
+                return std::nullopt;
+            }
+            return module;
+        }
+        catch (const std::exception &)
+        {
+            return std::nullopt;
+        }
+    }
+
+    void store_cached_module(const Str &key, const BytecodeModule &module)
+    {
+        if (key.empty() || build_cache_dir().empty())
+        {
+            return;
+        }
+        auto path = cached_module_path(key);
+        std::error_code error;
+        fs::create_directories(path.parent_path(), error);
+        // Concurrent builds write their own temporary file; any of the identical results may win the rename.
+        auto temporary = path;
+        temporary += NG::System::Process::unique_temporary_suffix();
+        try
+        {
+            write_bytecode_module(module, temporary.string(), key);
+        }
+        catch (const RuntimeException &)
+        {
+            fs::remove(temporary, error);
+            return;
+        }
+        fs::rename(temporary, path, error);
+        if (error)
+        {
+            fs::remove(temporary, error);
+        }
+    }
+
+    auto compile_source_module(const NG::module::ModuleInfo &moduleInfo, const Vec<Str> &modulePaths)
+        -> BytecodeModule
+    {
+        auto compileUnit = compile_unit_of(moduleInfo);
+        if (!compileUnit)
+        {
+            throw RuntimeException("Failed to cast AST to CompileUnit for module " + moduleInfo.moduleId);
+        }
+        // Modules of the prelude snapshot keep their bytecode in the snapshot image.
+        const bool inSnapshot = typecheck::prelude_snapshot_contains(moduleInfo.moduleId);
+        auto key = build_cache_dir().empty() && !inSnapshot ? Str{} : module_build_key(moduleInfo, modulePaths);
+        if (auto bytes = inSnapshot ? typecheck::prelude_snapshot_bytecode(moduleInfo.moduleId, key)
+                                    : std::string_view{};
+            !bytes.empty())
+        {
+            try
+            {
+                return decode_bytecode_module(bytes, moduleInfo.moduleId);
+            }
+            catch (const RuntimeException &)
+            {
+                // Recompile and replace the unreadable entry.
+            }
+        }
+        auto module = [&] {
+            if (auto cached = load_cached_module(key))
+            {
+                return std::move(*cached);
+            }
+            Compiler compiler{modulePaths};
+            auto compiled = compiler.compile(compileUnit);
+            store_cached_module(key, compiled);
+            return compiled;
+        }();
+        if (inSnapshot)
+        {
+            typecheck::store_prelude_snapshot_bytecode(moduleInfo.moduleId, key, encode_bytecode_module(module, key));
+        }
+        return module;
+    }
+
+} // namespace NG::orgasm
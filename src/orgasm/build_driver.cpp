@@ -0,0 +1,270 @@
+#include <orgasm/build_driver.hpp>
+#include <orgasm/build_cache.hpp>
+#include <orgasm/compiler.hpp>
+#include <sysdep/thread_pool.hpp>
+#include <module.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <functional>
+#include <mutex>
+#include <optional>
+#include <shared_mutex>
+
+namespace NG::orgasm
+{
+    using namespace NG::ast;
+
+    namespace
+    {
+        namespace fs = std::filesystem;
+        using Clock = std::chrono::steady_clock;
+
+        auto elapsed_ms(Clock::time_point since) -> double
+        {
+            return std::chrono::duration<double, std::milli>(Clock::now() - since).count();
+        }
+
+        struct BuildNode
+        {
+            Str moduleId;
+            std::shared_ptr<NG::module::ModuleInfo> moduleInfo; ///< Null for the entry program.
+            ASTRef<CompileUnit> compileUnit;
+            Str key;                   ///< Build cache key; empty when the module cannot be cached.
+            Str sourceHash;
+            fs::path output;
+            Vec<size_t> dependents;
+            size_t pendingImports = 0; ///< Imported modules not built yet.
+        };
+
+        /**
+         * Orders the source modules imported by a program into a dependency graph, imported modules first.
+         */
+        class BuildGraph
+        {
+            const Vec<Str> &modulePaths;
+            Map<Str, size_t> indexById;
+            Set<Str> visiting;
+            Map<Str, Str> keys;
+
+          public:
+            Vec<BuildNode> nodes;
+
+            explicit BuildGraph(const Vec<Str> &modulePaths) : modulePaths(modulePaths) {}
+
+            /**
+             * Adds `moduleInfo` after the modules it imports, returning its node index.
+             */
+            auto add(const std::shared_ptr<NG::module::ModuleInfo> &moduleInfo, const Str &moduleId,
+                     const NG::module::ModuleInfo &source) -> size_t
+            {
+                if (auto known = indexById.find(moduleId); known != indexById.end())
+                {
+                    return known->second;
+                }
+                auto compileUnit = dynamic_ast_cast<CompileUnit>(source.moduleAst);
+                if (!compileUnit || !compileUnit->module)
+                {
+                    throw RuntimeException("Failed to cast AST to CompileUnit for module " + moduleId);
+                }
+                if (!visiting.insert(moduleId).second)
+                {
+                    throw RuntimeException("Cyclic source module compilation detected: " + moduleId);
+                }
+                Vec<size_t> imports;
+                for (const auto &importDecl : compileUnit->module->imports)
+                {
+                    if (auto imported = addImport(*importDecl))
+                    {
+                        imports.push_back(*imported);
+                    }
+                }
+                visiting.erase(moduleId);
+
+                size_t index = nodes.size();
+                BuildNode node{
+                    .moduleId = moduleId,
+                    .moduleInfo = moduleInfo,
+                    .compileUnit = compileUnit,
+                    .key = build_cache_dir().empty() ? Str{} : module_build_key(source, modulePaths, &keys),
+                    .sourceHash = source.moduleSourceHash,
+                };
+                std::ranges::sort(imports);
+                imports.erase(std::unique(imports.begin(), imports.end()), imports.end());
+                node.pendingImports = imports.size();
+                for (auto imported : imports)
+                {
+                    nodes[imported].dependents.push_back(index);
+                }
+                nodes.push_back(std::move(node));
+                indexById.emplace(moduleId, index);
+                return index;
+            }
+
+          private:
+            auto addImport(const ImportDecl &importDecl) -> std::optional<size_t>
+            {
+                auto moduleId = NG::module::canonical_module_id(importDecl.modulePath);
+                if (moduleId.empty())
+                {
+                    moduleId = importDecl.module;
+                }
+                auto &registry = NG::module::get_module_registry();
+                if (auto artifact = registry.queryArtifactById(moduleId);
+                    artifact && artifact->format == NG::module::ModuleFormat::Native)
+                {
+                    return std::nullopt;
+                }
+                auto moduleInfo = registry.queryModuleById(moduleId);
+                if (!moduleInfo)
+                {
+                    NG::module::FileBasedExternalModuleLoader loader{modulePaths};
+                    moduleInfo = loader.load(importDecl.modulePath);
+                    if (!moduleInfo)
+                    {
+                        throw RuntimeException("Failed to load module " + moduleId);
+                    }
+                    registry.addModuleInfo(moduleInfo);
+                }
+                if (!moduleInfo->moduleAst)
+                {
+                    // Already a bytecode module: there is nothing to build.
+                    return std::nullopt;
+                }
+                return add(moduleInfo, moduleId, *moduleInfo);
+            }
+        };
+
+        auto module_output_path(const fs::path &outputDir, const Str &moduleId) -> fs::path
+        {
+            auto path = outputDir;
+            size_t begin = 0;
+            while (true)
+            {
+                auto end = moduleId.find('.', begin);
+                path /= moduleId.substr(begin, end - begin);
+                if (end == Str::npos)
+                {
+                    break;
+                }
+                begin = end + 1;
+            }
+            path += ".ngo";
+            return path;
+        }
+    } // namespace
+
+    auto build_program(ASTRef<ASTNode> entry, std::string_view entrySource, const Str &entryPath,
+                       const Vec<Str> &modulePaths, const Vec<Str> &nativeFunctions, const Str &outputDir)
+        -> BuildReport
+    {
+        auto buildStart = Clock::now();
+        BuildReport report;
+
+        NG::module::prefetch_module_imports(entry, modulePaths);
+        report.loadMs = elapsed_ms(buildStart);
+
+        fs::path output{outputDir};
+        BuildGraph graph{modulePaths};
+        NG::module::ModuleInfo entryInfo{
+            .moduleSourceHash = bytecode_source_hash(entrySource),
+            .moduleAst = entry,
+            .moduleAbsolutePath = fs::absolute(entryPath).lexically_normal().string(),
+        };
+        graph.add(nullptr, entryInfo.moduleAbsolutePath, entryInfo);
+        auto &nodes = graph.nodes;
+        for (auto &node : nodes)
+        {
+            node.output = node.moduleInfo ? module_output_path(output, node.moduleId)
+                                          : output / fs::path{entryPath}.stem().concat(".ngo");
+        }
+
+        std::mutex scheduleMutex;
+        // Type checking writes the global checker state and annotates imported generic bodies, which code
+        // generation reads; so a check runs alone while checked modules are compiled concurrently.
+        std::shared_mutex checkMutex;
+        struct SharedChecksGuard
+        {
+            ~SharedChecksGuard()
+            {
+                NG::typecheck::clear_shared_module_checks();
+            }
+        } sharedChecks;
+        NG::System::ThreadPool pool;
+        report.workers = pool.size();
+
+        std::function<void(size_t)> schedule;
+        auto build = [&](size_t index) {
+            auto &node = nodes[index];
+            ModuleBuildTiming timing{.moduleId = node.moduleId};
+
+            auto start = Clock::now();
+            auto module = load_cached_module(node.key);
+            timing.cacheMs = elapsed_ms(start);
+            timing.cached = module.has_value();
+            if (!module)
+            {
+                Compiler compiler{modulePaths, node.moduleInfo ? Vec<Str>{} : nativeFunctions};
+                {
+                    std::unique_lock lock{checkMutex};
+                    start = Clock::now();
+                    compiler.check(node.compileUnit);
+                    if (node.moduleInfo)
+                    {
+                        // Its importers take its artifacts instead of checking it again.
+                        NG::typecheck::share_module_check(node.moduleId);
+                    }
+                    timing.compileMs = elapsed_ms(start);
+                }
+                std::shared_lock lock{checkMutex};
+                start = Clock::now();
+                module = compiler.compile_checked(node.compileUnit);
+                timing.compileMs += elapsed_ms(start);
+            }
+            auto bytecode = std::make_shared<BytecodeModule>(std::move(*module));
+
+            start = Clock::now();
+            if (!timing.cached)
+            {
+                store_cached_module(node.key, *bytecode);
+            }
+            std::error_code error;
+            fs::create_directories(node.output.parent_path(), error);
+            write_bytecode_module(*bytecode, node.output.string(), node.sourceHash);
+            timing.writeMs = elapsed_ms(start);
+
+            if (node.moduleInfo)
+            {
+                // Importers compile against it from now on.
+                std::unique_lock lock{checkMutex};
+                node.moduleInfo->bytecodeModule = bytecode;
+            }
+
+            std::lock_guard lock{scheduleMutex};
+            report.modules.push_back(std::move(timing));
+            report.outputs.push_back(node.output.string());
+            for (auto dependent : node.dependents)
+            {
+                if (--nodes[dependent].pendingImports == 0)
+                {
+                    schedule(dependent);
+                }
+            }
+        };
+        schedule = [&](size_t index) { pool.submit([&build, index] { build(index); }); };
+
+        for (size_t index = 0; index < nodes.size(); ++index)
+        {
+            if (nodes[index].pendingImports == 0)
+            {
+                schedule(index);
+            }
+        }
+        pool.wait();
+
+        report.totalMs = elapsed_ms(buildStart);
+        return report;
+    }
+
+} // namespace NG::orgasm
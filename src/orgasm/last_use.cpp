@@ -0,0 +1,413 @@
+#include <orgasm/last_use.hpp>
+#include <token.hpp>
+#include <visitor.hpp>
+
+#include <optional>
+
+namespace NG::orgasm
+{
+    using namespace NG::ast;
+
+    namespace
+    {
+        /**
+         * Records every read of a local in evaluation order, grouped into statement-sized units.
+         */
+        class LastUseCollector : public DummyVisitor
+        {
+            struct Declaration
+            {
+                size_t loopDepth = 0;
+                bool borrowed = false;
+            };
+            struct Occurrence
+            {
+                size_t declaration = 0;
+                const IdExpression *expression = nullptr; ///< Null for reads that must not move.
+                size_t unit = 0;
+                size_t loopDepth = 0;
+            };
+
+            Vec<Declaration> declarations;
+            // Mirrors the compiler's locals: blocks restore them, loop and case bindings stay visible.
+            Vec<Map<Str, size_t>> scopes;
+            Vec<Occurrence> occurrences;
+            size_t unit = 0;
+            size_t loopDepth = 0;
+
+          public:
+            explicit LastUseCollector(FunctionDef *funDef)
+            {
+                scopes.emplace_back();
+                for (const auto &param : funDef->params)
+                {
+                    declare(param->paramName);
+                }
+                if (funDef->body)
+                {
+                    funDef->body->accept(this);
+                }
+            }
+
+            auto lastUses() const -> Set<const IdExpression *>
+            {
+                Vec<std::optional<size_t>> last(declarations.size());
+                for (size_t i = 0; i < occurrences.size(); ++i)
+                {
+                    last[occurrences[i].declaration] = i;
+                }
+                Set<const IdExpression *> result;
+                for (size_t declaration = 0; declaration < declarations.size(); ++declaration)
+                {
+                    if (!last[declaration] || declarations[declaration].borrowed)
+                    {
+                        continue;
+                    }
+                    const auto &occurrence = occurrences[*last[declaration]];
+                    if (!occurrence.expression || occurrence.loopDepth != declarations[declaration].loopDepth)
+                    {
+                        continue;
+                    }
+                    // Units only grow, so reads sharing the unit sit right before the last one.
+                    bool alone = true;
+                    for (auto i = *last[declaration]; i > 0 && occurrences[i - 1].unit == occurrence.unit; --i)
+                    {
+                        alone = alone && occurrences[i - 1].declaration != declaration;
+                    }
+                    if (alone)
+                    {
+                        result.insert(occurrence.expression);
+                    }
+                }
+                return result;
+            }
+
+            void visit(CompoundStatement *stmt) override
+            {
+                scopes.emplace_back();
+                for (auto &child : stmt->statements)
+                {
+                    child->accept(this);
+                }
+                scopes.pop_back();
+            }
+
+            void visit(SimpleStatement *stmt) override
+            {
+                ++unit;
+                if (stmt->expression) stmt->expression->accept(this);
+            }
+
+            void visit(ReturnStatement *stmt) override
+            {
+                ++unit;
+                if (stmt->expression) stmt->expression->accept(this);
+            }
+
+            void visit(ValDefStatement *stmt) override
+            {
+                ++unit;
+                if (stmt->value) stmt->value->accept(this);
+                declare(stmt->name);
+            }
+
+            void visit(ValueBindingStatement *stmt) override
+            {
+                ++unit;
+                if (stmt->value) stmt->value->accept(this);
+                for (const auto &binding : stmt->bindings)
+                {
+                    if (!binding->name.empty())
+                    {
+                        declare(binding->name);
+                    }
+                }
+            }
+
+            void visit(IfStatement *stmt) override
+            {
+                ++unit;
+                if (stmt->testing) stmt->testing->accept(this);
+                if (stmt->consequence) stmt->consequence->accept(this);
+                if (stmt->alternative) stmt->alternative->accept(this);
+            }
+
+            void visit(LoopStatement *stmt) override
+            {
+                ++unit;
+                for (auto &binding : stmt->bindings)
+                {
+                    if (binding.target) binding.target->accept(this);
+                }
+                ++loopDepth;
+                for (auto &binding : stmt->bindings)
+                {
+                    declare(binding.name);
+                }
+                if (stmt->loopBody) stmt->loopBody->accept(this);
+                --loopDepth;
+            }
+
+            void visit(NextStatement *stmt) override
+            {
+                ++unit;
+                for (auto &expr : stmt->expressions) expr->accept(this);
+            }
+
+            void visit(SwitchStatement *stmt) override
+            {
+                ++unit;
+                if (stmt->scrutinee) stmt->scrutinee->accept(this);
+                for (auto &caseClause : stmt->cases)
+                {
+                    for (const auto &binding : caseClause.bindings)
+                    {
+                        if (!binding.empty())
+                        {
+                            declare(binding);
+                        }
+                    }
+                    if (caseClause.body) caseClause.body->accept(this);
+                }
+            }
+
+            void visit(IdExpression *expr) override { read(expr, expr); }
+
+            void visit(UnaryExpression *expr) override
+            {
+                if (!expr->operand) return;
+                if (expr->optr && (expr->optr->type == TokenType::KEYWORD_REF || expr->optr->type == TokenType::AMPERSAND))
+                {
+                    if (auto declaration = placeDeclaration(expr->operand.get()))
+                    {
+                        declarations[*declaration].borrowed = true;
+                    }
+                    place(expr->operand.get());
+                    return;
+                }
+                if (expr->optr && expr->optr->type == TokenType::KEYWORD_MOVE)
+                {
+                    place(expr->operand.get());
+                    return;
+                }
+                expr->operand->accept(this);
+            }
+
+            void visit(BinaryExpression *expr) override
+            {
+                if (expr->left) expr->left->accept(this);
+                if (expr->right) expr->right->accept(this);
+            }
+
+            void visit(AssignmentExpression *expr) override
+            {
+                if (expr->value) expr->value->accept(this);
+                if (auto indexAssign = dynamic_ast_cast<IndexAssignmentExpression>(expr->target))
+                {
+                    place(indexAssign->primary.get());
+                    if (indexAssign->accessor) indexAssign->accessor->accept(this);
+                    return;
+                }
+                place(expr->target.get());
+            }
+
+            void visit(IndexAssignmentExpression *expr) override
+            {
+                place(expr->primary.get());
+                if (expr->accessor) expr->accessor->accept(this);
+                if (expr->value) expr->value->accept(this);
+            }
+
+            void visit(IdAccessorExpression *expr) override
+            {
+                if (expr->primaryExpression) expr->primaryExpression->accept(this);
+                for (auto &arg : expr->arguments) arg->accept(this);
+            }
+
+            void visit(IndexAccessorExpression *expr) override
+            {
+                if (expr->primary) expr->primary->accept(this);
+                if (expr->accessor) expr->accessor->accept(this);
+            }
+
+            void visit(RangeExpression *expr) override
+            {
+                if (expr->start) expr->start->accept(this);
+                if (expr->end) expr->end->accept(this);
+            }
+
+            void visit(FromEndIndexExpression *expr) override
+            {
+                if (expr->index) expr->index->accept(this);
+            }
+
+            void visit(FunCallExpression *expr) override
+            {
+                // A plain identifier callee names a function, not a local.
+                if (expr->primaryExpression && !dynamic_ast_cast<IdExpression>(expr->primaryExpression))
+                {
+                    expr->primaryExpression->accept(this);
+                }
+                for (auto &arg : expr->arguments) arg->accept(this);
+            }
+
+            void visit(QualifiedTraitCallExpression *expr) override
+            {
+                if (expr->receiver) expr->receiver->accept(this);
+                for (auto &arg : expr->arguments) arg->accept(this);
+            }
+
+            void visit(NewObjectExpression *expr) override
+            {
+                for (auto &[_, value] : expr->properties) value->accept(this);
+            }
+
+            void visit(ArrayLiteral *expr) override
+            {
+                for (auto &element : expr->elements) element->accept(this);
+            }
+
+            void visit(TupleLiteral *expr) override
+            {
+                for (auto &element : expr->elements) element->accept(this);
+            }
+
+            void visit(TaggedValueExpression *expr) override
+            {
+                for (auto &value : expr->payload) value->accept(this);
+            }
+
+            void visit(TypeCheckingExpression *expr) override
+            {
+                if (expr->value) expr->value->accept(this);
+            }
+
+            void visit(CastExpression *expr) override
+            {
+                if (expr->expression) expr->expression->accept(this);
+            }
+
+            void visit(SpreadExpression *expr) override { pinAll(expr->expression.get()); }
+            void visit(PostfixFoldExpression *expr) override { pinAll(expr->expression.get()); }
+            void visit(TypeOfExpression *expr) override { pinAll(expr->expression.get()); }
+
+          private:
+            void declare(const Str &name)
+            {
+                scopes.back()[name] = declarations.size();
+                declarations.push_back({.loopDepth = loopDepth});
+            }
+
+            auto lookup(const Str &name) const -> std::optional<size_t>
+            {
+                for (auto scope = scopes.rbegin(); scope != scopes.rend(); ++scope)
+                {
+                    if (auto found = scope->find(name); found != scope->end())
+                    {
+                        return found->second;
+                    }
+                }
+                return std::nullopt;
+            }
+
+            /**
+             * Records a read of `expr`, which may move when `movable` is set.
+             */
+            void read(const IdExpression *expr, const IdExpression *movable)
+            {
+                if (auto declaration = lookup(expr->id))
+                {
+                    occurrences.push_back({
+                        .declaration = *declaration,
+                        .expression = expr->id == "self" ? nullptr : movable,
+                        .unit = unit,
+                        .loopDepth = loopDepth,
+                    });
+                }
+            }
+
+            /**
+             * Returns the local a place expression (`x`, `x.field`, `x[i]`) is rooted at.
+             */
+            auto placeDeclaration(Expression *expr) const -> std::optional<size_t>
+            {
+                while (expr)
+                {
+                    if (auto id = dynamic_cast<IdExpression *>(expr))
+                    {
+                        return lookup(id->id);
+                    }
+                    if (auto accessor = dynamic_cast<IdAccessorExpression *>(expr))
+                    {
+                        expr = accessor->primaryExpression.get();
+                    }
+                    else if (auto index = dynamic_cast<IndexAccessorExpression *>(expr))
+                    {
+                        expr = index->primary.get();
+                    }
+                    else
+                    {
+                        return std::nullopt;
+                    }
+                }
+                return std::nullopt;
+            }
+
+            /**
+             * Records a place expression, whose root local is addressed rather than read.
+             */
+            void place(Expression *expr)
+            {
+                if (!expr)
+                {
+                    return;
+                }
+                if (auto id = dynamic_cast<IdExpression *>(expr))
+                {
+                    read(id, nullptr);
+                }
+                else if (auto accessor = dynamic_cast<IdAccessorExpression *>(expr))
+                {
+                    place(accessor->primaryExpression.get());
+                    for (auto &arg : accessor->arguments) arg->accept(this);
+                }
+                else if (auto index = dynamic_cast<IndexAccessorExpression *>(expr))
+                {
+                    place(index->primary.get());
+                    if (index->accessor) index->accessor->accept(this);
+                }
+                else
+                {
+                    expr->accept(this);
+                }
+            }
+
+            /**
+             * Records every read inside `expr` as one that must not move.
+             */
+            void pinAll(Expression *expr)
+            {
+                if (!expr)
+                {
+                    return;
+                }
+                auto first = occurrences.size();
+                expr->accept(this);
+                for (auto i = first; i < occurrences.size(); ++i)
+                {
+                    occurrences[i].expression = nullptr;
+                }
+            }
+        };
+    } // namespace
+
+    auto collect_last_uses(FunctionDef *funDef) -> Set<const IdExpression *>
+    {
+        if (!funDef)
+        {
+            return {};
+        }
+        return LastUseCollector{funDef}.lastUses();
+    }
+
+} // namespace NG::orgasm
@@ -2,6 +2,7 @@
 #include <cstring>
 #include <fstream>
 #include <limits>
+#include <spanstream>
 #include <sstream>
 #include <type_traits>
 
@@ -281,7 +282,7 @@ namespace NG::orgasm
         }
     } // namespace
 
-    auto bytecode_source_hash(const Str &source) -> Str
+    auto bytecode_source_hash(std::string_view source) -> Str
     {
         uint64_t hash = 1469598103934665603ULL;
         for (unsigned char ch : source)
@@ -294,6 +295,101 @@ namespace NG::orgasm
         return out.str();
     }
 
+    namespace
+    {
+        void write_module(std::ostream &out, const BytecodeModule &module, const Str &overrideSourceHash)
+        {
+            out.write(NGO_MAGIC, sizeof(NGO_MAGIC));
+            write_scalar<uint32_t>(out, NGO_FORMAT_VERSION);
+            write_scalar<uint32_t>(out, NGO_ABI_VERSION);
+            write_scalar<uint32_t>(out, NGO_METADATA_SCHEMA_VERSION);
+            write_string(out, module.name);
+            write_string(out, overrideSourceHash.empty() ? module.sourceHash : overrideSourceHash);
+
+            write_vector<int64_t>(out, module.constants, [&](int64_t value) { write_scalar<int64_t>(out, value); });
+            write_vector<double>(out, module.float_constants, [&](double value) { write_scalar<double>(out, value); });
+            write_string_vector(out, module.strings);
+            write_vector<Function>(out, module.functions, [&](const Function &function) { write_function(out, function); });
+            write_vector<Type>(out, module.types, [&](const Type &type) { write_type(out, type); });
+            write_vector<ExternalSymbol>(out, module.imports, [&](const ExternalSymbol &symbol) { write_import(out, symbol); });
+            write_scalar<uint32_t>(out, static_cast<uint32_t>(module.exports.size()));
+            for (const auto &[name, index] : module.exports)
+            {
+                write_string(out, name);
+                write_scalar<int32_t>(out, index);
+            }
+            write_string_map(out, module.exportTypeReprs);
+            write_vector<BytecodeTraitMetadata>(
+                out, module.traitMetadata,
+                [&](const BytecodeTraitMetadata &trait) { write_trait_metadata(out, trait); });
+            write_vector<BytecodeImplMetadata>(out, module.implMetadata,
+                                               [&](const BytecodeImplMetadata &impl) { write_impl_metadata(out, impl); });
+        }
+
+        auto read_module(std::istream &in, const Str &origin, const Str &expectedModuleId) -> BytecodeModule
+        {
+            char magic[4]{};
+            read_exact_bytes(in, magic, sizeof(magic), sizeof(magic), "magic");
+            if (std::memcmp(magic, NGO_MAGIC, sizeof(NGO_MAGIC)) != 0)
+            {
+                throw RuntimeException("Invalid .ngo artifact magic: " + origin);
+            }
+            auto formatVersion = read_scalar<uint32_t>(in, "formatVersion");
+            if (formatVersion != NGO_FORMAT_VERSION)
+            {
+                throw RuntimeException("Unsupported .ngo format version: " + std::to_string(formatVersion));
+            }
+            auto abiVersion = read_scalar<uint32_t>(in, "abiVersion");
+            if (abiVersion != NGO_ABI_VERSION)
+            {
+                throw RuntimeException("Unsupported .ngo ABI version: " + std::to_string(abiVersion));
+            }
+            auto metadataSchemaVersion = read_scalar<uint32_t>(in, "metadataSchemaVersion");
+            if (metadataSchemaVersion != NGO_METADATA_SCHEMA_VERSION)
+            {
+                throw RuntimeException("Unsupported .ngo metadata schema version: " +
+                                       std::to_string(metadataSchemaVersion));
+            }
+
+            BytecodeModule module;
+            module.name = read_string(in, "module.name");
+            module.sourceHash = read_string(in, "sourceHash");
+            if (!expectedModuleId.empty() && module.name != expectedModuleId)
+            {
+                throw RuntimeException("Bytecode module id mismatch: " + module.name + ", expected " + expectedModuleId);
+            }
+
+            module.constants = read_vector<int64_t>(in, "constants",
+                                                    [&](const Str &field) { return read_scalar<int64_t>(in, field); });
+            module.float_constants = read_vector<double>(in, "float_constants",
+                                                         [&](const Str &field) { return read_scalar<double>(in, field); });
+            module.strings = read_string_vector(in, "strings");
+            module.functions = read_vector<Function>(in, "functions",
+                                                     [&](const Str &field) { return read_function(in, field); });
+            module.types = read_vector<Type>(in, "types", [&](const Str &field) { return read_type(in, field); });
+            module.imports = read_vector<ExternalSymbol>(in, "imports",
+                                                         [&](const Str &field) { return read_import(in, field); });
+            auto exportCount = read_scalar<uint32_t>(in, "exports.count");
+            if (exportCount > MAX_NGO_EXPORTS)
+            {
+                throw RuntimeException(".ngo exports too large");
+            }
+            for (uint32_t i = 0; i < exportCount; ++i)
+            {
+                auto name = read_string(in, "exports[" + std::to_string(i) + "].name");
+                auto index = read_scalar<int32_t>(in, "exports[" + std::to_string(i) + "].index");
+                module.exports.insert_or_assign(std::move(name), index);
+            }
+            module.exportTypeReprs = read_string_map(in, "exportTypeReprs");
+            module.traitMetadata = read_vector<BytecodeTraitMetadata>(
+                in, "traitMetadata", [&](const Str &field) { return read_trait_metadata(in, field); });
+            module.implMetadata = read_vector<BytecodeImplMetadata>(
+                in, "implMetadata", [&](const Str &field) { return read_impl_metadata(in, field); });
+            module.buildIndex();
+            return module;
+        }
+    } // namespace
+
     void write_bytecode_module(const BytecodeModule &module, const Str &path, const Str &overrideSourceHash)
     {
         std::ofstream out(path, std::ios::binary);
@@ -301,32 +397,7 @@ namespace NG::orgasm
         {
             throw RuntimeException("Failed to open .ngo artifact for writing: " + path);
         }
-
-        out.write(NGO_MAGIC, sizeof(NGO_MAGIC));
-        write_scalar<uint32_t>(out, NGO_FORMAT_VERSION);
-        write_scalar<uint32_t>(out, NGO_ABI_VERSION);
-        write_scalar<uint32_t>(out, NGO_METADATA_SCHEMA_VERSION);
-        write_string(out, module.name);
-        write_string(out, overrideSourceHash.empty() ? module.sourceHash : overrideSourceHash);
-
-        write_vector<int64_t>(out, module.constants, [&](int64_t value) { write_scalar<int64_t>(out, value); });
-        write_vector<double>(out, module.float_constants, [&](double value) { write_scalar<double>(out, value); });
-        write_string_vector(out, module.strings);
-        write_vector<Function>(out, module.functions, [&](const Function &function) { write_function(out, function); });
-        write_vector<Type>(out, module.types, [&](const Type &type) { write_type(out, type); });
-        write_vector<ExternalSymbol>(out, module.imports, [&](const ExternalSymbol &symbol) { write_import(out, symbol); });
-        write_scalar<uint32_t>(out, static_cast<uint32_t>(module.exports.size()));
-        for (const auto &[name, index] : module.exports)
-        {
-            write_string(out, name);
-            write_scalar<int32_t>(out, index);
-        }
-        write_string_map(out, module.exportTypeReprs);
-        write_vector<BytecodeTraitMetadata>(
-            out, module.traitMetadata,
-            [&](const BytecodeTraitMetadata &trait) { write_trait_metadata(out, trait); });
-        write_vector<BytecodeImplMetadata>(out, module.implMetadata,
-                                           [&](const BytecodeImplMetadata &impl) { write_impl_metadata(out, impl); });
+        write_module(out, module, overrideSourceHash);
     }
 
     auto read_bytecode_module(const Str &path, const Str &expectedModuleId) -> BytecodeModule
@@ -336,66 +407,20 @@ namespace NG::orgasm
         {
             throw RuntimeException("Failed to open .ngo artifact for reading: " + path);
         }
+        return read_module(in, path, expectedModuleId);
+    }
 
-        char magic[4]{};
-        read_exact_bytes(in, magic, sizeof(magic), sizeof(magic), "magic");
-        if (std::memcmp(magic, NGO_MAGIC, sizeof(NGO_MAGIC)) != 0)
-        {
-            throw RuntimeException("Invalid .ngo artifact magic: " + path);
-        }
-        auto formatVersion = read_scalar<uint32_t>(in, "formatVersion");
-        if (formatVersion != NGO_FORMAT_VERSION)
-        {
-            throw RuntimeException("Unsupported .ngo format version: " + std::to_string(formatVersion));
-        }
-        auto abiVersion = read_scalar<uint32_t>(in, "abiVersion");
-        if (abiVersion != NGO_ABI_VERSION)
-        {
-            throw RuntimeException("Unsupported .ngo ABI version: " + std::to_string(abiVersion));
-        }
-        auto metadataSchemaVersion = read_scalar<uint32_t>(in, "metadataSchemaVersion");
-        if (metadataSchemaVersion != NGO_METADATA_SCHEMA_VERSION)
-        {
-            throw RuntimeException("Unsupported .ngo metadata schema version: " +
-                                   std::to_string(metadataSchemaVersion));
-        }
-
-        BytecodeModule module;
-        module.name = read_string(in, "module.name");
-        module.sourceHash = read_string(in, "sourceHash");
-        if (!expectedModuleId.empty() && module.name != expectedModuleId)
-        {
-            throw RuntimeException("Bytecode module id mismatch: " + module.name + ", expected " + expectedModuleId);
-        }
+    auto encode_bytecode_module(const BytecodeModule &module, const Str &overrideSourceHash) -> Str
+    {
+        std::ostringstream out{std::ios::binary};
+        write_module(out, module, overrideSourceHash);
+        return std::move(out).str();
+    }
 
-        module.constants = read_vector<int64_t>(in, "constants",
-                                                [&](const Str &field) { return read_scalar<int64_t>(in, field); });
-        module.float_constants = read_vector<double>(in, "float_constants",
-                                                     [&](const Str &field) { return read_scalar<double>(in, field); });
-        module.strings = read_string_vector(in, "strings");
-        module.functions = read_vector<Function>(in, "functions",
-                                                 [&](const Str &field) { return read_function(in, field); });
-        module.types = read_vector<Type>(in, "types", [&](const Str &field) { return read_type(in, field); });
-        module.imports = read_vector<ExternalSymbol>(in, "imports",
-                                                     [&](const Str &field) { return read_import(in, field); });
-        auto exportCount = read_scalar<uint32_t>(in, "exports.count");
-        if (exportCount > MAX_NGO_EXPORTS)
-        {
-            throw RuntimeException(".ngo exports too large");
-        }
-        for (uint32_t i = 0; i < exportCount; ++i)
-        {
-            auto name = read_string(in, "exports[" + std::to_string(i) + "].name");
-            auto index = read_scalar<int32_t>(in, "exports[" + std::to_string(i) + "].index");
-            module.exports.insert_or_assign(std::move(name), index);
-        }
-        module.exportTypeReprs = read_string_map(in, "exportTypeReprs");
-        module.traitMetadata = read_vector<BytecodeTraitMetadata>(
-            in, "traitMetadata", [&](const Str &field) { return read_trait_metadata(in, field); });
-        module.implMetadata = read_vector<BytecodeImplMetadata>(
-            in, "implMetadata", [&](const Str &field) { return read_impl_metadata(in, field); });
-        module.buildIndex();
-        return module;
+    auto decode_bytecode_module(std::string_view bytes, const Str &expectedModuleId) -> BytecodeModule
+    {
+        std::ispanstream in{std::span<const char>{bytes.data(), bytes.size()}};
+        return read_module(in, "<memory>", expectedModuleId);
     }
 
     void BytecodeModule::merge(const BytecodeModule &other, const Str &prefix)
@@ -541,6 +566,14 @@ namespace NG::orgasm
                     remap_u16_fun(1);
                     advance_operands(op == OpCode::CALL ? 4 : 2); // CALL has funIndex + numArgs; folds only funIndex.
                     break;
+                case OpCode::FOLD_KERNEL_CALL:
+                    remap_u16_fun(3);
+                    advance_operands(4); // kernel + fromRight + funIndex
+                    break;
+                case OpCode::SORT_CALL:
+                    remap_u16_fun(2);
+                    advance_operands(3); // kernel + funIndex
+                    break;
                 case OpCode::MAKE_RANGE:
                     advance_operands(1); // inclusive flag
                     break;
@@ -553,6 +586,7 @@ namespace NG::orgasm
 
                 // Instructions with local/global index operand
                 case OpCode::LOAD_LOCAL:
+                case OpCode::TAKE_LOCAL:
                 case OpCode::LOAD_PARAM:
                 case OpCode::STORE_LOCAL:
                 case OpCode::LOAD_GLOBAL:
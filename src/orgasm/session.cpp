@@ -0,0 +1,38 @@
+#include <orgasm/session.hpp>
+
+namespace NG::orgasm
+{
+    using namespace NG::ast;
+
+    ReplSession::ReplSession(Vec<Str> modulePaths, Vec<Str> nativeFunctions)
+        : modulePaths(modulePaths), typeIndex(typecheck::build_prelude_type_index()),
+          compiler(modulePaths, std::move(nativeFunctions)), machine(std::move(modulePaths))
+    {
+    }
+
+    ReplSession::~ReplSession()
+    {
+        for (auto &ast : histories)
+        {
+            destroyast(ast);
+        }
+    }
+
+    auto ReplSession::evaluate(ASTRef<ASTNode> input) -> RuntimeRef<StorageCell>
+    {
+        auto compileUnit = dynamic_ast_cast<CompileUnit>(input);
+        if (!compileUnit || !compileUnit->module)
+        {
+            throw RuntimeException("REPL input must be a compile unit");
+        }
+        auto checked = typecheck::type_check(input, typeIndex, modulePaths);
+        histories.push_back(input);
+
+        auto entryName = "__repl_" + std::to_string(inputCount++) + "__";
+        const auto &bytecode = compiler.compile_increment(compileUnit, entryName);
+        auto result = machine.run_function(bytecode, entryName);
+        // Later inputs only see the bindings of inputs that ran to the end.
+        typeIndex = std::move(checked);
+        return result;
+    }
+} // namespace NG::orgasm
@@ -8,11 +8,19 @@ namespace NG::parsing
 
   LexState::LexState(const Str &_source) : source(_source), size(_source.size()), index(0), line(1), col(1) {}
 
+  auto LexState::borrowing(std::string_view source) -> LexState
+  {
+    LexState state{Str{}};
+    state.borrowed = source;
+    state.size = source.size();
+    return state;
+  }
+
   auto LexState::current() const -> char
   {
     if (!eof())
     {
-      return source.at(index);
+      return text()[index];
     }
     return '\0';
   }
@@ -24,6 +32,11 @@ namespace NG::parsing
 
   void LexState::extend(const Str &source)
   {
+    if (borrowed.data() != nullptr)
+    {
+      this->source.assign(borrowed);
+      borrowed = {};
+    }
     this->source += source;
     this->size += source.size();
   }
@@ -34,7 +47,7 @@ namespace NG::parsing
     {
       return '\0';
     }
-    return source.at(index + 1);
+    return text()[index + 1];
   }
 
   void LexState::next(size_t n)
@@ -26,11 +26,9 @@ namespace NG::parsing
 
   constexpr std::array<int, 6> bitlengths{8, 16, 32, 64, 128, 256};
 
-  auto emitToken(Vec<Token> &tokens, TokenType type, const Str &repr, TokenPosition pos) -> Token
+  auto emitToken(TokenType type, const Str &repr, TokenPosition pos) -> Token
   {
-    Token token{.type = type, .repr = repr, .position = pos};
-    tokens.push_back(token);
-    return token;
+    return Token{.type = type, .repr = repr, .position = pos};
   }
 
   template <class Container, class T>
@@ -191,13 +189,13 @@ namespace NG::parsing
 
   };
 
-  static Token lexSymbol(LexState &state, Vec<Token> &tokens);
+  static Token lexSymbol(LexState &state);
 
-  static Token lexNumber(LexState &state, Vec<Token> &tokens);
+  static Token lexNumber(LexState &state);
 
-  static Token lexOperator(LexState &state, Vec<Token> &tokens);
+  static Token lexOperator(LexState &state);
 
-  static Token lexString(LexState &state, Vec<Token> &tokens);
+  static Token lexString(LexState &state);
 
   [[nodiscard]] inline auto isTerminator(char character) -> bool
   {
@@ -264,24 +262,24 @@ namespace NG::parsing
   }
 
   // Lex colon variants: ::, :=, :
-  static auto lexColon(LexState &state, Vec<Token> &tokens, TokenPosition pos) -> Token
+  static auto lexColon(LexState &state, TokenPosition pos) -> Token
   {
     if (state.lookAhead() == ':')
     {
       state.next(2);
-      return emitToken(tokens, TokenType::SEPARATOR, "::", pos);
+      return emitToken(TokenType::SEPARATOR, "::", pos);
     }
     if (state.lookAhead() == '=')
     {
       state.next(2);
-      return emitToken(tokens, TokenType::ASSIGN_EQUAL, ":=", pos);
+      return emitToken(TokenType::ASSIGN_EQUAL, ":=", pos);
     }
     state.next();
-    return emitToken(tokens, TokenType::COLON, ":", pos);
+    return emitToken(TokenType::COLON, ":", pos);
   }
 
   // Lex dot variants: ..., ..=, .., .
-  static auto lexDot(LexState &state, Vec<Token> &tokens, TokenPosition pos) -> Token
+  static auto lexDot(LexState &state, TokenPosition pos) -> Token
   {
     if (state.lookAhead() == '.')
     {
@@ -289,18 +287,18 @@ namespace NG::parsing
       if (state.lookAhead() == '.')
       {
         state.next(2);
-        return emitToken(tokens, TokenType::SPREAD, "...", pos);
+        return emitToken(TokenType::SPREAD, "...", pos);
       }
       if (state.lookAhead() == '=')
       {
         state.next(2);
-        return emitToken(tokens, TokenType::RANGE_INCLUSIVE, "..=", pos);
+        return emitToken(TokenType::RANGE_INCLUSIVE, "..=", pos);
       }
       state.next();
-      return emitToken(tokens, TokenType::RANGE, "..", pos);
+      return emitToken(TokenType::RANGE, "..", pos);
     }
     state.next();
-    return emitToken(tokens, TokenType::DOT, ".", pos);
+    return emitToken(TokenType::DOT, ".", pos);
   }
 
   auto Lexer::next() -> Token
@@ -318,20 +316,20 @@ namespace NG::parsing
       }
 
       // Identifiers and keywords
-      if (isalpha(current) || current == '_') return lexSymbol(state, tokens);
+      if (isalpha(current) || current == '_') return lexSymbol(state);
 
       // Numbers
-      if (isdigit(current)) return lexNumber(state, tokens);
+      if (isdigit(current)) return lexNumber(state);
 
       // Strings
-      if (current == '"') return lexString(state, tokens);
+      if (current == '"') return lexString(state);
 
       // Brackets
       if (is(brackets, current))
       {
         Str result(1, current);
         state.next();
-        return emitToken(tokens, tokenType.at(result), result, pos);
+        return emitToken(tokenType.at(result), result, pos);
       }
 
       // Comments (// and /* */) and division operator
@@ -339,20 +337,20 @@ namespace NG::parsing
       {
         if (state.lookAhead() == '/') { skipLineComment(state); continue; }
         if (state.lookAhead() == '*') { skipBlockComment(state); continue; }
-        return lexOperator(state, tokens);
+        return lexOperator(state);
       }
 
       // Hash comments
       if (current == '#') { skipLineComment(state); continue; }
 
       // Operators (including minus)
-      if (is(operators, current)) return lexOperator(state, tokens);
+      if (is(operators, current)) return lexOperator(state);
 
       // Punctuation
-      if (current == ':') return lexColon(state, tokens, pos);
-      if (current == ';') { state.next(); return emitToken(tokens, TokenType::SEMICOLON, ";", pos); }
-      if (current == ',') { state.next(); return emitToken(tokens, TokenType::COMMA, ",", pos); }
-      if (current == '.') return lexDot(state, tokens, pos);
+      if (current == ':') return lexColon(state, pos);
+      if (current == ';') { state.next(); return emitToken(TokenType::SEMICOLON, ";", pos); }
+      if (current == ',') { state.next(); return emitToken(TokenType::COMMA, ",", pos); }
+      if (current == '.') return lexDot(state, pos);
 
       throw LexException("Unknown token: " + std::string(1, current));
     }
@@ -361,15 +359,20 @@ namespace NG::parsing
 
   auto Lexer::lex() -> Vec<Token> // NOLINT(readability-function-cognitive-complexity)
   {
-    while (const char current = state.current())
+    Vec<Token> tokens;
+    while (state.current())
     {
-      next();
+      auto token = next();
+      if (token.type != TokenType::NONE)
+      {
+        tokens.push_back(std::move(token));
+      }
     }
 
     return tokens;
   }
 
-  static Token lexSymbol(LexState &state, Vec<Token> &tokens)
+  static Token lexSymbol(LexState &state)
   {
     TokenPosition pos{.line = state.line, .col = state.col};
     Str result = withStream(state,
@@ -389,11 +392,11 @@ namespace NG::parsing
       {
         throw LexException("You are using a reserved token: " + result);
       }
-      return emitToken(tokens, tokenType.at(result), result, pos);
+      return emitToken(tokenType.at(result), result, pos);
     }
     else
     {
-      return emitToken(tokens, TokenType::ID, result, pos);
+      return emitToken(TokenType::ID, result, pos);
     }
   }
 
@@ -507,7 +510,7 @@ namespace NG::parsing
     return result;
   }
 
-  static Token lexNumber(LexState &state, Vec<Token> &tokens)
+  static Token lexNumber(LexState &state)
   {
     TokenPosition pos{.line = state.line, .col = state.col};
     TokenType numTokenType = TokenType::NUMBER;
@@ -556,7 +559,7 @@ namespace NG::parsing
                                   auto digitsStart = state.index;
                                   int bitlength = numberTypePostfix(state);
                                   out += suffix;
-                                  out += state.source.substr(digitsStart, state.index - digitsStart);
+                                  out += state.text().substr(digitsStart, state.index - digitsStart);
                                   numTokenType = resolveIntegralType(current, from_code<Words>(bitlength));
                                   return;
                                 }
@@ -567,7 +570,7 @@ namespace NG::parsing
                                   auto digitsStart = state.index;
                                   int bitlength = numberTypePostfix(state);
                                   out += suffix;
-                                  out += state.source.substr(digitsStart, state.index - digitsStart);
+                                  out += state.text().substr(digitsStart, state.index - digitsStart);
                                   numTokenType = resolveFloatingPointType(from_code<Floats>(bitlength));
                                   return;
                                 }
@@ -582,7 +585,7 @@ namespace NG::parsing
 
     if (!result.empty())
     {
-      return emitToken(tokens, numTokenType, result, pos);
+      return emitToken(numTokenType, result, pos);
     }
     else
     {
@@ -672,7 +675,7 @@ namespace NG::parsing
     return escaped;
   }
 
-  static Token lexString(LexState &state, Vec<Token> &tokens)
+  static Token lexString(LexState &state)
   {
     TokenPosition pos{.line = state.line, .col = state.col};
 
@@ -698,10 +701,10 @@ namespace NG::parsing
       throw LexException("Unterminated string literal");
     }
     state.next();
-    return emitToken(tokens, TokenType::STRING, result, pos);
+    return emitToken(TokenType::STRING, result, pos);
   }
 
-  static Token lexOperator(LexState &state, Vec<Token> &tokens)
+  static Token lexOperator(LexState &state)
   {
     TokenPosition pos{.line = state.line, .col = state.col};
     Str result = withStream(state,
@@ -734,6 +737,6 @@ namespace NG::parsing
     {
       throw LexException("Unknown operator: " + result);
     }
-    return emitToken(tokens, tokenType.at(result), result, pos);
+    return emitToken(tokenType.at(result), result, pos);
   }
 } // namespace NG::parsing
@@ -1,25 +1,64 @@
-
 #include <parser.hpp>
 #include <token.hpp>
+#include <algorithm>
 
 namespace NG::parsing
 {
   using namespace NG;
 
-  ParseState::ParseState(const Vec<Token> &tokens) : tokens(tokens), size(tokens.size()), index(0) {}
+  ParseState::ParseState(const Vec<Token> &tokens)
+      : tokens(tokens.begin(), tokens.end()), size(tokens.size()), index(0)
+  {
+    if (!tokens.empty())
+    {
+      lastToken = tokens.back();
+    }
+  }
+
+  ParseState::ParseState(std::shared_ptr<Lexer> lexer) : size(0), index(0), lexer(std::move(lexer)) {}
+
+  auto ParseState::fill(size_t n) const -> bool
+  {
+    while (n >= size && lexer)
+    {
+      auto token = lexer->next();
+      if (token.type == TokenType::NONE)
+      {
+        lexer = nullptr;
+        break;
+      }
+      lastToken = token;
+      tokens.push_back(std::move(token));
+      ++size;
+    }
+    return n < size;
+  }
+
+  auto ParseState::at(size_t n) const -> const Token *
+  {
+    if (n < base)
+    {
+      throw ParseException("Cannot backtrack before committed token window", lastToken.position);
+    }
+    if (!fill(n))
+    {
+      return nullptr;
+    }
+    return &tokens[n - base];
+  }
 
   auto ParseState::current() const -> const Token &
   {
-    if (!eof())
+    if (const auto *token = at(index))
     {
-      return tokens.at(index);
+      return *token;
     }
     throw EOFException();
   }
 
   auto ParseState::eof() const -> bool
   {
-    return index >= size;
+    return at(index) == nullptr;
   }
 
   void ParseState::next(size_t n)
@@ -36,6 +75,29 @@ namespace NG::parsing
     {
       return;
     }
+    if (n < base)
+    {
+      throw ParseException("Cannot backtrack before committed token window", lastToken.position);
+    }
     index = n;
   }
-} // namespace NG::parsing
\ No newline at end of file
+
+  void ParseState::commit()
+  {
+    auto release = std::min(index, size) - base;
+    tokens.erase(tokens.begin(), tokens.begin() + static_cast<std::ptrdiff_t>(release));
+    base += release;
+  }
+
+  void ParseState::splitCurrent(Token head, Token tail)
+  {
+    if (!fill(index))
+    {
+      throw EOFException();
+    }
+    auto offset = static_cast<std::ptrdiff_t>(index - base);
+    tokens[offset] = std::move(head);
+    tokens.insert(tokens.begin() + offset + 1, std::move(tail));
+    ++size;
+  }
+} // namespace NG::parsing
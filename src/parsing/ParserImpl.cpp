@@ -109,9 +109,9 @@ namespace NG::parsing
           if (!state.eof())      {
         node->pos = state->position;
       }
-      else if (!state.tokens.empty())
+      else
       {
-        node->pos = state.tokens.back().position;
+        node->pos = state.lastToken.position;
       }
       return node;
     }
@@ -135,9 +135,9 @@ namespace NG::parsing
       {
         position = state->position;
       }
-      else if (!state.tokens.empty())
+      else
       {
-        position = state.tokens.back().position;
+        position = state.lastToken.position;
       }
       throw ParseException(message, position);
     }
@@ -306,6 +306,8 @@ namespace NG::parsing
           current_mod->statements.push_back(statement());
         }
         }
+        // Top-level items are never backtracked across, so release their tokens.
+        state.commit();
       }
       return compileUnit;
     }
@@ -343,9 +345,9 @@ namespace NG::parsing
         return false;
       }
       int depth = 0;
-      for (size_t i = state.index; i < state.size; ++i)
+      for (size_t i = state.index; const auto *token = state.at(i); ++i)
       {
-        auto tokenType = state.tokens[i].type;
+        auto tokenType = token->type;
         if (tokenType == TokenType::LT)
         {
           ++depth;
@@ -360,8 +362,8 @@ namespace NG::parsing
         }
         if (depth == 0)
         {
-          auto nextIndex = i + 1;
-          return nextIndex >= state.size || expressionTerminatorAfterGenericArgs(state.tokens[nextIndex].type);
+          const auto *nextToken = state.at(i + 1);
+          return nextToken == nullptr || expressionTerminatorAfterGenericArgs(nextToken->type);
         }
         if (depth < 0)
         {
@@ -423,9 +425,9 @@ namespace NG::parsing
 
     auto peekTokenType(int offset) -> TokenType
     {
-      size_t target = state.index + offset;
-      if (target >= state.size) return TokenType::NONE;
-      return state.tokens[target].type;
+      const auto *target = state.at(state.index + offset);
+      if (target == nullptr) return TokenType::NONE;
+      return target->type;
     }
 
     void accept(TokenType type)
@@ -454,14 +456,12 @@ namespace NG::parsing
       else if (!state.eof() && state->type == TokenType::RSHIFT)
       {
         // Split >> into two > tokens: replace current >> with >, insert second > after it
-        state.tokens[state.index].type = TokenType::GT;
-        state.tokens[state.index].repr = ">";
-        Token secondGT;
-        secondGT.type = TokenType::GT;
-        secondGT.repr = ">";
-        secondGT.position = state.tokens[state.index].position;
-        state.tokens.insert(state.tokens.begin() + state.index + 1, secondGT);
-        state.size = state.tokens.size();
+        Token firstGT;
+        firstGT.type = TokenType::GT;
+        firstGT.repr = ">";
+        firstGT.position = state->position;
+        Token secondGT = firstGT;
+        state.splitCurrent(std::move(firstGT), std::move(secondGT));
         state.next(); // consume the first >
       }
       else
@@ -1140,7 +1140,7 @@ namespace NG::parsing
       Vec<ASTRef<TypeAnnotation>> derivedTraits;
       if (expect(TokenType::COLON))
       {
-        if (peekTokenType(1) == TokenType::ID && state.tokens[state.index + 1].repr == "derive")
+        if (peekTokenType(1) == TokenType::ID && state.at(state.index + 1)->repr == "derive")
         {
           derivedTraits = deriveTraitList();
         }
@@ -1416,7 +1416,7 @@ namespace NG::parsing
 
         while (expect(TokenType::ID))
         {
-          const Str &name = state->repr;
+          Str name = state->repr;
           ASTRef<Param> param = createNode<Param>(name);
           accept(TokenType::ID);
           if (expect(TokenType::COLON))
@@ -1624,8 +1624,8 @@ namespace NG::parsing
           // Look ahead to see if this is a type argument list (not comparison).
           // Type arg lists: ID < type | ID , type , ... >
           // We try to parse it: if we see a valid type after `<`, it's generic args.
-          // Save current state in case we need to backtrack.
-          auto savedState = state;
+          // Save current position in case we need to backtrack.
+          auto savedIndex = state.index;
           state.next(); // consume `<`
           bool isGenericArgs = false;
           if (!expect(TokenType::GT))
@@ -1647,7 +1647,7 @@ namespace NG::parsing
             isGenericArgs = true;
           }
           // Restore state
-          state = savedState;
+          state.revert(savedIndex);
 
           if (isGenericArgs)
           {
@@ -2482,6 +2482,8 @@ namespace NG::parsing
           break;
         }
         accept(TokenType::COMMA);
+        // Large table literals would otherwise keep every element token buffered.
+        state.commit();
       }
       accept(TokenType::RIGHT_SQUARE);
 
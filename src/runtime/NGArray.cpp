@@ -2,19 +2,163 @@
 #include <intp/runtime_numerals.hpp>
 #include <runtime/value_access.hpp>
 
+#include <algorithm>
+
 namespace NG::runtime
 {
+  namespace
+  {
+    struct PackedElement
+    {
+      RuntimeRef<NGType> type;
+      TypeLayout arrayLayout;
+    };
+
+    template <class T>
+    auto packed_numeral_entry() -> std::pair<const Str, PackedElement>
+    {
+      auto type = numeral_runtime_type<T>();
+      return {type->name, PackedElement{type, buffer_runtime::make_packed_array_layout(type->layout)}};
+    }
+
+    /**
+     * The element types an array can pack, keyed by their layout name.
+     */
+    auto packed_element(const Str &name) -> const PackedElement *
+    {
+      static const Map<Str, PackedElement> elements = [] {
+        Map<Str, PackedElement> result{
+            packed_numeral_entry<int8_t>(),  packed_numeral_entry<uint8_t>(),  packed_numeral_entry<int16_t>(),
+            packed_numeral_entry<uint16_t>(), packed_numeral_entry<int32_t>(), packed_numeral_entry<uint32_t>(),
+            packed_numeral_entry<int64_t>(), packed_numeral_entry<uint64_t>(), packed_numeral_entry<float>(),
+            packed_numeral_entry<double>(),
+        };
+        auto boolType = boolean_runtime_type();
+        result.emplace(boolType->name, PackedElement{boolType, buffer_runtime::make_packed_array_layout(boolType->layout)});
+        return result;
+      }();
+      auto found = elements.find(name);
+      return found == elements.end() ? nullptr : &found->second;
+    }
+
+    /**
+     * Returns the packed element `value` can be stored as, or null when it needs an element slot.
+     */
+    auto packable_element(const RuntimeRef<StorageCell> &value) -> const PackedElement *
+    {
+      if (!value || !value->initialized || !value->runtimeType || !value->opaqueRefs.empty() ||
+          !value->namedRefs.empty() || !value->nativeHandles.empty())
+      {
+        return nullptr;
+      }
+      auto element = packed_element(value->runtimeType->name);
+      if (!element || element->type != value->runtimeType || value->bytes.size() != element->type->layout.size)
+      {
+        return nullptr;
+      }
+      return element;
+    }
+
+    auto array_packed_element(const RuntimeRef<StorageCell> &cell) -> const PackedElement *
+    {
+      auto field = cell ? buffer_runtime::packed_array_element_field(cell->layout) : nullptr;
+      return field ? packed_element(field->name) : nullptr;
+    }
+
+    auto packed_element_cell(const RuntimeRef<StorageCell> &cell, const PackedElement &element, size_t index)
+        -> RuntimeRef<StorageCell>
+    {
+      auto stride = element.type->layout.size;
+      auto result = make_storage_cell(element.type->layout, StorageClass::TEMPORARY, std::to_string(index), element.type);
+      auto begin = cell->bytes.begin() + static_cast<std::ptrdiff_t>(index * stride);
+      result->bytes.assign(begin, begin + static_cast<std::ptrdiff_t>(stride));
+      result->initialized = true;
+      return result;
+    }
+
+    /**
+     * Switches an empty array to packed storage for `element`, keeping its reserved capacity.
+     */
+    void pack_empty_array(const RuntimeRef<StorageCell> &cell, const PackedElement &element)
+    {
+      auto capacity = cell->opaqueRefs.capacity();
+      cell->opaqueRefs = {};
+      cell->layout = element.arrayLayout;
+      cell->bytes.clear();
+      cell->bytes.reserve(capacity * element.type->layout.size);
+    }
+  } // namespace
+
   auto make_runtime_array_cell(const Vec<RuntimeRef<StorageCell>> &slots, size_t capacityHint,
                                StorageClass storageClass) -> RuntimeRef<StorageCell>
   {
     auto type = array_runtime_type();
     auto cell = make_storage_cell(type->layout, storageClass, {}, type);
+    cell->namedRefs.clear();
+    cell->nativeHandles.clear();
+    cell->initialized = true;
+
+    auto element = slots.empty() ? nullptr : packable_element(slots.front());
+    if (element && std::ranges::all_of(slots, [&](const auto &slot) { return packable_element(slot) == element; }))
+    {
+      cell->layout = element->arrayLayout;
+      cell->bytes.clear();
+      cell->bytes.reserve(std::max(capacityHint, slots.size()) * element->type->layout.size);
+      for (const auto &slot : slots)
+      {
+        cell->bytes.insert(cell->bytes.end(), slot->bytes.begin(), slot->bytes.end());
+      }
+      return cell;
+    }
     cell->bytes.resize(type->layout.size);
+    cell->opaqueRefs.reserve(std::max(capacityHint, slots.size()));
     cell->opaqueRefs.assign(slots.begin(), slots.end());
+    return cell;
+  }
+
+  namespace
+  {
+    /**
+     * Copies `value` into a fresh element cell named after its index, as `xs << value` does.
+     */
+    auto make_array_element_cell(const RuntimeRef<StorageCell> &value, size_t index) -> RuntimeRef<StorageCell>
+    {
+      auto element = make_storage_cell(value ? value->layout : TypeLayout{}, StorageClass::TEMPORARY,
+                                       std::to_string(index), value ? value->runtimeType : nullptr);
+      runtime_copy_storage_cell(element, value);
+      element->name = std::to_string(index);
+      return element;
+    }
+
+    auto require_array_index_arg(const Str &member, const NGArgs &args, size_t position) -> size_t
+    {
+      if (args.size() <= position)
+      {
+        throw RuntimeException("Array." + member + " expects an index argument");
+      }
+      auto index = read_numeric_cell_as<int64_t>(args[position]);
+      if (index < 0)
+      {
+        throw RuntimeException("Array." + member + " index out of bounds: " + std::to_string(index));
+      }
+      return static_cast<size_t>(index);
+    }
+  } // namespace
+
+  auto make_runtime_packed_array_cell(const RuntimeRef<NGType> &elementType, Vec<uint8_t> bytes,
+                                      StorageClass storageClass) -> RuntimeRef<StorageCell>
+  {
+    auto element = elementType ? packed_element(elementType->name) : nullptr;
+    if (!element || element->type != elementType || bytes.size() % elementType->layout.size != 0)
+    {
+      throw RuntimeException("Cannot pack array elements of type " + (elementType ? elementType->name : Str{"<null>"}));
+    }
+    auto type = array_runtime_type();
+    auto cell = make_storage_cell(element->arrayLayout, storageClass, {}, type);
+    cell->bytes = std::move(bytes);
     cell->namedRefs.clear();
     cell->nativeHandles.clear();
     cell->initialized = true;
-    (void) capacityHint;
     return cell;
   }
 
@@ -24,11 +168,26 @@ namespace NG::runtime
     return type && type->name == "Array";
   }
 
+  auto runtime_array_is_packed(const RuntimeRef<StorageCell> &cell) -> bool
+  {
+    return array_packed_element(cell) != nullptr;
+  }
+
+  auto runtime_array_packed_type(const RuntimeRef<StorageCell> &cell) -> RuntimeRef<NGType>
+  {
+    auto element = array_packed_element(cell);
+    return element ? element->type : nullptr;
+  }
+
   auto runtime_array_length(const RuntimeRef<StorageCell> &cell) -> size_t
   {
     if (runtime_is_array_value(cell))
     {
-      return runtime_cell_slot_refs(cell).size();
+      if (auto element = array_packed_element(cell))
+      {
+        return cell->bytes.size() / element->type->layout.size;
+      }
+      return cell->opaqueRefs.size();
     }
     throw RuntimeException("Expected Array runtime value");
   }
@@ -37,11 +196,73 @@ namespace NG::runtime
   {
     if (runtime_is_array_value(cell))
     {
+      if (auto element = array_packed_element(cell))
+      {
+        // A snapshot: writes to these cells do not reach the array.
+        auto length = cell->bytes.size() / element->type->layout.size;
+        Vec<RuntimeRef<StorageCell>> slots;
+        slots.reserve(length);
+        for (size_t i = 0; i < length; ++i)
+        {
+          slots.push_back(packed_element_cell(cell, *element, i));
+        }
+        return slots;
+      }
       return runtime_cell_slot_refs(cell);
     }
     throw RuntimeException("Expected Array runtime value");
   }
 
+  auto runtime_array_element(const RuntimeRef<StorageCell> &cell, size_t index) -> RuntimeRef<StorageCell>
+  {
+    if (index >= runtime_array_length(cell))
+    {
+      throw RuntimeException("Index out of bounds: " + std::to_string(index));
+    }
+    if (auto element = array_packed_element(cell))
+    {
+      return packed_element_cell(cell, *element, index);
+    }
+    if (auto slot = runtime_cell_slot_ref(cell, index))
+    {
+      return slot;
+    }
+    throw RuntimeException("Array element slot is missing: " + std::to_string(index));
+  }
+
+  void runtime_array_write_element(const RuntimeRef<StorageCell> &cell, size_t index,
+                                   const RuntimeRef<StorageCell> &value)
+  {
+    if (index >= runtime_array_length(cell))
+    {
+      throw RuntimeException("Index out of bounds: " + std::to_string(index));
+    }
+    if (auto element = array_packed_element(cell))
+    {
+      if (packable_element(value) == element)
+      {
+        std::ranges::copy(value->bytes, cell->bytes.begin() + static_cast<std::ptrdiff_t>(index * element->type->layout.size));
+        return;
+      }
+      runtime_array_unpack(cell);
+    }
+    runtime_copy_storage_cell(runtime_array_element(cell, index), value);
+  }
+
+  void runtime_array_unpack(const RuntimeRef<StorageCell> &cell)
+  {
+    auto element = array_packed_element(cell);
+    if (!element)
+    {
+      return;
+    }
+    auto slots = runtime_array_slots(cell);
+    auto type = array_runtime_type();
+    cell->layout = type->layout;
+    cell->bytes.assign(type->layout.size, 0);
+    cell->opaqueRefs = std::move(slots);
+  }
+
   auto array_runtime_type() -> RuntimeRef<NGType>
   {
     static RuntimeRef<NGType> arrayType = makert<NGType>(NGType{
@@ -50,7 +271,7 @@ namespace NG::runtime
         .showCellHandler =
             [](const RuntimeRef<StorageCell> &cell) {
               Str result{};
-              for (const auto &slot : runtime_cell_slot_refs(cell))
+              for (const auto &slot : runtime_array_slots(cell))
               {
                 if (!result.empty())
                 {
@@ -62,7 +283,7 @@ namespace NG::runtime
             },
         .boolCellHandler =
             [](const RuntimeRef<StorageCell> &cell) {
-              return !runtime_cell_slot_refs(cell).empty();
+              return runtime_array_length(cell) != 0;
             },
         .memberFunctions =
             {
@@ -81,7 +302,124 @@ namespace NG::runtime
                    {
                      throw RuntimeException("Array.get index out of bounds: " + std::to_string(index));
                    }
-                   return runtime_sequence_slot(self, static_cast<size_t>(index));
+                   return runtime_array_element(self, static_cast<size_t>(index));
+                 }},
+                // The mutating members below edit the receiver in place; element storage grows
+                // geometrically, so a run of `push` calls is amortized O(1) per element.
+                {"push",
+                 [](const NGSelf &self, const NGEnv &, const NGArgs &args) -> RuntimeRef<StorageCell> {
+                   if (args.size() != 1)
+                   {
+                     throw RuntimeException("Array.push expects one value argument");
+                   }
+                   auto element = array_packed_element(self);
+                   auto valueElement = packable_element(args[0]);
+                   if (!element && valueElement && self->opaqueRefs.empty())
+                   {
+                     pack_empty_array(self, *valueElement);
+                     element = valueElement;
+                   }
+                   if (element && element == valueElement)
+                   {
+                     self->bytes.insert(self->bytes.end(), args[0]->bytes.begin(), args[0]->bytes.end());
+                     return unit_cell();
+                   }
+                   runtime_array_unpack(self);
+                   auto &elements = self->opaqueRefs;
+                   elements.push_back(make_array_element_cell(args[0], elements.size()));
+                   return unit_cell();
+                 }},
+                {"pop",
+                 [](const NGSelf &self, const NGEnv &, const NGArgs &) -> RuntimeRef<StorageCell> {
+                   auto length = runtime_array_length(self);
+                   if (length == 0)
+                   {
+                     throw RuntimeException("Array.pop on an empty array");
+                   }
+                   if (auto element = array_packed_element(self))
+                   {
+                     auto last = packed_element_cell(self, *element, length - 1);
+                     self->bytes.resize(self->bytes.size() - element->type->layout.size);
+                     return last;
+                   }
+                   auto &elements = self->opaqueRefs;
+                   auto last = std::move(elements.back());
+                   elements.pop_back();
+                   return last;
+                 }},
+                {"insert",
+                 [](const NGSelf &self, const NGEnv &, const NGArgs &args) -> RuntimeRef<StorageCell> {
+                   if (args.size() != 2)
+                   {
+                     throw RuntimeException("Array.insert expects an index and a value argument");
+                   }
+                   auto index = require_array_index_arg("insert", args, 0);
+                   if (index > runtime_array_length(self))
+                   {
+                     throw RuntimeException("Array.insert index out of bounds: " + std::to_string(index));
+                   }
+                   if (auto element = array_packed_element(self); element && element == packable_element(args[1]))
+                   {
+                     auto position = self->bytes.begin() + static_cast<std::ptrdiff_t>(index * element->type->layout.size);
+                     self->bytes.insert(position, args[1]->bytes.begin(), args[1]->bytes.end());
+                     return unit_cell();
+                   }
+                   runtime_array_unpack(self);
+                   auto &elements = self->opaqueRefs;
+                   elements.insert(elements.begin() + static_cast<std::ptrdiff_t>(index),
+                                   make_array_element_cell(args[1], index));
+                   for (auto i = index + 1; i < elements.size(); ++i)
+                   {
+                     elements[i]->name = std::to_string(i);
+                   }
+                   return unit_cell();
+                 }},
+                {"truncate",
+                 [](const NGSelf &self, const NGEnv &, const NGArgs &args) -> RuntimeRef<StorageCell> {
+                   auto length = require_array_index_arg("truncate", args, 0);
+                   if (length < runtime_array_length(self))
+                   {
+                     if (auto element = array_packed_element(self))
+                     {
+                       self->bytes.resize(length * element->type->layout.size);
+                     }
+                     else
+                     {
+                       self->opaqueRefs.resize(length);
+                     }
+                   }
+                   return unit_cell();
+                 }},
+                {"clear",
+                 [](const NGSelf &self, const NGEnv &, const NGArgs &) -> RuntimeRef<StorageCell> {
+                   if (array_packed_element(self))
+                   {
+                     self->bytes.clear();
+                   }
+                   else
+                   {
+                     self->opaqueRefs.clear();
+                   }
+                   return unit_cell();
+                 }},
+                {"reserve",
+                 [](const NGSelf &self, const NGEnv &, const NGArgs &args) -> RuntimeRef<StorageCell> {
+                   auto additional = require_array_index_arg("reserve", args, 0);
+                   if (auto element = array_packed_element(self))
+                   {
+                     self->bytes.reserve(self->bytes.size() + additional * element->type->layout.size);
+                   }
+                   else
+                   {
+                     self->opaqueRefs.reserve(self->opaqueRefs.size() + additional);
+                   }
+                   return unit_cell();
+                 }},
+                {"capacity",
+                 [](const NGSelf &self, const NGEnv &, const NGArgs &) -> RuntimeRef<StorageCell> {
+                   auto element = array_packed_element(self);
+                   auto capacity = element ? self->bytes.capacity() / element->type->layout.size : self->opaqueRefs.capacity();
+                   return numeral_cell_from_value<uint32_t>(static_cast<uint32_t>(capacity));
                  }},
             },
         .cellBinaryOperators =
@@ -89,7 +427,7 @@ namespace NG::runtime
                 {RuntimeBinaryOperator::LShift,
                  [](const RuntimeRef<StorageCell> &self,
                     const RuntimeRef<StorageCell> &other) -> RuntimeRef<StorageCell> {
-                   auto slots = runtime_cell_slot_refs(self);
+                   auto slots = runtime_array_slots(self);
                    auto appended = make_storage_cell(other ? other->layout : TypeLayout{}, StorageClass::TEMPORARY,
                                                      std::to_string(slots.size()),
                                                      other ? other->runtimeType : nullptr);
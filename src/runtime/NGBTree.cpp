@@ -0,0 +1,757 @@
+#include <runtime/btree.hpp>
+#include <runtime/value_ops.hpp>
+
+#include <cstring>
+
+namespace NG::runtime
+{
+  namespace
+  {
+    /// Nodes other than the root hold between MIN_DEGREE - 1 and MAX_ENTRIES entries.
+    constexpr uint32_t MIN_DEGREE = 16;
+    constexpr uint32_t MAX_ENTRIES = 2 * MIN_DEGREE - 1;
+
+    struct TreeHeader
+    {
+      uint32_t stride = 1; ///< Cells per entry: 2 for maps, 1 for sets.
+      uint32_t reserved = 0;
+    };
+
+    struct NodeHeader
+    {
+      uint32_t count = 0; ///< Entries in this node; an internal node has one more child.
+      uint32_t leaf = 1;
+      uint64_t total = 0; ///< Entries in this node and all nodes below it.
+    };
+
+    struct RangeHeader
+    {
+      uint32_t stride = 1;
+      uint32_t reserved = 0;
+      uint64_t start = 0; ///< Sorted position of the first entry in the range.
+      uint64_t end = 0;   ///< Sorted position just past the last entry in the range.
+    };
+
+    template <class Header>
+    auto read_header(const RuntimeRef<StorageCell> &cell) -> Header
+    {
+      Header header;
+      std::memcpy(&header, cell->bytes.data(), sizeof(header));
+      return header;
+    }
+
+    template <class Header>
+    void write_header(const RuntimeRef<StorageCell> &cell, const Header &header)
+    {
+      std::memcpy(cell->bytes.data(), &header, sizeof(header));
+    }
+
+    auto btree_node_runtime_type() -> RuntimeRef<NGType>
+    {
+      static RuntimeRef<NGType> nodeType = makert<NGType>(NGType{
+          .name = "BTreeNode",
+          .layout = TypeLayout{.name = "BTreeNode", .kind = LayoutKind::DYNAMIC},
+      });
+      return nodeType;
+    }
+
+    auto make_node(bool leaf) -> RuntimeRef<StorageCell>
+    {
+      auto type = btree_node_runtime_type();
+      auto node = make_storage_cell(type->layout, StorageClass::TEMPORARY, {}, type);
+      node->bytes.assign(sizeof(NodeHeader), 0);
+      write_header(node, NodeHeader{.leaf = leaf ? 1U : 0U});
+      node->opaqueRefs.clear();
+      node->initialized = true;
+      return node;
+    }
+
+    auto require_tree(const RuntimeRef<StorageCell> &cell) -> TreeHeader
+    {
+      if (!runtime_is_btree_value(cell) || cell->bytes.size() < sizeof(TreeHeader) || cell->opaqueRefs.empty())
+      {
+        throw RuntimeException("Expected BTree runtime value");
+      }
+      return read_header<TreeHeader>(cell);
+    }
+
+    auto require_range(const RuntimeRef<StorageCell> &cell) -> RangeHeader
+    {
+      if (!runtime_is_btree_range_value(cell) || cell->bytes.size() < sizeof(RangeHeader) || cell->opaqueRefs.empty())
+      {
+        throw RuntimeException("Expected BTreeRange runtime value");
+      }
+      return read_header<RangeHeader>(cell);
+    }
+
+    auto entry_count(const RuntimeRef<StorageCell> &node) -> uint32_t
+    {
+      return read_header<NodeHeader>(node).count;
+    }
+
+    auto is_leaf(const RuntimeRef<StorageCell> &node) -> bool
+    {
+      return read_header<NodeHeader>(node).leaf != 0;
+    }
+
+    auto subtree_size(const RuntimeRef<StorageCell> &node) -> size_t
+    {
+      return read_header<NodeHeader>(node).total;
+    }
+
+    auto key_at(const RuntimeRef<StorageCell> &node, uint32_t stride, uint32_t index) -> RuntimeRef<StorageCell> &
+    {
+      return node->opaqueRefs[index * stride];
+    }
+
+    auto child_at(const RuntimeRef<StorageCell> &node, uint32_t stride, uint32_t index) -> RuntimeRef<StorageCell> &
+    {
+      return node->opaqueRefs[entry_count(node) * stride + index];
+    }
+
+    void set_entry_count(const RuntimeRef<StorageCell> &node, uint32_t count)
+    {
+      auto header = read_header<NodeHeader>(node);
+      header.count = count;
+      write_header(node, header);
+    }
+
+    /**
+     * Recomputes the subtree size of `node` from its entries and children.
+     */
+    void recount(const RuntimeRef<StorageCell> &node, uint32_t stride)
+    {
+      auto header = read_header<NodeHeader>(node);
+      header.total = header.count;
+      if (header.leaf == 0)
+      {
+        for (uint32_t i = 0; i <= header.count; ++i)
+        {
+          header.total += subtree_size(child_at(node, stride, i));
+        }
+      }
+      write_header(node, header);
+    }
+
+    /**
+     * Returns the `stride` cells of entry `index`.
+     */
+    auto entry_cells(const RuntimeRef<StorageCell> &node, uint32_t stride, uint32_t index) -> Vec<RuntimeRef<StorageCell>>
+    {
+      auto first = node->opaqueRefs.begin() + static_cast<ptrdiff_t>(index * stride);
+      return {first, first + stride};
+    }
+
+    void insert_entry(const RuntimeRef<StorageCell> &node, uint32_t stride, uint32_t index,
+                      const Vec<RuntimeRef<StorageCell>> &entry)
+    {
+      node->opaqueRefs.insert(node->opaqueRefs.begin() + static_cast<ptrdiff_t>(index * stride), entry.begin(),
+                              entry.end());
+      set_entry_count(node, entry_count(node) + 1);
+    }
+
+    void erase_entry(const RuntimeRef<StorageCell> &node, uint32_t stride, uint32_t index)
+    {
+      auto first = node->opaqueRefs.begin() + static_cast<ptrdiff_t>(index * stride);
+      node->opaqueRefs.erase(first, first + stride);
+      set_entry_count(node, entry_count(node) - 1);
+    }
+
+    void insert_child(const RuntimeRef<StorageCell> &node, uint32_t stride, uint32_t index,
+                      RuntimeRef<StorageCell> child)
+    {
+      node->opaqueRefs.insert(node->opaqueRefs.begin() + static_cast<ptrdiff_t>(entry_count(node) * stride + index),
+                              std::move(child));
+    }
+
+    void erase_child(const RuntimeRef<StorageCell> &node, uint32_t stride, uint32_t index)
+    {
+      node->opaqueRefs.erase(node->opaqueRefs.begin() + static_cast<ptrdiff_t>(entry_count(node) * stride + index));
+    }
+
+    /**
+     * Orders two keys; tuples and arrays compare lexicographically.
+     */
+    auto compare_keys(const RuntimeRef<StorageCell> &left, const RuntimeRef<StorageCell> &right) -> Orders
+    {
+      auto order = ops::key_order(left, right);
+      if (order == Orders::UNORDERED)
+      {
+        throw RuntimeException("BTree keys must be ordered: cannot compare " + runtime_value_show(left) + " with " +
+                               runtime_value_show(right));
+      }
+      return order;
+    }
+
+    /**
+     * Returns the first entry of `node` whose key is not less than `key`, and whether it equals it.
+     */
+    auto search_node(const RuntimeRef<StorageCell> &node, uint32_t stride, const RuntimeRef<StorageCell> &key)
+        -> std::pair<uint32_t, bool>
+    {
+      uint32_t low = 0;
+      uint32_t high = entry_count(node);
+      while (low < high)
+      {
+        auto middle = low + (high - low) / 2;
+        auto order = compare_keys(key_at(node, stride, middle), key);
+        if (order == Orders::EQ)
+        {
+          return {middle, true};
+        }
+        if (order == Orders::LT)
+        {
+          low = middle + 1;
+        }
+        else
+        {
+          high = middle;
+        }
+      }
+      return {low, false};
+    }
+
+    /**
+     * Returns the number of keys below `root` that are less than `key`, and whether `key` is present.
+     */
+    auto rank_in(RuntimeRef<StorageCell> node, uint32_t stride, const RuntimeRef<StorageCell> &key)
+        -> std::pair<size_t, bool>
+    {
+      size_t rank = 0;
+      while (true)
+      {
+        auto [index, found] = search_node(node, stride, key);
+        rank += index;
+        if (is_leaf(node))
+        {
+          return {rank, found};
+        }
+        for (uint32_t i = 0; i < index; ++i)
+        {
+          rank += subtree_size(child_at(node, stride, i));
+        }
+        if (found)
+        {
+          return {rank + subtree_size(child_at(node, stride, index)), true};
+        }
+        node = child_at(node, stride, index);
+      }
+    }
+
+    /**
+     * Returns the node and entry holding sorted position `index` below `node`.
+     */
+    auto locate(RuntimeRef<StorageCell> node, uint32_t stride, size_t index) -> std::pair<RuntimeRef<StorageCell>, uint32_t>
+    {
+      while (!is_leaf(node))
+      {
+        auto count = entry_count(node);
+        uint32_t child = 0;
+        for (; child < count; ++child)
+        {
+          auto size = subtree_size(child_at(node, stride, child));
+          if (index < size)
+          {
+            break;
+          }
+          if (index == size)
+          {
+            return {node, child};
+          }
+          index -= size + 1;
+        }
+        node = child_at(node, stride, child);
+      }
+      return {node, static_cast<uint32_t>(index)};
+    }
+
+    /**
+     * Moves the upper half of the full child `index` of `parent` into a new sibling and its median entry
+     * into `parent`.
+     */
+    void split_child(const RuntimeRef<StorageCell> &parent, uint32_t stride, uint32_t index)
+    {
+      auto child = child_at(parent, stride, index);
+      auto leaf = is_leaf(child);
+      auto &refs = child->opaqueRefs;
+      auto entries = refs.begin();
+      auto children = entries + static_cast<ptrdiff_t>(MAX_ENTRIES * stride);
+      auto median = entry_cells(child, stride, MIN_DEGREE - 1);
+
+      auto sibling = make_node(leaf);
+      sibling->opaqueRefs.assign(entries + static_cast<ptrdiff_t>(MIN_DEGREE * stride), children);
+      Vec<RuntimeRef<StorageCell>> lower(entries, entries + static_cast<ptrdiff_t>((MIN_DEGREE - 1) * stride));
+      if (!leaf)
+      {
+        sibling->opaqueRefs.insert(sibling->opaqueRefs.end(), children + MIN_DEGREE, refs.end());
+        lower.insert(lower.end(), children, children + MIN_DEGREE);
+      }
+      refs = std::move(lower);
+      set_entry_count(child, MIN_DEGREE - 1);
+      set_entry_count(sibling, MIN_DEGREE - 1);
+      recount(child, stride);
+      recount(sibling, stride);
+
+      insert_entry(parent, stride, index, median);
+      insert_child(parent, stride, index + 1, std::move(sibling));
+    }
+
+    void replace_value(const RuntimeRef<StorageCell> &node, uint32_t stride, uint32_t index,
+                       const RuntimeRef<StorageCell> &value)
+    {
+      if (stride == 2)
+      {
+        node->opaqueRefs[index * 2 + 1] = clone_runtime_storage_cell(value, StorageClass::TEMPORARY);
+      }
+    }
+
+    /**
+     * Inserts `key` into the subtree of a node that is not full, splitting full nodes on the way down,
+     * or replaces the value of an equal key.
+     *
+     * @return Whether the key was new.
+     */
+    auto insert_nonfull(RuntimeRef<StorageCell> node, uint32_t stride, const RuntimeRef<StorageCell> &key,
+                        const RuntimeRef<StorageCell> &value) -> bool
+    {
+      Vec<RuntimeRef<StorageCell>> path;
+      while (true)
+      {
+        auto [index, found] = search_node(node, stride, key);
+        if (found)
+        {
+          replace_value(node, stride, index, value);
+          return false;
+        }
+        path.push_back(node);
+        if (is_leaf(node))
+        {
+          Vec<RuntimeRef<StorageCell>> entry{clone_runtime_storage_cell(key, StorageClass::TEMPORARY)};
+          if (stride == 2)
+          {
+            entry.push_back(clone_runtime_storage_cell(value, StorageClass::TEMPORARY));
+          }
+          insert_entry(node, stride, index, entry);
+          for (const auto &visited : path)
+          {
+            auto header = read_header<NodeHeader>(visited);
+            ++header.total;
+            write_header(visited, header);
+          }
+          return true;
+        }
+        if (entry_count(child_at(node, stride, index)) == MAX_ENTRIES)
+        {
+          split_child(node, stride, index);
+          auto order = compare_keys(key_at(node, stride, index), key);
+          if (order == Orders::EQ)
+          {
+            replace_value(node, stride, index, value);
+            return false;
+          }
+          if (order == Orders::LT)
+          {
+            ++index;
+          }
+        }
+        node = child_at(node, stride, index);
+      }
+    }
+
+    /**
+     * Joins child `index + 1` of `node` and the entry between them into child `index`.
+     */
+    void merge_children(const RuntimeRef<StorageCell> &node, uint32_t stride, uint32_t index)
+    {
+      auto left = child_at(node, stride, index);
+      auto right = child_at(node, stride, index + 1);
+      auto leftCount = entry_count(left);
+      auto rightCount = entry_count(right);
+      auto separator = entry_cells(node, stride, index);
+
+      auto leftChildren = left->opaqueRefs.begin() + static_cast<ptrdiff_t>(leftCount * stride);
+      Vec<RuntimeRef<StorageCell>> merged(left->opaqueRefs.begin(), leftChildren);
+      merged.insert(merged.end(), separator.begin(), separator.end());
+      auto rightChildren = right->opaqueRefs.begin() + static_cast<ptrdiff_t>(rightCount * stride);
+      merged.insert(merged.end(), right->opaqueRefs.begin(), rightChildren);
+      merged.insert(merged.end(), leftChildren, left->opaqueRefs.end());
+      merged.insert(merged.end(), rightChildren, right->opaqueRefs.end());
+      left->opaqueRefs = std::move(merged);
+      set_entry_count(left, leftCount + rightCount + 1);
+      recount(left, stride);
+
+      erase_entry(node, stride, index);
+      erase_child(node, stride, index + 1);
+    }
+
+    /**
+     * Moves the last entry of child `index` up into `node` and the entry it replaces down into child
+     * `index + 1`.
+     */
+    void rotate_right(const RuntimeRef<StorageCell> &node, uint32_t stride, uint32_t index)
+    {
+      auto left = child_at(node, stride, index);
+      auto right = child_at(node, stride, index + 1);
+      auto last = entry_count(left) - 1;
+      insert_entry(right, stride, 0, entry_cells(node, stride, index));
+      if (!is_leaf(left))
+      {
+        auto moved = child_at(left, stride, last + 1);
+        erase_child(left, stride, last + 1);
+        insert_child(right, stride, 0, std::move(moved));
+      }
+      auto raised = entry_cells(left, stride, last);
+      std::ranges::copy(raised, node->opaqueRefs.begin() + static_cast<ptrdiff_t>(index * stride));
+      erase_entry(left, stride, last);
+      recount(left, stride);
+      recount(right, stride);
+    }
+
+    /**
+     * Moves the first entry of child `index + 1` up into `node` and the entry it replaces down into child
+     * `index`.
+     */
+    void rotate_left(const RuntimeRef<StorageCell> &node, uint32_t stride, uint32_t index)
+    {
+      auto left = child_at(node, stride, index);
+      auto right = child_at(node, stride, index + 1);
+      insert_entry(left, stride, entry_count(left), entry_cells(node, stride, index));
+      if (!is_leaf(right))
+      {
+        auto moved = child_at(right, stride, 0);
+        erase_child(right, stride, 0);
+        insert_child(left, stride, entry_count(left), std::move(moved));
+      }
+      auto raised = entry_cells(right, stride, 0);
+      std::ranges::copy(raised, node->opaqueRefs.begin() + static_cast<ptrdiff_t>(index * stride));
+      erase_entry(right, stride, 0);
+      recount(left, stride);
+      recount(right, stride);
+    }
+
+    /**
+     * Removes a present key from the subtree of `node`, which is the root or holds at least
+     * MIN_DEGREE entries, so every node on the way down can give one up.
+     */
+    void remove_present(const RuntimeRef<StorageCell> &node, uint32_t stride, const RuntimeRef<StorageCell> &key)
+    {
+      auto [index, found] = search_node(node, stride, key);
+      if (is_leaf(node))
+      {
+        erase_entry(node, stride, index);
+      }
+      else if (found)
+      {
+        auto left = child_at(node, stride, index);
+        auto right = child_at(node, stride, index + 1);
+        if (entry_count(left) >= MIN_DEGREE)
+        {
+          // Replace the key by its predecessor, then remove that from the left subtree.
+          auto [holder, at] = locate(left, stride, subtree_size(left) - 1);
+          auto predecessor = entry_cells(holder, stride, at);
+          std::ranges::copy(predecessor, node->opaqueRefs.begin() + static_cast<ptrdiff_t>(index * stride));
+          remove_present(left, stride, predecessor.front());
+        }
+        else if (entry_count(right) >= MIN_DEGREE)
+        {
+          auto [holder, at] = locate(right, stride, 0);
+          auto successor = entry_cells(holder, stride, at);
+          std::ranges::copy(successor, node->opaqueRefs.begin() + static_cast<ptrdiff_t>(index * stride));
+          remove_present(right, stride, successor.front());
+        }
+        else
+        {
+          merge_children(node, stride, index);
+          remove_present(child_at(node, stride, index), stride, key);
+        }
+      }
+      else
+      {
+        if (entry_count(child_at(node, stride, index)) < MIN_DEGREE)
+        {
+          auto count = entry_count(node);
+          if (index > 0 && entry_count(child_at(node, stride, index - 1)) >= MIN_DEGREE)
+          {
+            rotate_right(node, stride, index - 1);
+          }
+          else if (index < count && entry_count(child_at(node, stride, index + 1)) >= MIN_DEGREE)
+          {
+            rotate_left(node, stride, index);
+          }
+          else if (index < count)
+          {
+            merge_children(node, stride, index);
+          }
+          else
+          {
+            merge_children(node, stride, --index);
+          }
+        }
+        remove_present(child_at(node, stride, index), stride, key);
+      }
+      recount(node, stride);
+    }
+
+    /**
+     * Returns the root of `cell` for a change, copying the nodes first while a range shares them.
+     */
+    auto mutable_root(const RuntimeRef<StorageCell> &cell) -> RuntimeRef<StorageCell> &
+    {
+      auto &root = cell->opaqueRefs.front();
+      if (root.use_count() > 1)
+      {
+        root = clone_runtime_storage_cell(root, StorageClass::TEMPORARY);
+      }
+      return root;
+    }
+
+    auto entry_show(const RuntimeRef<StorageCell> &node, uint32_t stride, uint32_t index) -> Str
+    {
+      auto key = runtime_value_show(key_at(node, stride, index));
+      return stride == 2 ? key + ": " + runtime_value_show(node->opaqueRefs[index * 2 + 1]) : key;
+    }
+
+    /**
+     * Shows sorted positions `[start, end)` below `root` as `{k: v, ...}` or `{k, ...}`.
+     */
+    auto show_entries(const RuntimeRef<StorageCell> &root, uint32_t stride, size_t start, size_t end) -> Str
+    {
+      Str result{};
+      for (auto index = start; index < end; ++index)
+      {
+        if (!result.empty())
+        {
+          result += ", ";
+        }
+        auto [node, at] = locate(root, stride, index);
+        result += entry_show(node, stride, at);
+      }
+      return "{" + result + "}";
+    }
+
+    auto entry_key_at(const RuntimeRef<StorageCell> &root, uint32_t stride, size_t index) -> RuntimeRef<StorageCell>
+    {
+      auto [node, at] = locate(root, stride, index);
+      return key_at(node, stride, at);
+    }
+
+    auto entry_value_at(const RuntimeRef<StorageCell> &root, uint32_t stride, size_t index) -> RuntimeRef<StorageCell>
+    {
+      if (stride != 2)
+      {
+        throw RuntimeException("BTree has no values");
+      }
+      auto [node, at] = locate(root, stride, index);
+      return node->opaqueRefs[at * 2 + 1];
+    }
+
+    void require_index(size_t index, size_t size)
+    {
+      if (index >= size)
+      {
+        throw RuntimeException("BTree entry index out of bounds: " + std::to_string(index));
+      }
+    }
+  } // namespace
+
+  auto make_runtime_btree_cell(bool withValues, StorageClass storageClass) -> RuntimeRef<StorageCell>
+  {
+    auto type = btree_runtime_type();
+    auto cell = make_storage_cell(type->layout, storageClass, {}, type);
+    cell->bytes.assign(sizeof(TreeHeader), 0);
+    write_header(cell, TreeHeader{.stride = withValues ? 2U : 1U});
+    cell->opaqueRefs.assign(1, make_node(true));
+    cell->namedRefs.clear();
+    cell->nativeHandles.clear();
+    cell->initialized = true;
+    return cell;
+  }
+
+  auto runtime_is_btree_value(const RuntimeRef<StorageCell> &cell) -> bool
+  {
+    return cell && cell->runtimeType == btree_runtime_type();
+  }
+
+  auto runtime_is_btree_range_value(const RuntimeRef<StorageCell> &cell) -> bool
+  {
+    return cell && cell->runtimeType == btree_range_runtime_type();
+  }
+
+  auto btree_size(const RuntimeRef<StorageCell> &cell) -> size_t
+  {
+    require_tree(cell);
+    return subtree_size(cell->opaqueRefs.front());
+  }
+
+  auto btree_find(const RuntimeRef<StorageCell> &cell, const RuntimeRef<StorageCell> &key) -> std::optional<size_t>
+  {
+    auto header = require_tree(cell);
+    if (auto [rank, found] = rank_in(cell->opaqueRefs.front(), header.stride, key); found)
+    {
+      return rank;
+    }
+    return std::nullopt;
+  }
+
+  auto btree_rank(const RuntimeRef<StorageCell> &cell, const RuntimeRef<StorageCell> &key) -> size_t
+  {
+    auto header = require_tree(cell);
+    return rank_in(cell->opaqueRefs.front(), header.stride, key).first;
+  }
+
+  auto btree_insert(const RuntimeRef<StorageCell> &cell, const RuntimeRef<StorageCell> &key,
+                    const RuntimeRef<StorageCell> &value) -> bool
+  {
+    auto stride = require_tree(cell).stride;
+    auto &root = mutable_root(cell);
+    if (entry_count(root) == MAX_ENTRIES)
+    {
+      auto grown = make_node(false);
+      grown->opaqueRefs.push_back(root);
+      split_child(grown, stride, 0);
+      recount(grown, stride);
+      root = std::move(grown);
+    }
+    return insert_nonfull(root, stride, key, value);
+  }
+
+  auto btree_remove(const RuntimeRef<StorageCell> &cell, const RuntimeRef<StorageCell> &key) -> bool
+  {
+    auto header = require_tree(cell);
+    if (!btree_find(cell, key))
+    {
+      return false;
+    }
+    auto &root = mutable_root(cell);
+    remove_present(root, header.stride, key);
+    if (entry_count(root) == 0 && !is_leaf(root))
+    {
+      root = RuntimeRef<StorageCell>{child_at(root, header.stride, 0)};
+    }
+    return true;
+  }
+
+  void btree_clear(const RuntimeRef<StorageCell> &cell)
+  {
+    require_tree(cell);
+    cell->opaqueRefs.front() = make_node(true);
+  }
+
+  auto btree_key(const RuntimeRef<StorageCell> &cell, size_t index) -> RuntimeRef<StorageCell>
+  {
+    auto header = require_tree(cell);
+    require_index(index, btree_size(cell));
+    return entry_key_at(cell->opaqueRefs.front(), header.stride, index);
+  }
+
+  auto btree_value(const RuntimeRef<StorageCell> &cell, size_t index) -> RuntimeRef<StorageCell>
+  {
+    auto header = require_tree(cell);
+    require_index(index, btree_size(cell));
+    return entry_value_at(cell->opaqueRefs.front(), header.stride, index);
+  }
+
+  auto make_runtime_btree_range_cell(const RuntimeRef<StorageCell> &cell, const RuntimeRef<StorageCell> &low,
+                                     const RuntimeRef<StorageCell> &high) -> RuntimeRef<StorageCell>
+  {
+    auto header = require_tree(cell);
+    auto start = btree_rank(cell, low);
+    auto end = std::max(start, btree_rank(cell, high));
+    auto type = btree_range_runtime_type();
+    auto range = make_storage_cell(type->layout, StorageClass::TEMPORARY, {}, type);
+    range->bytes.assign(sizeof(RangeHeader), 0);
+    write_header(range, RangeHeader{.stride = header.stride, .start = start, .end = end});
+    range->opaqueRefs.assign(1, cell->opaqueRefs.front());
+    range->initialized = true;
+    return range;
+  }
+
+  auto btree_range_size(const RuntimeRef<StorageCell> &range) -> size_t
+  {
+    auto header = require_range(range);
+    return header.end - header.start;
+  }
+
+  auto btree_range_key(const RuntimeRef<StorageCell> &range, size_t index) -> RuntimeRef<StorageCell>
+  {
+    auto header = require_range(range);
+    require_index(index, header.end - header.start);
+    return entry_key_at(range->opaqueRefs.front(), header.stride, header.start + index);
+  }
+
+  auto btree_range_value(const RuntimeRef<StorageCell> &range, size_t index) -> RuntimeRef<StorageCell>
+  {
+    auto header = require_range(range);
+    require_index(index, header.end - header.start);
+    return entry_value_at(range->opaqueRefs.front(), header.stride, header.start + index);
+  }
+
+  auto btree_runtime_type() -> RuntimeRef<NGType>
+  {
+    static RuntimeRef<NGType> btreeType = makert<NGType>(NGType{
+        .name = "BTree",
+        .layout = TypeLayout{.name = "BTree", .kind = LayoutKind::DYNAMIC},
+        .showCellHandler =
+            [](const RuntimeRef<StorageCell> &cell) {
+              auto header = require_tree(cell);
+              return show_entries(cell->opaqueRefs.front(), header.stride, 0, btree_size(cell));
+            },
+        .boolCellHandler =
+            [](const RuntimeRef<StorageCell> &cell) {
+              return btree_size(cell) != 0;
+            },
+        .cellOrderHandler =
+            [](const RuntimeRef<StorageCell> &left, const RuntimeRef<StorageCell> &right) -> Orders {
+              if (!runtime_is_btree_value(right) || btree_size(left) != btree_size(right))
+              {
+                return Orders::UNORDERED;
+              }
+              auto header = require_tree(left);
+              for (size_t index = 0; index < btree_size(left); ++index)
+              {
+                if (!ops::value_equals(btree_key(left, index), btree_key(right, index)) ||
+                    (header.stride == 2 && !ops::value_equals(btree_value(left, index), btree_value(right, index))))
+                {
+                  return Orders::UNORDERED;
+                }
+              }
+              return Orders::EQ;
+            },
+        .hashCellHandler =
+            [](const RuntimeRef<StorageCell> &cell) {
+              auto header = require_tree(cell);
+              uint64_t seed = btree_size(cell);
+              for (size_t index = 0; index < btree_size(cell); ++index)
+              {
+                seed = ops::hash_combine(seed, ops::value_hash(btree_key(cell, index)));
+                if (header.stride == 2)
+                {
+                  seed = ops::hash_combine(seed, ops::value_hash(btree_value(cell, index)));
+                }
+              }
+              return seed;
+            },
+        .sharesOpaqueRefs = true,
+    });
+    return btreeType;
+  }
+
+  auto btree_range_runtime_type() -> RuntimeRef<NGType>
+  {
+    static RuntimeRef<NGType> rangeType = makert<NGType>(NGType{
+        .name = "BTreeRange",
+        .layout = TypeLayout{.name = "BTreeRange", .kind = LayoutKind::DYNAMIC},
+        .showCellHandler =
+            [](const RuntimeRef<StorageCell> &range) {
+              auto header = require_range(range);
+              return show_entries(range->opaqueRefs.front(), header.stride, header.start, header.end);
+            },
+        .boolCellHandler =
+            [](const RuntimeRef<StorageCell> &range) {
+              return btree_range_size(range) != 0;
+            },
+        .sharesOpaqueRefs = true,
+    });
+    return rangeType;
+  }
+} // namespace NG::runtime
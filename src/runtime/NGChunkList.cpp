@@ -0,0 +1,300 @@
+#include <runtime/chunk_list.hpp>
+#include <runtime/value_ops.hpp>
+
+#include <cstring>
+
+namespace NG::runtime
+{
+  namespace
+  {
+    constexpr uint32_t CHUNK_SIZE = 32;
+    /// Free chunk slots added before the first chunk when pushing to the front finds none.
+    constexpr size_t MIN_HEADROOM = 4;
+
+    struct ListHeader
+    {
+      uint64_t size = 0;
+      uint32_t firstChunk = 0; ///< Spine position of the chunk holding the first element.
+      uint32_t front = 0;      ///< Offset of the first element in that chunk.
+    };
+
+    auto read_header(const RuntimeRef<StorageCell> &cell) -> ListHeader
+    {
+      ListHeader header;
+      std::memcpy(&header, cell->bytes.data(), sizeof(header));
+      return header;
+    }
+
+    void write_header(const RuntimeRef<StorageCell> &cell, const ListHeader &header)
+    {
+      std::memcpy(cell->bytes.data(), &header, sizeof(header));
+    }
+
+    auto chunk_list_part_runtime_type() -> RuntimeRef<NGType>
+    {
+      static RuntimeRef<NGType> partType = makert<NGType>(NGType{
+          .name = "ChunkListPart",
+          .layout = TypeLayout{.name = "ChunkListPart", .kind = LayoutKind::DYNAMIC},
+      });
+      return partType;
+    }
+
+    /**
+     * Makes a spine or chunk cell holding `refs`.
+     */
+    auto make_part(Vec<RuntimeRef<StorageCell>> refs) -> RuntimeRef<StorageCell>
+    {
+      auto type = chunk_list_part_runtime_type();
+      auto part = make_storage_cell(type->layout, StorageClass::TEMPORARY, {}, type);
+      part->opaqueRefs = std::move(refs);
+      part->initialized = true;
+      return part;
+    }
+
+    auto require_list(const RuntimeRef<StorageCell> &cell) -> ListHeader
+    {
+      if (!runtime_is_chunk_list_value(cell) || cell->bytes.size() < sizeof(ListHeader) || cell->opaqueRefs.empty())
+      {
+        throw RuntimeException("Expected ChunkList runtime value");
+      }
+      return read_header(cell);
+    }
+
+    auto spine_of(const RuntimeRef<StorageCell> &cell) -> Vec<RuntimeRef<StorageCell>> &
+    {
+      return cell->opaqueRefs.front()->opaqueRefs;
+    }
+
+    /**
+     * Returns the chunk slots of `cell` for a change, copying the spine first while a copy shares it.
+     */
+    auto mutable_spine(const RuntimeRef<StorageCell> &cell) -> Vec<RuntimeRef<StorageCell>> &
+    {
+      auto &spine = cell->opaqueRefs.front();
+      if (spine.use_count() > 1)
+      {
+        spine = make_part(spine->opaqueRefs);
+      }
+      return spine->opaqueRefs;
+    }
+
+    /**
+     * Returns the element slots of chunk `index` for a change, creating or unsharing it as needed.
+     */
+    auto mutable_chunk(Vec<RuntimeRef<StorageCell>> &spine, size_t index) -> Vec<RuntimeRef<StorageCell>> &
+    {
+      if (index >= spine.size())
+      {
+        spine.resize(index + 1);
+      }
+      auto &chunk = spine[index];
+      if (!chunk)
+      {
+        chunk = make_part(Vec<RuntimeRef<StorageCell>>(CHUNK_SIZE));
+      }
+      else if (chunk.use_count() > 1)
+      {
+        chunk = make_part(chunk->opaqueRefs);
+      }
+      return chunk->opaqueRefs;
+    }
+
+    /**
+     * Returns the spine position and chunk offset of element `index`.
+     */
+    auto locate(const ListHeader &header, size_t index) -> std::pair<size_t, uint32_t>
+    {
+      auto position = header.front + index;
+      return {header.firstChunk + position / CHUNK_SIZE, static_cast<uint32_t>(position % CHUNK_SIZE)};
+    }
+
+    auto require_index(const ListHeader &header, size_t index) -> std::pair<size_t, uint32_t>
+    {
+      if (index >= header.size)
+      {
+        throw RuntimeException("List index out of range: " + std::to_string(index));
+      }
+      return locate(header, index);
+    }
+
+    auto stored_copy(const RuntimeRef<StorageCell> &value) -> RuntimeRef<StorageCell>
+    {
+      return clone_runtime_storage_cell(value, StorageClass::TEMPORARY);
+    }
+  } // namespace
+
+  auto make_runtime_chunk_list_cell(StorageClass storageClass) -> RuntimeRef<StorageCell>
+  {
+    auto type = chunk_list_runtime_type();
+    auto cell = make_storage_cell(type->layout, storageClass, {}, type);
+    cell->bytes.assign(sizeof(ListHeader), 0);
+    cell->opaqueRefs.assign(1, make_part({}));
+    cell->namedRefs.clear();
+    cell->nativeHandles.clear();
+    cell->initialized = true;
+    return cell;
+  }
+
+  auto runtime_is_chunk_list_value(const RuntimeRef<StorageCell> &cell) -> bool
+  {
+    return cell && cell->runtimeType == chunk_list_runtime_type();
+  }
+
+  auto chunk_list_size(const RuntimeRef<StorageCell> &cell) -> size_t
+  {
+    return require_list(cell).size;
+  }
+
+  auto chunk_list_get(const RuntimeRef<StorageCell> &cell, size_t index) -> RuntimeRef<StorageCell>
+  {
+    auto [chunk, offset] = require_index(require_list(cell), index);
+    return spine_of(cell)[chunk]->opaqueRefs[offset];
+  }
+
+  void chunk_list_set(const RuntimeRef<StorageCell> &cell, size_t index, const RuntimeRef<StorageCell> &value)
+  {
+    auto [chunk, offset] = require_index(require_list(cell), index);
+    mutable_chunk(mutable_spine(cell), chunk)[offset] = stored_copy(value);
+  }
+
+  void chunk_list_push_front(const RuntimeRef<StorageCell> &cell, const RuntimeRef<StorageCell> &value)
+  {
+    auto header = require_list(cell);
+    auto &spine = mutable_spine(cell);
+    if (header.front == 0)
+    {
+      if (header.firstChunk == 0)
+      {
+        // Doubling the headroom keeps pushes to the front amortized O(1).
+        auto headroom = std::max(spine.size(), MIN_HEADROOM);
+        spine.insert(spine.begin(), headroom, nullptr);
+        header.firstChunk = static_cast<uint32_t>(headroom);
+      }
+      --header.firstChunk;
+      header.front = CHUNK_SIZE;
+    }
+    --header.front;
+    mutable_chunk(spine, header.firstChunk)[header.front] = stored_copy(value);
+    ++header.size;
+    write_header(cell, header);
+  }
+
+  void chunk_list_push_back(const RuntimeRef<StorageCell> &cell, const RuntimeRef<StorageCell> &value)
+  {
+    auto header = require_list(cell);
+    auto [chunk, offset] = locate(header, header.size);
+    mutable_chunk(mutable_spine(cell), chunk)[offset] = stored_copy(value);
+    ++header.size;
+    write_header(cell, header);
+  }
+
+  auto chunk_list_pop_front(const RuntimeRef<StorageCell> &cell) -> RuntimeRef<StorageCell>
+  {
+    auto header = require_list(cell);
+    if (header.size == 0)
+    {
+      throw RuntimeException("popFront() on an empty list");
+    }
+    auto &spine = mutable_spine(cell);
+    auto &slot = mutable_chunk(spine, header.firstChunk)[header.front];
+    auto value = std::move(slot);
+    slot = nullptr;
+    if (--header.size == 0)
+    {
+      header = ListHeader{};
+      spine.clear();
+    }
+    else if (++header.front == CHUNK_SIZE)
+    {
+      spine[header.firstChunk++] = nullptr;
+      header.front = 0;
+      // A queue keeps popping from the front; drop the free slots it leaves once they are most of the spine.
+      if (header.firstChunk > 2 * MIN_HEADROOM && header.firstChunk * 2 > spine.size())
+      {
+        spine.erase(spine.begin(), spine.begin() + header.firstChunk);
+        header.firstChunk = 0;
+      }
+    }
+    write_header(cell, header);
+    return value;
+  }
+
+  auto chunk_list_pop_back(const RuntimeRef<StorageCell> &cell) -> RuntimeRef<StorageCell>
+  {
+    auto header = require_list(cell);
+    if (header.size == 0)
+    {
+      throw RuntimeException("popBack() on an empty list");
+    }
+    auto [chunk, offset] = locate(header, header.size - 1);
+    auto &spine = mutable_spine(cell);
+    auto &slot = mutable_chunk(spine, chunk)[offset];
+    auto value = std::move(slot);
+    slot = nullptr;
+    if (--header.size == 0)
+    {
+      header = ListHeader{};
+      spine.clear();
+    }
+    else if (offset == 0)
+    {
+      spine.resize(chunk);
+    }
+    write_header(cell, header);
+    return value;
+  }
+
+  void chunk_list_clear(const RuntimeRef<StorageCell> &cell)
+  {
+    require_list(cell);
+    write_header(cell, ListHeader{});
+    cell->opaqueRefs.front() = make_part({});
+  }
+
+  auto chunk_list_runtime_type() -> RuntimeRef<NGType>
+  {
+    static RuntimeRef<NGType> listType = makert<NGType>(NGType{
+        .name = "ChunkList",
+        .layout = TypeLayout{.name = "ChunkList", .kind = LayoutKind::DYNAMIC},
+        .showCellHandler =
+            [](const RuntimeRef<StorageCell> &cell) {
+              Str result{};
+              for (size_t index = 0; index < chunk_list_size(cell); ++index)
+              {
+                result += (index == 0 ? "" : ", ") + runtime_value_show(chunk_list_get(cell, index));
+              }
+              return "[" + result + "]";
+            },
+        .boolCellHandler =
+            [](const RuntimeRef<StorageCell> &cell) {
+              return chunk_list_size(cell) != 0;
+            },
+        .cellOrderHandler =
+            [](const RuntimeRef<StorageCell> &left, const RuntimeRef<StorageCell> &right) -> Orders {
+              if (!runtime_is_chunk_list_value(right) || chunk_list_size(left) != chunk_list_size(right))
+              {
+                return Orders::UNORDERED;
+              }
+              for (size_t index = 0; index < chunk_list_size(left); ++index)
+              {
+                if (!ops::value_equals(chunk_list_get(left, index), chunk_list_get(right, index)))
+                {
+                  return Orders::UNORDERED;
+                }
+              }
+              return Orders::EQ;
+            },
+        .hashCellHandler =
+            [](const RuntimeRef<StorageCell> &cell) {
+              uint64_t seed = chunk_list_size(cell);
+              for (size_t index = 0; index < chunk_list_size(cell); ++index)
+              {
+                seed = ops::hash_combine(seed, ops::value_hash(chunk_list_get(cell, index)));
+              }
+              return seed;
+            },
+        .sharesOpaqueRefs = true,
+    });
+    return listType;
+  }
+} // namespace NG::runtime
@@ -0,0 +1,432 @@
+#include <runtime/hash_table.hpp>
+#include <runtime/value_ops.hpp>
+
+#include <algorithm>
+#include <bit>
+#include <cstring>
+#include <limits>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+namespace NG::runtime
+{
+  namespace
+  {
+    constexpr size_t GROUP_WIDTH = 16;
+    constexpr uint8_t CONTROL_EMPTY = 0x80;
+    constexpr uint8_t CONTROL_DELETED = 0xFE;
+
+    /**
+     * The fixed part of a table's `bytes`; control bytes and then entry indices follow it.
+     */
+    struct TableHeader
+    {
+      uint32_t stride = 1;     ///< Cells per entry: 2 for maps, 1 for sets.
+      uint32_t capacity = 0;   ///< Slots in the index, zero or a power of two of at least GROUP_WIDTH.
+      uint32_t tombstones = 0; ///< Deleted slots, which still lengthen probes.
+      uint32_t reserved = 0;
+    };
+
+    auto read_header(const RuntimeRef<StorageCell> &cell) -> TableHeader
+    {
+      TableHeader header;
+      std::memcpy(&header, cell->bytes.data(), sizeof(header));
+      return header;
+    }
+
+    void write_header(const RuntimeRef<StorageCell> &cell, const TableHeader &header)
+    {
+      std::memcpy(cell->bytes.data(), &header, sizeof(header));
+    }
+
+    auto controls(const RuntimeRef<StorageCell> &cell) -> uint8_t *
+    {
+      return cell->bytes.data() + sizeof(TableHeader);
+    }
+
+    auto read_index(const RuntimeRef<StorageCell> &cell, size_t capacity, size_t slot) -> uint32_t
+    {
+      uint32_t index = 0;
+      std::memcpy(&index, controls(cell) + capacity + slot * sizeof(uint32_t), sizeof(index));
+      return index;
+    }
+
+    void write_index(const RuntimeRef<StorageCell> &cell, size_t capacity, size_t slot, uint32_t index)
+    {
+      std::memcpy(controls(cell) + capacity + slot * sizeof(uint32_t), &index, sizeof(index));
+    }
+
+    /**
+     * Returns a bit per control byte of the group at `group` that equals `value`.
+     */
+    auto match_group(const uint8_t *group, uint8_t value) -> uint32_t
+    {
+#if defined(__SSE2__)
+      auto bytes = _mm_loadu_si128(reinterpret_cast<const __m128i *>(group));
+      return static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(bytes, _mm_set1_epi8(static_cast<char>(value)))));
+#else
+      uint32_t mask = 0;
+      for (size_t i = 0; i < GROUP_WIDTH; ++i)
+      {
+        mask |= static_cast<uint32_t>(group[i] == value) << i;
+      }
+      return mask;
+#endif
+    }
+
+    /**
+     * Returns a bit per empty or deleted control byte; both have the top bit set.
+     */
+    auto match_free(const uint8_t *group) -> uint32_t
+    {
+#if defined(__SSE2__)
+      return static_cast<uint32_t>(_mm_movemask_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i *>(group))));
+#else
+      uint32_t mask = 0;
+      for (size_t i = 0; i < GROUP_WIDTH; ++i)
+      {
+        mask |= static_cast<uint32_t>(group[i] >> 7U) << i;
+      }
+      return mask;
+#endif
+    }
+
+    auto control_tag(uint64_t hash) -> uint8_t
+    {
+      return static_cast<uint8_t>(hash & 0x7FU);
+    }
+
+    /**
+     * Visits the groups of the probe sequence for `hash` (triangular, so it covers every group) until
+     * `visit(base)` returns true.
+     */
+    template <class Visit>
+    void probe(size_t capacity, uint64_t hash, Visit &&visit)
+    {
+      auto groupMask = capacity / GROUP_WIDTH - 1;
+      auto group = static_cast<size_t>(hash >> 7U) & groupMask;
+      for (size_t step = 1; step <= groupMask + 1; ++step)
+      {
+        if (visit(group * GROUP_WIDTH))
+        {
+          return;
+        }
+        group = (group + step) & groupMask;
+      }
+    }
+
+    auto require_table(const RuntimeRef<StorageCell> &cell) -> TableHeader
+    {
+      if (!runtime_is_hash_table_value(cell) || cell->bytes.size() < sizeof(TableHeader))
+      {
+        throw RuntimeException("Expected HashTable runtime value");
+      }
+      return read_header(cell);
+    }
+
+    auto entry_key(const RuntimeRef<StorageCell> &cell, const TableHeader &header, size_t index)
+        -> const RuntimeRef<StorageCell> &
+    {
+      return cell->opaqueRefs[index * header.stride];
+    }
+
+    /**
+     * Returns the slot holding `key`, if any.
+     */
+    auto find_slot(const RuntimeRef<StorageCell> &cell, const TableHeader &header, const RuntimeRef<StorageCell> &key,
+                   uint64_t hash) -> std::optional<size_t>
+    {
+      if (header.capacity == 0)
+      {
+        return std::nullopt;
+      }
+      std::optional<size_t> found;
+      const auto *control = controls(cell);
+      probe(header.capacity, hash, [&](size_t base) {
+        for (auto matches = match_group(control + base, control_tag(hash)); matches != 0; matches &= matches - 1)
+        {
+          auto slot = base + static_cast<size_t>(std::countr_zero(matches));
+          if (ops::value_equals(entry_key(cell, header, read_index(cell, header.capacity, slot)), key))
+          {
+            found = slot;
+            return true;
+          }
+        }
+        return match_group(control + base, CONTROL_EMPTY) != 0;
+      });
+      return found;
+    }
+
+    /**
+     * Returns the first empty or deleted slot on the probe sequence for `hash`.
+     */
+    auto free_slot(const RuntimeRef<StorageCell> &cell, size_t capacity, uint64_t hash) -> size_t
+    {
+      size_t found = 0;
+      const auto *control = controls(cell);
+      probe(capacity, hash, [&](size_t base) {
+        if (auto free = match_free(control + base); free != 0)
+        {
+          found = base + static_cast<size_t>(std::countr_zero(free));
+          return true;
+        }
+        return false;
+      });
+      return found;
+    }
+
+    /**
+     * Rebuilds the index with `capacity` slots, dropping tombstones.
+     */
+    void rehash(const RuntimeRef<StorageCell> &cell, TableHeader header, size_t capacity)
+    {
+      header.capacity = static_cast<uint32_t>(capacity);
+      header.tombstones = 0;
+      cell->bytes.assign(sizeof(TableHeader) + capacity * (1 + sizeof(uint32_t)), 0);
+      std::memset(controls(cell), CONTROL_EMPTY, capacity);
+      write_header(cell, header);
+      auto size = cell->opaqueRefs.size() / header.stride;
+      for (size_t index = 0; index < size; ++index)
+      {
+        auto hash = ops::value_hash(entry_key(cell, header, index));
+        auto slot = free_slot(cell, capacity, hash);
+        controls(cell)[slot] = control_tag(hash);
+        write_index(cell, capacity, slot, static_cast<uint32_t>(index));
+      }
+    }
+
+    /**
+     * Keeps the index at most 7/8 full, counting tombstones, once `entries` entries are stored.
+     */
+    void ensure_capacity(const RuntimeRef<StorageCell> &cell, TableHeader header, size_t entries)
+    {
+      if (entries + header.tombstones <= header.capacity / 8 * 7)
+      {
+        return;
+      }
+      size_t capacity = std::max<size_t>(header.capacity, GROUP_WIDTH);
+      while (entries > capacity / 8 * 7)
+      {
+        capacity *= 2;
+      }
+      if (capacity > std::numeric_limits<uint32_t>::max())
+      {
+        throw RuntimeException("HashTable capacity overflow");
+      }
+      rehash(cell, header, capacity);
+    }
+
+    auto entry_show(const RuntimeRef<StorageCell> &cell, const TableHeader &header, size_t index) -> Str
+    {
+      auto key = runtime_value_show(entry_key(cell, header, index));
+      return header.stride == 2 ? key + ": " + runtime_value_show(cell->opaqueRefs[index * 2 + 1]) : key;
+    }
+  } // namespace
+
+  auto make_runtime_hash_table_cell(bool withValues, StorageClass storageClass) -> RuntimeRef<StorageCell>
+  {
+    auto type = hash_table_runtime_type();
+    auto cell = make_storage_cell(type->layout, storageClass, {}, type);
+    cell->bytes.assign(sizeof(TableHeader), 0);
+    write_header(cell, TableHeader{.stride = withValues ? 2U : 1U});
+    cell->opaqueRefs.clear();
+    cell->namedRefs.clear();
+    cell->nativeHandles.clear();
+    cell->initialized = true;
+    return cell;
+  }
+
+  auto runtime_is_hash_table_value(const RuntimeRef<StorageCell> &cell) -> bool
+  {
+    return cell && cell->runtimeType == hash_table_runtime_type();
+  }
+
+  auto hash_table_size(const RuntimeRef<StorageCell> &cell) -> size_t
+  {
+    return cell->opaqueRefs.size() / require_table(cell).stride;
+  }
+
+  auto hash_table_find(const RuntimeRef<StorageCell> &cell, const RuntimeRef<StorageCell> &key)
+      -> std::optional<size_t>
+  {
+    auto header = require_table(cell);
+    if (auto slot = find_slot(cell, header, key, ops::value_hash(key)))
+    {
+      return read_index(cell, header.capacity, *slot);
+    }
+    return std::nullopt;
+  }
+
+  auto hash_table_insert(const RuntimeRef<StorageCell> &cell, const RuntimeRef<StorageCell> &key,
+                         const RuntimeRef<StorageCell> &value) -> bool
+  {
+    auto header = require_table(cell);
+    auto hash = ops::value_hash(key);
+    if (auto slot = find_slot(cell, header, key, hash))
+    {
+      if (header.stride == 2)
+      {
+        auto index = read_index(cell, header.capacity, *slot);
+        cell->opaqueRefs[index * 2 + 1] = clone_runtime_storage_cell(value, StorageClass::TEMPORARY);
+      }
+      return false;
+    }
+    auto size = cell->opaqueRefs.size() / header.stride;
+    ensure_capacity(cell, header, size + 1);
+    header = read_header(cell);
+    auto slot = free_slot(cell, header.capacity, hash);
+    if (controls(cell)[slot] == CONTROL_DELETED)
+    {
+      --header.tombstones;
+      write_header(cell, header);
+    }
+    controls(cell)[slot] = control_tag(hash);
+    write_index(cell, header.capacity, slot, static_cast<uint32_t>(size));
+    cell->opaqueRefs.push_back(clone_runtime_storage_cell(key, StorageClass::TEMPORARY));
+    if (header.stride == 2)
+    {
+      cell->opaqueRefs.push_back(clone_runtime_storage_cell(value, StorageClass::TEMPORARY));
+    }
+    return true;
+  }
+
+  auto hash_table_remove(const RuntimeRef<StorageCell> &cell, const RuntimeRef<StorageCell> &key) -> bool
+  {
+    auto header = require_table(cell);
+    auto slot = find_slot(cell, header, key, ops::value_hash(key));
+    if (!slot)
+    {
+      return false;
+    }
+    auto index = read_index(cell, header.capacity, *slot);
+    controls(cell)[*slot] = CONTROL_DELETED;
+    ++header.tombstones;
+    write_header(cell, header);
+
+    auto last = cell->opaqueRefs.size() / header.stride - 1;
+    if (index != last)
+    {
+      // Move the last entry into the hole and repoint its slot.
+      auto lastHash = ops::value_hash(entry_key(cell, header, last));
+      const auto *control = controls(cell);
+      probe(header.capacity, lastHash, [&](size_t base) {
+        for (auto matches = match_group(control + base, control_tag(lastHash)); matches != 0; matches &= matches - 1)
+        {
+          auto candidate = base + static_cast<size_t>(std::countr_zero(matches));
+          if (read_index(cell, header.capacity, candidate) == last)
+          {
+            write_index(cell, header.capacity, candidate, index);
+            return true;
+          }
+        }
+        return false;
+      });
+      for (size_t i = 0; i < header.stride; ++i)
+      {
+        cell->opaqueRefs[index * header.stride + i] = std::move(cell->opaqueRefs[last * header.stride + i]);
+      }
+    }
+    cell->opaqueRefs.resize(last * header.stride);
+    return true;
+  }
+
+  void hash_table_clear(const RuntimeRef<StorageCell> &cell)
+  {
+    auto header = require_table(cell);
+    cell->opaqueRefs.clear();
+    rehash(cell, header, header.capacity);
+  }
+
+  void hash_table_reserve(const RuntimeRef<StorageCell> &cell, size_t entries)
+  {
+    ensure_capacity(cell, require_table(cell), entries);
+  }
+
+  auto hash_table_key(const RuntimeRef<StorageCell> &cell, size_t index) -> RuntimeRef<StorageCell>
+  {
+    auto header = require_table(cell);
+    if (index >= cell->opaqueRefs.size() / header.stride)
+    {
+      throw RuntimeException("HashTable entry index out of bounds: " + std::to_string(index));
+    }
+    return entry_key(cell, header, index);
+  }
+
+  auto hash_table_value(const RuntimeRef<StorageCell> &cell, size_t index) -> RuntimeRef<StorageCell>
+  {
+    auto header = require_table(cell);
+    if (header.stride != 2)
+    {
+      throw RuntimeException("HashTable has no values");
+    }
+    if (index >= cell->opaqueRefs.size() / 2)
+    {
+      throw RuntimeException("HashTable entry index out of bounds: " + std::to_string(index));
+    }
+    return cell->opaqueRefs[index * 2 + 1];
+  }
+
+  auto hash_table_runtime_type() -> RuntimeRef<NGType>
+  {
+    static RuntimeRef<NGType> hashTableType = makert<NGType>(NGType{
+        .name = "HashTable",
+        .layout = TypeLayout{.name = "HashTable", .kind = LayoutKind::DYNAMIC},
+        .showCellHandler =
+            [](const RuntimeRef<StorageCell> &cell) {
+              auto header = require_table(cell);
+              Str result{};
+              for (size_t index = 0; index < cell->opaqueRefs.size() / header.stride; ++index)
+              {
+                if (!result.empty())
+                {
+                  result += ", ";
+                }
+                result += entry_show(cell, header, index);
+              }
+              return "{" + result + "}";
+            },
+        .boolCellHandler =
+            [](const RuntimeRef<StorageCell> &cell) {
+              return !cell->opaqueRefs.empty();
+            },
+        .cellOrderHandler =
+            [](const RuntimeRef<StorageCell> &left, const RuntimeRef<StorageCell> &right) -> Orders {
+              // Tables are unordered; equal ones hold equal entries in any order.
+              if (!runtime_is_hash_table_value(right) || hash_table_size(left) != hash_table_size(right))
+              {
+                return Orders::UNORDERED;
+              }
+              auto header = require_table(left);
+              for (size_t index = 0; index < hash_table_size(left); ++index)
+              {
+                auto found = hash_table_find(right, entry_key(left, header, index));
+                if (!found || (header.stride == 2 &&
+                               !ops::value_equals(hash_table_value(left, index), hash_table_value(right, *found))))
+                {
+                  return Orders::UNORDERED;
+                }
+              }
+              return Orders::EQ;
+            },
+        .hashCellHandler =
+            [](const RuntimeRef<StorageCell> &cell) {
+              // Entries hash alike in any order, so their hashes are combined with a commutative sum.
+              auto header = require_table(cell);
+              uint64_t entries = 0;
+              for (size_t index = 0; index < hash_table_size(cell); ++index)
+              {
+                auto entry = ops::value_hash(entry_key(cell, header, index));
+                if (header.stride == 2)
+                {
+                  entry = ops::hash_combine(entry, ops::value_hash(hash_table_value(cell, index)));
+                }
+                entries += entry;
+              }
+              return ops::hash_combine(hash_table_size(cell), entries);
+            },
+    });
+    return hashTableType;
+  }
+} // namespace NG::runtime
@@ -0,0 +1,1080 @@
+#include <runtime/regex.hpp>
+#include <runtime/value_access.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cctype>
+#include <cstring>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <optional>
+
+namespace NG::runtime
+{
+  namespace
+  {
+    constexpr size_t REGEX_CACHE_CAPACITY = 64;
+    constexpr uint32_t MAX_REPEAT_COUNT = 1000;
+    constexpr size_t MAX_PROGRAM_SIZE = 100000;
+    constexpr size_t MAX_NESTING_DEPTH = 1000;
+
+    using ByteSet = std::array<uint64_t, 4>;
+
+    void add_byte(ByteSet &set, uint8_t byte)
+    {
+      set[byte >> 6] |= uint64_t{1} << (byte & 63);
+    }
+
+    void add_range(ByteSet &set, uint8_t low, uint8_t high)
+    {
+      for (unsigned byte = low; byte <= high; ++byte)
+      {
+        add_byte(set, static_cast<uint8_t>(byte));
+      }
+    }
+
+    auto has_byte(const ByteSet &set, uint8_t byte) -> bool
+    {
+      return (set[byte >> 6] >> (byte & 63)) & 1;
+    }
+
+    auto inverted(ByteSet set) -> ByteSet
+    {
+      for (auto &word : set)
+      {
+        word = ~word;
+      }
+      return set;
+    }
+
+    auto is_word_byte(char c) -> bool
+    {
+      return std::isalnum(static_cast<unsigned char>(c)) || c == '_';
+    }
+
+    enum class RegexOp : uint8_t
+    {
+      Char,
+      Class,
+      Split, ///< Continues at `x`, then at `y` with lower priority.
+      Jump,
+      Save,
+      Begin,
+      End,
+      WordBoundary,
+      NotWordBoundary,
+      Match,
+    };
+
+    struct RegexInst
+    {
+      RegexOp op = RegexOp::Match;
+      uint8_t byte = 0;
+      uint16_t unused = 0;
+      uint32_t x = 0; ///< Class index, jump target or capture slot.
+      uint32_t y = 0;
+    };
+
+    /*
+     * A program cell's bytes are this header, the byte sets of its classes, its instructions and the
+     * literal every match starts with, which lets a search skip to candidate positions with `find`.
+     */
+    struct ProgramHeader
+    {
+      uint32_t instCount = 0;
+      uint32_t classCount = 0;
+      uint32_t groupCount = 0;
+      uint32_t prefixSize = 0;
+      uint32_t anchored = 0;
+      uint32_t unused = 0;
+    };
+
+    struct ProgramView
+    {
+      ProgramHeader header;
+      const ByteSet *classes = nullptr;
+      const RegexInst *insts = nullptr;
+      std::string_view prefix;
+    };
+
+    struct RegexNode
+    {
+      enum class Kind : uint8_t
+      {
+        Empty,
+        Char,
+        Class,
+        Begin,
+        End,
+        WordBoundary,
+        NotWordBoundary,
+        Group,
+        Concat,
+        Alternate,
+        Repeat,
+      };
+
+      Kind kind = Kind::Empty;
+      uint8_t byte = 0;
+      ByteSet set{};
+      int32_t group = -1; ///< Capture group number, or -1 for `(?:...)`.
+      uint32_t min = 0;
+      uint32_t max = 0;
+      bool unbounded = false;
+      bool greedy = true;
+      Vec<std::unique_ptr<RegexNode>> children;
+    };
+
+    auto make_node(RegexNode::Kind kind) -> std::unique_ptr<RegexNode>
+    {
+      auto node = std::make_unique<RegexNode>();
+      node->kind = kind;
+      return node;
+    }
+
+    class RegexParser
+    {
+    public:
+      explicit RegexParser(std::string_view pattern) : pattern(pattern) {}
+
+      auto parse() -> std::unique_ptr<RegexNode>
+      {
+        auto root = parse_alternation(0);
+        if (pos < pattern.size())
+        {
+          fail("unmatched ')'");
+        }
+        return root;
+      }
+
+      uint32_t groupCount = 0;
+
+    private:
+      std::string_view pattern;
+      size_t pos = 0;
+
+      [[noreturn]] void fail(const Str &message) const
+      {
+        throw RuntimeException("Invalid regex '" + Str(pattern) + "': " + message);
+      }
+
+      auto at(char c) const -> bool
+      {
+        return pos < pattern.size() && pattern[pos] == c;
+      }
+
+      auto parse_alternation(size_t depth) -> std::unique_ptr<RegexNode>
+      {
+        if (depth > MAX_NESTING_DEPTH)
+        {
+          fail("groups are nested too deeply");
+        }
+        auto first = parse_concat(depth);
+        if (!at('|'))
+        {
+          return first;
+        }
+        auto node = make_node(RegexNode::Kind::Alternate);
+        node->children.push_back(std::move(first));
+        while (at('|'))
+        {
+          ++pos;
+          node->children.push_back(parse_concat(depth));
+        }
+        return node;
+      }
+
+      auto parse_concat(size_t depth) -> std::unique_ptr<RegexNode>
+      {
+        auto node = make_node(RegexNode::Kind::Concat);
+        while (pos < pattern.size() && !at('|') && !at(')'))
+        {
+          node->children.push_back(parse_repeat(depth));
+        }
+        if (node->children.size() == 1)
+        {
+          return std::move(node->children.front());
+        }
+        return node;
+      }
+
+      auto parse_count() -> std::optional<uint32_t>
+      {
+        if (pos >= pattern.size() || !std::isdigit(static_cast<unsigned char>(pattern[pos])))
+        {
+          return std::nullopt;
+        }
+        uint64_t count = 0;
+        while (pos < pattern.size() && std::isdigit(static_cast<unsigned char>(pattern[pos])))
+        {
+          count = std::min<uint64_t>(count * 10 + static_cast<uint64_t>(pattern[pos++] - '0'), MAX_REPEAT_COUNT + 1);
+        }
+        if (count > MAX_REPEAT_COUNT)
+        {
+          fail("repetition count is larger than " + std::to_string(MAX_REPEAT_COUNT));
+        }
+        return static_cast<uint32_t>(count);
+      }
+
+      auto parse_repeat(size_t depth) -> std::unique_ptr<RegexNode>
+      {
+        auto atom = parse_atom(depth);
+        if (pos >= pattern.size())
+        {
+          return atom;
+        }
+        auto node = make_node(RegexNode::Kind::Repeat);
+        switch (pattern[pos])
+        {
+        case '*':
+          node->unbounded = true;
+          break;
+        case '+':
+          node->min = 1;
+          node->unbounded = true;
+          break;
+        case '?':
+          node->max = 1;
+          break;
+        case '{':
+        {
+          ++pos;
+          auto min = parse_count();
+          if (!min)
+          {
+            fail("invalid repetition");
+          }
+          node->min = *min;
+          node->max = *min;
+          if (at(','))
+          {
+            ++pos;
+            auto max = parse_count();
+            node->unbounded = !max;
+            node->max = max.value_or(0);
+          }
+          if (!at('}') || (!node->unbounded && node->max < node->min))
+          {
+            fail("invalid repetition");
+          }
+          break;
+        }
+        default:
+          return atom;
+        }
+        ++pos;
+        if (at('?'))
+        {
+          node->greedy = false;
+          ++pos;
+        }
+        if (atom->kind == RegexNode::Kind::Begin || atom->kind == RegexNode::Kind::End ||
+            atom->kind == RegexNode::Kind::WordBoundary || atom->kind == RegexNode::Kind::NotWordBoundary ||
+            (pos < pattern.size() && std::string_view("*+?{").find(pattern[pos]) != std::string_view::npos))
+        {
+          fail("nothing to repeat");
+        }
+        node->children.push_back(std::move(atom));
+        return node;
+      }
+
+      auto parse_atom(size_t depth) -> std::unique_ptr<RegexNode>
+      {
+        char c = pattern[pos++];
+        switch (c)
+        {
+        case '(':
+        {
+          auto node = make_node(RegexNode::Kind::Group);
+          if (at('?'))
+          {
+            if (pos + 1 >= pattern.size() || pattern[pos + 1] != ':')
+            {
+              fail("lookaround and named groups are not supported");
+            }
+            pos += 2;
+          }
+          else
+          {
+            node->group = static_cast<int32_t>(++groupCount);
+          }
+          node->children.push_back(parse_alternation(depth + 1));
+          if (!at(')'))
+          {
+            fail("missing ')'");
+          }
+          ++pos;
+          return node;
+        }
+        case '[':
+          return parse_class();
+        case '.':
+        {
+          auto node = make_node(RegexNode::Kind::Class);
+          node->set = inverted(ByteSet{});
+          node->set[0] &= ~((uint64_t{1} << '\n') | (uint64_t{1} << '\r'));
+          return node;
+        }
+        case '^':
+          return make_node(RegexNode::Kind::Begin);
+        case '$':
+          return make_node(RegexNode::Kind::End);
+        case '\\':
+          return parse_escape();
+        case '*':
+        case '+':
+        case '?':
+        case '{':
+          fail("nothing to repeat");
+        default:
+        {
+          auto node = make_node(RegexNode::Kind::Char);
+          node->byte = static_cast<uint8_t>(c);
+          return node;
+        }
+        }
+      }
+
+      /**
+       * Returns the byte set of `\d`, `\w` or `\s` and their negations, or nothing for other escapes.
+       */
+      static auto class_escape(char c) -> std::optional<ByteSet>
+      {
+        ByteSet set{};
+        switch (std::tolower(static_cast<unsigned char>(c)))
+        {
+        case 'd':
+          add_range(set, '0', '9');
+          break;
+        case 'w':
+          add_range(set, '0', '9');
+          add_range(set, 'A', 'Z');
+          add_range(set, 'a', 'z');
+          add_byte(set, '_');
+          break;
+        case 's':
+          for (char space : Str(" \t\n\v\f\r"))
+          {
+            add_byte(set, static_cast<uint8_t>(space));
+          }
+          break;
+        default:
+          return std::nullopt;
+        }
+        return std::isupper(static_cast<unsigned char>(c)) ? inverted(set) : set;
+      }
+
+      auto hex_digit() -> uint8_t
+      {
+        if (pos >= pattern.size() || !std::isxdigit(static_cast<unsigned char>(pattern[pos])))
+        {
+          fail("\\x needs two hex digits");
+        }
+        char c = static_cast<char>(std::tolower(static_cast<unsigned char>(pattern[pos++])));
+        return static_cast<uint8_t>(std::isdigit(static_cast<unsigned char>(c)) ? c - '0' : c - 'a' + 10);
+      }
+
+      auto escaped_byte(char c) -> uint8_t
+      {
+        switch (c)
+        {
+        case 'n':
+          return '\n';
+        case 'r':
+          return '\r';
+        case 't':
+          return '\t';
+        case 'f':
+          return '\f';
+        case 'v':
+          return '\v';
+        case '0':
+          return 0;
+        case 'x':
+        {
+          auto high = hex_digit();
+          return static_cast<uint8_t>(high * 16 + hex_digit());
+        }
+        default:
+          if (std::isdigit(static_cast<unsigned char>(c)))
+          {
+            fail("backreferences are not supported");
+          }
+          if (std::isalpha(static_cast<unsigned char>(c)))
+          {
+            fail(Str("unknown escape \\") + c);
+          }
+          return static_cast<uint8_t>(c);
+        }
+      }
+
+      auto parse_escape() -> std::unique_ptr<RegexNode>
+      {
+        if (pos >= pattern.size())
+        {
+          fail("trailing backslash");
+        }
+        char c = pattern[pos++];
+        if (auto set = class_escape(c))
+        {
+          auto node = make_node(RegexNode::Kind::Class);
+          node->set = *set;
+          return node;
+        }
+        if (c == 'b' || c == 'B')
+        {
+          return make_node(c == 'b' ? RegexNode::Kind::WordBoundary : RegexNode::Kind::NotWordBoundary);
+        }
+        auto node = make_node(RegexNode::Kind::Char);
+        node->byte = escaped_byte(c);
+        return node;
+      }
+
+      /**
+       * Reads one class member after the `[`: a byte, or in `set` the bytes of an escape like `\d`.
+       */
+      auto class_member(ByteSet &set) -> std::optional<uint8_t>
+      {
+        char c = pattern[pos++];
+        if (c != '\\')
+        {
+          return static_cast<uint8_t>(c);
+        }
+        if (pos >= pattern.size())
+        {
+          fail("trailing backslash");
+        }
+        c = pattern[pos++];
+        if (auto escape = class_escape(c))
+        {
+          for (size_t i = 0; i < set.size(); ++i)
+          {
+            set[i] |= (*escape)[i];
+          }
+          return std::nullopt;
+        }
+        return c == 'b' ? uint8_t{'\b'} : escaped_byte(c);
+      }
+
+      auto parse_class() -> std::unique_ptr<RegexNode>
+      {
+        auto node = make_node(RegexNode::Kind::Class);
+        bool negated = at('^');
+        pos += negated ? 1 : 0;
+        while (!at(']'))
+        {
+          if (pos >= pattern.size())
+          {
+            fail("missing ']'");
+          }
+          auto low = class_member(node->set);
+          if (!low)
+          {
+            continue;
+          }
+          if (at('-') && pos + 1 < pattern.size() && pattern[pos + 1] != ']')
+          {
+            ++pos;
+            ByteSet escape{};
+            auto high = class_member(escape);
+            if (!high || *high < *low)
+            {
+              fail("invalid class range");
+            }
+            add_range(node->set, *low, *high);
+            continue;
+          }
+          add_byte(node->set, *low);
+        }
+        ++pos;
+        if (negated)
+        {
+          node->set = inverted(node->set);
+        }
+        return node;
+      }
+    };
+
+    class RegexCodegen
+    {
+    public:
+      Vec<RegexInst> insts;
+      Vec<ByteSet> classes;
+
+      auto emit(RegexOp op, uint32_t x = 0, uint32_t y = 0) -> uint32_t
+      {
+        if (insts.size() >= MAX_PROGRAM_SIZE)
+        {
+          throw RuntimeException("Invalid regex: the compiled program is too large");
+        }
+        insts.push_back(RegexInst{.op = op, .x = x, .y = y});
+        return static_cast<uint32_t>(insts.size() - 1);
+      }
+
+      auto here() const -> uint32_t
+      {
+        return static_cast<uint32_t>(insts.size());
+      }
+
+      /**
+       * Points a split at `body` and `skip`, trying the body first if the repetition is greedy.
+       */
+      void patch_split(uint32_t split, uint32_t body, uint32_t skip, bool greedy)
+      {
+        insts[split].x = greedy ? body : skip;
+        insts[split].y = greedy ? skip : body;
+      }
+
+      void compile(const RegexNode &node)
+      {
+        switch (node.kind)
+        {
+        case RegexNode::Kind::Empty:
+          break;
+        case RegexNode::Kind::Char:
+          insts[emit(RegexOp::Char)].byte = node.byte;
+          break;
+        case RegexNode::Kind::Class:
+          classes.push_back(node.set);
+          emit(RegexOp::Class, static_cast<uint32_t>(classes.size() - 1));
+          break;
+        case RegexNode::Kind::Begin:
+          emit(RegexOp::Begin);
+          break;
+        case RegexNode::Kind::End:
+          emit(RegexOp::End);
+          break;
+        case RegexNode::Kind::WordBoundary:
+          emit(RegexOp::WordBoundary);
+          break;
+        case RegexNode::Kind::NotWordBoundary:
+          emit(RegexOp::NotWordBoundary);
+          break;
+        case RegexNode::Kind::Group:
+          if (node.group >= 0)
+          {
+            emit(RegexOp::Save, static_cast<uint32_t>(node.group) * 2);
+          }
+          compile(*node.children.front());
+          if (node.group >= 0)
+          {
+            emit(RegexOp::Save, static_cast<uint32_t>(node.group) * 2 + 1);
+          }
+          break;
+        case RegexNode::Kind::Concat:
+          for (const auto &child : node.children)
+          {
+            compile(*child);
+          }
+          break;
+        case RegexNode::Kind::Alternate:
+        {
+          Vec<uint32_t> jumps;
+          for (size_t i = 0; i + 1 < node.children.size(); ++i)
+          {
+            auto split = emit(RegexOp::Split);
+            compile(*node.children[i]);
+            jumps.push_back(emit(RegexOp::Jump));
+            patch_split(split, split + 1, here(), true);
+          }
+          compile(*node.children.back());
+          for (auto jump : jumps)
+          {
+            insts[jump].x = here();
+          }
+          break;
+        }
+        case RegexNode::Kind::Repeat:
+          compile_repeat(node);
+          break;
+        }
+      }
+
+    private:
+      void compile_repeat(const RegexNode &node)
+      {
+        const auto &child = *node.children.front();
+        if (node.unbounded && node.min > 0)
+        {
+          // x{n,} is n - 1 copies of x followed by x+, which loops back over its last copy.
+          for (uint32_t i = 1; i < node.min; ++i)
+          {
+            compile(child);
+          }
+          auto body = here();
+          compile(child);
+          auto split = emit(RegexOp::Split);
+          patch_split(split, body, split + 1, node.greedy);
+          return;
+        }
+        if (node.unbounded)
+        {
+          auto split = emit(RegexOp::Split);
+          compile(child);
+          emit(RegexOp::Jump, split);
+          patch_split(split, split + 1, here(), node.greedy);
+          return;
+        }
+        for (uint32_t i = 0; i < node.min; ++i)
+        {
+          compile(child);
+        }
+        Vec<uint32_t> splits;
+        for (uint32_t i = node.min; i < node.max; ++i)
+        {
+          splits.push_back(emit(RegexOp::Split));
+          compile(child);
+        }
+        for (auto split : splits)
+        {
+          patch_split(split, split + 1, here(), node.greedy);
+        }
+      }
+    };
+
+    auto regex_program_runtime_type() -> RuntimeRef<NGType>
+    {
+      static RuntimeRef<NGType> programType = makert<NGType>(NGType{
+          .name = "RegexProgram",
+          .layout = TypeLayout{.name = "RegexProgram", .kind = LayoutKind::DYNAMIC},
+      });
+      return programType;
+    }
+
+    auto compile_program(std::string_view pattern) -> RuntimeRef<StorageCell>
+    {
+      RegexParser parser(pattern);
+      auto root = parser.parse();
+      RegexCodegen codegen;
+      codegen.emit(RegexOp::Save, 0);
+      codegen.compile(*root);
+      codegen.emit(RegexOp::Save, 1);
+      codegen.emit(RegexOp::Match);
+
+      ProgramHeader header{
+          .instCount = static_cast<uint32_t>(codegen.insts.size()),
+          .classCount = static_cast<uint32_t>(codegen.classes.size()),
+          .groupCount = parser.groupCount,
+      };
+      Str prefix;
+      size_t pc = 0;
+      while (codegen.insts[pc].op == RegexOp::Save)
+      {
+        ++pc;
+      }
+      header.anchored = codegen.insts[pc].op == RegexOp::Begin ? 1 : 0;
+      for (; codegen.insts[pc].op == RegexOp::Char || codegen.insts[pc].op == RegexOp::Save; ++pc)
+      {
+        if (codegen.insts[pc].op == RegexOp::Char)
+        {
+          prefix.push_back(static_cast<char>(codegen.insts[pc].byte));
+        }
+      }
+      header.prefixSize = static_cast<uint32_t>(prefix.size());
+
+      auto type = regex_program_runtime_type();
+      auto cell = make_storage_cell(type->layout, StorageClass::TEMPORARY, {}, type);
+      auto classBytes = codegen.classes.size() * sizeof(ByteSet);
+      auto instBytes = codegen.insts.size() * sizeof(RegexInst);
+      cell->bytes.resize(sizeof(header) + classBytes + instBytes + prefix.size());
+      auto *data = cell->bytes.data();
+      std::memcpy(data, &header, sizeof(header));
+      std::memcpy(data + sizeof(header), codegen.classes.data(), classBytes);
+      std::memcpy(data + sizeof(header) + classBytes, codegen.insts.data(), instBytes);
+      std::memcpy(data + sizeof(header) + classBytes + instBytes, prefix.data(), prefix.size());
+      cell->initialized = true;
+      return cell;
+    }
+
+    auto program_view(const StorageCell &program) -> ProgramView
+    {
+      ProgramView view;
+      std::memcpy(&view.header, program.bytes.data(), sizeof(view.header));
+      const auto *data = program.bytes.data() + sizeof(view.header);
+      view.classes = reinterpret_cast<const ByteSet *>(data);
+      data += view.header.classCount * sizeof(ByteSet);
+      view.insts = reinterpret_cast<const RegexInst *>(data);
+      data += view.header.instCount * sizeof(RegexInst);
+      view.prefix = std::string_view(reinterpret_cast<const char *>(data), view.header.prefixSize);
+      return view;
+    }
+
+    /**
+     * The threads live at one text position, in priority order, each with its capture slots.
+     */
+    struct ThreadList
+    {
+      Vec<uint32_t> sparse;
+      Vec<uint32_t> dense;
+      size_t visited = 0;
+      Vec<uint32_t> pcs;
+      Vec<int64_t> slots;
+
+      explicit ThreadList(size_t instCount) : sparse(instCount), dense(instCount) {}
+
+      /**
+       * Marks `pc` as reached at this position; returns false if it already was.
+       */
+      auto visit(uint32_t pc) -> bool
+      {
+        if (sparse[pc] < visited && dense[sparse[pc]] == pc)
+        {
+          return false;
+        }
+        sparse[pc] = static_cast<uint32_t>(visited);
+        dense[visited++] = pc;
+        return true;
+      }
+
+      void clear()
+      {
+        visited = 0;
+        pcs.clear();
+        slots.clear();
+      }
+    };
+
+    class PikeVM
+    {
+    public:
+      PikeVM(const ProgramView &program, std::string_view text)
+          : program(program), text(text), slotCount(2 * (program.header.groupCount + 1)),
+            current(program.header.instCount), next(program.header.instCount), scratch(slotCount, -1)
+      {
+      }
+
+      /**
+       * Runs from `from`; with `anyMatch`, stops at the first match found rather than the leftmost-first one.
+       */
+      auto run(size_t from, bool anyMatch) -> Vec<int64_t>
+      {
+        current.clear();
+        next.clear();
+        Vec<int64_t> best;
+        bool anchored = program.header.anchored != 0;
+        for (size_t pos = from;; ++pos)
+        {
+          if (best.empty() && (!anchored || pos == 0))
+          {
+            if (current.pcs.empty() && !program.prefix.empty())
+            {
+              pos = text.find(program.prefix, pos);
+              if (pos == std::string_view::npos)
+              {
+                break;
+              }
+            }
+            std::fill(scratch.begin(), scratch.end(), -1);
+            add_thread(current, 0, pos);
+          }
+          if (current.pcs.empty() && (!best.empty() || (anchored && pos > 0)))
+          {
+            break;
+          }
+          for (size_t i = 0; i < current.pcs.size(); ++i)
+          {
+            const auto &inst = program.insts[current.pcs[i]];
+            const auto *slots = current.slots.data() + i * slotCount;
+            if (inst.op == RegexOp::Match)
+            {
+              best.assign(slots, slots + slotCount);
+              if (anyMatch)
+              {
+                return best;
+              }
+              // Threads after this one have lower priority than the match.
+              break;
+            }
+            if (pos < text.size() && consumes(inst, static_cast<uint8_t>(text[pos])))
+            {
+              std::copy(slots, slots + slotCount, scratch.begin());
+              add_thread(next, current.pcs[i] + 1, pos + 1);
+            }
+          }
+          std::swap(current, next);
+          next.clear();
+          if (pos >= text.size())
+          {
+            break;
+          }
+        }
+        return best;
+      }
+
+    private:
+      struct Pending
+      {
+        int64_t savedValue;
+        uint32_t pcOrSlot;
+        bool restore;
+      };
+
+      const ProgramView &program;
+      std::string_view text;
+      size_t slotCount;
+      ThreadList current;
+      ThreadList next;
+      Vec<int64_t> scratch;
+      Vec<Pending> stack;
+
+      auto consumes(const RegexInst &inst, uint8_t byte) const -> bool
+      {
+        return inst.op == RegexOp::Char ? inst.byte == byte
+                                        : inst.op == RegexOp::Class && has_byte(program.classes[inst.x], byte);
+      }
+
+      auto word_boundary(size_t pos) const -> bool
+      {
+        bool before = pos > 0 && is_word_byte(text[pos - 1]);
+        bool after = pos < text.size() && is_word_byte(text[pos]);
+        return before != after;
+      }
+
+      /**
+       * Follows jumps, splits, saves and assertions from `start` at `pos`, adding the threads that consume
+       * a byte or match to `list` in priority order, each with the capture slots in `scratch` on its path.
+       */
+      void add_thread(ThreadList &list, uint32_t start, size_t pos)
+      {
+        stack.push_back(Pending{.savedValue = 0, .pcOrSlot = start, .restore = false});
+        while (!stack.empty())
+        {
+          auto pending = stack.back();
+          stack.pop_back();
+          if (pending.restore)
+          {
+            scratch[pending.pcOrSlot] = pending.savedValue;
+            continue;
+          }
+          auto pc = pending.pcOrSlot;
+          if (!list.visit(pc))
+          {
+            continue;
+          }
+          const auto &inst = program.insts[pc];
+          switch (inst.op)
+          {
+          case RegexOp::Jump:
+            stack.push_back(Pending{.savedValue = 0, .pcOrSlot = inst.x, .restore = false});
+            break;
+          case RegexOp::Split:
+            stack.push_back(Pending{.savedValue = 0, .pcOrSlot = inst.y, .restore = false});
+            stack.push_back(Pending{.savedValue = 0, .pcOrSlot = inst.x, .restore = false});
+            break;
+          case RegexOp::Save:
+            stack.push_back(Pending{.savedValue = scratch[inst.x], .pcOrSlot = inst.x, .restore = true});
+            scratch[inst.x] = static_cast<int64_t>(pos);
+            stack.push_back(Pending{.savedValue = 0, .pcOrSlot = pc + 1, .restore = false});
+            break;
+          case RegexOp::Begin:
+          case RegexOp::End:
+          case RegexOp::WordBoundary:
+          case RegexOp::NotWordBoundary:
+            if ((inst.op == RegexOp::Begin && pos == 0) || (inst.op == RegexOp::End && pos == text.size()) ||
+                (inst.op == RegexOp::WordBoundary && word_boundary(pos)) ||
+                (inst.op == RegexOp::NotWordBoundary && !word_boundary(pos)))
+            {
+              stack.push_back(Pending{.savedValue = 0, .pcOrSlot = pc + 1, .restore = false});
+            }
+            break;
+          case RegexOp::Char:
+          case RegexOp::Class:
+          case RegexOp::Match:
+            list.pcs.push_back(pc);
+            list.slots.insert(list.slots.end(), scratch.begin(), scratch.end());
+            break;
+          }
+        }
+      }
+    };
+
+    /**
+     * Least recently used programs, keyed by pattern; invalid patterns are not cached.
+     */
+    class RegexProgramCache
+    {
+    public:
+      auto get(std::string_view pattern) -> RuntimeRef<StorageCell>
+      {
+        std::lock_guard lock(mutex);
+        Str key(pattern);
+        if (auto it = index.find(key); it != index.end())
+        {
+          entries.splice(entries.begin(), entries, it->second);
+          return it->second->second;
+        }
+        auto program = compile_program(pattern);
+        entries.emplace_front(key, program);
+        index[key] = entries.begin();
+        if (entries.size() > REGEX_CACHE_CAPACITY)
+        {
+          index.erase(entries.back().first);
+          entries.pop_back();
+        }
+        return program;
+      }
+
+    private:
+      std::mutex mutex;
+      std::list<std::pair<Str, RuntimeRef<StorageCell>>> entries;
+      Map<Str, std::list<std::pair<Str, RuntimeRef<StorageCell>>>::iterator> index;
+    };
+
+    auto program_cache() -> RegexProgramCache &
+    {
+      static RegexProgramCache cache;
+      return cache;
+    }
+
+    auto require_program(const RuntimeRef<StorageCell> &cell) -> const StorageCell &
+    {
+      if (!runtime_is_regex_value(cell) || cell->opaqueRefs.size() < 2 || !cell->opaqueRefs[1])
+      {
+        throw RuntimeException("Expected Regex runtime value");
+      }
+      return *cell->opaqueRefs[1];
+    }
+
+    /**
+     * Appends `replacement` to `result`, expanding `$` references against the match in `slots`.
+     */
+    void expand_replacement(Str &result, std::string_view text, std::string_view replacement,
+                            const Vec<int64_t> &slots)
+    {
+      auto groups = slots.size() / 2;
+      auto appendGroup = [&](size_t group) {
+        if (slots[group * 2] >= 0)
+        {
+          result += text.substr(static_cast<size_t>(slots[group * 2]),
+                                static_cast<size_t>(slots[group * 2 + 1] - slots[group * 2]));
+        }
+      };
+      for (size_t i = 0; i < replacement.size(); ++i)
+      {
+        char c = replacement[i];
+        if (c != '$' || i + 1 >= replacement.size())
+        {
+          result += c;
+          continue;
+        }
+        char reference = replacement[i + 1];
+        if (reference == '$')
+        {
+          result += '$';
+          ++i;
+          continue;
+        }
+        if (reference == '&')
+        {
+          appendGroup(0);
+          ++i;
+          continue;
+        }
+        if (!std::isdigit(static_cast<unsigned char>(reference)))
+        {
+          result += c;
+          continue;
+        }
+        size_t group = static_cast<size_t>(reference - '0');
+        size_t length = 1;
+        if (i + 2 < replacement.size() && std::isdigit(static_cast<unsigned char>(replacement[i + 2])) &&
+            group * 10 + static_cast<size_t>(replacement[i + 2] - '0') < groups)
+        {
+          group = group * 10 + static_cast<size_t>(replacement[i + 2] - '0');
+          length = 2;
+        }
+        if (group >= groups)
+        {
+          result += c;
+          continue;
+        }
+        appendGroup(group);
+        i += length;
+      }
+    }
+  } // namespace
+
+  auto make_runtime_regex_cell(std::string_view pattern) -> RuntimeRef<StorageCell>
+  {
+    auto program = program_cache().get(pattern);
+    auto type = regex_runtime_type();
+    auto cell = make_storage_cell(type->layout, StorageClass::TEMPORARY, {}, type);
+    cell->opaqueRefs = {make_runtime_string(Str(pattern)), std::move(program)};
+    cell->initialized = true;
+    return cell;
+  }
+
+  auto runtime_is_regex_value(const RuntimeRef<StorageCell> &cell) -> bool
+  {
+    return cell && cell->runtimeType == regex_runtime_type();
+  }
+
+  auto regex_group_count(const RuntimeRef<StorageCell> &cell) -> size_t
+  {
+    return program_view(require_program(cell)).header.groupCount;
+  }
+
+  auto regex_matches(const RuntimeRef<StorageCell> &cell, std::string_view text) -> bool
+  {
+    auto program = program_view(require_program(cell));
+    return !PikeVM(program, text).run(0, true).empty();
+  }
+
+  auto regex_search(const RuntimeRef<StorageCell> &cell, std::string_view text, size_t from) -> Vec<int64_t>
+  {
+    auto program = program_view(require_program(cell));
+    if (from > text.size())
+    {
+      return {};
+    }
+    return PikeVM(program, text).run(from, false);
+  }
+
+  auto regex_replace_all(const RuntimeRef<StorageCell> &cell, std::string_view text, std::string_view replacement)
+      -> Str
+  {
+    auto program = program_view(require_program(cell));
+    PikeVM vm(program, text);
+    Str result;
+    size_t copied = 0;
+    for (size_t from = 0; from <= text.size();)
+    {
+      auto slots = vm.run(from, false);
+      if (slots.empty())
+      {
+        break;
+      }
+      auto start = static_cast<size_t>(slots[0]);
+      auto end = static_cast<size_t>(slots[1]);
+      result += text.substr(copied, start - copied);
+      expand_replacement(result, text, replacement, slots);
+      copied = end;
+      // After an empty match, the next one starts at least one byte later.
+      from = end == start ? end + 1 : end;
+    }
+    result += text.substr(std::min(copied, text.size()));
+    return result;
+  }
+
+  auto regex_match_cached(std::string_view text, std::string_view pattern) -> bool
+  {
+    auto program = program_cache().get(pattern);
+    auto view = program_view(*program);
+    return !PikeVM(view, text).run(0, true).empty();
+  }
+
+  auto regex_runtime_type() -> RuntimeRef<NGType>
+  {
+    static RuntimeRef<NGType> regexType = makert<NGType>(NGType{
+        .name = "Regex",
+        .layout = TypeLayout{.name = "Regex", .kind = LayoutKind::DYNAMIC},
+        .showCellHandler =
+            [](const RuntimeRef<StorageCell> &cell) {
+              return "/" + runtime_string_value(cell->opaqueRefs[0]) + "/";
+            },
+        .sharesOpaqueRefs = true,
+    });
+    return regexType;
+  }
+} // namespace NG::runtime
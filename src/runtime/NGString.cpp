@@ -2,13 +2,100 @@
 #include <intp/runtime_numerals.hpp>
 #include <runtime/value_access.hpp>
 
+#include <cstring>
+#include <string_view>
+
 namespace NG::runtime
 {
   namespace
   {
+    /*
+     * A string cell is flat, with its payload in `bytes`, or shared: `opaqueRefs[0]` is an append buffer
+     * and `bytes` holds the payload length, a prefix of the buffer. Concatenating onto the string that
+     * ends at the buffer's end appends to the buffer in place, so `s + a + b` and `s := s + a` in a loop
+     * copy each byte once, and copying a shared string copies no payload. No string ever changes the
+     * part of a buffer it shares.
+     */
+    constexpr size_t SHARED_STRING_THRESHOLD = 256;
+
+    auto string_buffer_runtime_type() -> RuntimeRef<NGType>
+    {
+      static RuntimeRef<NGType> bufferType = makert<NGType>(NGType{
+          .name = "StringBuffer",
+          .layout = TypeLayout{.name = "StringBuffer", .kind = LayoutKind::DYNAMIC},
+      });
+      return bufferType;
+    }
+
+    auto string_buffer(const RuntimeRef<StorageCell> &cell) -> StorageCell *
+    {
+      return cell && !cell->opaqueRefs.empty() ? cell->opaqueRefs.front().get() : nullptr;
+    }
+
+    auto string_cell_view(const RuntimeRef<StorageCell> &cell) -> std::string_view
+    {
+      if (!cell)
+      {
+        return {};
+      }
+      if (auto *buffer = string_buffer(cell))
+      {
+        uint64_t size = 0;
+        std::memcpy(&size, cell->bytes.data(), sizeof(size));
+        return {reinterpret_cast<const char *>(buffer->bytes.data()), static_cast<size_t>(size)};
+      }
+      return {reinterpret_cast<const char *>(cell->bytes.data()), cell->bytes.size()};
+    }
+
     auto string_cell_payload(const RuntimeRef<StorageCell> &cell) -> Str
     {
-      return cell ? Str(reinterpret_cast<const char *>(cell->bytes.data()), cell->bytes.size()) : Str{};
+      return Str(string_cell_view(cell));
+    }
+
+    /**
+     * Points `cell` at the first `size` bytes of `buffer`.
+     */
+    void share_string_buffer(const RuntimeRef<StorageCell> &cell, RuntimeRef<StorageCell> buffer, size_t size)
+    {
+      auto length = static_cast<uint64_t>(size);
+      cell->bytes.resize(sizeof(length));
+      std::memcpy(cell->bytes.data(), &length, sizeof(length));
+      cell->opaqueRefs.assign(1, std::move(buffer));
+    }
+
+    /**
+     * Returns the buffer `cell` can append to in place: its own if the payload ends at the buffer's end,
+     * otherwise a new one holding a copy of the payload with room for `capacity` bytes.
+     */
+    auto appendable_string_buffer(const RuntimeRef<StorageCell> &cell, size_t capacity) -> RuntimeRef<StorageCell>
+    {
+      auto payload = string_cell_view(cell);
+      if (auto *buffer = string_buffer(cell); buffer && buffer->bytes.size() == payload.size())
+      {
+        return cell->opaqueRefs.front();
+      }
+      auto type = string_buffer_runtime_type();
+      auto buffer = make_storage_cell(type->layout, StorageClass::TEMPORARY, {}, type);
+      buffer->bytes.reserve(std::max(capacity, payload.size() * 2));
+      buffer->bytes.assign(payload.begin(), payload.end());
+      buffer->initialized = true;
+      return buffer;
+    }
+
+    auto concat_string(const RuntimeRef<StorageCell> &left, const Str &right) -> RuntimeRef<StorageCell>
+    {
+      auto leftSize = string_cell_view(left).size();
+      if (!string_buffer(left) && leftSize + right.size() < SHARED_STRING_THRESHOLD)
+      {
+        return make_runtime_string(string_cell_payload(left) + right);
+      }
+      auto buffer = appendable_string_buffer(left, leftSize + right.size());
+      buffer->bytes.insert(buffer->bytes.end(), right.begin(), right.end());
+      auto type = string_runtime_type();
+      auto cell = make_storage_cell(type->layout, StorageClass::TEMPORARY, {}, type);
+      share_string_buffer(cell, std::move(buffer), leftSize + right.size());
+      cell->initialized = true;
+      return cell;
     }
   } // namespace
 
@@ -28,14 +115,31 @@ namespace NG::runtime
   }
 
   auto runtime_string_value(const RuntimeRef<StorageCell> &cell) -> Str
+  {
+    return Str(runtime_string_view(cell));
+  }
+
+  auto runtime_string_view(const RuntimeRef<StorageCell> &cell) -> std::string_view
   {
     if (runtime_is_string_value(cell))
     {
-      return string_cell_payload(cell);
+      return string_cell_view(cell);
     }
     throw RuntimeException("Expected String runtime value");
   }
 
+  void runtime_string_reserve(const RuntimeRef<StorageCell> &cell, size_t capacity)
+  {
+    if (!runtime_is_string_value(cell))
+    {
+      throw RuntimeException("Expected String runtime value");
+    }
+    auto size = string_cell_view(cell).size();
+    auto buffer = appendable_string_buffer(cell, capacity);
+    buffer->bytes.reserve(capacity);
+    share_string_buffer(cell, std::move(buffer), size);
+  }
+
   auto string_runtime_type() -> RuntimeRef<NGType>
   {
     static RuntimeRef<NGType> stringType = makert<NGType>(NGType{
@@ -44,7 +148,7 @@ namespace NG::runtime
         .memberFunctions = {
             {"size",
              [](const NGSelf &self, const NGEnv &, const NGArgs &) -> RuntimeRef<StorageCell> {
-               return numeral_cell_from_value<uint32_t>(static_cast<uint32_t>(string_cell_payload(self).size()));
+               return numeral_cell_from_value<uint32_t>(static_cast<uint32_t>(string_cell_view(self).size()));
              }},
             {"charAt",
              [](const NGSelf &self, const NGEnv &, const NGArgs &args) -> RuntimeRef<StorageCell> {
@@ -57,7 +161,7 @@ namespace NG::runtime
                {
                  throw RuntimeException("Index out of bounds: " + std::to_string(index));
                }
-               auto payload = string_cell_payload(self);
+               auto payload = string_cell_view(self);
                if (static_cast<size_t>(index) >= payload.size())
                {
                  throw RuntimeException("Index out of bounds: " + std::to_string(index));
@@ -70,7 +174,7 @@ namespace NG::runtime
                {
                  throw RuntimeException("String.append() requires a value argument");
                }
-               return make_runtime_string(string_cell_payload(self) + runtime_value_show(args[0]));
+               return concat_string(self, runtime_value_show(args[0]));
              }},
         },
         .showCellHandler =
@@ -79,14 +183,14 @@ namespace NG::runtime
             },
         .boolCellHandler =
             [](const RuntimeRef<StorageCell> &cell) {
-              return !string_cell_payload(cell).empty();
+              return !string_cell_view(cell).empty();
             },
         .cellBinaryOperators =
             {
                 {RuntimeBinaryOperator::Add,
                  [](const RuntimeRef<StorageCell> &self,
                     const RuntimeRef<StorageCell> &other) -> RuntimeRef<StorageCell> {
-                   return make_runtime_string(string_cell_payload(self) + runtime_value_show(other));
+                   return concat_string(self, runtime_value_show(other));
                  }},
             },
         .cellOrderHandler =
@@ -95,12 +199,13 @@ namespace NG::runtime
               {
                 return Orders::UNORDERED;
               }
-              auto left = string_cell_payload(self);
-              auto right = string_cell_payload(other);
+              auto left = string_cell_view(self);
+              auto right = string_cell_view(other);
               if (left < right) return Orders::LT;
               if (left > right) return Orders::GT;
               return Orders::EQ;
             },
+        .sharesOpaqueRefs = true,
     });
     return stringType;
   }
@@ -0,0 +1,392 @@
+#include <runtime/regex.hpp>
+#include <runtime/text_slices.hpp>
+#include <runtime/value_access.hpp>
+
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <limits>
+
+namespace NG::runtime
+{
+  namespace
+  {
+    constexpr uint64_t NO_PIECE = std::numeric_limits<uint64_t>::max();
+    constexpr uint64_t UNKNOWN_COUNT = std::numeric_limits<uint64_t>::max();
+    constexpr uint64_t FILE_CHUNK_SIZE = 64 * 1024;
+
+    enum class SliceKind : uint8_t
+    {
+      Split = 1,
+      Tokens = 2,
+      Lines = 3,
+      Matches = 4,
+    };
+
+    struct SlicesHeader
+    {
+      uint64_t count = UNKNOWN_COUNT;
+      uint64_t index = 0;  ///< Piece the cursor is at.
+      uint64_t offset = 0; ///< Byte offset of that piece, or `NO_PIECE` past the last one.
+      uint64_t textSize = 0;
+      SliceKind kind = SliceKind::Split;
+    };
+
+    auto read_header(const RuntimeRef<StorageCell> &cell) -> SlicesHeader
+    {
+      SlicesHeader header;
+      std::memcpy(&header, cell->bytes.data(), sizeof(header));
+      return header;
+    }
+
+    void write_header(const RuntimeRef<StorageCell> &cell, const SlicesHeader &header)
+    {
+      std::memcpy(cell->bytes.data(), &header, sizeof(header));
+    }
+
+    auto require_slices(const RuntimeRef<StorageCell> &cell) -> SlicesHeader
+    {
+      if (!runtime_is_text_slices_value(cell) || cell->bytes.size() < sizeof(SlicesHeader) ||
+          cell->opaqueRefs.size() < 2)
+      {
+        throw RuntimeException("Expected TextSlices runtime value");
+      }
+      return read_header(cell);
+    }
+
+    auto text_chunk_runtime_type() -> RuntimeRef<NGType>
+    {
+      static RuntimeRef<NGType> chunkType = makert<NGType>(NGType{
+          .name = "TextChunk",
+          .layout = TypeLayout{.name = "TextChunk", .kind = LayoutKind::DYNAMIC},
+      });
+      return chunkType;
+    }
+
+    /**
+     * Returns the file offset and the bytes of the chunk a lines cell holds, empty before the first read.
+     */
+    auto chunk_view(const RuntimeRef<StorageCell> &cell) -> std::pair<uint64_t, std::string_view>
+    {
+      const auto &chunk = cell->opaqueRefs[1];
+      if (!chunk)
+      {
+        return {0, {}};
+      }
+      uint64_t start = 0;
+      std::memcpy(&start, chunk->bytes.data(), sizeof(start));
+      return {start, std::string_view(reinterpret_cast<const char *>(chunk->bytes.data()) + sizeof(start),
+                                      chunk->bytes.size() - sizeof(start))};
+    }
+
+    /**
+     * Reads up to `length` bytes of the file from `start` into the chunk, replacing it if a copy shares it.
+     */
+    void load_chunk(const RuntimeRef<StorageCell> &cell, const SlicesHeader &header, uint64_t start, uint64_t length)
+    {
+      auto path = runtime_string_value(cell->opaqueRefs[0]);
+      std::ifstream file(path, std::ios::binary);
+      if (!file.is_open())
+      {
+        throw RuntimeException("lines() failed to open: " + path);
+      }
+      length = std::min(length, header.textSize - start);
+      auto &chunk = cell->opaqueRefs[1];
+      if (!chunk || chunk.use_count() > 1)
+      {
+        auto type = text_chunk_runtime_type();
+        chunk = make_storage_cell(type->layout, StorageClass::TEMPORARY, {}, type);
+        chunk->initialized = true;
+      }
+      chunk->bytes.resize(sizeof(start) + length);
+      std::memcpy(chunk->bytes.data(), &start, sizeof(start));
+      file.seekg(static_cast<std::streamoff>(start));
+      file.read(reinterpret_cast<char *>(chunk->bytes.data()) + sizeof(start), static_cast<std::streamsize>(length));
+      if (static_cast<uint64_t>(file.gcount()) != length)
+      {
+        throw RuntimeException("lines() failed to read: " + path);
+      }
+    }
+
+    /**
+     * Returns the offset of the `\n` ending the line at `offset`, or the file size, with the chunk holding the line.
+     */
+    auto line_end(const RuntimeRef<StorageCell> &cell, const SlicesHeader &header, uint64_t offset) -> uint64_t
+    {
+      auto [start, data] = chunk_view(cell);
+      if (!cell->opaqueRefs[1] || offset < start || offset >= start + data.size())
+      {
+        load_chunk(cell, header, offset, FILE_CHUNK_SIZE);
+      }
+      while (true)
+      {
+        std::tie(start, data) = chunk_view(cell);
+        if (auto pos = data.find('\n', offset - start); pos != std::string_view::npos)
+        {
+          return start + pos;
+        }
+        if (start + data.size() >= header.textSize)
+        {
+          return header.textSize;
+        }
+        // The line does not fit: read it again from its start into a chunk twice as long.
+        load_chunk(cell, header, offset, std::max(FILE_CHUNK_SIZE, 2 * (start + data.size() - offset)));
+      }
+    }
+
+    auto source_view(const RuntimeRef<StorageCell> &cell) -> std::string_view
+    {
+      return runtime_string_view(cell->opaqueRefs[0]);
+    }
+
+    auto pattern_view(const RuntimeRef<StorageCell> &cell) -> std::string_view
+    {
+      return runtime_string_view(cell->opaqueRefs[1]);
+    }
+
+    /**
+     * Returns the start of the first regex match at or after `from`, or `NO_PIECE`.
+     */
+    auto next_match(const RuntimeRef<StorageCell> &cell, const SlicesHeader &header, uint64_t from) -> uint64_t
+    {
+      if (from > header.textSize)
+      {
+        return NO_PIECE;
+      }
+      auto slots = regex_search(cell->opaqueRefs[1], source_view(cell), from);
+      return slots.empty() ? NO_PIECE : static_cast<uint64_t>(slots[0]);
+    }
+
+    auto first_offset(const RuntimeRef<StorageCell> &cell, const SlicesHeader &header) -> uint64_t
+    {
+      switch (header.kind)
+      {
+      case SliceKind::Split:
+        return pattern_view(cell).empty() && header.textSize == 0 ? NO_PIECE : 0;
+      case SliceKind::Tokens:
+      {
+        auto start = source_view(cell).find_first_not_of(pattern_view(cell));
+        return start == std::string_view::npos ? NO_PIECE : start;
+      }
+      case SliceKind::Lines:
+        return header.textSize == 0 ? NO_PIECE : 0;
+      case SliceKind::Matches:
+        return next_match(cell, header, 0);
+      }
+      return NO_PIECE;
+    }
+
+    /**
+     * Returns the end of the piece at `offset` and the offset of the next piece, or `NO_PIECE` if it is the last.
+     */
+    auto step(const RuntimeRef<StorageCell> &cell, const SlicesHeader &header, uint64_t offset)
+        -> std::pair<uint64_t, uint64_t>
+    {
+      switch (header.kind)
+      {
+      case SliceKind::Split:
+      {
+        auto delimiter = pattern_view(cell);
+        if (delimiter.empty())
+        {
+          return {offset + 1, offset + 1 < header.textSize ? offset + 1 : NO_PIECE};
+        }
+        auto pos = source_view(cell).find(delimiter, offset);
+        if (pos == std::string_view::npos)
+        {
+          return {header.textSize, NO_PIECE};
+        }
+        return {pos, pos + delimiter.size()};
+      }
+      case SliceKind::Tokens:
+      {
+        auto source = source_view(cell);
+        auto separators = pattern_view(cell);
+        auto end = std::min<uint64_t>(source.find_first_of(separators, offset), header.textSize);
+        auto next = end == header.textSize ? std::string_view::npos : source.find_first_not_of(separators, end);
+        return {end, next == std::string_view::npos ? NO_PIECE : next};
+      }
+      case SliceKind::Lines:
+      {
+        auto end = line_end(cell, header, offset);
+        return {end, end + 1 < header.textSize ? end + 1 : NO_PIECE};
+      }
+      case SliceKind::Matches:
+      {
+        // The match at `offset` is the leftmost one from there, so searching again finds its end.
+        auto end = static_cast<uint64_t>(regex_search(cell->opaqueRefs[1], source_view(cell), offset)[1]);
+        return {end, next_match(cell, header, end == offset ? end + 1 : end)};
+      }
+      }
+      return {offset, NO_PIECE};
+    }
+
+    /**
+     * Moves the cursor to piece `index`, restarting from the first piece to go back; returns whether it exists.
+     */
+    auto seek(const RuntimeRef<StorageCell> &cell, SlicesHeader &header, uint64_t index) -> bool
+    {
+      if (index < header.index)
+      {
+        header.index = 0;
+        header.offset = first_offset(cell, header);
+      }
+      while (header.index < index && header.offset != NO_PIECE)
+      {
+        header.offset = step(cell, header, header.offset).second;
+        ++header.index;
+      }
+      if (header.offset == NO_PIECE)
+      {
+        header.count = header.index;
+      }
+      write_header(cell, header);
+      return header.index == index && header.offset != NO_PIECE;
+    }
+
+    auto make_slices_cell(SliceKind kind, RuntimeRef<StorageCell> text, RuntimeRef<StorageCell> second,
+                          uint64_t textSize) -> RuntimeRef<StorageCell>
+    {
+      auto type = text_slices_runtime_type();
+      auto cell = make_storage_cell(type->layout, StorageClass::TEMPORARY, {}, type);
+      cell->bytes.assign(sizeof(SlicesHeader), 0);
+      cell->opaqueRefs = {std::move(text), std::move(second)};
+      cell->initialized = true;
+      SlicesHeader header{.textSize = textSize, .kind = kind};
+      header.offset = first_offset(cell, header);
+      write_header(cell, header);
+      return cell;
+    }
+
+    /**
+     * Keeps a string argument for a slices cell: temporaries belong to the call and are kept as they are.
+     */
+    auto kept_source(const RuntimeRef<StorageCell> &source) -> RuntimeRef<StorageCell>
+    {
+      if (!runtime_is_string_value(source))
+      {
+        throw RuntimeException("Expected String runtime value");
+      }
+      if (source->storageClass == StorageClass::TEMPORARY)
+      {
+        return source;
+      }
+      return clone_runtime_storage_cell(source, StorageClass::TEMPORARY);
+    }
+  } // namespace
+
+  auto make_runtime_split_slices_cell(const RuntimeRef<StorageCell> &source, std::string_view delimiter)
+      -> RuntimeRef<StorageCell>
+  {
+    auto text = kept_source(source);
+    auto size = runtime_string_view(text).size();
+    return make_slices_cell(SliceKind::Split, std::move(text), make_runtime_string(Str(delimiter)), size);
+  }
+
+  auto make_runtime_token_slices_cell(const RuntimeRef<StorageCell> &source, std::string_view separators)
+      -> RuntimeRef<StorageCell>
+  {
+    auto text = kept_source(source);
+    auto size = runtime_string_view(text).size();
+    return make_slices_cell(SliceKind::Tokens, std::move(text), make_runtime_string(Str(separators)), size);
+  }
+
+  auto make_runtime_regex_slices_cell(const RuntimeRef<StorageCell> &source, const RuntimeRef<StorageCell> &regex)
+      -> RuntimeRef<StorageCell>
+  {
+    if (!runtime_is_regex_value(regex))
+    {
+      throw RuntimeException("Expected Regex runtime value");
+    }
+    auto text = kept_source(source);
+    auto size = runtime_string_view(text).size();
+    return make_slices_cell(SliceKind::Matches, std::move(text), regex, size);
+  }
+
+  auto make_runtime_file_lines_cell(std::string_view path) -> RuntimeRef<StorageCell>
+  {
+    std::error_code error;
+    auto size = std::filesystem::file_size(std::filesystem::path(path), error);
+    if (error || !std::ifstream(Str(path), std::ios::binary).is_open())
+    {
+      throw RuntimeException("lines() failed to open: " + Str(path));
+    }
+    return make_slices_cell(SliceKind::Lines, make_runtime_string(Str(path)), nullptr, size);
+  }
+
+  auto runtime_is_text_slices_value(const RuntimeRef<StorageCell> &cell) -> bool
+  {
+    return cell && cell->runtimeType == text_slices_runtime_type();
+  }
+
+  auto text_slices_size(const RuntimeRef<StorageCell> &cell) -> size_t
+  {
+    auto header = require_slices(cell);
+    if (header.count == UNKNOWN_COUNT)
+    {
+      // Count from the cursor without moving it, so reading in order continues where it was.
+      auto count = header.index;
+      for (auto offset = header.offset; offset != NO_PIECE; ++count)
+      {
+        offset = step(cell, header, offset).second;
+      }
+      header.count = count;
+      write_header(cell, header);
+    }
+    return static_cast<size_t>(header.count);
+  }
+
+  auto text_slices_has(const RuntimeRef<StorageCell> &cell, size_t index) -> bool
+  {
+    auto header = require_slices(cell);
+    if (header.count != UNKNOWN_COUNT)
+    {
+      return index < header.count;
+    }
+    return seek(cell, header, index);
+  }
+
+  auto text_slices_get(const RuntimeRef<StorageCell> &cell, size_t index) -> RuntimeRef<StorageCell>
+  {
+    auto header = require_slices(cell);
+    if (!seek(cell, header, index))
+    {
+      throw RuntimeException("Text slice index out of range: " + std::to_string(index));
+    }
+    auto end = step(cell, header, header.offset).first;
+    if (header.kind != SliceKind::Lines)
+    {
+      return make_runtime_string(Str(source_view(cell).substr(header.offset, end - header.offset)));
+    }
+    auto [start, data] = chunk_view(cell);
+    auto line = data.substr(header.offset - start, end - header.offset);
+    if (line.ends_with('\r'))
+    {
+      line.remove_suffix(1);
+    }
+    return make_runtime_string(Str(line));
+  }
+
+  auto text_slices_runtime_type() -> RuntimeRef<NGType>
+  {
+    static RuntimeRef<NGType> slicesType = makert<NGType>(NGType{
+        .name = "TextSlices",
+        .layout = TypeLayout{.name = "TextSlices", .kind = LayoutKind::DYNAMIC},
+        .showCellHandler =
+            [](const RuntimeRef<StorageCell> &cell) {
+              Str result{};
+              for (size_t index = 0; text_slices_has(cell, index); ++index)
+              {
+                result += (index == 0 ? "" : ", ") + runtime_string_value(text_slices_get(cell, index));
+              }
+              return "[" + result + "]";
+            },
+        .boolCellHandler =
+            [](const RuntimeRef<StorageCell> &cell) {
+              return text_slices_has(cell, 0);
+            },
+        .sharesOpaqueRefs = true,
+    });
+    return slicesType;
+  }
+} // namespace NG::runtime
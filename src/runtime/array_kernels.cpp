@@ -0,0 +1,1068 @@
+#include <runtime/array_kernels.hpp>
+#include <intp/runtime_numerals.hpp>
+#include <runtime/value_access.hpp>
+#include <runtime/value_ops.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <concepts>
+#include <limits>
+#include <memory>
+#include <numeric>
+#include <type_traits>
+
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+#define NG_KERNELS_X86 1
+#else
+#define NG_KERNELS_X86 0
+#endif
+
+#if defined(__GNUC__) || defined(__clang__)
+#define NG_KERNEL_INLINE [[gnu::always_inline]] inline
+#define NG_KERNEL_FLATTEN [[gnu::flatten]]
+#else
+#define NG_KERNEL_INLINE inline
+#define NG_KERNEL_FLATTEN
+#endif
+
+namespace NG::runtime::kernels
+{
+  using System::Cpu::SimdLevel;
+
+  namespace
+  {
+    constexpr size_t LANES = 8;
+    constexpr size_t SEARCH_CHUNK = 64;
+
+    auto simd_level_setting() -> std::atomic<SimdLevel> &
+    {
+      static std::atomic<SimdLevel> level{System::Cpu::detected_simd_level()};
+      return level;
+    }
+
+    /*
+     * Each kernel body is a lambda run through `dispatch`, which inlines it into a copy compiled for
+     * the active instruction set, so the same loops are vectorized for AVX2, SSE2 or neither.
+     */
+    template <class F>
+    NG_KERNEL_FLATTEN auto run_portable(F &body)
+    {
+      return body();
+    }
+
+#if NG_KERNELS_X86
+    template <class F>
+    [[gnu::flatten, gnu::target("sse2")]] auto run_sse2(F &body)
+    {
+      return body();
+    }
+
+    template <class F>
+    [[gnu::flatten, gnu::target("avx2")]] auto run_avx2(F &body)
+    {
+      return body();
+    }
+#endif
+
+    template <class F>
+    auto dispatch(F &&body)
+    {
+#if NG_KERNELS_X86
+      switch (active_simd_level())
+      {
+      case SimdLevel::Avx2:
+        return run_avx2(body);
+      case SimdLevel::Sse2:
+        return run_sse2(body);
+      case SimdLevel::Scalar:
+        break;
+      }
+#endif
+      return run_portable(body);
+    }
+
+    /// Signed integers trap on overflow like the arithmetic operators; unsigned ones wrap.
+    template <class T>
+    constexpr bool CHECKED_INTEGER = std::integral<T> && std::is_signed_v<T> && !std::same_as<T, bool>;
+
+    /// The accumulator a checked integer kernel uses, wide enough that it cannot overflow itself.
+    template <class T>
+    using Wide = std::conditional_t<(sizeof(T) < sizeof(int64_t)), int64_t, __int128>;
+
+    template <class T, class W>
+    auto fits(W value) -> bool
+    {
+      return value >= static_cast<W>(std::numeric_limits<T>::min()) &&
+             value <= static_cast<W>(std::numeric_limits<T>::max());
+    }
+
+    template <class T>
+    auto element_data(const RuntimeRef<StorageCell> &array) -> const T *
+    {
+      return reinterpret_cast<const T *>(array->bytes.data());
+    }
+
+    template <class T>
+    auto element_type() -> RuntimeRef<NGType>
+    {
+      if constexpr (std::same_as<T, bool>)
+      {
+        return boolean_runtime_type();
+      }
+      else
+      {
+        return numeral_runtime_type<T>();
+      }
+    }
+
+    template <class T>
+    auto scalar_value(const RuntimeRef<StorageCell> &value) -> T
+    {
+      if constexpr (std::same_as<T, bool>)
+      {
+        return runtime_value_bool(value);
+      }
+      else
+      {
+        return read_numeric_cell_as<T>(value);
+      }
+    }
+
+    /**
+     * Builds a packed array of `length` elements written by `write(out)`.
+     */
+    template <class T, class Write>
+    auto make_packed_result(size_t length, Write &&write) -> RuntimeRef<StorageCell>
+    {
+      Vec<uint8_t> bytes(length * sizeof(T));
+      write(reinterpret_cast<T *>(bytes.data()));
+      return make_runtime_packed_array_cell(element_type<T>(), std::move(bytes));
+    }
+
+    template <class Acc, class T>
+    NG_KERNEL_INLINE auto lane_sum(const T *data, size_t length) -> Acc
+    {
+      Acc lanes[LANES]{};
+      size_t i = 0;
+      for (; i + LANES <= length; i += LANES)
+      {
+        for (size_t lane = 0; lane < LANES; ++lane)
+        {
+          lanes[lane] += static_cast<Acc>(data[i + lane]);
+        }
+      }
+      Acc total{};
+      for (auto lane : lanes)
+      {
+        total += lane;
+      }
+      for (; i < length; ++i)
+      {
+        total += static_cast<Acc>(data[i]);
+      }
+      return total;
+    }
+
+    template <class Acc, class T>
+    NG_KERNEL_INLINE auto lane_dot(const T *left, const T *right, size_t length) -> Acc
+    {
+      Acc lanes[LANES]{};
+      size_t i = 0;
+      for (; i + LANES <= length; i += LANES)
+      {
+        for (size_t lane = 0; lane < LANES; ++lane)
+        {
+          lanes[lane] += static_cast<Acc>(left[i + lane]) * static_cast<Acc>(right[i + lane]);
+        }
+      }
+      Acc total{};
+      for (auto lane : lanes)
+      {
+        total += lane;
+      }
+      for (; i < length; ++i)
+      {
+        total += static_cast<Acc>(left[i]) * static_cast<Acc>(right[i]);
+      }
+      return total;
+    }
+
+    /**
+     * Returns the smallest (or, with `Maximum`, largest) of `length > 0` elements.
+     */
+    template <bool Maximum, class T>
+    NG_KERNEL_INLINE auto lane_extreme(const T *data, size_t length) -> T
+    {
+      auto pick = [](T current, T candidate) {
+        if constexpr (Maximum)
+        {
+          return current < candidate ? candidate : current;
+        }
+        else
+        {
+          return candidate < current ? candidate : current;
+        }
+      };
+      T lanes[LANES];
+      std::fill(std::begin(lanes), std::end(lanes), data[0]);
+      size_t i = 0;
+      for (; i + LANES <= length; i += LANES)
+      {
+        for (size_t lane = 0; lane < LANES; ++lane)
+        {
+          lanes[lane] = pick(lanes[lane], data[i + lane]);
+        }
+      }
+      T result = lanes[0];
+      for (auto lane : lanes)
+      {
+        result = pick(result, lane);
+      }
+      for (; i < length; ++i)
+      {
+        result = pick(result, data[i]);
+      }
+      return result;
+    }
+
+    /**
+     * An array argument in packed form; `cell` is null for an empty slot-backed array, whose element
+     * type is unknown at runtime.
+     */
+    struct PackedInput
+    {
+      RuntimeRef<StorageCell> cell;
+      RuntimeRef<NGType> type;
+      size_t length = 0;
+    };
+
+    auto packed_input(const Str &function, const RuntimeRef<StorageCell> &array) -> PackedInput
+    {
+      if (!runtime_is_array_value(array))
+      {
+        throw RuntimeException(function + "() requires an array");
+      }
+      auto packed = array;
+      if (!runtime_array_is_packed(packed))
+      {
+        if (runtime_array_length(packed) == 0)
+        {
+          return {};
+        }
+        packed = make_runtime_array_cell(runtime_array_slots(array));
+        if (!runtime_array_is_packed(packed))
+        {
+          throw RuntimeException(function + "() requires an array of numbers or booleans");
+        }
+      }
+      return {packed, runtime_array_packed_type(packed), runtime_array_length(packed)};
+    }
+
+    auto packed_inputs(const Str &function, const RuntimeRef<StorageCell> &left, const RuntimeRef<StorageCell> &right)
+        -> std::pair<PackedInput, PackedInput>
+    {
+      auto leftInput = packed_input(function, left);
+      auto rightInput = packed_input(function, right);
+      if (leftInput.length != rightInput.length)
+      {
+        throw RuntimeException(function + "() requires arrays of equal length");
+      }
+      if (leftInput.length != 0 && leftInput.type != rightInput.type)
+      {
+        throw RuntimeException(function + "() requires arrays of the same element type");
+      }
+      return {leftInput, rightInput};
+    }
+
+    template <class F>
+    auto visit_numeral(const Str &function, const RuntimeRef<NGType> &type, F &&visitor)
+    {
+      const auto &name = type->name;
+      if (name == "i8") return visitor(std::type_identity<int8_t>{});
+      if (name == "u8") return visitor(std::type_identity<uint8_t>{});
+      if (name == "i16") return visitor(std::type_identity<int16_t>{});
+      if (name == "u16") return visitor(std::type_identity<uint16_t>{});
+      if (name == "i32") return visitor(std::type_identity<int32_t>{});
+      if (name == "u32") return visitor(std::type_identity<uint32_t>{});
+      if (name == "i64") return visitor(std::type_identity<int64_t>{});
+      if (name == "u64") return visitor(std::type_identity<uint64_t>{});
+      if (name == "f32") return visitor(std::type_identity<float>{});
+      if (name == "f64") return visitor(std::type_identity<double>{});
+      throw RuntimeException(function + "() requires an array of numbers");
+    }
+
+    template <class F>
+    auto visit_element(const Str &function, const RuntimeRef<NGType> &type, F &&visitor)
+    {
+      if (type == boolean_runtime_type())
+      {
+        return visitor(std::type_identity<bool>{});
+      }
+      return visit_numeral(function, type, std::forward<F>(visitor));
+    }
+
+    auto empty_array() -> RuntimeRef<StorageCell>
+    {
+      return make_runtime_array_cell({});
+    }
+
+    template <bool Maximum>
+    auto array_extreme(const Str &function, const RuntimeRef<StorageCell> &array) -> RuntimeRef<StorageCell>
+    {
+      auto input = packed_input(function, array);
+      if (input.length == 0)
+      {
+        throw RuntimeException(function + "() requires a non-empty array");
+      }
+      return visit_numeral(function, input.type, [&]<class T>(std::type_identity<T>) {
+        const auto *data = element_data<T>(input.cell);
+        return numeral_cell_from_value<T>(dispatch([&] { return lane_extreme<Maximum>(data, input.length); }));
+      });
+    }
+
+    /// Below this length an integer sort is faster with introsort than with radix passes.
+    constexpr size_t RADIX_THRESHOLD = 64;
+    /// Runs of this length are insertion-sorted before merging.
+    constexpr size_t MERGE_RUN = 32;
+
+    /**
+     * Maps an integer to an unsigned key with the same order.
+     */
+    template <class T>
+    auto radix_key(T value) -> std::make_unsigned_t<T>
+    {
+      using Key = std::make_unsigned_t<T>;
+      auto key = static_cast<Key>(value);
+      if constexpr (std::is_signed_v<T>)
+      {
+        key ^= static_cast<Key>(Key{1} << (sizeof(T) * 8 - 1));
+      }
+      return key;
+    }
+
+    /**
+     * Sorts integers with an LSD radix sort over bytes, skipping bytes in which all elements agree.
+     */
+    template <class T>
+    void radix_sort(T *data, size_t length, bool descending)
+    {
+      Vec<T> buffer(length);
+      T *from = data;
+      T *to = buffer.data();
+      for (size_t shift = 0; shift < sizeof(T) * 8; shift += 8)
+      {
+        size_t counts[256]{};
+        for (size_t i = 0; i < length; ++i)
+        {
+          ++counts[(radix_key(from[i]) >> shift) & 0xFF];
+        }
+        if (std::ranges::any_of(counts, [length](size_t count) { return count == length; }))
+        {
+          continue;
+        }
+        size_t offsets[256];
+        size_t offset = 0;
+        for (size_t digit = 0; digit < 256; ++digit)
+        {
+          auto bucket = descending ? 255 - digit : digit;
+          offsets[bucket] = offset;
+          offset += counts[bucket];
+        }
+        for (size_t i = 0; i < length; ++i)
+        {
+          to[offsets[(radix_key(from[i]) >> shift) & 0xFF]++] = from[i];
+        }
+        std::swap(from, to);
+      }
+      if (from != data)
+      {
+        std::copy(from, from + length, data);
+      }
+    }
+
+    template <class T>
+    void require_ordered_numbers(const T *data, size_t length)
+    {
+      if constexpr (std::floating_point<T>)
+      {
+        if (std::any_of(data, data + length, [](T value) { return std::isnan(value); }))
+        {
+          throw RuntimeException("Sorting cannot order NaN");
+        }
+      }
+    }
+
+    /**
+     * Sorts packed elements in place. Equal integers and booleans are indistinguishable, so only
+     * floating-point sorts, where `-0.0` equals `0.0`, need a stable algorithm.
+     */
+    template <class T>
+    void sort_elements(T *data, size_t length, bool stable, bool descending)
+    {
+      require_ordered_numbers(data, length);
+      if constexpr (std::same_as<T, bool>)
+      {
+        auto trues = static_cast<size_t>(std::count(data, data + length, true));
+        std::fill(data, data + length, descending);
+        std::fill(data + (descending ? trues : length - trues), data + length, !descending);
+      }
+      else if constexpr (std::floating_point<T>)
+      {
+        auto less = [descending](T left, T right) { return descending ? right < left : left < right; };
+        if (stable)
+        {
+          std::stable_sort(data, data + length, less);
+        }
+        else
+        {
+          std::sort(data, data + length, less);
+        }
+      }
+      else if (length >= RADIX_THRESHOLD)
+      {
+        radix_sort(data, length, descending);
+      }
+      else if (descending)
+      {
+        std::sort(data, data + length, std::greater<T>{});
+      }
+      else
+      {
+        std::sort(data, data + length);
+      }
+    }
+
+    /**
+     * Returns the array's elements packed when they are numbers or booleans of one type, or null.
+     */
+    auto packed_elements(const Str &function, const RuntimeRef<StorageCell> &array) -> RuntimeRef<StorageCell>
+    {
+      if (!runtime_is_array_value(array))
+      {
+        throw RuntimeException(function + "() requires an array");
+      }
+      if (runtime_array_is_packed(array))
+      {
+        return array;
+      }
+      auto packed = make_runtime_array_cell(runtime_array_slots(array));
+      return runtime_array_is_packed(packed) ? packed : nullptr;
+    }
+
+    auto sort_order(const RuntimeRef<StorageCell> &left, const RuntimeRef<StorageCell> &right) -> Orders
+    {
+      auto order = ops::key_order(left, right);
+      if (order == Orders::UNORDERED)
+      {
+        throw RuntimeException("Sorting requires ordered elements: cannot compare " + runtime_value_show(left) +
+                               " with " + runtime_value_show(right));
+      }
+      return order;
+    }
+
+    auto sort_less(const RuntimeRef<StorageCell> &left, const RuntimeRef<StorageCell> &right) -> bool
+    {
+      return sort_order(left, right) == Orders::LT;
+    }
+
+    auto cloned_array(const Vec<RuntimeRef<StorageCell>> &slots, size_t length) -> RuntimeRef<StorageCell>
+    {
+      Vec<RuntimeRef<StorageCell>> items;
+      items.reserve(length);
+      for (size_t i = 0; i < length; ++i)
+      {
+        items.push_back(clone_runtime_storage_cell(slots[i], StorageClass::TEMPORARY));
+      }
+      return make_runtime_array_cell(items, items.size());
+    }
+
+    /**
+     * A stable merge sort that stays in bounds whatever `less` answers, since it may be an NG function.
+     * Comparisons are what cost, so runs are built by binary insertion and merges of runs already in
+     * order are skipped.
+     */
+    template <class Less>
+    void merge_sort(Vec<RuntimeRef<StorageCell>> &items, Less &&less)
+    {
+      auto length = items.size();
+      auto at = [&items](size_t index) { return items.begin() + static_cast<ptrdiff_t>(index); };
+      for (size_t start = 0; start < length; start += MERGE_RUN)
+      {
+        auto end = std::min(start + MERGE_RUN, length);
+        for (size_t i = start + 1; i < end; ++i)
+        {
+          auto low = start;
+          auto high = i;
+          while (low < high)
+          {
+            auto middle = low + (high - low) / 2;
+            if (less(items[i], items[middle]))
+            {
+              high = middle;
+            }
+            else
+            {
+              low = middle + 1;
+            }
+          }
+          std::rotate(at(low), at(i), at(i + 1));
+        }
+      }
+      Vec<RuntimeRef<StorageCell>> buffer(length);
+      for (size_t width = MERGE_RUN; width < length; width *= 2)
+      {
+        for (size_t low = 0; low < length; low += 2 * width)
+        {
+          auto middle = std::min(low + width, length);
+          auto high = std::min(low + 2 * width, length);
+          if (middle == high || !less(items[middle], items[middle - 1]))
+          {
+            std::move(at(low), at(high), buffer.begin() + static_cast<ptrdiff_t>(low));
+            continue;
+          }
+          auto left = low;
+          auto right = middle;
+          auto out = low;
+          while (left < middle && right < high)
+          {
+            buffer[out++] = std::move(less(items[right], items[left]) ? items[right++] : items[left++]);
+          }
+          std::move(at(left), at(middle), buffer.begin() + static_cast<ptrdiff_t>(out));
+          std::move(at(right), at(high), buffer.begin() + static_cast<ptrdiff_t>(out + (middle - left)));
+        }
+        items.swap(buffer);
+      }
+    }
+  } // namespace
+
+  auto active_simd_level() -> SimdLevel
+  {
+    return simd_level_setting().load(std::memory_order_relaxed);
+  }
+
+  void set_simd_level(SimdLevel level)
+  {
+    simd_level_setting().store(std::min(level, System::Cpu::detected_simd_level()), std::memory_order_relaxed);
+  }
+
+  auto array_sum(const RuntimeRef<StorageCell> &array) -> RuntimeRef<StorageCell>
+  {
+    auto input = packed_input("sum", array);
+    if (!input.cell)
+    {
+      return numeral_cell_from_value<int32_t>(0);
+    }
+    return visit_numeral("sum", input.type, [&]<class T>(std::type_identity<T>) {
+      const auto *data = element_data<T>(input.cell);
+      if constexpr (CHECKED_INTEGER<T>)
+      {
+        auto total = dispatch([&] { return lane_sum<Wide<T>>(data, input.length); });
+        if (!fits<T>(total))
+        {
+          throw RuntimeException("Integer overflow in addition");
+        }
+        return numeral_cell_from_value<T>(static_cast<T>(total));
+      }
+      else
+      {
+        return numeral_cell_from_value<T>(dispatch([&] { return lane_sum<T>(data, input.length); }));
+      }
+    });
+  }
+
+  auto array_min(const RuntimeRef<StorageCell> &array) -> RuntimeRef<StorageCell>
+  {
+    return array_extreme<false>("min", array);
+  }
+
+  auto array_max(const RuntimeRef<StorageCell> &array) -> RuntimeRef<StorageCell>
+  {
+    return array_extreme<true>("max", array);
+  }
+
+  auto array_dot(const RuntimeRef<StorageCell> &left, const RuntimeRef<StorageCell> &right) -> RuntimeRef<StorageCell>
+  {
+    auto [leftInput, rightInput] = packed_inputs("dot", left, right);
+    if (!leftInput.cell || !rightInput.cell)
+    {
+      return numeral_cell_from_value<int32_t>(0);
+    }
+    return visit_numeral("dot", leftInput.type, [&]<class T>(std::type_identity<T>) {
+      const auto *lhs = element_data<T>(leftInput.cell);
+      const auto *rhs = element_data<T>(rightInput.cell);
+      auto length = leftInput.length;
+      if constexpr (CHECKED_INTEGER<T> && sizeof(T) <= sizeof(int16_t))
+      {
+        auto total = dispatch([&] { return lane_dot<int64_t>(lhs, rhs, length); });
+        if (!fits<T>(total))
+        {
+          throw RuntimeException("Integer overflow in addition");
+        }
+        return numeral_cell_from_value<T>(static_cast<T>(total));
+      }
+      else if constexpr (CHECKED_INTEGER<T>)
+      {
+        // Products of wide integers need 128 bits, which does not vectorize; keep it exact instead.
+        __int128 total = 0;
+        for (size_t i = 0; i < length; ++i)
+        {
+          if (__builtin_add_overflow(total, static_cast<__int128>(lhs[i]) * rhs[i], &total))
+          {
+            throw RuntimeException("Integer overflow in addition");
+          }
+        }
+        if (!fits<T>(total))
+        {
+          throw RuntimeException("Integer overflow in addition");
+        }
+        return numeral_cell_from_value<T>(static_cast<T>(total));
+      }
+      else
+      {
+        return numeral_cell_from_value<T>(dispatch([&] { return lane_dot<T>(lhs, rhs, length); }));
+      }
+    });
+  }
+
+  auto array_scale(const RuntimeRef<StorageCell> &array, const RuntimeRef<StorageCell> &factor)
+      -> RuntimeRef<StorageCell>
+  {
+    auto input = packed_input("scale", array);
+    if (!input.cell)
+    {
+      return empty_array();
+    }
+    return visit_numeral("scale", input.type, [&]<class T>(std::type_identity<T>) {
+      const auto *data = element_data<T>(input.cell);
+      auto scalar = scalar_value<T>(factor);
+      bool overflow = false;
+      auto result = make_packed_result<T>(input.length, [&](T *out) {
+        overflow = dispatch([&] {
+          bool overflowed = false;
+          for (size_t i = 0; i < input.length; ++i)
+          {
+            if constexpr (CHECKED_INTEGER<T> && sizeof(T) < sizeof(int64_t))
+            {
+              auto product = static_cast<int64_t>(data[i]) * scalar;
+              overflowed |= !fits<T>(product);
+              out[i] = static_cast<T>(product);
+            }
+            else if constexpr (CHECKED_INTEGER<T>)
+            {
+              overflowed |= __builtin_mul_overflow(data[i], scalar, &out[i]);
+            }
+            else
+            {
+              out[i] = static_cast<T>(data[i] * scalar);
+            }
+          }
+          return overflowed;
+        });
+      });
+      if (overflow)
+      {
+        throw RuntimeException("Integer overflow in multiplication");
+      }
+      return result;
+    });
+  }
+
+  auto array_add(const RuntimeRef<StorageCell> &left, const RuntimeRef<StorageCell> &right) -> RuntimeRef<StorageCell>
+  {
+    auto [leftInput, rightInput] = packed_inputs("add", left, right);
+    if (!leftInput.cell || !rightInput.cell)
+    {
+      return empty_array();
+    }
+    return visit_numeral("add", leftInput.type, [&]<class T>(std::type_identity<T>) {
+      const auto *lhs = element_data<T>(leftInput.cell);
+      const auto *rhs = element_data<T>(rightInput.cell);
+      auto length = leftInput.length;
+      bool overflow = false;
+      auto result = make_packed_result<T>(length, [&](T *out) {
+        overflow = dispatch([&] {
+          bool overflowed = false;
+          for (size_t i = 0; i < length; ++i)
+          {
+            if constexpr (CHECKED_INTEGER<T>)
+            {
+              overflowed |= __builtin_add_overflow(lhs[i], rhs[i], &out[i]);
+            }
+            else
+            {
+              out[i] = static_cast<T>(lhs[i] + rhs[i]);
+            }
+          }
+          return overflowed;
+        });
+      });
+      if (overflow)
+      {
+        throw RuntimeException("Integer overflow in addition");
+      }
+      return result;
+    });
+  }
+
+  auto array_fill(const RuntimeRef<StorageCell> &array, const RuntimeRef<StorageCell> &value) -> RuntimeRef<StorageCell>
+  {
+    auto input = packed_input("fill", array);
+    if (!input.cell)
+    {
+      return empty_array();
+    }
+    return visit_element("fill", input.type, [&]<class T>(std::type_identity<T>) {
+      auto scalar = scalar_value<T>(value);
+      return make_packed_result<T>(input.length, [&](T *out) {
+        dispatch([&] { std::fill_n(out, input.length, scalar); });
+      });
+    });
+  }
+
+  auto array_index_of(const RuntimeRef<StorageCell> &array, const RuntimeRef<StorageCell> &value) -> int32_t
+  {
+    auto input = packed_input("indexOf", array);
+    if (!input.cell)
+    {
+      return -1;
+    }
+    return visit_element("indexOf", input.type, [&]<class T>(std::type_identity<T>) -> int32_t {
+      const auto *data = element_data<T>(input.cell);
+      auto scalar = scalar_value<T>(value);
+      return dispatch([&]() -> int32_t {
+        // Test a chunk without branching first, so the common miss stays vectorized.
+        for (size_t base = 0; base < input.length; base += SEARCH_CHUNK)
+        {
+          auto end = std::min(input.length, base + SEARCH_CHUNK);
+          bool found = false;
+          for (size_t i = base; i < end; ++i)
+          {
+            found |= data[i] == scalar;
+          }
+          if (!found)
+          {
+            continue;
+          }
+          for (size_t i = base; i < end; ++i)
+          {
+            if (data[i] == scalar)
+            {
+              return static_cast<int32_t>(i);
+            }
+          }
+        }
+        return -1;
+      });
+    });
+  }
+
+  auto array_count(const RuntimeRef<StorageCell> &array, const RuntimeRef<StorageCell> &value) -> int32_t
+  {
+    auto input = packed_input("count", array);
+    if (!input.cell)
+    {
+      return 0;
+    }
+    return visit_element("count", input.type, [&]<class T>(std::type_identity<T>) -> int32_t {
+      const auto *data = element_data<T>(input.cell);
+      auto scalar = scalar_value<T>(value);
+      return dispatch([&] {
+        uint32_t matches = 0;
+        for (size_t i = 0; i < input.length; ++i)
+        {
+          matches += data[i] == scalar ? 1U : 0U;
+        }
+        return static_cast<int32_t>(matches);
+      });
+    });
+  }
+
+  auto array_prefix_sum(const RuntimeRef<StorageCell> &array) -> RuntimeRef<StorageCell>
+  {
+    auto input = packed_input("prefixSum", array);
+    if (!input.cell)
+    {
+      return empty_array();
+    }
+    return visit_numeral("prefixSum", input.type, [&]<class T>(std::type_identity<T>) {
+      const auto *data = element_data<T>(input.cell);
+      bool overflow = false;
+      auto result = make_packed_result<T>(input.length, [&](T *out) {
+        // Each sum depends on the previous one, so there is nothing to vectorize.
+        if constexpr (CHECKED_INTEGER<T> && sizeof(T) < sizeof(int64_t))
+        {
+          int64_t running = 0;
+          for (size_t i = 0; i < input.length; ++i)
+          {
+            running += data[i];
+            overflow |= !fits<T>(running);
+            out[i] = static_cast<T>(running);
+          }
+        }
+        else if constexpr (CHECKED_INTEGER<T>)
+        {
+          T running = 0;
+          for (size_t i = 0; i < input.length; ++i)
+          {
+            overflow |= __builtin_add_overflow(running, data[i], &running);
+            out[i] = running;
+          }
+        }
+        else
+        {
+          T running = 0;
+          for (size_t i = 0; i < input.length; ++i)
+          {
+            running = static_cast<T>(running + data[i]);
+            out[i] = running;
+          }
+        }
+      });
+      if (overflow)
+      {
+        throw RuntimeException("Integer overflow in addition");
+      }
+      return result;
+    });
+  }
+
+  auto array_compare(const RuntimeRef<StorageCell> &left, const RuntimeRef<StorageCell> &right, Comparison comparison)
+      -> RuntimeRef<StorageCell>
+  {
+    Str function = comparison == Comparison::Equal ? "equalTo" : comparison == Comparison::Less ? "lessThan" : "greaterThan";
+    auto [leftInput, rightInput] = packed_inputs(function, left, right);
+    if (!leftInput.cell || !rightInput.cell)
+    {
+      return empty_array();
+    }
+    auto compare = [&]<class T>(std::type_identity<T>) {
+      const auto *lhs = element_data<T>(leftInput.cell);
+      const auto *rhs = element_data<T>(rightInput.cell);
+      auto length = leftInput.length;
+      return make_packed_result<bool>(length, [&](bool *out) {
+        dispatch([&] {
+          for (size_t i = 0; i < length; ++i)
+          {
+            switch (comparison)
+            {
+            case Comparison::Equal:
+              out[i] = lhs[i] == rhs[i];
+              break;
+            case Comparison::Less:
+              out[i] = lhs[i] < rhs[i];
+              break;
+            case Comparison::Greater:
+              out[i] = lhs[i] > rhs[i];
+              break;
+            }
+          }
+        });
+      });
+    };
+    if (comparison == Comparison::Equal)
+    {
+      return visit_element(function, leftInput.type, compare);
+    }
+    return visit_numeral(function, leftInput.type, compare);
+  }
+
+  auto fold_with_kernel(FoldKernel kernel, const RuntimeRef<StorageCell> &init, const RuntimeRef<StorageCell> &sequence,
+                        bool fromRight) -> RuntimeRef<StorageCell>
+  {
+    auto type = runtime_array_packed_type(sequence);
+    if (!type || !init || init->runtimeType != type || type == boolean_runtime_type())
+    {
+      return nullptr;
+    }
+    return visit_numeral("fold", type, [&]<class T>(std::type_identity<T>) -> RuntimeRef<StorageCell> {
+      const auto *data = element_data<T>(sequence);
+      auto length = runtime_array_length(sequence);
+      auto seed = read_inline_cell_bytes<T>(init);
+      if (kernel == FoldKernel::Sum)
+      {
+        if constexpr (std::floating_point<T>)
+        {
+          // Rounding depends on the order, so add in the order the fold function would.
+          T acc = seed;
+          for (size_t i = 0; i < length; ++i)
+          {
+            acc = static_cast<T>(acc + data[fromRight ? length - 1 - i : i]);
+          }
+          return numeral_cell_from_value<T>(acc);
+        }
+        else if constexpr (CHECKED_INTEGER<T>)
+        {
+          auto total = static_cast<Wide<T>>(seed) + dispatch([&] { return lane_sum<Wide<T>>(data, length); });
+          bool monotonic = length == 0 ||
+                           (seed >= 0 && dispatch([&] { return lane_extreme<false>(data, length); }) >= 0) ||
+                           (seed <= 0 && dispatch([&] { return lane_extreme<true>(data, length); }) <= 0);
+          if (monotonic)
+          {
+            // Partial sums only move towards the total, so checking it covers them all.
+            if (!fits<T>(total))
+            {
+              throw RuntimeException("Integer overflow in addition");
+            }
+            return numeral_cell_from_value<T>(static_cast<T>(total));
+          }
+          // With mixed signs a partial sum can overflow even when the total fits.
+          T acc = seed;
+          for (size_t i = 0; i < length; ++i)
+          {
+            acc = checked_add(acc, data[fromRight ? length - 1 - i : i]);
+          }
+          return numeral_cell_from_value<T>(acc);
+        }
+        else
+        {
+          return numeral_cell_from_value<T>(static_cast<T>(seed + dispatch([&] { return lane_sum<T>(data, length); })));
+        }
+      }
+      if constexpr (std::floating_point<T>)
+      {
+        // NaN and signed zeros make a floating-point minimum depend on how the function compares.
+        return nullptr;
+      }
+      else
+      {
+        if (length == 0)
+        {
+          return numeral_cell_from_value<T>(seed);
+        }
+        if (kernel == FoldKernel::Min)
+        {
+          return numeral_cell_from_value<T>(std::min(seed, dispatch([&] { return lane_extreme<false>(data, length); })));
+        }
+        return numeral_cell_from_value<T>(std::max(seed, dispatch([&] { return lane_extreme<true>(data, length); })));
+      }
+    });
+  }
+
+  auto array_sort(const RuntimeRef<StorageCell> &array, bool stable, bool descending) -> RuntimeRef<StorageCell>
+  {
+    auto packed = packed_elements(stable ? "stableSort" : "sort", array);
+    if (packed)
+    {
+      return visit_element("sort", runtime_array_packed_type(packed), [&]<class T>(std::type_identity<T>) {
+        auto length = runtime_array_length(packed);
+        return make_packed_result<T>(length, [&](T *out) {
+          std::copy_n(element_data<T>(packed), length, out);
+          sort_elements(out, length, stable, descending);
+        });
+      });
+    }
+    auto slots = runtime_array_slots(array);
+    auto less = [descending](const auto &left, const auto &right) {
+      return descending ? sort_less(right, left) : sort_less(left, right);
+    };
+    if (stable)
+    {
+      std::stable_sort(slots.begin(), slots.end(), less);
+    }
+    else
+    {
+      std::sort(slots.begin(), slots.end(), less);
+    }
+    return cloned_array(slots, slots.size());
+  }
+
+  auto array_partial_sort(const RuntimeRef<StorageCell> &array, int32_t count) -> RuntimeRef<StorageCell>
+  {
+    if (count < 0)
+    {
+      throw RuntimeException("partialSort() requires a non-negative element count");
+    }
+    auto packed = packed_elements("partialSort", array);
+    if (packed)
+    {
+      return visit_element("partialSort", runtime_array_packed_type(packed), [&]<class T>(std::type_identity<T>) {
+        auto length = runtime_array_length(packed);
+        const auto *data = element_data<T>(packed);
+        require_ordered_numbers(data, length);
+        auto items = std::make_unique<T[]>(length);
+        std::copy_n(data, length, items.get());
+        auto kept = std::min(static_cast<size_t>(count), length);
+        std::partial_sort(items.get(), items.get() + kept, items.get() + length);
+        return make_packed_result<T>(kept, [&](T *out) { std::copy_n(items.get(), kept, out); });
+      });
+    }
+    auto slots = runtime_array_slots(array);
+    auto kept = std::min(static_cast<size_t>(count), slots.size());
+    std::partial_sort(slots.begin(), slots.begin() + static_cast<ptrdiff_t>(kept), slots.end(), sort_less);
+    return cloned_array(slots, kept);
+  }
+
+  auto array_nth_element(const RuntimeRef<StorageCell> &array, int32_t index) -> RuntimeRef<StorageCell>
+  {
+    auto packed = packed_elements("nthElement", array);
+    auto length = packed ? runtime_array_length(packed) : runtime_array_length(array);
+    if (index < 0 || static_cast<size_t>(index) >= length)
+    {
+      throw RuntimeException("nthElement() index out of range");
+    }
+    auto nth = static_cast<ptrdiff_t>(index);
+    if (packed)
+    {
+      return visit_element("nthElement", runtime_array_packed_type(packed),
+                           [&]<class T>(std::type_identity<T>) -> RuntimeRef<StorageCell> {
+                             const auto *data = element_data<T>(packed);
+                             require_ordered_numbers(data, length);
+                             auto items = std::make_unique<T[]>(length);
+                             std::copy_n(data, length, items.get());
+                             std::nth_element(items.get(), items.get() + nth, items.get() + length);
+                             if constexpr (std::same_as<T, bool>)
+                             {
+                               return make_runtime_boolean(items[index]);
+                             }
+                             else
+                             {
+                               return numeral_cell_from_value<T>(items[index]);
+                             }
+                           });
+    }
+    auto slots = runtime_array_slots(array);
+    std::nth_element(slots.begin(), slots.begin() + nth, slots.end(), sort_less);
+    return clone_runtime_storage_cell(slots[index], StorageClass::TEMPORARY);
+  }
+
+  auto array_sort_by_keys(const RuntimeRef<StorageCell> &array, const Vec<RuntimeRef<StorageCell>> &keys)
+      -> RuntimeRef<StorageCell>
+  {
+    auto slots = runtime_array_slots(array);
+    if (keys.size() != slots.size())
+    {
+      throw RuntimeException("sortBy() requires one key per element");
+    }
+    Vec<size_t> order(slots.size());
+    std::iota(order.begin(), order.end(), size_t{0});
+    auto packedKeys = keys.empty() ? nullptr : make_runtime_array_cell(keys);
+    if (packedKeys && runtime_array_is_packed(packedKeys))
+    {
+      visit_element("sortBy", runtime_array_packed_type(packedKeys), [&]<class T>(std::type_identity<T>) {
+        const auto *data = element_data<T>(packedKeys);
+        require_ordered_numbers(data, keys.size());
+        std::stable_sort(order.begin(), order.end(), [data](size_t left, size_t right) { return data[left] < data[right]; });
+      });
+    }
+    else
+    {
+      std::stable_sort(order.begin(), order.end(),
+                       [&keys](size_t left, size_t right) { return sort_less(keys[left], keys[right]); });
+    }
+    Vec<RuntimeRef<StorageCell>> sorted;
+    sorted.reserve(order.size());
+    for (auto position : order)
+    {
+      sorted.push_back(slots[position]);
+    }
+    return cloned_array(sorted, sorted.size());
+  }
+
+  auto array_sort_with(const RuntimeRef<StorageCell> &array, const SortComparator &less) -> RuntimeRef<StorageCell>
+  {
+    auto slots = runtime_array_slots(array);
+    merge_sort(slots, less);
+    return cloned_array(slots, slots.size());
+  }
+} // namespace NG::runtime::kernels
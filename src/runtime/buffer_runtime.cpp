@@ -294,6 +294,34 @@ namespace NG::buffer_runtime
     };
   }
 
+  auto make_packed_array_layout(const TypeLayout &element, Str name) -> TypeLayout
+  {
+    // Elements sit back to back in the cell bytes; the layout size is the element stride.
+    return TypeLayout{
+        .name = std::move(name) + ".packed",
+        .kind = LayoutKind::DYNAMIC,
+        .size = element.size,
+        .alignment = element.alignment,
+        .fields =
+            {
+                FieldLayout{.name = element.name, .layoutId = element.id, .offset = 0, .size = element.size, .alignment = element.alignment},
+            },
+        .containsPointers = false,
+        .triviallyCopyable = true,
+        .triviallyMovable = true,
+    };
+  }
+
+  auto packed_array_element_field(const TypeLayout &layout) -> const FieldLayout *
+  {
+    static constexpr std::string_view suffix = ".packed";
+    if (layout.fields.size() != 1 || layout.size == 0 || !layout.name.ends_with(suffix))
+    {
+      return nullptr;
+    }
+    return &layout.fields.front();
+  }
+
   auto make_string_header_layout(Str name) -> TypeLayout
   {
     auto handleLayout = make_native_handle_layout(name + ".buffer");
@@ -3,9 +3,15 @@
 #include <module.hpp>
 #include <orgasm/native_bridge.hpp>
 #include <orgasm/vm.hpp>
+#include <runtime/array_kernels.hpp>
+#include <runtime/btree.hpp>
+#include <runtime/chunk_list.hpp>
+#include <runtime/hash_table.hpp>
 #include <runtime/native_marshaling.hpp>
+#include <runtime/regex.hpp>
 #include <runtime/value_access.hpp>
 #include <runtime/string_layout_access.hpp>
+#include <runtime/text_slices.hpp>
 #include <sysdep/process.hpp>
 #include <algorithm>
 #include <array>
@@ -17,7 +23,6 @@
 #include <fstream>
 #include <initializer_list>
 #include <iostream>
-#include <regex>
 #include <cstdlib>
 #ifndef _WIN32
 #include <sys/wait.h>
@@ -37,76 +42,84 @@ namespace NG::library::prelude
     return line;
   }
 
-  static auto read_file_native(Str path) -> Str
+  static auto read_file_native(std::string_view path) -> Str
   {
-    std::ifstream file(path);
+    std::ifstream file{Str(path)};
     if (!file.is_open())
     {
-      throw RuntimeException("readFile() failed to open: " + path);
+      throw RuntimeException("readFile() failed to open: " + Str(path));
     }
     return Str((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
   }
 
-  static void write_file_native(Str path, Str content)
+  static void write_file_native(std::string_view path, std::string_view content)
   {
-    std::ofstream file(path);
+    std::ofstream file{Str(path)};
     if (!file.is_open())
     {
-      throw RuntimeException("writeFile() failed to open: " + path);
+      throw RuntimeException("writeFile() failed to open: " + Str(path));
     }
     file << content;
     if (!file.good())
     {
-      throw RuntimeException("writeFile() failed to write: " + path);
+      throw RuntimeException("writeFile() failed to write: " + Str(path));
     }
   }
 
-  static auto trim_native(Str s) -> Str
+  static auto trim_native(std::string_view s) -> std::string_view
   {
     size_t start = s.find_first_not_of(" \t\n\r");
     size_t end = s.find_last_not_of(" \t\n\r");
-    return start == Str::npos ? Str{} : s.substr(start, end - start + 1);
+    return start == std::string_view::npos ? std::string_view{} : s.substr(start, end - start + 1);
   }
 
-  static auto contains_native(Str str, Str sub) -> bool
+  static auto contains_native(std::string_view str, std::string_view sub) -> bool
   {
-    return str.find(sub) != Str::npos;
+    return str.find(sub) != std::string_view::npos;
   }
 
-  static auto replace_native(Str result, Str oldValue, Str newValue) -> Str
+  static auto replace_native(std::string_view source, std::string_view oldValue, std::string_view newValue) -> Str
   {
-    if (!oldValue.empty())
+    if (oldValue.empty())
     {
-      size_t pos = 0;
-      while ((pos = result.find(oldValue, pos)) != Str::npos)
-      {
-        result.replace(pos, oldValue.size(), newValue);
-        pos += newValue.size();
-      }
+      return Str(source);
     }
+    Str result;
+    result.reserve(source.size());
+    size_t start = 0;
+    size_t pos = 0;
+    while ((pos = source.find(oldValue, start)) != std::string_view::npos)
+    {
+      result.append(source, start, pos - start);
+      result.append(newValue);
+      start = pos + oldValue.size();
+    }
+    result.append(source, start);
     return result;
   }
 
-  static auto starts_with_native(Str str, Str prefix) -> bool
+  static auto starts_with_native(std::string_view str, std::string_view prefix) -> bool
   {
     return str.starts_with(prefix);
   }
 
-  static auto ends_with_native(Str str, Str suffix) -> bool
+  static auto ends_with_native(std::string_view str, std::string_view suffix) -> bool
   {
     return str.ends_with(suffix);
   }
 
-  static auto to_upper_native(Str result) -> Str
+  static auto to_upper_native(std::string_view source) -> Str
   {
-    std::transform(result.begin(), result.end(), result.begin(),
+    Str result(source.size(), '\0');
+    std::transform(source.begin(), source.end(), result.begin(),
                    [](unsigned char ch) { return static_cast<char>(std::toupper(ch)); });
     return result;
   }
 
-  static auto to_lower_native(Str result) -> Str
+  static auto to_lower_native(std::string_view source) -> Str
   {
-    std::transform(result.begin(), result.end(), result.begin(),
+    Str result(source.size(), '\0');
+    std::transform(source.begin(), source.end(), result.begin(),
                    [](unsigned char ch) { return static_cast<char>(std::tolower(ch)); });
     return result;
   }
@@ -190,7 +203,7 @@ namespace NG::library::prelude
 #endif
   }
 
-  static auto validate_ngi_script_path(const Str &path) -> bool
+  static auto validate_ngi_script_path(std::string_view path) -> bool
   {
     if (path.empty() || !path.ends_with(".ng"))
     {
@@ -209,7 +222,7 @@ namespace NG::library::prelude
     });
   }
 
-  static auto run_ngi_native(Str path) -> Str
+  static auto run_ngi_native(std::string_view path) -> Str
   {
     if (!validate_ngi_script_path(path))
     {
@@ -220,19 +233,26 @@ namespace NG::library::prelude
     {
       throw RuntimeException("runNgi() could not resolve current executable path");
     }
-    return run_child_process(executable, path);
+    return run_child_process(executable, Str(path));
   }
 
-  static auto regex_match_native(Str value, Str pattern) -> bool
+  /**
+   * Wraps a std.array kernel taking an array and `extraArgs` further arguments.
+   */
+  template <class Kernel>
+  static auto array_kernel_handler(Str name, size_t extraArgs, Kernel kernel) -> NGCallable
   {
-    try
-    {
-      return std::regex_search(value, std::regex(pattern));
-    }
-    catch (const std::regex_error &ex)
-    {
-      throw RuntimeException("regexMatch() invalid regex: " + Str(ex.what()));
-    }
+    return [name = std::move(name), extraArgs, kernel](const NGSelf &, const NGEnv &context,
+                                                       const NGArgs &args) -> RuntimeRef<StorageCell> {
+      auto nativeArgs = native_args_view(context, args);
+      require_arg_count(name, nativeArgs, 1 + extraArgs, 1 + extraArgs);
+      auto array = require_array_arg_slot(name, nativeArgs, 0, "an array");
+      if (extraArgs == 0)
+      {
+        return kernel(array, nullptr);
+      }
+      return kernel(array, require_arg_slot(name, nativeArgs, 1, "an array or element value"));
+    };
   }
 
   static auto native_allocation_count() -> int32_t &
@@ -264,6 +284,158 @@ namespace NG::library::prelude
     slot->lifecycleDropped = true;
   }
 
+  /**
+   * Reads the `ref<HashTable<K, V>>` argument; std.hashmap passes tables by reference so calls do not copy them.
+   */
+  static auto require_hash_table_arg(const Str &functionName, const NativeArgsView &args) -> RuntimeRef<StorageCell>
+  {
+    auto table = require_arg_slot(functionName, args, 0, "a HashTable reference");
+    while (runtime_is_reference_value(table))
+    {
+      table = runtime_reference_target(table);
+    }
+    if (!runtime_is_hash_table_value(table))
+    {
+      throw RuntimeException(functionName + "() requires a HashTable reference at argument 1");
+    }
+    return table;
+  }
+
+  /**
+   * Wraps a std.hashmap native taking a table reference and `extraArgs` further arguments.
+   */
+  template <class Handler>
+  static auto hash_table_handler(Str name, size_t extraArgs, Handler handler) -> NGCallable
+  {
+    return [name = std::move(name), extraArgs, handler](const NGSelf &, const NGEnv &context,
+                                                        const NGArgs &args) -> RuntimeRef<StorageCell> {
+      auto nativeArgs = native_args_view(context, args);
+      require_arg_count(name, nativeArgs, extraArgs + 1, extraArgs + 1);
+      return handler(require_hash_table_arg(name, nativeArgs), nativeArgs);
+    };
+  }
+
+  /**
+   * Reads a key or value argument; aggregates may arrive as references to the caller's value.
+   */
+  static auto collection_element_arg(const NativeArgsView &args, size_t index) -> RuntimeRef<StorageCell>
+  {
+    auto element = args.slot_at(index);
+    while (runtime_is_reference_value(element))
+    {
+      element = runtime_reference_target(element);
+    }
+    return element;
+  }
+
+  static auto collection_index_arg(const Str &functionName, const NativeArgsView &args) -> size_t
+  {
+    auto index = require_numeric_arg<int32_t>(functionName, args, 1, "an entry index");
+    if (index < 0)
+    {
+      throw RuntimeException(functionName + "() requires a non-negative entry index");
+    }
+    return static_cast<size_t>(index);
+  }
+
+  /**
+   * Reads the `ref<BTree<K, V>>` or `ref<BTreeRange<K, V>>` argument of a std.collections native.
+   */
+  static auto require_btree_arg(const Str &functionName, const NativeArgsView &args, bool range)
+      -> RuntimeRef<StorageCell>
+  {
+    auto kind = range ? Str{"BTreeRange"} : Str{"BTree"};
+    auto tree = require_arg_slot(functionName, args, 0, "a " + kind + " reference");
+    while (runtime_is_reference_value(tree))
+    {
+      tree = runtime_reference_target(tree);
+    }
+    if (range ? !runtime_is_btree_range_value(tree) : !runtime_is_btree_value(tree))
+    {
+      throw RuntimeException(functionName + "() requires a " + kind + " reference at argument 1");
+    }
+    return tree;
+  }
+
+  /**
+   * Wraps a std.collections native taking a tree or range reference and `extraArgs` further arguments.
+   */
+  template <class Handler>
+  static auto btree_handler(Str name, size_t extraArgs, bool range, Handler handler) -> NGCallable
+  {
+    return [name = std::move(name), extraArgs, range, handler](const NGSelf &, const NGEnv &context,
+                                                               const NGArgs &args) -> RuntimeRef<StorageCell> {
+      auto nativeArgs = native_args_view(context, args);
+      require_arg_count(name, nativeArgs, extraArgs + 1, extraArgs + 1);
+      return handler(require_btree_arg(name, nativeArgs, range), nativeArgs);
+    };
+  }
+
+  /**
+   * Reads the `ref<ChunkList<T>>` argument of a std.list native.
+   */
+  static auto require_chunk_list_arg(const Str &functionName, const NativeArgsView &args) -> RuntimeRef<StorageCell>
+  {
+    auto list = require_arg_slot(functionName, args, 0, "a ChunkList reference");
+    while (runtime_is_reference_value(list))
+    {
+      list = runtime_reference_target(list);
+    }
+    if (!runtime_is_chunk_list_value(list))
+    {
+      throw RuntimeException(functionName + "() requires a ChunkList reference at argument 1");
+    }
+    return list;
+  }
+
+  /**
+   * Wraps a std.list native taking a list reference and `extraArgs` further arguments.
+   */
+  template <class Handler>
+  static auto chunk_list_handler(Str name, size_t extraArgs, Handler handler) -> NGCallable
+  {
+    return [name = std::move(name), extraArgs, handler](const NGSelf &, const NGEnv &context,
+                                                        const NGArgs &args) -> RuntimeRef<StorageCell> {
+      auto nativeArgs = native_args_view(context, args);
+      require_arg_count(name, nativeArgs, extraArgs + 1, extraArgs + 1);
+      return handler(require_chunk_list_arg(name, nativeArgs), nativeArgs);
+    };
+  }
+
+  /**
+   * Reads the `ref<TextSlices>` argument of a std.string native.
+   */
+  static auto require_text_slices_arg(const Str &functionName, const NativeArgsView &args) -> RuntimeRef<StorageCell>
+  {
+    auto slices = require_arg_slot(functionName, args, 0, "a TextSlices reference");
+    while (runtime_is_reference_value(slices))
+    {
+      slices = runtime_reference_target(slices);
+    }
+    if (!runtime_is_text_slices_value(slices))
+    {
+      throw RuntimeException(functionName + "() requires a TextSlices reference at argument 1");
+    }
+    return slices;
+  }
+
+  /**
+   * Reads the `ref<RegexProgram>` argument of a std.string native.
+   */
+  static auto require_regex_arg(const Str &functionName, const NativeArgsView &args) -> RuntimeRef<StorageCell>
+  {
+    auto regex = require_arg_slot(functionName, args, 0, "a Regex reference");
+    while (runtime_is_reference_value(regex))
+    {
+      regex = runtime_reference_target(regex);
+    }
+    if (!runtime_is_regex_value(regex))
+    {
+      throw RuntimeException(functionName + "() requires a Regex reference at argument 1");
+    }
+    return regex;
+  }
+
   static Map<Str, NGCallable> handlers{
     {"print",
      [](const NGSelf &, const NGEnv &context, const NGArgs &args) -> RuntimeRef<StorageCell> {
@@ -306,7 +478,7 @@ namespace NG::library::prelude
        }
        if (runtime_is_string_value(slot))
        {
-         return numeral_cell_from_value<uint32_t>(static_cast<uint32_t>(runtime_string_value(slot).size()));
+         return numeral_cell_from_value<uint32_t>(static_cast<uint32_t>(runtime_string_view(slot).size()));
        }
        throw RuntimeException("len() requires an array or string at argument 1");
      }},
@@ -316,8 +488,8 @@ namespace NG::library::prelude
     {"split",
      [](const NGSelf &, const NGEnv &context, const NGArgs &args) -> RuntimeRef<StorageCell> {
        auto nativeArgs = native_args_view(context, args);
-       auto s = require_string_arg("split", nativeArgs, 0, "a source string");
-       auto d = require_string_arg("split", nativeArgs, 1, "a string delimiter");
+       auto s = require_string_view_arg("split", nativeArgs, 0, "a source string");
+       auto d = require_string_view_arg("split", nativeArgs, 1, "a string delimiter");
        auto items = makert<Vec<RuntimeRef<StorageCell>>>();
        if (d.empty())
        {
@@ -330,12 +502,12 @@ namespace NG::library::prelude
        {
          size_t start = 0;
          size_t pos;
-         while ((pos = s.find(d, start)) != Str::npos)
+         while ((pos = s.find(d, start)) != std::string_view::npos)
          {
-           items->push_back(make_runtime_string(s.substr(start, pos - start)));
+           items->push_back(make_runtime_string(Str(s.substr(start, pos - start))));
            start = pos + d.size();
          }
-         items->push_back(make_runtime_string(s.substr(start)));
+         items->push_back(make_runtime_string(Str(s.substr(start))));
        }
        return make_runtime_array_cell(*items);
      }},
@@ -343,7 +515,7 @@ namespace NG::library::prelude
      [](const NGSelf &, const NGEnv &context, const NGArgs &args) -> RuntimeRef<StorageCell> {
        auto nativeArgs = native_args_view(context, args);
        auto arrObj = require_array_arg_slot("join", nativeArgs, 0, "an array");
-       auto sep = require_string_arg("join", nativeArgs, 1, "a string separator");
+       auto sep = require_string_view_arg("join", nativeArgs, 1, "a string separator");
        Str result;
        auto items = runtime_array_slots(arrObj);
        for (size_t i = 0; i < items.size(); ++i)
@@ -352,7 +524,14 @@ namespace NG::library::prelude
          {
            result += sep;
          }
-         result += runtime_value_show(items[i]);
+         if (runtime_is_string_value(items[i]))
+         {
+           result += runtime_string_view(items[i]);
+         }
+         else
+         {
+           result += runtime_value_show(items[i]);
+         }
        }
        return make_runtime_string(result);
      }},
@@ -365,7 +544,129 @@ namespace NG::library::prelude
     {"toLower", NG::orgasm::wrap_native_callable(to_lower_native)},
     {"currentExecutablePath", NG::orgasm::wrap_native_callable(current_executable_path_native)},
     {"runNgi", NG::orgasm::wrap_native_callable(run_ngi_native)},
-    {"regexMatch", NG::orgasm::wrap_native_callable(regex_match_native)},
+    {"regexMatch", NG::orgasm::wrap_native_callable(regex_match_cached)},
+    {"regexCompile",
+     [](const NGSelf &, const NGEnv &context, const NGArgs &args) -> RuntimeRef<StorageCell> {
+       auto nativeArgs = native_args_view(context, args);
+       require_arg_count("regexCompile", nativeArgs, 1, 1);
+       return make_runtime_regex_cell(require_string_view_arg("regexCompile", nativeArgs, 0, "a pattern string"));
+     }},
+    {"regexMatches",
+     [](const NGSelf &, const NGEnv &context, const NGArgs &args) -> RuntimeRef<StorageCell> {
+       auto nativeArgs = native_args_view(context, args);
+       require_arg_count("regexMatches", nativeArgs, 2, 2);
+       auto regex = require_regex_arg("regexMatches", nativeArgs);
+       return make_runtime_boolean(
+           regex_matches(regex, require_string_view_arg("regexMatches", nativeArgs, 1, "a string")));
+     }},
+    {"regexFind",
+     [](const NGSelf &, const NGEnv &context, const NGArgs &args) -> RuntimeRef<StorageCell> {
+       auto nativeArgs = native_args_view(context, args);
+       require_arg_count("regexFind", nativeArgs, 2, 2);
+       auto regex = require_regex_arg("regexFind", nativeArgs);
+       auto text = require_string_view_arg("regexFind", nativeArgs, 1, "a string");
+       auto slots = regex_search(regex, text);
+       return NG::orgasm::to_ng(slots.empty() ? std::string_view{}
+                                  : text.substr(static_cast<size_t>(slots[0]),
+                                                static_cast<size_t>(slots[1] - slots[0])));
+     }},
+    {"regexFindAll",
+     [](const NGSelf &, const NGEnv &context, const NGArgs &args) -> RuntimeRef<StorageCell> {
+       auto nativeArgs = native_args_view(context, args);
+       require_arg_count("regexFindAll", nativeArgs, 2, 2);
+       auto regex = require_regex_arg("regexFindAll", nativeArgs);
+       require_string_view_arg("regexFindAll", nativeArgs, 1, "a string");
+       return make_runtime_regex_slices_cell(nativeArgs.slot_at(1), regex);
+     }},
+    {"regexCaptures",
+     [](const NGSelf &, const NGEnv &context, const NGArgs &args) -> RuntimeRef<StorageCell> {
+       auto nativeArgs = native_args_view(context, args);
+       require_arg_count("regexCaptures", nativeArgs, 2, 2);
+       auto regex = require_regex_arg("regexCaptures", nativeArgs);
+       auto text = require_string_view_arg("regexCaptures", nativeArgs, 1, "a string");
+       auto slots = regex_search(regex, text);
+       Vec<RuntimeRef<StorageCell>> groups;
+       for (size_t i = 0; i + 1 < slots.size(); i += 2)
+       {
+         groups.push_back(make_runtime_string(
+             slots[i] < 0 ? Str{}
+                          : Str(text.substr(static_cast<size_t>(slots[i]), static_cast<size_t>(slots[i + 1] - slots[i])))));
+       }
+       return make_runtime_array_cell(groups);
+     }},
+    {"regexReplaceAll",
+     [](const NGSelf &, const NGEnv &context, const NGArgs &args) -> RuntimeRef<StorageCell> {
+       auto nativeArgs = native_args_view(context, args);
+       require_arg_count("regexReplaceAll", nativeArgs, 3, 3);
+       auto regex = require_regex_arg("regexReplaceAll", nativeArgs);
+       return make_runtime_string(
+           regex_replace_all(regex, require_string_view_arg("regexReplaceAll", nativeArgs, 1, "a string"),
+                             require_string_view_arg("regexReplaceAll", nativeArgs, 2, "a replacement string")));
+     }},
+    {"splitSlices",
+     [](const NGSelf &, const NGEnv &context, const NGArgs &args) -> RuntimeRef<StorageCell> {
+       auto nativeArgs = native_args_view(context, args);
+       require_arg_count("splitSlices", nativeArgs, 2, 2);
+       require_string_view_arg("splitSlices", nativeArgs, 0, "a source string");
+       return make_runtime_split_slices_cell(
+           nativeArgs.slot_at(0), require_string_view_arg("splitSlices", nativeArgs, 1, "a string delimiter"));
+     }},
+    {"tokenSlices",
+     [](const NGSelf &, const NGEnv &context, const NGArgs &args) -> RuntimeRef<StorageCell> {
+       auto nativeArgs = native_args_view(context, args);
+       require_arg_count("tokenSlices", nativeArgs, 2, 2);
+       require_string_view_arg("tokenSlices", nativeArgs, 0, "a source string");
+       return make_runtime_token_slices_cell(
+           nativeArgs.slot_at(0), require_string_view_arg("tokenSlices", nativeArgs, 1, "a separator string"));
+     }},
+    {"fileLines",
+     [](const NGSelf &, const NGEnv &context, const NGArgs &args) -> RuntimeRef<StorageCell> {
+       auto nativeArgs = native_args_view(context, args);
+       require_arg_count("fileLines", nativeArgs, 1, 1);
+       return make_runtime_file_lines_cell(require_string_view_arg("fileLines", nativeArgs, 0, "a file path"));
+     }},
+    {"textSlicesSize",
+     [](const NGSelf &, const NGEnv &context, const NGArgs &args) -> RuntimeRef<StorageCell> {
+       auto nativeArgs = native_args_view(context, args);
+       require_arg_count("textSlicesSize", nativeArgs, 1, 1);
+       auto slices = require_text_slices_arg("textSlicesSize", nativeArgs);
+       return numeral_cell_from_value<uint32_t>(static_cast<uint32_t>(text_slices_size(slices)));
+     }},
+    {"textSlicesHas",
+     [](const NGSelf &, const NGEnv &context, const NGArgs &args) -> RuntimeRef<StorageCell> {
+       auto nativeArgs = native_args_view(context, args);
+       require_arg_count("textSlicesHas", nativeArgs, 2, 2);
+       auto slices = require_text_slices_arg("textSlicesHas", nativeArgs);
+       return make_runtime_boolean(text_slices_has(slices, collection_index_arg("textSlicesHas", nativeArgs)));
+     }},
+    {"textSlicesGet",
+     [](const NGSelf &, const NGEnv &context, const NGArgs &args) -> RuntimeRef<StorageCell> {
+       auto nativeArgs = native_args_view(context, args);
+       require_arg_count("textSlicesGet", nativeArgs, 2, 2);
+       auto slices = require_text_slices_arg("textSlicesGet", nativeArgs);
+       return text_slices_get(slices, collection_index_arg("textSlicesGet", nativeArgs));
+     }},
+    {"reserveString",
+     [](const NGSelf &, const NGEnv &context, const NGArgs &args) -> RuntimeRef<StorageCell> {
+       auto nativeArgs = native_args_view(context, args);
+       require_arg_count("reserveString", nativeArgs, 2, 2);
+       auto target = require_arg_slot("reserveString", nativeArgs, 0, "a string reference");
+       while (runtime_is_reference_value(target))
+       {
+         target = runtime_reference_target(target);
+       }
+       if (!runtime_is_string_value(target))
+       {
+         throw RuntimeException("reserveString() requires a string reference at argument 1");
+       }
+       auto capacity = require_numeric_arg<int32_t>("reserveString", nativeArgs, 1, "a byte count");
+       if (capacity < 0)
+       {
+         throw RuntimeException("reserveString() requires a non-negative byte count");
+       }
+       runtime_string_reserve(target, static_cast<size_t>(capacity));
+       return unit_cell();
+     }},
     {"reverse",
      [](const NGSelf &, const NGEnv &context, const NGArgs &args) -> RuntimeRef<StorageCell> {
        auto nativeArgs = native_args_view(context, args);
@@ -379,6 +680,287 @@ namespace NG::library::prelude
        }
        return make_runtime_array_cell(*items);
      }},
+    {"filled",
+     [](const NGSelf &, const NGEnv &context, const NGArgs &args) -> RuntimeRef<StorageCell> {
+       auto nativeArgs = native_args_view(context, args);
+       require_arg_count("filled", nativeArgs, 2, 2);
+       auto value = require_arg_slot("filled", nativeArgs, 0, "an element value");
+       auto count = require_numeric_arg<int32_t>("filled", nativeArgs, 1, "an element count");
+       if (count < 0)
+       {
+         throw RuntimeException("filled() requires a non-negative element count");
+       }
+       Vec<RuntimeRef<StorageCell>> items;
+       items.reserve(static_cast<size_t>(count));
+       for (int32_t i = 0; i < count; ++i)
+       {
+         items.push_back(clone_runtime_storage_cell(value, StorageClass::TEMPORARY));
+       }
+       return make_runtime_array_cell(items, items.size());
+     }},
+    {"sum", array_kernel_handler("sum", 0, [](const auto &xs, const auto &) { return kernels::array_sum(xs); })},
+    {"min", array_kernel_handler("min", 0, [](const auto &xs, const auto &) { return kernels::array_min(xs); })},
+    {"max", array_kernel_handler("max", 0, [](const auto &xs, const auto &) { return kernels::array_max(xs); })},
+    {"prefixSum",
+     array_kernel_handler("prefixSum", 0, [](const auto &xs, const auto &) { return kernels::array_prefix_sum(xs); })},
+    {"dot", array_kernel_handler("dot", 1, kernels::array_dot)},
+    {"scale", array_kernel_handler("scale", 1, kernels::array_scale)},
+    {"add", array_kernel_handler("add", 1, kernels::array_add)},
+    {"fill", array_kernel_handler("fill", 1, kernels::array_fill)},
+    {"indexOf", array_kernel_handler("indexOf", 1,
+                                     [](const auto &xs, const auto &value) {
+                                       return numeral_cell_from_value<int32_t>(kernels::array_index_of(xs, value));
+                                     })},
+    {"count", array_kernel_handler("count", 1,
+                                   [](const auto &xs, const auto &value) {
+                                     return numeral_cell_from_value<int32_t>(kernels::array_count(xs, value));
+                                   })},
+    {"equalTo", array_kernel_handler("equalTo", 1,
+                                     [](const auto &xs, const auto &ys) {
+                                       return kernels::array_compare(xs, ys, kernels::Comparison::Equal);
+                                     })},
+    {"lessThan", array_kernel_handler("lessThan", 1,
+                                      [](const auto &xs, const auto &ys) {
+                                        return kernels::array_compare(xs, ys, kernels::Comparison::Less);
+                                      })},
+    {"greaterThan", array_kernel_handler("greaterThan", 1,
+                                         [](const auto &xs, const auto &ys) {
+                                           return kernels::array_compare(xs, ys, kernels::Comparison::Greater);
+                                         })},
+    {"sort", array_kernel_handler("sort", 0, [](const auto &xs, const auto &) { return kernels::array_sort(xs, false); })},
+    {"stableSort",
+     array_kernel_handler("stableSort", 0, [](const auto &xs, const auto &) { return kernels::array_sort(xs, true); })},
+    {"partialSort", array_kernel_handler("partialSort", 1,
+                                         [](const auto &xs, const auto &count) {
+                                           return kernels::array_partial_sort(xs, read_numeric_cell_as<int32_t>(count));
+                                         })},
+    {"nthElement", array_kernel_handler("nthElement", 1,
+                                        [](const auto &xs, const auto &index) {
+                                          return kernels::array_nth_element(xs, read_numeric_cell_as<int32_t>(index));
+                                        })},
+    // Calls naming a function are lowered by the compiler and the interpreter; nothing else can reach
+    // the function from here.
+    {"sortBy",
+     [](const NGSelf &, const NGEnv &, const NGArgs &) -> RuntimeRef<StorageCell> {
+       throw RuntimeException("sortBy() requires the name of a function");
+     }},
+    {"sortWith",
+     [](const NGSelf &, const NGEnv &, const NGArgs &) -> RuntimeRef<StorageCell> {
+       throw RuntimeException("sortWith() requires the name of a function");
+     }},
+    {"hashTable",
+     [](const NGSelf &, const NGEnv &context, const NGArgs &args) -> RuntimeRef<StorageCell> {
+       auto nativeArgs = native_args_view(context, args);
+       require_arg_count("hashTable", nativeArgs, 1, 1);
+       auto withValues = runtime_boolean_value(require_arg_slot("hashTable", nativeArgs, 0, "a bool"));
+       if (!withValues)
+       {
+         throw RuntimeException("hashTable() requires a bool at argument 1");
+       }
+       return make_runtime_hash_table_cell(*withValues);
+     }},
+    {"hashTableSize", hash_table_handler("hashTableSize", 0,
+                                         [](const auto &table, const auto &) {
+                                           return numeral_cell_from_value<uint32_t>(
+                                               static_cast<uint32_t>(hash_table_size(table)));
+                                         })},
+    {"hashTableInsert", hash_table_handler("hashTableInsert", 2,
+                                           [](const auto &table, const auto &args) {
+                                             return make_runtime_boolean(hash_table_insert(
+                                                 table, collection_element_arg(args, 1), collection_element_arg(args, 2)));
+                                           })},
+    {"hashTableContains", hash_table_handler("hashTableContains", 1,
+                                             [](const auto &table, const auto &args) {
+                                               return make_runtime_boolean(
+                                                   hash_table_find(table, collection_element_arg(args, 1)).has_value());
+                                             })},
+    {"hashTableLookup", hash_table_handler("hashTableLookup", 1,
+                                           [](const auto &table, const auto &args) {
+                                             auto key = collection_element_arg(args, 1);
+                                             auto index = hash_table_find(table, key);
+                                             if (!index)
+                                             {
+                                               throw RuntimeException("HashMap has no key " + runtime_value_show(key));
+                                             }
+                                             return clone_runtime_storage_cell(hash_table_value(table, *index),
+                                                                               StorageClass::TEMPORARY);
+                                           })},
+    {"hashTableRemove", hash_table_handler("hashTableRemove", 1,
+                                           [](const auto &table, const auto &args) {
+                                             return make_runtime_boolean(
+                                                 hash_table_remove(table, collection_element_arg(args, 1)));
+                                           })},
+    {"hashTableKey", hash_table_handler("hashTableKey", 1,
+                                        [](const auto &table, const auto &args) {
+                                          return clone_runtime_storage_cell(
+                                              hash_table_key(table, collection_index_arg("hashTableKey", args)),
+                                              StorageClass::TEMPORARY);
+                                        })},
+    {"hashTableValue", hash_table_handler("hashTableValue", 1,
+                                          [](const auto &table, const auto &args) {
+                                            return clone_runtime_storage_cell(
+                                                hash_table_value(table, collection_index_arg("hashTableValue", args)),
+                                                StorageClass::TEMPORARY);
+                                          })},
+    {"hashTableClear", hash_table_handler("hashTableClear", 0,
+                                          [](const auto &table, const auto &) {
+                                            hash_table_clear(table);
+                                            return unit_cell();
+                                          })},
+    {"hashTableReserve", hash_table_handler("hashTableReserve", 1,
+                                            [](const auto &table, const auto &args) {
+                                              auto entries = require_numeric_arg<int32_t>("hashTableReserve", args, 1,
+                                                                                          "an entry count");
+                                              if (entries < 0)
+                                              {
+                                                throw RuntimeException(
+                                                    "hashTableReserve() requires a non-negative entry count");
+                                              }
+                                              hash_table_reserve(table, static_cast<size_t>(entries));
+                                              return unit_cell();
+                                            })},
+    {"btree",
+     [](const NGSelf &, const NGEnv &context, const NGArgs &args) -> RuntimeRef<StorageCell> {
+       auto nativeArgs = native_args_view(context, args);
+       require_arg_count("btree", nativeArgs, 1, 1);
+       auto withValues = runtime_boolean_value(require_arg_slot("btree", nativeArgs, 0, "a bool"));
+       if (!withValues)
+       {
+         throw RuntimeException("btree() requires a bool at argument 1");
+       }
+       return make_runtime_btree_cell(*withValues);
+     }},
+    {"btreeSize", btree_handler("btreeSize", 0, false,
+                                [](const auto &tree, const auto &) {
+                                  return numeral_cell_from_value<uint32_t>(static_cast<uint32_t>(btree_size(tree)));
+                                })},
+    {"btreeInsert", btree_handler("btreeInsert", 2, false,
+                                  [](const auto &tree, const auto &args) {
+                                    return make_runtime_boolean(btree_insert(tree, collection_element_arg(args, 1),
+                                                                             collection_element_arg(args, 2)));
+                                  })},
+    {"btreeContains", btree_handler("btreeContains", 1, false,
+                                    [](const auto &tree, const auto &args) {
+                                      return make_runtime_boolean(
+                                          btree_find(tree, collection_element_arg(args, 1)).has_value());
+                                    })},
+    {"btreeLookup", btree_handler("btreeLookup", 1, false,
+                                  [](const auto &tree, const auto &args) {
+                                    auto key = collection_element_arg(args, 1);
+                                    auto index = btree_find(tree, key);
+                                    if (!index)
+                                    {
+                                      throw RuntimeException("BTreeMap has no key " + runtime_value_show(key));
+                                    }
+                                    return clone_runtime_storage_cell(btree_value(tree, *index),
+                                                                      StorageClass::TEMPORARY);
+                                  })},
+    {"btreeRemove", btree_handler("btreeRemove", 1, false,
+                                  [](const auto &tree, const auto &args) {
+                                    return make_runtime_boolean(btree_remove(tree, collection_element_arg(args, 1)));
+                                  })},
+    {"btreeRank", btree_handler("btreeRank", 1, false,
+                                [](const auto &tree, const auto &args) {
+                                  return numeral_cell_from_value<uint32_t>(
+                                      static_cast<uint32_t>(btree_rank(tree, collection_element_arg(args, 1))));
+                                })},
+    {"btreeKey", btree_handler("btreeKey", 1, false,
+                               [](const auto &tree, const auto &args) {
+                                 return clone_runtime_storage_cell(
+                                     btree_key(tree, collection_index_arg("btreeKey", args)), StorageClass::TEMPORARY);
+                               })},
+    {"btreeValue", btree_handler("btreeValue", 1, false,
+                                 [](const auto &tree, const auto &args) {
+                                   return clone_runtime_storage_cell(
+                                       btree_value(tree, collection_index_arg("btreeValue", args)),
+                                       StorageClass::TEMPORARY);
+                                 })},
+    {"btreeClear", btree_handler("btreeClear", 0, false,
+                                 [](const auto &tree, const auto &) {
+                                   btree_clear(tree);
+                                   return unit_cell();
+                                 })},
+    {"btreeRange", btree_handler("btreeRange", 2, false,
+                                 [](const auto &tree, const auto &args) {
+                                   return make_runtime_btree_range_cell(tree, collection_element_arg(args, 1),
+                                                                        collection_element_arg(args, 2));
+                                 })},
+    {"btreeRangeSize", btree_handler("btreeRangeSize", 0, true,
+                                     [](const auto &range, const auto &) {
+                                       return numeral_cell_from_value<uint32_t>(
+                                           static_cast<uint32_t>(btree_range_size(range)));
+                                     })},
+    {"btreeRangeKey", btree_handler("btreeRangeKey", 1, true,
+                                    [](const auto &range, const auto &args) {
+                                      return clone_runtime_storage_cell(
+                                          btree_range_key(range, collection_index_arg("btreeRangeKey", args)),
+                                          StorageClass::TEMPORARY);
+                                    })},
+    {"btreeRangeValue", btree_handler("btreeRangeValue", 1, true,
+                                      [](const auto &range, const auto &args) {
+                                        return clone_runtime_storage_cell(
+                                            btree_range_value(range, collection_index_arg("btreeRangeValue", args)),
+                                            StorageClass::TEMPORARY);
+                                      })},
+    {"chunkList",
+     [](const NGSelf &, const NGEnv &context, const NGArgs &args) -> RuntimeRef<StorageCell> {
+       require_arg_count("chunkList", native_args_view(context, args), 0, 0);
+       return make_runtime_chunk_list_cell();
+     }},
+    {"chunkListSize", chunk_list_handler("chunkListSize", 0,
+                                         [](const auto &list, const auto &) {
+                                           return numeral_cell_from_value<uint32_t>(
+                                               static_cast<uint32_t>(chunk_list_size(list)));
+                                         })},
+    {"chunkListGet", chunk_list_handler("chunkListGet", 1,
+                                        [](const auto &list, const auto &args) {
+                                          return clone_runtime_storage_cell(
+                                              chunk_list_get(list, collection_index_arg("chunkListGet", args)),
+                                              StorageClass::TEMPORARY);
+                                        })},
+    {"chunkListBack", chunk_list_handler("chunkListBack", 0,
+                                         [](const auto &list, const auto &) {
+                                           auto size = chunk_list_size(list);
+                                           if (size == 0)
+                                           {
+                                             throw RuntimeException("back() on an empty list");
+                                           }
+                                           return clone_runtime_storage_cell(chunk_list_get(list, size - 1),
+                                                                             StorageClass::TEMPORARY);
+                                         })},
+    {"chunkListSet", chunk_list_handler("chunkListSet", 2,
+                                        [](const auto &list, const auto &args) {
+                                          chunk_list_set(list, collection_index_arg("chunkListSet", args),
+                                                         collection_element_arg(args, 2));
+                                          return unit_cell();
+                                        })},
+    {"chunkListPushFront", chunk_list_handler("chunkListPushFront", 1,
+                                              [](const auto &list, const auto &args) {
+                                                chunk_list_push_front(list, collection_element_arg(args, 1));
+                                                return unit_cell();
+                                              })},
+    {"chunkListPushBack", chunk_list_handler("chunkListPushBack", 1,
+                                             [](const auto &list, const auto &args) {
+                                               chunk_list_push_back(list, collection_element_arg(args, 1));
+                                               return unit_cell();
+                                             })},
+    {"chunkListPopFront", chunk_list_handler("chunkListPopFront", 0,
+                                             [](const auto &list, const auto &) {
+                                               // Copies of the list may still share the popped element.
+                                               return clone_runtime_storage_cell(chunk_list_pop_front(list),
+                                                                                 StorageClass::TEMPORARY);
+                                             })},
+    {"chunkListPopBack", chunk_list_handler("chunkListPopBack", 0,
+                                            [](const auto &list, const auto &) {
+                                              // Copies of the list may still share the popped element.
+                                              return clone_runtime_storage_cell(chunk_list_pop_back(list),
+                                                                                StorageClass::TEMPORARY);
+                                            })},
+    {"chunkListClear", chunk_list_handler("chunkListClear", 0,
+                                          [](const auto &list, const auto &) {
+                                            chunk_list_clear(list);
+                                            return unit_cell();
+                                          })},
     {"__ng_from_end",
      [](const NGSelf &, const NGEnv &context, const NGArgs &args) -> RuntimeRef<StorageCell> {
        auto value = require_numeric_arg<int32_t>("__ng_from_end", native_args_view(context, args), 0,
@@ -467,10 +1049,83 @@ namespace NG::library::prelude
                                           "toUpper",
                                           "toLower",
                                           "regexMatch",
+                                          "regexCompile",
+                                          "regexMatches",
+                                          "regexFind",
+                                          "regexFindAll",
+                                          "regexCaptures",
+                                          "regexReplaceAll",
+                                          "reserveString",
+                                          "splitSlices",
+                                          "tokenSlices",
+                                          "fileLines",
+                                          "textSlicesSize",
+                                          "textSlicesHas",
+                                          "textSlicesGet",
                                       }));
     register_native_library("std.array", handlers_for({
                                          "reverse",
+                                         "filled",
+                                         "sum",
+                                         "min",
+                                         "max",
+                                         "dot",
+                                         "scale",
+                                         "add",
+                                         "fill",
+                                         "indexOf",
+                                         "count",
+                                         "prefixSum",
+                                         "equalTo",
+                                         "lessThan",
+                                         "greaterThan",
+                                         "sort",
+                                         "stableSort",
+                                         "partialSort",
+                                         "nthElement",
+                                         "sortBy",
+                                         "sortWith",
                                      }));
+    register_native_library("std.hashmap", handlers_for({
+                                           "hashTable",
+                                           "hashTableSize",
+                                           "hashTableInsert",
+                                           "hashTableContains",
+                                           "hashTableLookup",
+                                           "hashTableRemove",
+                                           "hashTableKey",
+                                           "hashTableValue",
+                                           "hashTableClear",
+                                           "hashTableReserve",
+                                       }));
+    register_native_library("std.collections", handlers_for({
+                                               "btree",
+                                               "btreeSize",
+                                               "btreeInsert",
+                                               "btreeContains",
+                                               "btreeLookup",
+                                               "btreeRemove",
+                                               "btreeRank",
+                                               "btreeKey",
+                                               "btreeValue",
+                                               "btreeClear",
+                                               "btreeRange",
+                                               "btreeRangeSize",
+                                               "btreeRangeKey",
+                                               "btreeRangeValue",
+                                           }));
+    register_native_library("std.list", handlers_for({
+                                        "chunkList",
+                                        "chunkListSize",
+                                        "chunkListGet",
+                                        "chunkListBack",
+                                        "chunkListSet",
+                                        "chunkListPushFront",
+                                        "chunkListPushBack",
+                                        "chunkListPopFront",
+                                        "chunkListPopBack",
+                                        "chunkListClear",
+                                    }));
     register_native_library("std.memory", handlers_for({
                                           "nativeMalloc",
                                           "nativeFree",
@@ -0,0 +1,40 @@
+#include <sysdep/cpu_features.hpp>
+
+namespace NG::System::Cpu
+{
+
+  SimdLevel detected_simd_level()
+  {
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+    static const SimdLevel level = [] {
+      __builtin_cpu_init();
+      if (__builtin_cpu_supports("avx2"))
+      {
+        return SimdLevel::Avx2;
+      }
+      if (__builtin_cpu_supports("sse2"))
+      {
+        return SimdLevel::Sse2;
+      }
+      return SimdLevel::Scalar;
+    }();
+    return level;
+#else
+    return SimdLevel::Scalar;
+#endif
+  }
+
+  Str simd_level_name(SimdLevel level)
+  {
+    switch (level)
+    {
+    case SimdLevel::Avx2:
+      return "avx2";
+    case SimdLevel::Sse2:
+      return "sse2";
+    case SimdLevel::Scalar:
+      break;
+    }
+    return "scalar";
+  }
+} // namespace NG::System::Cpu
@@ -0,0 +1,70 @@
+#include <sysdep/mapped_file.hpp>
+
+#include <fstream>
+#include <iterator>
+
+#if defined(__linux__) || defined(__APPLE__)
+#include <fcntl.h>    // For open
+#include <sys/mman.h> // For mmap, munmap
+#include <sys/stat.h> // For fstat
+#include <unistd.h>   // For close
+#define NG_SYSDEP_HAS_MMAP 1
+#endif
+
+namespace NG::System
+{
+
+  using namespace NG;
+
+  MappedFile::MappedFile(const Str &path)
+  {
+#ifdef NG_SYSDEP_HAS_MMAP
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0)
+    {
+      throw RuntimeException("Failed to open file: " + path);
+    }
+    struct stat info{};
+    if (::fstat(fd, &info) != 0)
+    {
+      ::close(fd);
+      throw RuntimeException("Failed to stat file: " + path);
+    }
+    length = static_cast<size_t>(info.st_size);
+    if (length > 0)
+    {
+      void *address = ::mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fd, 0);
+      if (address == MAP_FAILED)
+      {
+        ::close(fd);
+        throw RuntimeException("Failed to map file: " + path);
+      }
+      ::madvise(address, length, MADV_SEQUENTIAL);
+      data = static_cast<const char *>(address);
+      mapped = true;
+    }
+    // The mapping keeps its own reference to the file.
+    ::close(fd);
+#else
+    std::ifstream file{path, std::ios::binary};
+    if (!file)
+    {
+      throw RuntimeException("Failed to open file: " + path);
+    }
+    fallback.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+    data = fallback.data();
+    length = fallback.size();
+#endif
+  }
+
+  MappedFile::~MappedFile()
+  {
+#ifdef NG_SYSDEP_HAS_MMAP
+    if (mapped)
+    {
+      ::munmap(const_cast<char *>(data), length);
+    }
+#endif
+  }
+
+} // namespace NG::System
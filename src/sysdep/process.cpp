@@ -1,5 +1,6 @@
 #include <sysdep/process.hpp>
 
+#include <atomic>
 #include <iostream> // For potential error output
 
 #ifdef _WIN32
@@ -10,6 +11,7 @@
 #elif __APPLE__
 #include <limits.h>      // For PATH_MAX
 #include <mach-o/dyld.h> // For _NSGetExecutablePath
+#include <unistd.h>      // For getpid
 #endif
 
 namespace NG::System::Process
@@ -72,4 +74,19 @@ namespace NG::System::Process
     return ""; // Return empty string for unsupported platforms
 #endif
   }
-} // namespace NG::System::Process
\ No newline at end of file
+
+  uint64_t current_process_id()
+  {
+#ifdef _WIN32
+    return static_cast<uint64_t>(GetCurrentProcessId());
+#else
+    return static_cast<uint64_t>(getpid());
+#endif
+  }
+
+  Str unique_temporary_suffix()
+  {
+    static std::atomic<uint64_t> counter{0};
+    return ".tmp" + std::to_string(current_process_id()) + "." + std::to_string(counter.fetch_add(1));
+  }
+} // namespace NG::System::Process
@@ -0,0 +1,106 @@
+#include <sysdep/thread_pool.hpp>
+
+#include <algorithm>
+#include <cstdlib>
+#include <utility>
+
+namespace NG::System
+{
+
+  using namespace NG;
+
+  ThreadPool::ThreadPool(size_t workerCount)
+  {
+    workerCount = std::max<size_t>(workerCount, 1);
+    workers.reserve(workerCount);
+    for (size_t i = 0; i < workerCount; ++i)
+    {
+      workers.emplace_back([this] { work(); });
+    }
+  }
+
+  ThreadPool::~ThreadPool()
+  {
+    {
+      std::unique_lock lock{mutex};
+      allDone.wait(lock, [this] { return tasks.empty() && running == 0; });
+      stopping = true;
+    }
+    taskReady.notify_all();
+    for (auto &worker : workers)
+    {
+      worker.join();
+    }
+  }
+
+  void ThreadPool::submit(std::function<void()> task)
+  {
+    {
+      std::lock_guard lock{mutex};
+      tasks.push_back(std::move(task));
+    }
+    taskReady.notify_one();
+  }
+
+  void ThreadPool::wait()
+  {
+    std::unique_lock lock{mutex};
+    allDone.wait(lock, [this] { return tasks.empty() && running == 0; });
+    if (firstError)
+    {
+      std::rethrow_exception(std::exchange(firstError, nullptr));
+    }
+  }
+
+  void ThreadPool::work()
+  {
+    while (true)
+    {
+      std::function<void()> task;
+      {
+        std::unique_lock lock{mutex};
+        taskReady.wait(lock, [this] { return stopping || !tasks.empty(); });
+        if (tasks.empty())
+        {
+          return;
+        }
+        task = std::move(tasks.front());
+        tasks.pop_front();
+        ++running;
+      }
+      try
+      {
+        task();
+      }
+      catch (...)
+      {
+        std::lock_guard lock{mutex};
+        if (!firstError)
+        {
+          firstError = std::current_exception();
+        }
+      }
+      std::lock_guard lock{mutex};
+      --running;
+      if (tasks.empty() && running == 0)
+      {
+        allDone.notify_all();
+      }
+    }
+  }
+
+  auto ThreadPool::default_concurrency() -> size_t
+  {
+    if (const char *jobs = std::getenv("NG_JOBS"))
+    {
+      char *end = nullptr;
+      auto value = std::strtoul(jobs, &end, 10);
+      if (end != jobs && *end == '\0' && value > 0)
+      {
+        return value;
+      }
+    }
+    return std::max<size_t>(std::thread::hardware_concurrency(), 1);
+  }
+
+} // namespace NG::System
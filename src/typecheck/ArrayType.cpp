@@ -23,14 +23,20 @@ namespace NG::typecheck
   }
   auto ArrayType::repr() const -> Str
   {
-    if (length)
-    {
-      return "array<" + elementType->repr() + ", " + length->repr() + ">";
-    }
-    return "array<" + elementType->repr() + ", ?>";
+    return memoizedRepr([this] {
+      if (length)
+      {
+        return "array<" + elementType->repr() + ", " + length->repr() + ">";
+      }
+      return "array<" + elementType->repr() + ", ?>";
+    });
   }
   auto ArrayType::match(const TypeInfo &other) const -> bool
   {
+    if (this == &other)
+    {
+      return true;
+    }
     if (other.tag() != typeinfo_tag::ARRAY)
     {
       return false;
@@ -54,11 +60,15 @@ namespace NG::typecheck
 
   auto VectorType::repr() const -> Str
   {
-    return "vector<" + elementType->repr() + ">";
+    return memoizedRepr([this] { return "vector<" + elementType->repr() + ">"; });
   }
 
   auto VectorType::match(const TypeInfo &other) const -> bool
   {
+    if (this == &other)
+    {
+      return true;
+    }
     if (other.tag() != typeinfo_tag::VECTOR)
     {
       return false;
@@ -78,11 +88,15 @@ namespace NG::typecheck
 
   auto SpanType::repr() const -> Str
   {
-    return "span<" + elementType->repr() + ">";
+    return memoizedRepr([this] { return "span<" + elementType->repr() + ">"; });
   }
 
   auto SpanType::match(const TypeInfo &other) const -> bool
   {
+    if (this == &other)
+    {
+      return true;
+    }
     if (other.tag() != typeinfo_tag::SPAN)
     {
       return false;
@@ -102,11 +116,15 @@ namespace NG::typecheck
 
   auto RangeType::repr() const -> Str
   {
-    return "Range<" + elementType->repr() + ">";
+    return memoizedRepr([this] { return "Range<" + elementType->repr() + ">"; });
   }
 
   auto RangeType::match(const TypeInfo &other) const -> bool
   {
+    if (this == &other)
+    {
+      return true;
+    }
     if (other.tag() != typeinfo_tag::RANGE)
     {
       return false;
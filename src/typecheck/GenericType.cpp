@@ -129,6 +129,8 @@ namespace NG::typecheck
 
     auto TypeConstructorApplicationType::match(const TypeInfo &other) const -> bool
     {
+        if (this == &other)
+            return true;
         if (other.tag() != TYPE_CONSTRUCTOR_APPLICATION)
             return false;
         auto &otherApp = static_cast<const TypeConstructorApplicationType &>(other);
@@ -148,19 +150,23 @@ namespace NG::typecheck
 
     auto VarargsType::repr() const -> Str
     {
-        Str result = "Varargs<";
-        for (size_t i = 0; i < elementTypes.size(); ++i)
-        {
-            if (i > 0)
-                result += ", ";
-            result += elementTypes[i]->repr();
-        }
-        result += ">";
-        return result;
+        return memoizedRepr([this] {
+            Str result = "Varargs<";
+            for (size_t i = 0; i < elementTypes.size(); ++i)
+            {
+                if (i > 0)
+                    result += ", ";
+                result += elementTypes[i]->repr();
+            }
+            result += ">";
+            return result;
+        });
     }
 
     auto VarargsType::match(const TypeInfo &other) const -> bool
     {
+        if (this == &other)
+            return true;
         if (other.tag() != VARARGS)
             return false;
         auto &otherVarargs = static_cast<const VarargsType &>(other);
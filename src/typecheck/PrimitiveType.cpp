@@ -1,57 +1,84 @@
 #include <debug.hpp>
+#include <typecheck/type_interner.hpp>
 #include <typecheck/typeinfo.hpp>
 
+#include <array>
+
 namespace NG::typecheck
 {
+  namespace
+  {
+    /**
+     * The interned node for each primitive tag, so that annotations and type reprs naming the same
+     * primitive share one node without allocating.
+     */
+    auto interned(typeinfo_tag tag) -> CheckingRef<PrimitiveType>
+    {
+      static const auto primitives = [] {
+        std::array<CheckingRef<PrimitiveType>, 0x100> table{};
+        for (auto primitive : {typeinfo_tag::UNIT, typeinfo_tag::BOOL, typeinfo_tag::STRING, typeinfo_tag::I8,
+                               typeinfo_tag::I16, typeinfo_tag::I32, typeinfo_tag::I64, typeinfo_tag::I128,
+                               typeinfo_tag::U8, typeinfo_tag::U16, typeinfo_tag::U32, typeinfo_tag::U64,
+                               typeinfo_tag::U128, typeinfo_tag::F16, typeinfo_tag::F32, typeinfo_tag::F64,
+                               typeinfo_tag::F128, typeinfo_tag::F256})
+        {
+          table[code(primitive)] =
+              std::static_pointer_cast<PrimitiveType>(intern_type(makecheck<PrimitiveType>(primitive)));
+        }
+        return table;
+      }();
+      return primitives[code(tag)];
+    }
+  } // namespace
 
   auto PrimitiveType::from(const TypeAnnotationType &annotation) -> CheckingRef<PrimitiveType>
   {
     switch (annotation)
     {
     case TypeAnnotationType::BUILTIN_UNIT:
-      return makecheck<PrimitiveType>(typeinfo_tag::UNIT);
+      return interned(typeinfo_tag::UNIT);
     case TypeAnnotationType::BUILTIN_BOOL:
-      return makecheck<PrimitiveType>(typeinfo_tag::BOOL);
+      return interned(typeinfo_tag::BOOL);
     case TypeAnnotationType::BUILTIN_STRING:
-      return makecheck<PrimitiveType>(typeinfo_tag::STRING);
+      return interned(typeinfo_tag::STRING);
     case TypeAnnotationType::BUILTIN_UBYTE:
     case TypeAnnotationType::BUILTIN_U8:
-      return makecheck<PrimitiveType>(typeinfo_tag::U8);
+      return interned(typeinfo_tag::U8);
     case TypeAnnotationType::BUILTIN_BYTE:
     case TypeAnnotationType::BUILTIN_I8:
-      return makecheck<PrimitiveType>(typeinfo_tag::I8);
+      return interned(typeinfo_tag::I8);
     case TypeAnnotationType::BUILTIN_USHORT:
     case TypeAnnotationType::BUILTIN_U16:
-      return makecheck<PrimitiveType>(typeinfo_tag::U16);
+      return interned(typeinfo_tag::U16);
     case TypeAnnotationType::BUILTIN_SHORT:
     case TypeAnnotationType::BUILTIN_I16:
-      return makecheck<PrimitiveType>(typeinfo_tag::I16);
+      return interned(typeinfo_tag::I16);
     case TypeAnnotationType::BUILTIN_UINT:
     case TypeAnnotationType::BUILTIN_U32:
-      return makecheck<PrimitiveType>(typeinfo_tag::U32);
+      return interned(typeinfo_tag::U32);
     case TypeAnnotationType::BUILTIN_INT:
     case TypeAnnotationType::BUILTIN_I32:
-      return makecheck<PrimitiveType>(typeinfo_tag::I32);
+      return interned(typeinfo_tag::I32);
     case TypeAnnotationType::BUILTIN_UPTR:
     case TypeAnnotationType::BUILTIN_ULONG:
     case TypeAnnotationType::BUILTIN_U64:
-      return makecheck<PrimitiveType>(typeinfo_tag::U64);
+      return interned(typeinfo_tag::U64);
     case TypeAnnotationType::BUILTIN_IPTR:
     case TypeAnnotationType::BUILTIN_LONG:
     case TypeAnnotationType::BUILTIN_I64:
-      return makecheck<PrimitiveType>(typeinfo_tag::I64);
+      return interned(typeinfo_tag::I64);
     case TypeAnnotationType::BUILTIN_HALF:
     case TypeAnnotationType::BUILTIN_F16:
-      return makecheck<PrimitiveType>(typeinfo_tag::F16);
+      return interned(typeinfo_tag::F16);
     case TypeAnnotationType::BUILTIN_FLOAT:
     case TypeAnnotationType::BUILTIN_F32:
-      return makecheck<PrimitiveType>(typeinfo_tag::F32);
+      return interned(typeinfo_tag::F32);
     case TypeAnnotationType::BUILTIN_DOUBLE:
     case TypeAnnotationType::BUILTIN_F64:
-      return makecheck<PrimitiveType>(typeinfo_tag::F64);
+      return interned(typeinfo_tag::F64);
     case TypeAnnotationType::BUILTIN_QUADRUPLE:
     case TypeAnnotationType::BUILTIN_F128:
-      return makecheck<PrimitiveType>(typeinfo_tag::F128);
+      return interned(typeinfo_tag::F128);
     default:
       return {};
     }
@@ -61,75 +88,75 @@ namespace NG::typecheck
   {
     if (primitive_type == "unit")
     {
-      return makecheck<PrimitiveType>(typeinfo_tag::UNIT);
+      return interned(typeinfo_tag::UNIT);
     }
     if (primitive_type == "bool")
     {
-      return makecheck<PrimitiveType>(typeinfo_tag::BOOL);
+      return interned(typeinfo_tag::BOOL);
     }
     if (primitive_type == "i8" || primitive_type == "byte")
     {
-      return makecheck<PrimitiveType>(typeinfo_tag::I8);
+      return interned(typeinfo_tag::I8);
     }
     if (primitive_type == "i16" || primitive_type == "short")
     {
-      return makecheck<PrimitiveType>(typeinfo_tag::I16);
+      return interned(typeinfo_tag::I16);
     }
     if (primitive_type == "i32" || primitive_type == "int")
     {
-      return makecheck<PrimitiveType>(typeinfo_tag::I32);
+      return interned(typeinfo_tag::I32);
     }
     if (primitive_type == "i64" || primitive_type == "long" || primitive_type == "iptr")
     {
-      return makecheck<PrimitiveType>(typeinfo_tag::I64);
+      return interned(typeinfo_tag::I64);
     }
     if (primitive_type == "i128")
     {
-      return makecheck<PrimitiveType>(typeinfo_tag::I128);
+      return interned(typeinfo_tag::I128);
     }
     if (primitive_type == "u8" || primitive_type == "ubyte")
     {
-      return makecheck<PrimitiveType>(typeinfo_tag::U8);
+      return interned(typeinfo_tag::U8);
     }
     if (primitive_type == "u16" || primitive_type == "ushort")
     {
-      return makecheck<PrimitiveType>(typeinfo_tag::U16);
+      return interned(typeinfo_tag::U16);
     }
     if (primitive_type == "u32" || primitive_type == "uint")
     {
-      return makecheck<PrimitiveType>(typeinfo_tag::U32);
+      return interned(typeinfo_tag::U32);
     }
     if (primitive_type == "u64" || primitive_type == "ulong" || primitive_type == "uptr")
     {
-      return makecheck<PrimitiveType>(typeinfo_tag::U64);
+      return interned(typeinfo_tag::U64);
     }
     if (primitive_type == "u128")
     {
-      return makecheck<PrimitiveType>(typeinfo_tag::U128);
+      return interned(typeinfo_tag::U128);
     }
     if (primitive_type == "f16" || primitive_type == "half")
     {
-      return makecheck<PrimitiveType>(typeinfo_tag::F16);
+      return interned(typeinfo_tag::F16);
     }
     if (primitive_type == "f32" || primitive_type == "float")
     {
-      return makecheck<PrimitiveType>(typeinfo_tag::F32);
+      return interned(typeinfo_tag::F32);
     }
     if (primitive_type == "f64" || primitive_type == "double")
     {
-      return makecheck<PrimitiveType>(typeinfo_tag::F64);
+      return interned(typeinfo_tag::F64);
     }
     if (primitive_type == "f128" || primitive_type == "quadruple")
     {
-      return makecheck<PrimitiveType>(typeinfo_tag::F128);
+      return interned(typeinfo_tag::F128);
     }
     if (primitive_type == "f256")
     {
-      return makecheck<PrimitiveType>(typeinfo_tag::F256);
+      return interned(typeinfo_tag::F256);
     }
     if (primitive_type == "string")
     {
-      return makecheck<PrimitiveType>(typeinfo_tag::STRING);
+      return interned(typeinfo_tag::STRING);
     }
     return {};
   }
@@ -188,6 +215,10 @@ namespace NG::typecheck
   }
   auto PrimitiveType::match(const TypeInfo &other) const -> bool
   {
+    if (this == &other)
+    {
+      return true;
+    }
     const auto *otherPrimitive = dynamic_cast<const PrimitiveType *>(&other);
     if (otherPrimitive == nullptr)
     {
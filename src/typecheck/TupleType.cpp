@@ -10,21 +10,27 @@ namespace NG::typecheck
 
   auto TupleType::repr() const -> Str
   {
-    Str result = "(";
-    for (size_t i = 0; i < elementTypes.size(); ++i)
-    {
-      if (i > 0)
+    return memoizedRepr([this] {
+      Str result = "(";
+      for (size_t i = 0; i < elementTypes.size(); ++i)
       {
-        result += ", ";
+        if (i > 0)
+        {
+          result += ", ";
+        }
+        result += elementTypes[i]->repr();
       }
-      result += elementTypes[i]->repr();
-    }
-    result += ")";
-    return result;
+      result += ")";
+      return result;
+    });
   }
 
   auto TupleType::match(const TypeInfo &other) const -> bool
   {
+    if (this == &other)
+    {
+      return true;
+    }
     if (other.tag() != typeinfo_tag::TUPLE)
     {
       return false;
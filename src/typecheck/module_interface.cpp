@@ -0,0 +1,1347 @@
+#include <orgasm/module.hpp>
+#include <sysdep/process.hpp>
+#include <typecheck/module_interface.hpp>
+#include <typecheck/overload_resolver.hpp>
+#include <typecheck/type_interner.hpp>
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <type_traits>
+
+namespace NG::typecheck
+{
+  namespace
+  {
+    constexpr char NGI_MAGIC[4] = {'N', 'G', 'I', '\0'};
+    constexpr char SNAPSHOT_MAGIC[4] = {'N', 'G', 'S', '\0'};
+    constexpr uint32_t SNAPSHOT_LAYOUT_VERSION = 2; ///< 2: entries carry compiled bytecode.
+    constexpr uint32_t MAX_NGI_COUNT = 16U * 1024U * 1024U;
+
+    /// Type references: null, or an index tagged even for nominal and odd for structural nodes.
+    constexpr uint32_t NULL_TYPE_REF = UINT32_MAX;
+
+    auto nominal_ref(size_t index) -> uint32_t { return static_cast<uint32_t>(index * 2); }
+    auto structural_ref(size_t index) -> uint32_t { return static_cast<uint32_t>(index * 2 + 1); }
+
+    class ByteWriter
+    {
+      Str bytes;
+
+    public:
+      template <typename T>
+      void scalar(T value)
+      {
+        static_assert(std::is_integral_v<T> || std::is_enum_v<T>);
+        bytes.append(reinterpret_cast<const char *>(&value), sizeof(T));
+      }
+
+      void flag(bool value) { scalar<uint8_t>(value ? 1 : 0); }
+
+      void count(size_t value) { scalar<uint32_t>(static_cast<uint32_t>(value)); }
+
+      void string(std::string_view value)
+      {
+        count(value.size());
+        bytes.append(value);
+      }
+
+      void strings(const Vec<Str> &values)
+      {
+        count(values.size());
+        for (const auto &value : values)
+        {
+          string(value);
+        }
+      }
+
+      void flags(const Vec<bool> &values)
+      {
+        count(values.size());
+        for (bool value : values)
+        {
+          flag(value);
+        }
+      }
+
+      void sizes(const Vec<size_t> &values)
+      {
+        count(values.size());
+        for (auto value : values)
+        {
+          scalar<uint64_t>(value);
+        }
+      }
+
+      void append(std::string_view other) { bytes.append(other); }
+
+      [[nodiscard]] auto view() const -> std::string_view { return bytes; }
+      auto take() -> Str { return std::move(bytes); }
+    };
+
+    class ByteReader
+    {
+      std::string_view bytes;
+      size_t offset = 0;
+
+      void need(size_t size) const
+      {
+        if (bytes.size() - offset < size)
+        {
+          throw RuntimeException("Truncated .ngi interface");
+        }
+      }
+
+    public:
+      explicit ByteReader(std::string_view bytes) : bytes(bytes) {}
+
+      template <typename T>
+      auto scalar() -> T
+      {
+        static_assert(std::is_integral_v<T> || std::is_enum_v<T>);
+        need(sizeof(T));
+        T value{};
+        std::memcpy(&value, bytes.data() + offset, sizeof(T));
+        offset += sizeof(T);
+        return value;
+      }
+
+      auto flag() -> bool { return scalar<uint8_t>() != 0; }
+
+      auto count() -> uint32_t
+      {
+        auto value = scalar<uint32_t>();
+        if (value > MAX_NGI_COUNT)
+        {
+          throw RuntimeException("Corrupt .ngi interface: count too large");
+        }
+        return value;
+      }
+
+      auto string() -> Str
+      {
+        auto size = count();
+        need(size);
+        Str value{bytes.substr(offset, size)};
+        offset += size;
+        return value;
+      }
+
+      auto strings() -> Vec<Str>
+      {
+        Vec<Str> values(count());
+        for (auto &value : values)
+        {
+          value = string();
+        }
+        return values;
+      }
+
+      auto flags() -> Vec<bool>
+      {
+        Vec<bool> values(count());
+        for (size_t i = 0; i < values.size(); ++i)
+        {
+          values[i] = flag();
+        }
+        return values;
+      }
+
+      auto sizes() -> Vec<size_t>
+      {
+        Vec<size_t> values(count());
+        for (auto &value : values)
+        {
+          value = static_cast<size_t>(scalar<uint64_t>());
+        }
+        return values;
+      }
+
+      auto view(size_t size) -> std::string_view
+      {
+        need(size);
+        auto value = bytes.substr(offset, size);
+        offset += size;
+        return value;
+      }
+
+      [[nodiscard]] auto rest() const -> std::string_view { return bytes.substr(offset); }
+      [[nodiscard]] auto done() const -> bool { return offset == bytes.size(); }
+    };
+
+    /**
+     * Returns the node kind stored in an interface. Primitive types report their primitive as tag, so
+     * they are told apart by class.
+     */
+    auto kind_of(const TypeInfo &type) -> typeinfo_tag
+    {
+      if (dynamic_cast<const PrimitiveType *>(&type))
+      {
+        return typeinfo_tag::PRIMITIVE;
+      }
+      if (dynamic_cast<const Untyped *>(&type))
+      {
+        return typeinfo_tag::UNTYPED;
+      }
+      return type.tag();
+    }
+
+    auto is_nominal(typeinfo_tag kind) -> bool
+    {
+      switch (kind)
+      {
+      case typeinfo_tag::CUSTOMIZED:
+      case typeinfo_tag::TRAIT:
+      case typeinfo_tag::TYPE_ALIAS:
+      case typeinfo_tag::NEW_TYPE:
+      case typeinfo_tag::TAGGED_UNION:
+      case typeinfo_tag::GENERIC_DEF:
+      case typeinfo_tag::GENERIC_TYPE_DEF:
+        return true;
+      default:
+        return false;
+      }
+    }
+
+    auto nominal_identity(const TypeInfo &type) -> std::pair<Str, Str>
+    {
+      switch (type.tag())
+      {
+      case typeinfo_tag::CUSTOMIZED:
+        return {static_cast<const CustomizedType &>(type).name, static_cast<const CustomizedType &>(type).moduleId};
+      case typeinfo_tag::TRAIT:
+        return {static_cast<const TraitType &>(type).name, static_cast<const TraitType &>(type).moduleId};
+      case typeinfo_tag::TYPE_ALIAS:
+        return {static_cast<const TypeAliasType &>(type).name, static_cast<const TypeAliasType &>(type).moduleId};
+      case typeinfo_tag::NEW_TYPE:
+        return {static_cast<const NewTypeType &>(type).name, static_cast<const NewTypeType &>(type).moduleId};
+      case typeinfo_tag::TAGGED_UNION:
+        return {static_cast<const TaggedUnionType &>(type).name,
+                static_cast<const TaggedUnionType &>(type).moduleId};
+      case typeinfo_tag::GENERIC_DEF:
+        return {static_cast<const GenericDefType &>(type).name, static_cast<const GenericDefType &>(type).moduleId};
+      case typeinfo_tag::GENERIC_TYPE_DEF:
+        return {static_cast<const GenericTypeDef &>(type).name, static_cast<const GenericTypeDef &>(type).moduleId};
+      default:
+        return {};
+      }
+    }
+
+    /**
+     * Returns the entries of an unordered map sorted by key, so equal interfaces encode to equal bytes.
+     */
+    template <typename M>
+    auto sorted_entries(const M &map) -> Vec<const typename M::value_type *>
+    {
+      Vec<const typename M::value_type *> entries;
+      entries.reserve(map.size());
+      for (const auto &entry : map)
+      {
+        entries.push_back(&entry);
+      }
+      std::ranges::sort(entries, {}, [](const auto *entry) -> const Str & { return entry->first; });
+      return entries;
+    }
+
+    void encode_header(ByteWriter &out, const ModuleInterface &moduleInterface)
+    {
+      out.append(std::string_view{NGI_MAGIC, sizeof(NGI_MAGIC)});
+      out.scalar<uint32_t>(NGI_FORMAT_VERSION);
+      out.string(moduleInterface.moduleId);
+      out.string(moduleInterface.sourceHash);
+      out.count(moduleInterface.dependencies.size());
+      for (const auto &[moduleId, hash] : moduleInterface.dependencies)
+      {
+        out.string(moduleId);
+        out.string(hash);
+      }
+      out.string(moduleInterface.interfaceHash);
+    }
+
+    auto decode_header(ByteReader &in) -> ModuleInterface
+    {
+      char magic[sizeof(NGI_MAGIC)];
+      for (auto &ch : magic)
+      {
+        ch = in.scalar<char>();
+      }
+      if (std::memcmp(magic, NGI_MAGIC, sizeof(NGI_MAGIC)) != 0)
+      {
+        throw RuntimeException("Not a .ngi interface");
+      }
+      if (auto version = in.scalar<uint32_t>(); version != NGI_FORMAT_VERSION)
+      {
+        throw RuntimeException("Unsupported .ngi format version " + std::to_string(version));
+      }
+      ModuleInterface moduleInterface;
+      moduleInterface.moduleId = in.string();
+      moduleInterface.sourceHash = in.string();
+      auto dependencyCount = in.count();
+      for (uint32_t i = 0; i < dependencyCount; ++i)
+      {
+        auto moduleId = in.string();
+        moduleInterface.dependencies.emplace_back(std::move(moduleId), in.string());
+      }
+      moduleInterface.interfaceHash = in.string();
+      return moduleInterface;
+    }
+
+    /**
+     * Writes the type graph reachable from an interface. Nominal types get a shell (enough to create the
+     * object) and a payload (their members), written after all structural nodes so cycles through nominal
+     * types resolve. Structural nodes are written children first.
+     */
+    class InterfaceEncoder
+    {
+      const Str &moduleId;
+      const InterfaceAstLocator &locate;
+      Map<const TypeInfo *, uint32_t> refs;
+      Vec<const TypeInfo *> nominals;
+      size_t structuralCount = 0;
+      ByteWriter shells;
+      ByteWriter structural;
+      ByteWriter payloads;
+
+      void astRef(ByteWriter &out, const NG::ast::ASTNode *node, bool required)
+      {
+        auto location = node ? locate(node) : std::nullopt;
+        if (!location)
+        {
+          if (required)
+          {
+            throw TypeCheckingException("Cannot locate definition for module interface of " + moduleId);
+          }
+          out.flag(false);
+          return;
+        }
+        out.flag(true);
+        out.string(location->moduleId);
+        out.scalar<uint32_t>(location->definition);
+        out.scalar<uint32_t>(location->member);
+      }
+
+      void refs_of(ByteWriter &out, const Vec<CheckingRef<TypeInfo>> &types)
+      {
+        Vec<uint32_t> ids;
+        ids.reserve(types.size());
+        for (const auto &type : types)
+        {
+          ids.push_back(ref(type));
+        }
+        out.count(ids.size());
+        for (auto id : ids)
+        {
+          out.scalar<uint32_t>(id);
+        }
+      }
+
+      template <typename T>
+      void type_map(ByteWriter &out, const Map<Str, CheckingRef<T>> &types)
+      {
+        Vec<std::pair<Str, uint32_t>> entries;
+        for (const auto *entry : sorted_entries(types))
+        {
+          const auto &[name, type] = *entry;
+          entries.emplace_back(name, ref(type));
+        }
+        out.count(entries.size());
+        for (const auto &[name, id] : entries)
+        {
+          out.string(name);
+          out.scalar<uint32_t>(id);
+        }
+      }
+
+      void shell(typeinfo_tag kind, const TypeInfo &type)
+      {
+        auto [name, owner] = nominal_identity(type);
+        const bool own = owner == moduleId;
+        shells.scalar<uint8_t>(kind);
+        shells.string(name);
+        shells.string(owner);
+        if (kind == typeinfo_tag::CUSTOMIZED)
+        {
+          auto &custom = static_cast<const CustomizedType &>(type);
+          shells.flag(custom.nativeOpaque);
+          shells.flag(custom.abstract);
+        }
+        else if (kind == typeinfo_tag::TRAIT)
+        {
+          shells.strings(static_cast<const TraitType &>(type).typeParamNames);
+        }
+        else if (kind == typeinfo_tag::GENERIC_DEF)
+        {
+          auto &generic = static_cast<const GenericDefType &>(type);
+          shells.strings(generic.typeParamNames);
+          shells.flags(generic.typeParamIsPack);
+          shells.flags(generic.typeParamIsConst);
+          shells.sizes(generic.typeParamKindArities);
+          shells.flags(generic.typeParamKindVariadicTails);
+          shells.count(generic.overloads.size());
+          for (const auto &overload : generic.overloads)
+          {
+            astRef(shells, overload.get(), own);
+          }
+        }
+        else if (kind == typeinfo_tag::GENERIC_TYPE_DEF)
+        {
+          auto &generic = static_cast<const GenericTypeDef &>(type);
+          shells.scalar<uint8_t>(static_cast<uint8_t>(generic.kind));
+          shells.strings(generic.typeParamNames);
+          shells.flags(generic.typeParamIsPack);
+          shells.flags(generic.typeParamIsConst);
+          shells.sizes(generic.typeParamKindArities);
+          shells.flags(generic.typeParamKindVariadicTails);
+          const NG::ast::ASTNode *definition = nullptr;
+          switch (generic.kind)
+          {
+          case GenericTypeKind::TYPE_DEF:
+            definition = generic.typeDef.get();
+            break;
+          case GenericTypeKind::TYPE_ALIAS:
+            definition = generic.typeAliasDef.get();
+            break;
+          case GenericTypeKind::NEW_TYPE:
+            definition = generic.newTypeDef.get();
+            break;
+          case GenericTypeKind::TAGGED_UNION:
+            definition = generic.taggedUnionDef.get();
+            break;
+          }
+          astRef(shells, definition, own);
+          shells.count(generic.specializations.size());
+          for (auto *specialization : generic.specializations)
+          {
+            astRef(shells, specialization, own);
+          }
+        }
+      }
+
+      void payload(const TypeInfo &type)
+      {
+        auto [name, owner] = nominal_identity(type);
+        const bool own = owner == moduleId;
+        ByteWriter out;
+        switch (type.tag())
+        {
+        case typeinfo_tag::CUSTOMIZED:
+        {
+          auto &custom = static_cast<const CustomizedType &>(type);
+          refs_of(out, custom.typeArgs);
+          type_map(out, custom.properties);
+          type_map(out, custom.memberFunctions);
+          out.count(custom.traitMemberFunctions.size());
+          for (const auto *entry : sorted_entries(custom.traitMemberFunctions))
+          {
+            const auto &[traitName, functions] = *entry;
+            out.string(traitName);
+            type_map(out, functions);
+          }
+          break;
+        }
+        case typeinfo_tag::TRAIT:
+        {
+          auto &trait = static_cast<const TraitType &>(type);
+          refs_of(out, Vec<CheckingRef<TypeInfo>>{trait.superTraits.begin(), trait.superTraits.end()});
+          type_map(out, trait.methods);
+          type_map(out, trait.allMethods);
+          out.count(trait.defaultMethods.size());
+          for (const auto *entry : sorted_entries(trait.defaultMethods))
+          {
+            const auto &[methodName, method] = *entry;
+            out.string(methodName);
+            astRef(out, method, own);
+          }
+          // Inherited defaults may live in modules the importer does not index; they are found again
+          // through the super traits when decoding.
+          out.count(trait.allDefaultMethods.size());
+          for (const auto *entry : sorted_entries(trait.allDefaultMethods))
+          {
+            const auto &[methodName, method] = *entry;
+            out.string(methodName);
+            astRef(out, method, false);
+          }
+          out.count(trait.allMethodOrigins.size());
+          for (const auto *entry : sorted_entries(trait.allMethodOrigins))
+          {
+            const auto &[methodName, origin] = *entry;
+            out.string(methodName);
+            out.string(origin);
+          }
+          out.count(trait.allDefaultOrigins.size());
+          for (const auto *entry : sorted_entries(trait.allDefaultOrigins))
+          {
+            const auto &[methodName, origin] = *entry;
+            out.string(methodName);
+            out.string(origin);
+          }
+          break;
+        }
+        case typeinfo_tag::TYPE_ALIAS:
+          out.scalar<uint32_t>(ref(static_cast<const TypeAliasType &>(type).underlyingType));
+          break;
+        case typeinfo_tag::NEW_TYPE:
+          out.scalar<uint32_t>(ref(static_cast<const NewTypeType &>(type).wrappedType));
+          break;
+        case typeinfo_tag::TAGGED_UNION:
+        {
+          auto &tagged = static_cast<const TaggedUnionType &>(type);
+          out.count(tagged.variants.size());
+          for (const auto *entry : sorted_entries(tagged.variants))
+          {
+            const auto &[variantName, payloadTypes] = *entry;
+            out.string(variantName);
+            refs_of(out, payloadTypes);
+          }
+          out.count(tagged.variantPayloadNames.size());
+          for (const auto *entry : sorted_entries(tagged.variantPayloadNames))
+          {
+            const auto &[variantName, payloadNames] = *entry;
+            out.string(variantName);
+            out.strings(payloadNames);
+          }
+          break;
+        }
+        default:
+          break;
+        }
+        payloads.append(out.view());
+      }
+
+      void node(ByteWriter &out, typeinfo_tag kind, const TypeInfo &type)
+      {
+        switch (kind)
+        {
+        case typeinfo_tag::UNTYPED:
+          break;
+        case typeinfo_tag::PRIMITIVE:
+          out.scalar<uint8_t>(static_cast<const PrimitiveType &>(type).type);
+          break;
+        case typeinfo_tag::FUNCTION:
+        {
+          auto &function = static_cast<const FunctionType &>(type);
+          auto returnType = ref(function.returnType);
+          out.scalar<uint32_t>(returnType);
+          refs_of(out, function.parametersType);
+          out.count(function.placeEffects.size());
+          for (const auto &effect : function.placeEffects)
+          {
+            out.scalar<uint8_t>(static_cast<uint8_t>(effect.kind));
+            out.string(effect.place);
+          }
+          out.flag(function.unknownPlaceEffects);
+          out.flag(function.deleted);
+          out.string(function.deletedRepr);
+          break;
+        }
+        case typeinfo_tag::PARAM_WITH_DEFAULT_VALUE:
+          out.scalar<uint32_t>(ref(static_cast<const ParamWithDefaultValueType &>(type).paramType));
+          break;
+        case typeinfo_tag::ARRAY:
+        {
+          auto &array = static_cast<const ArrayType &>(type);
+          auto element = ref(array.elementType);
+          auto length = ref(array.length);
+          out.scalar<uint32_t>(element);
+          out.scalar<uint32_t>(length);
+          break;
+        }
+        case typeinfo_tag::VECTOR:
+          out.scalar<uint32_t>(ref(static_cast<const VectorType &>(type).elementType));
+          break;
+        case typeinfo_tag::SPAN:
+          out.scalar<uint32_t>(ref(static_cast<const SpanType &>(type).elementType));
+          break;
+        case typeinfo_tag::RANGE:
+          out.scalar<uint32_t>(ref(static_cast<const RangeType &>(type).elementType));
+          break;
+        case typeinfo_tag::REFERENCE:
+          out.scalar<uint32_t>(ref(static_cast<const ReferenceType &>(type).referencedType));
+          break;
+        case typeinfo_tag::TUPLE:
+          refs_of(out, static_cast<const TupleType &>(type).elementTypes);
+          break;
+        case typeinfo_tag::UNION:
+          refs_of(out, static_cast<const UnionType &>(type).types);
+          break;
+        case typeinfo_tag::VARARGS:
+          refs_of(out, static_cast<const VarargsType &>(type).elementTypes);
+          break;
+        case typeinfo_tag::VARIANT:
+        {
+          auto &variant = static_cast<const VariantType &>(type);
+          out.string(variant.unionName);
+          out.string(variant.moduleId);
+          out.string(variant.variantName);
+          out.scalar<int32_t>(variant.variantIndex);
+          refs_of(out, variant.payloadTypes);
+          out.strings(variant.payloadNames);
+          break;
+        }
+        case typeinfo_tag::GENERIC_PARAM:
+        {
+          auto &param = static_cast<const GenericParamType &>(type);
+          out.string(param.name);
+          out.string(param.bound);
+          out.flag(param.isPack);
+          out.scalar<uint64_t>(param.kindArity);
+          out.flag(param.kindVariadicTail);
+          break;
+        }
+        case typeinfo_tag::CONST_VALUE:
+        {
+          auto &value = static_cast<const ConstValueType &>(type);
+          out.string(value.value);
+          out.string(value.valueType);
+          out.flag(value.isParam);
+          break;
+        }
+        case typeinfo_tag::TYPE_CONSTRUCTOR_APPLICATION:
+        {
+          auto &application = static_cast<const TypeConstructorApplicationType &>(type);
+          auto constructor = ref(application.constructorType);
+          out.scalar<uint32_t>(constructor);
+          refs_of(out, application.typeArgs);
+          break;
+        }
+        default:
+          throw TypeCheckingException("Cannot store type in module interface: " + type.repr());
+        }
+      }
+
+    public:
+      InterfaceEncoder(const Str &moduleId, const InterfaceAstLocator &locate) : moduleId(moduleId), locate(locate) {}
+
+      auto ref(const CheckingRef<TypeInfo> &type) -> uint32_t
+      {
+        if (!type)
+        {
+          return NULL_TYPE_REF;
+        }
+        if (auto known = refs.find(type.get()); known != refs.end())
+        {
+          return known->second;
+        }
+        auto kind = kind_of(*type);
+        if (is_nominal(kind))
+        {
+          auto id = nominal_ref(nominals.size());
+          refs.emplace(type.get(), id);
+          nominals.push_back(type.get());
+          shell(kind, *type);
+          return id;
+        }
+        // Children are written first; structural types cannot refer back to themselves.
+        ByteWriter out;
+        out.scalar<uint8_t>(kind);
+        node(out, kind, *type);
+        structural.append(out.view());
+        auto id = structural_ref(structuralCount++);
+        refs.emplace(type.get(), id);
+        return id;
+      }
+
+      /**
+       * Writes the payloads of all nominal types found so far, including those their payloads reach.
+       */
+      auto finish() -> Str
+      {
+        for (size_t i = 0; i < nominals.size(); ++i)
+        {
+          payload(*nominals[i]);
+        }
+        ByteWriter out;
+        out.count(nominals.size());
+        out.append(shells.view());
+        out.count(structuralCount);
+        out.append(structural.view());
+        out.append(payloads.view());
+        return out.take();
+      }
+    };
+
+    class InterfaceDecoder
+    {
+      ByteReader &in;
+      const Str &moduleId;
+      const ModuleInterfaceResolver &resolver;
+      Vec<CheckingRef<TypeInfo>> nominals;
+      Vec<bool> resolved; ///< Nominal types found in the program; their stored payload is skipped.
+      Vec<CheckingRef<TypeInfo>> structural;
+      Vec<std::pair<CheckingRef<TraitType>, Str>> inheritedDefaults; ///< Defaults to find via super traits.
+
+      auto astRef() -> NG::ast::ASTRef<NG::ast::ASTNode>
+      {
+        if (!in.flag())
+        {
+          return nullptr;
+        }
+        InterfaceAstRef location;
+        location.moduleId = in.string();
+        location.definition = in.scalar<uint32_t>();
+        location.member = in.scalar<uint32_t>();
+        return resolver.definition ? resolver.definition(location) : nullptr;
+      }
+
+      template <typename T>
+      auto definition(const Str &name) -> NG::ast::ASTRef<T>
+      {
+        auto node = NG::ast::dynamic_ast_cast<T>(astRef());
+        if (!node)
+        {
+          throw RuntimeException("Missing definition for '" + name + "' in .ngi interface");
+        }
+        return node;
+      }
+
+      template <typename T = TypeInfo>
+      auto type() -> CheckingRef<T>
+      {
+        auto id = in.scalar<uint32_t>();
+        if (id == NULL_TYPE_REF)
+        {
+          return nullptr;
+        }
+        auto &table = id % 2 == 0 ? nominals : structural;
+        if (id / 2 >= table.size())
+        {
+          throw RuntimeException("Corrupt .ngi interface: dangling type reference");
+        }
+        auto typed = std::dynamic_pointer_cast<T>(table[id / 2]);
+        if (!typed)
+        {
+          throw RuntimeException("Corrupt .ngi interface: unexpected type " + table[id / 2]->repr());
+        }
+        return typed;
+      }
+
+      template <typename T = TypeInfo>
+      auto types() -> Vec<CheckingRef<T>>
+      {
+        Vec<CheckingRef<T>> values(in.count());
+        for (auto &value : values)
+        {
+          value = type<T>();
+        }
+        return values;
+      }
+
+      template <typename T>
+      auto typeMap() -> Map<Str, CheckingRef<T>>
+      {
+        Map<Str, CheckingRef<T>> values;
+        auto count = in.count();
+        for (uint32_t i = 0; i < count; ++i)
+        {
+          auto name = in.string();
+          values.insert_or_assign(std::move(name), type<T>());
+        }
+        return values;
+      }
+
+      auto stringMap() -> Map<Str, Str>
+      {
+        Map<Str, Str> values;
+        auto count = in.count();
+        for (uint32_t i = 0; i < count; ++i)
+        {
+          auto name = in.string();
+          values.insert_or_assign(std::move(name), in.string());
+        }
+        return values;
+      }
+
+      auto shell() -> CheckingRef<TypeInfo>
+      {
+        auto kind = static_cast<typeinfo_tag>(in.scalar<uint8_t>());
+        auto name = in.string();
+        auto owner = in.string();
+        CheckingRef<TypeInfo> live;
+        if (owner != moduleId && resolver.type)
+        {
+          live = resolver.type(kind, owner, name);
+          if (live && (live->tag() != kind || nominal_identity(*live) != std::pair{name, owner}))
+          {
+            live = nullptr;
+          }
+        }
+        resolved.push_back(live != nullptr);
+        CheckingRef<TypeInfo> decoded;
+        switch (kind)
+        {
+        case typeinfo_tag::CUSTOMIZED:
+        {
+          auto nativeOpaque = in.flag();
+          auto abstract = in.flag();
+          decoded = makecheck<CustomizedType>(name, nativeOpaque, abstract, owner);
+          break;
+        }
+        case typeinfo_tag::TRAIT:
+          decoded = makecheck<TraitType>(name, in.strings(), owner);
+          break;
+        case typeinfo_tag::TYPE_ALIAS:
+          decoded = makecheck<TypeAliasType>(name, nullptr, owner);
+          break;
+        case typeinfo_tag::NEW_TYPE:
+          decoded = makecheck<NewTypeType>(name, nullptr, owner);
+          break;
+        case typeinfo_tag::TAGGED_UNION:
+          decoded = makecheck<TaggedUnionType>(name, owner);
+          break;
+        case typeinfo_tag::GENERIC_DEF:
+        {
+          auto typeParamNames = in.strings();
+          auto typeParamIsPack = in.flags();
+          auto typeParamIsConst = in.flags();
+          auto typeParamKindArities = in.sizes();
+          auto typeParamKindVariadicTails = in.flags();
+          Vec<NG::ast::ASTRef<NG::ast::FunctionDef>> overloads(in.count());
+          for (auto &overload : overloads)
+          {
+            overload = NG::ast::dynamic_ast_cast<NG::ast::FunctionDef>(astRef());
+          }
+          if (live)
+          {
+            break;
+          }
+          if (overloads.empty() || std::ranges::find(overloads, nullptr) != overloads.end())
+          {
+            throw RuntimeException("Missing definition for '" + name + "' in .ngi interface");
+          }
+          auto generic = makecheck<GenericDefType>(name, std::move(typeParamNames), std::move(typeParamIsPack),
+                                                   overloads.front(), TypeScope{}, owner);
+          generic->overloads.insert(generic->overloads.end(), overloads.begin() + 1, overloads.end());
+          generic->typeParamIsConst = std::move(typeParamIsConst);
+          generic->typeParamKindArities = std::move(typeParamKindArities);
+          generic->typeParamKindVariadicTails = std::move(typeParamKindVariadicTails);
+          indexGenericOverloads(*generic);
+          decoded = generic;
+          break;
+        }
+        case typeinfo_tag::GENERIC_TYPE_DEF:
+        {
+          auto genericKind = static_cast<GenericTypeKind>(in.scalar<uint8_t>());
+          auto typeParamNames = in.strings();
+          auto typeParamIsPack = in.flags();
+          auto typeParamIsConst = in.flags();
+          auto typeParamKindArities = in.sizes();
+          auto typeParamKindVariadicTails = in.flags();
+          auto node = astRef();
+          Vec<NG::ast::ASTRef<NG::ast::ASTNode>> specializations(in.count());
+          for (auto &specialization : specializations)
+          {
+            specialization = astRef();
+          }
+          if (live)
+          {
+            break;
+          }
+          CheckingRef<GenericTypeDef> generic;
+          auto missing = [&] { return RuntimeException("Missing definition for '" + name + "' in .ngi interface"); };
+          switch (genericKind)
+          {
+          case GenericTypeKind::TYPE_DEF:
+            if (auto typeDef = NG::ast::dynamic_ast_cast<NG::ast::TypeDef>(node))
+            {
+              generic = makecheck<GenericTypeDef>(name, typeParamNames, typeParamIsPack, typeDef, TypeScope{}, owner);
+            }
+            break;
+          case GenericTypeKind::TYPE_ALIAS:
+            if (auto aliasDef = NG::ast::dynamic_ast_cast<NG::ast::TypeAliasDef>(node))
+            {
+              generic = makecheck<GenericTypeDef>(name, typeParamNames, typeParamIsPack, aliasDef, TypeScope{}, owner);
+            }
+            break;
+          case GenericTypeKind::NEW_TYPE:
+            if (auto newTypeDef = NG::ast::dynamic_ast_cast<NG::ast::NewTypeDef>(node))
+            {
+              generic = makecheck<GenericTypeDef>(name, typeParamNames, typeParamIsPack, newTypeDef, TypeScope{}, owner);
+            }
+            break;
+          case GenericTypeKind::TAGGED_UNION:
+            if (auto unionDef = NG::ast::dynamic_ast_cast<NG::ast::TaggedUnionDef>(node))
+            {
+              generic = makecheck<GenericTypeDef>(name, typeParamNames, typeParamIsPack, unionDef, TypeScope{}, owner);
+            }
+            break;
+          }
+          if (!generic)
+          {
+            throw missing();
+          }
+          for (const auto &specialization : specializations)
+          {
+            auto aliasDef = NG::ast::dynamic_ast_cast<NG::ast::TypeAliasDef>(specialization);
+            if (!aliasDef)
+            {
+              throw missing();
+            }
+            generic->specializations.push_back(aliasDef.get());
+          }
+          generic->typeParamIsConst = std::move(typeParamIsConst);
+          generic->typeParamKindArities = std::move(typeParamKindArities);
+          generic->typeParamKindVariadicTails = std::move(typeParamKindVariadicTails);
+          decoded = generic;
+          break;
+        }
+        default:
+          throw RuntimeException("Corrupt .ngi interface: unknown nominal kind");
+        }
+        return live ? live : decoded;
+      }
+
+      auto node() -> CheckingRef<TypeInfo>
+      {
+        auto kind = static_cast<typeinfo_tag>(in.scalar<uint8_t>());
+        switch (kind)
+        {
+        case typeinfo_tag::UNTYPED:
+          return makecheck<Untyped>();
+        case typeinfo_tag::PRIMITIVE:
+          return makecheck<PrimitiveType>(static_cast<typeinfo_tag>(in.scalar<uint8_t>()));
+        case typeinfo_tag::FUNCTION:
+        {
+          auto returnType = type();
+          auto function = makecheck<FunctionType>(returnType, types());
+          auto effectCount = in.count();
+          for (uint32_t i = 0; i < effectCount; ++i)
+          {
+            auto effectKind = static_cast<PlaceEffectKind>(in.scalar<uint8_t>());
+            function->placeEffects.push_back(PlaceEffect{effectKind, in.string()});
+          }
+          function->unknownPlaceEffects = in.flag();
+          function->deleted = in.flag();
+          function->deletedRepr = in.string();
+          return function;
+        }
+        case typeinfo_tag::PARAM_WITH_DEFAULT_VALUE:
+          return makecheck<ParamWithDefaultValueType>(type());
+        case typeinfo_tag::ARRAY:
+        {
+          auto element = type();
+          return makecheck<ArrayType>(element, type());
+        }
+        case typeinfo_tag::VECTOR:
+          return makecheck<VectorType>(type());
+        case typeinfo_tag::SPAN:
+          return makecheck<SpanType>(type());
+        case typeinfo_tag::RANGE:
+          return makecheck<RangeType>(type());
+        case typeinfo_tag::REFERENCE:
+          return makecheck<ReferenceType>(type());
+        case typeinfo_tag::TUPLE:
+          return makecheck<TupleType>(types());
+        case typeinfo_tag::UNION:
+          return makecheck<UnionType>(types());
+        case typeinfo_tag::VARARGS:
+          return makecheck<VarargsType>(types());
+        case typeinfo_tag::VARIANT:
+        {
+          auto unionName = in.string();
+          auto owner = in.string();
+          auto variantName = in.string();
+          auto variantIndex = in.scalar<int32_t>();
+          auto payloadTypes = types();
+          return makecheck<VariantType>(unionName, variantName, variantIndex, std::move(payloadTypes), in.strings(),
+                                        owner);
+        }
+        case typeinfo_tag::GENERIC_PARAM:
+        {
+          auto name = in.string();
+          auto bound = in.string();
+          auto isPack = in.flag();
+          auto kindArity = static_cast<size_t>(in.scalar<uint64_t>());
+          return makecheck<GenericParamType>(name, bound, isPack, kindArity, in.flag());
+        }
+        case typeinfo_tag::CONST_VALUE:
+        {
+          auto value = in.string();
+          auto valueType = in.string();
+          return makecheck<ConstValueType>(value, valueType, in.flag());
+        }
+        case typeinfo_tag::TYPE_CONSTRUCTOR_APPLICATION:
+        {
+          auto constructor = type();
+          return makecheck<TypeConstructorApplicationType>(constructor, types());
+        }
+        default:
+          throw RuntimeException("Corrupt .ngi interface: unknown type kind");
+        }
+      }
+
+      void payload(const CheckingRef<TypeInfo> &target, bool skip)
+      {
+        // Resolved types keep their live members; the stored copy is still read to advance the input.
+        switch (target->tag())
+        {
+        case typeinfo_tag::CUSTOMIZED:
+        {
+          auto typeArgs = types();
+          auto properties = typeMap<TypeInfo>();
+          auto memberFunctions = typeMap<FunctionType>();
+          Map<Str, Map<Str, CheckingRef<FunctionType>>> traitMemberFunctions;
+          auto traitCount = in.count();
+          for (uint32_t i = 0; i < traitCount; ++i)
+          {
+            auto traitName = in.string();
+            traitMemberFunctions.insert_or_assign(std::move(traitName), typeMap<FunctionType>());
+          }
+          if (!skip)
+          {
+            auto &custom = static_cast<CustomizedType &>(*target);
+            custom.typeArgs = std::move(typeArgs);
+            custom.properties = std::move(properties);
+            custom.memberFunctions = std::move(memberFunctions);
+            custom.traitMemberFunctions = std::move(traitMemberFunctions);
+          }
+          break;
+        }
+        case typeinfo_tag::TRAIT:
+        {
+          auto superTraits = types<TraitType>();
+          auto methods = typeMap<FunctionType>();
+          auto allMethods = typeMap<FunctionType>();
+          Map<Str, NG::ast::FunctionDef *> defaultMethods;
+          auto defaultCount = in.count();
+          for (uint32_t i = 0; i < defaultCount; ++i)
+          {
+            auto methodName = in.string();
+            auto method = NG::ast::dynamic_ast_cast<NG::ast::FunctionDef>(astRef());
+            if (!method && !skip)
+            {
+              throw RuntimeException("Missing default method '" + methodName + "' in .ngi interface");
+            }
+            defaultMethods.insert_or_assign(methodName, method.get());
+          }
+          Map<Str, NG::ast::FunctionDef *> allDefaultMethods;
+          Vec<Str> unresolvedDefaults;
+          auto allDefaultCount = in.count();
+          for (uint32_t i = 0; i < allDefaultCount; ++i)
+          {
+            auto methodName = in.string();
+            auto method = NG::ast::dynamic_ast_cast<NG::ast::FunctionDef>(astRef());
+            if (!method)
+            {
+              unresolvedDefaults.push_back(methodName);
+            }
+            allDefaultMethods.insert_or_assign(methodName, method.get());
+          }
+          auto allMethodOrigins = stringMap();
+          auto allDefaultOrigins = stringMap();
+          if (!skip)
+          {
+            auto trait = std::static_pointer_cast<TraitType>(target);
+            trait->superTraits = std::move(superTraits);
+            TraitImplIndex::traitGraphChanged();
+            trait->methods = std::move(methods);
+            trait->allMethods = std::move(allMethods);
+            trait->defaultMethods = std::move(defaultMethods);
+            trait->allDefaultMethods = std::move(allDefaultMethods);
+            trait->allMethodOrigins = std::move(allMethodOrigins);
+            trait->allDefaultOrigins = std::move(allDefaultOrigins);
+            for (auto &methodName : unresolvedDefaults)
+            {
+              inheritedDefaults.emplace_back(trait, std::move(methodName));
+            }
+          }
+          break;
+        }
+        case typeinfo_tag::TYPE_ALIAS:
+        {
+          auto underlying = type();
+          if (!skip)
+          {
+            static_cast<TypeAliasType &>(*target).underlyingType = std::move(underlying);
+          }
+          break;
+        }
+        case typeinfo_tag::NEW_TYPE:
+        {
+          auto wrapped = type();
+          if (!skip)
+          {
+            static_cast<NewTypeType &>(*target).wrappedType = std::move(wrapped);
+          }
+          break;
+        }
+        case typeinfo_tag::TAGGED_UNION:
+        {
+          Map<Str, Vec<CheckingRef<TypeInfo>>> variants;
+          auto variantCount = in.count();
+          for (uint32_t i = 0; i < variantCount; ++i)
+          {
+            auto variantName = in.string();
+            variants.insert_or_assign(std::move(variantName), types());
+          }
+          Map<Str, Vec<Str>> payloadNames;
+          auto namedCount = in.count();
+          for (uint32_t i = 0; i < namedCount; ++i)
+          {
+            auto variantName = in.string();
+            payloadNames.insert_or_assign(std::move(variantName), in.strings());
+          }
+          if (!skip)
+          {
+            auto &tagged = static_cast<TaggedUnionType &>(*target);
+            tagged.variants = std::move(variants);
+            tagged.variantPayloadNames = std::move(payloadNames);
+          }
+          break;
+        }
+        default:
+          break;
+        }
+      }
+
+      static auto inheritedDefault(const TraitType &trait, const Str &methodName) -> NG::ast::FunctionDef *
+      {
+        for (const auto &super : trait.superTraits)
+        {
+          if (!super)
+          {
+            continue;
+          }
+          if (auto found = super->allDefaultMethods.find(methodName);
+              found != super->allDefaultMethods.end() && found->second)
+          {
+            return found->second;
+          }
+          if (auto *method = inheritedDefault(*super, methodName))
+          {
+            return method;
+          }
+        }
+        return nullptr;
+      }
+
+    public:
+      InterfaceDecoder(ByteReader &in, const Str &moduleId, const ModuleInterfaceResolver &resolver)
+          : in(in), moduleId(moduleId), resolver(resolver)
+      {
+      }
+
+      void decodeTypes()
+      {
+        auto nominalCount = in.count();
+        nominals.reserve(nominalCount);
+        for (uint32_t i = 0; i < nominalCount; ++i)
+        {
+          nominals.push_back(shell());
+        }
+        auto structuralCount = in.count();
+        structural.reserve(structuralCount);
+        for (uint32_t i = 0; i < structuralCount; ++i)
+        {
+          structural.push_back(intern_type(node()));
+        }
+        for (size_t i = 0; i < nominals.size(); ++i)
+        {
+          payload(nominals[i], resolved[i]);
+        }
+        for (auto &[trait, methodName] : inheritedDefaults)
+        {
+          auto *method = inheritedDefault(*trait, methodName);
+          if (!method)
+          {
+            throw RuntimeException("Missing default method '" + methodName + "' in .ngi interface");
+          }
+          trait->allDefaultMethods[methodName] = method;
+        }
+      }
+
+      auto typeRef() -> CheckingRef<TypeInfo> { return type(); }
+    };
+  } // namespace
+
+  auto encode_module_interface(ModuleInterface &moduleInterface, const InterfaceAstLocator &locate) -> Str
+  {
+    InterfaceEncoder encoder{moduleInterface.moduleId, locate};
+    Vec<uint32_t> symbolRefs;
+    symbolRefs.reserve(moduleInterface.symbols.size());
+    for (const auto &[_name, type] : moduleInterface.symbols)
+    {
+      symbolRefs.push_back(encoder.ref(type));
+    }
+    ByteWriter body;
+    body.append(encoder.finish());
+    body.count(moduleInterface.symbols.size());
+    for (size_t i = 0; i < moduleInterface.symbols.size(); ++i)
+    {
+      body.string(moduleInterface.symbols[i].first);
+      body.scalar<uint32_t>(symbolRefs[i]);
+    }
+    body.count(moduleInterface.impls.size());
+    for (const auto &impl : moduleInterface.impls)
+    {
+      body.string(impl.traitName);
+      body.string(impl.targetPattern);
+      body.strings(impl.genericParamNames);
+      body.strings(impl.whereBounds);
+      body.count(impl.methods.size());
+      for (const auto *entry : sorted_entries(impl.methods))
+      {
+        const auto &[methodName, implementation] = *entry;
+        body.string(methodName);
+        body.string(implementation);
+      }
+      body.scalar<uint32_t>(impl.definition);
+    }
+    body.strings(moduleInterface.derivedTraitImplKeys);
+    body.strings(moduleInterface.autoTraits);
+
+    moduleInterface.interfaceHash = NG::orgasm::bytecode_source_hash(body.view());
+    ByteWriter out;
+    encode_header(out, moduleInterface);
+    out.append(body.view());
+    return out.take();
+  }
+
+  auto decode_module_interface_header(std::string_view bytes) -> ModuleInterface
+  {
+    ByteReader in{bytes};
+    return decode_header(in);
+  }
+
+  auto decode_module_interface(std::string_view bytes, const ModuleInterfaceResolver &resolver) -> ModuleInterface
+  {
+    ByteReader in{bytes};
+    auto moduleInterface = decode_header(in);
+    if (NG::orgasm::bytecode_source_hash(in.rest()) != moduleInterface.interfaceHash)
+    {
+      throw RuntimeException("Corrupt .ngi interface: hash mismatch");
+    }
+    InterfaceDecoder decoder{in, moduleInterface.moduleId, resolver};
+    decoder.decodeTypes();
+    auto symbolCount = in.count();
+    for (uint32_t i = 0; i < symbolCount; ++i)
+    {
+      auto name = in.string();
+      moduleInterface.symbols.emplace_back(std::move(name), decoder.typeRef());
+    }
+    auto implCount = in.count();
+    for (uint32_t i = 0; i < implCount; ++i)
+    {
+      InterfaceImpl impl;
+      impl.traitName = in.string();
+      impl.targetPattern = in.string();
+      impl.genericParamNames = in.strings();
+      impl.whereBounds = in.strings();
+      auto methodCount = in.count();
+      for (uint32_t j = 0; j < methodCount; ++j)
+      {
+        auto methodName = in.string();
+        impl.methods.insert_or_assign(std::move(methodName), in.string());
+      }
+      impl.definition = in.scalar<uint32_t>();
+      moduleInterface.impls.push_back(std::move(impl));
+    }
+    moduleInterface.derivedTraitImplKeys = in.strings();
+    moduleInterface.autoTraits = in.strings();
+    if (!in.done())
+    {
+      throw RuntimeException("Corrupt .ngi interface: trailing bytes");
+    }
+    return moduleInterface;
+  }
+
+  auto module_interface_path(const Str &moduleId, const Str &sourcePath) -> Str
+  {
+    const char *directory = std::getenv("NG_INTERFACE_DIR");
+    if (directory == nullptr || *directory == '\0' || moduleId.empty() || sourcePath.empty())
+    {
+      return "";
+    }
+    std::error_code error;
+    auto absolute = std::filesystem::absolute(sourcePath, error);
+    auto pathHash = NG::orgasm::bytecode_source_hash(error ? sourcePath : absolute.string());
+    return (std::filesystem::path{directory} / (moduleId + "-" + pathHash + ".ngi")).string();
+  }
+
+  auto write_module_interface_file(const Str &path, std::string_view bytes) -> bool
+  {
+    std::error_code error;
+    std::filesystem::path target{path};
+    std::filesystem::create_directories(target.parent_path(), error);
+    // Concurrent writers each use their own temporary file; the last rename wins.
+    auto temporary = target;
+    temporary += NG::System::Process::unique_temporary_suffix();
+    {
+      std::ofstream out{temporary, std::ios::binary | std::ios::trunc};
+      if (!out || !out.write(bytes.data(), static_cast<std::streamsize>(bytes.size())))
+      {
+        std::filesystem::remove(temporary, error);
+        return false;
+      }
+    }
+    std::filesystem::rename(temporary, target, error);
+    if (error)
+    {
+      std::filesystem::remove(temporary, error);
+      return false;
+    }
+    return true;
+  }
+
+  auto prelude_snapshot_path() -> Str
+  {
+    const char *path = std::getenv("NG_PRELUDE_SNAPSHOT");
+    return path == nullptr ? "" : path;
+  }
+
+  auto encode_prelude_snapshot(const Vec<PreludeSnapshotEntry> &entries) -> Str
+  {
+    ByteWriter out;
+    out.append(std::string_view{SNAPSHOT_MAGIC, sizeof(SNAPSHOT_MAGIC)});
+    out.scalar<uint32_t>(NGI_FORMAT_VERSION);
+    out.scalar<uint32_t>(SNAPSHOT_LAYOUT_VERSION);
+    out.count(entries.size());
+    for (const auto &entry : entries)
+    {
+      out.string(entry.moduleId);
+      out.scalar<uint64_t>(entry.interface.size());
+      out.append(entry.interface);
+      out.string(entry.bytecodeKey);
+      out.scalar<uint64_t>(entry.bytecode.size());
+      out.append(entry.bytecode);
+    }
+    return out.take();
+  }
+
+  auto decode_prelude_snapshot(std::string_view bytes) -> Vec<PreludeSnapshotEntry>
+  {
+    ByteReader in{bytes};
+    char magic[sizeof(SNAPSHOT_MAGIC)];
+    for (auto &ch : magic)
+    {
+      ch = in.scalar<char>();
+    }
+    if (std::memcmp(magic, SNAPSHOT_MAGIC, sizeof(SNAPSHOT_MAGIC)) != 0)
+    {
+      throw RuntimeException("Not a prelude snapshot");
+    }
+    if (auto version = in.scalar<uint32_t>(); version != NGI_FORMAT_VERSION)
+    {
+      throw RuntimeException("Unsupported prelude snapshot version " + std::to_string(version));
+    }
+    if (auto layout = in.scalar<uint32_t>(); layout != SNAPSHOT_LAYOUT_VERSION)
+    {
+      throw RuntimeException("Unsupported prelude snapshot layout " + std::to_string(layout));
+    }
+    Vec<PreludeSnapshotEntry> entries(in.count());
+    for (auto &entry : entries)
+    {
+      entry.moduleId = in.string();
+      entry.interface = in.view(static_cast<size_t>(in.scalar<uint64_t>()));
+      entry.bytecodeKey = in.string();
+      entry.bytecode = in.view(static_cast<size_t>(in.scalar<uint64_t>()));
+    }
+    if (!in.done())
+    {
+      throw RuntimeException("Corrupt prelude snapshot: trailing bytes");
+    }
+    return entries;
+  }
+
+} // namespace NG::typecheck
@@ -2,20 +2,22 @@
 #include <typecheck/overload_resolver.hpp>
 #include <typecheck/typecheck_utils.hpp>
 #include <typecheck/pattern_matching.hpp>
+#include <typecheck/typecheck.hpp>
 #include <ast.hpp>
+#include <algorithm>
 
 namespace NG::typecheck
 {
     // Forward declarations
     auto typeSatisfiesTrait(const CheckingRef<TypeInfo> &type, const TraitType &trait,
-                            const Map<Str, Vec<Str>> &trait_impls_by_type,
+                            const TraitImplIndex &trait_impls_by_type,
                             const Set<Str> &activeAutoTraits,
                             const Set<Str> &activeDerivedTraitImplKeys,
                             const TypeEnvironment &env) -> bool;
     auto isObjectSafeTrait(const TraitType &trait) -> bool;
 
     auto typeMatches(const TypeInfo &expected, const TypeInfo &actual,
-                     const Map<Str, Vec<Str>> &trait_impls_by_type,
+                     const TraitImplIndex &trait_impls_by_type,
                      const Set<Str> &activeAutoTraits,
                      const Set<Str> &activeDerivedTraitImplKeys,
                      const TypeEnvironment &env) -> bool
@@ -53,14 +55,15 @@ namespace NG::typecheck
         Str current;
         for (char c : inner)
         {
-            if (c == '<') depth++;
-            else if (c == '>') depth--;
+            if (c == '<' || c == '(' || c == '[') depth++;
+            else if (c == '>' || c == ')' || c == ']') depth--;
             else if (c == ',' && depth == 0)
             {
                 args.push_back(current);
                 current.clear();
                 continue;
             }
+            if (current.empty() && c == ' ') continue; // instance names separate arguments with ", "
             current += c;
         }
         if (!current.empty()) args.push_back(current);
@@ -92,6 +95,95 @@ namespace NG::typecheck
         return score;
     }
 
+    auto typePatternHead(const ast::TypeAnnotation *pattern, const Set<Str> &genericParamNames) -> Str
+    {
+        if (!pattern || pattern->constLiteral || pattern->type == ast::TypeAnnotationType::TUPLE ||
+            pattern->type == ast::TypeAnnotationType::UNION || genericParamNames.contains(pattern->name) ||
+            isPackTypePattern(pattern, genericParamNames))
+        {
+            return "";
+        }
+        return pattern->name;
+    }
+
+    auto typeHead(const CheckingRef<TypeInfo> &type) -> Str
+    {
+        if (!type) return "";
+        // Mirrors the name comparison at the end of typePatternMatch.
+        auto unwrapped = unwrap(type);
+        switch (unwrapped->tag())
+        {
+        case typeinfo_tag::REFERENCE: return "ref";
+        case typeinfo_tag::ARRAY: return "array";
+        case typeinfo_tag::VECTOR: return "vector";
+        case typeinfo_tag::SPAN: return "span";
+        case typeinfo_tag::RANGE: return "Range";
+        default: break;
+        }
+        if (auto custom = std::dynamic_pointer_cast<CustomizedType>(unwrapped))
+            return stripTypeInstanceSuffix(custom->name);
+        if (auto alias = std::dynamic_pointer_cast<TypeAliasType>(unwrapped))
+            return stripTypeInstanceSuffix(alias->name);
+        if (auto tagged = std::dynamic_pointer_cast<TaggedUnionType>(unwrapped))
+            return stripTypeInstanceSuffix(tagged->name);
+        return type->repr();
+    }
+
+    void indexGenericOverloads(GenericDefType &genericDef)
+    {
+        auto &buckets = genericDef.overloadBuckets;
+        for (; buckets.indexed < genericDef.overloads.size(); ++buckets.indexed)
+        {
+            auto *candidate = genericDef.overloads[buckets.indexed].get();
+            if (!candidate) continue;
+            auto genericNames = genericParamNameSet(candidate->genericParams);
+            if (!candidate->params.empty() && candidate->params.back() &&
+                isPackTypePattern(candidate->params.back()->annotatedType.get(), genericNames))
+            {
+                buckets.variadic.push_back(buckets.indexed);
+                continue;
+            }
+            Str head = candidate->params.empty() || !candidate->params.front()
+                           ? ""
+                           : typePatternHead(candidate->params.front()->annotatedType.get(), genericNames);
+            buckets.byArity[candidate->params.size()][head].push_back(buckets.indexed);
+        }
+    }
+
+    auto genericOverloadCandidates(GenericDefType &genericDef, const Vec<CheckingRef<TypeInfo>> &argumentTypes)
+        -> Vec<ast::FunctionDef *>
+    {
+        indexGenericOverloads(genericDef);
+        const auto &buckets = genericDef.overloadBuckets;
+        Vec<size_t> positions = buckets.variadic;
+        if (auto arityIt = buckets.byArity.find(argumentTypes.size()); arityIt != buckets.byArity.end())
+        {
+            auto addBucket = [&](const Str &head) {
+                if (auto headIt = arityIt->second.find(head); headIt != arityIt->second.end())
+                {
+                    positions.insert(positions.end(), headIt->second.begin(), headIt->second.end());
+                }
+            };
+            addBucket("");
+            if (!argumentTypes.empty())
+            {
+                if (auto head = typeHead(argumentTypes.front()); !head.empty())
+                {
+                    addBucket(head);
+                }
+            }
+        }
+        // Ties between equally specific overloads go to the earlier declaration.
+        std::sort(positions.begin(), positions.end());
+        Vec<ast::FunctionDef *> candidates;
+        candidates.reserve(positions.size());
+        for (auto position : positions)
+        {
+            candidates.push_back(genericDef.overloads[position].get());
+        }
+        return candidates;
+    }
+
     // ── Generic binding extraction ──────────────────────────────────────
 
     namespace
@@ -130,6 +222,18 @@ namespace NG::typecheck
         }
     }
 
+    /**
+     * Resolves one argument of an instance name like `Box<(i32, string)>` back to a type.
+     */
+    auto instanceArgType(const Str &name, const TypeEnvironment &env) -> CheckingRef<TypeInfo>
+    {
+        // Primitive names first: a module named like one (`std.string`) may shadow it in locals.
+        if (auto primitive = PrimitiveType::from(name)) return primitive;
+        if (auto it = env.locals.find(name); it != env.locals.end()) return it->second;
+        if (name.starts_with('(')) return type_from_repr(name);
+        return makecheck<CustomizedType>(name);
+    }
+
     void extractGenericBindingsImpl(CheckingRef<TypeInfo> paramType, CheckingRef<TypeInfo> argType,
                                     Map<Str, CheckingRef<TypeInfo>> &substitution, Set<uintptr_t> &seen,
                                     const TypeEnvironment &env)
@@ -261,11 +365,8 @@ namespace NG::typecheck
             }
             for (size_t i = 0; i < paramApp.typeArgs.size() && i < argArgs.size(); ++i)
             {
-                CheckingRef<TypeInfo> argConcrete;
-                if (auto it = env.locals.find(argArgs[i]); it != env.locals.end()) argConcrete = it->second;
-                else if (auto pr = PrimitiveType::from(argArgs[i])) argConcrete = pr;
-                else argConcrete = makecheck<CustomizedType>(argArgs[i]);
-                extractGenericBindingsImpl(paramApp.typeArgs[i], argConcrete, substitution, seen, env);
+                extractGenericBindingsImpl(paramApp.typeArgs[i], instanceArgType(argArgs[i], env), substitution, seen,
+                                           env);
             }
             return;
         }
@@ -279,10 +380,7 @@ namespace NG::typecheck
             for (size_t i = 0; i < pArgs.size() && i < aArgs.size(); ++i)
             {
                 auto pIt = substitution.find(pArgs[i]);
-                CheckingRef<TypeInfo> aConcrete;
-                if (auto aIt = env.locals.find(aArgs[i]); aIt != env.locals.end()) aConcrete = aIt->second;
-                else if (auto primitive = PrimitiveType::from(aArgs[i])) aConcrete = primitive;
-                else aConcrete = makecheck<CustomizedType>(aArgs[i]);
+                auto aConcrete = instanceArgType(aArgs[i], env);
                 if (pIt == substitution.end())
                 {
                     substitution[pArgs[i]] = aConcrete;
@@ -22,6 +22,8 @@ namespace NG::typecheck
 
     static constexpr const char *COPY_TRAIT_NAME = "Copy";
     static constexpr const char *CLONE_TRAIT_NAME = "Clone";
+    static constexpr const char *HASH_TRAIT_NAME = "Hash";
+    static constexpr const char *DROP_TRAIT_NAME = "Drop";
 
     namespace
     {
@@ -57,8 +59,19 @@ namespace NG::typecheck
         return traitImpliesRecursive(*trait, requiredName, seen, env);
     }
 
+    namespace
+    {
+        auto hasTraitImpl(const TraitImplIndex &trait_impls_by_type, const Str &typeName, const Str &traitName,
+                          const TypeEnvironment &env) -> bool
+        {
+            return trait_impls_by_type.implements(typeName, traitName, [&](const Str &implemented, const Str &required) {
+                return traitImplies(implemented, required, env);
+            });
+        }
+    }
+
     auto typeSatisfiesAutoTrait(const CheckingRef<TypeInfo> &type, const TraitType &trait,
-                                const Map<Str, Vec<Str>> &trait_impls_by_type,
+                                const TraitImplIndex &trait_impls_by_type,
                                 const TypeEnvironment &env,
                                 Set<Str> &seen) -> bool
     {
@@ -93,14 +106,9 @@ namespace NG::typecheck
         }
         auto custom = std::dynamic_pointer_cast<CustomizedType>(candidate);
         if (!custom) return false;
-        if (auto implIt = trait_impls_by_type.find(custom->name); implIt != trait_impls_by_type.end())
+        if (hasTraitImpl(trait_impls_by_type, custom->name, trait.name, env))
         {
-            if (std::ranges::any_of(implIt->second, [&](const Str &implemented) {
-                return implemented == trait.name || traitImplies(implemented, trait.name, env);
-            }))
-            {
-                return true;
-            }
+            return true;
         }
         if (!seen.insert(custom->name + "::" + trait.name).second) return true;
         for (const auto &[_, fieldType] : custom->properties)
@@ -112,7 +120,7 @@ namespace NG::typecheck
     }
 
     auto typeSatisfiesTrait(const CheckingRef<TypeInfo> &type, const TraitType &trait,
-                            const Map<Str, Vec<Str>> &trait_impls_by_type,
+                            const TraitImplIndex &trait_impls_by_type,
                             const Set<Str> &activeAutoTraits,
                             const Set<Str> &activeDerivedTraitImplKeys,
                             const TypeEnvironment &env) -> bool
@@ -127,7 +135,7 @@ namespace NG::typecheck
         {
             return false;
         }
-        if (trait.name == COPY_TRAIT_NAME || trait.name == CLONE_TRAIT_NAME)
+        if (trait.name == COPY_TRAIT_NAME || trait.name == CLONE_TRAIT_NAME || trait.name == HASH_TRAIT_NAME)
         {
             if (isPrimitive(candidate->tag()) || candidate->tag() == typeinfo_tag::UNIT ||
                 candidate->tag() == typeinfo_tag::BOOL || candidate->tag() == typeinfo_tag::STRING)
@@ -137,6 +145,10 @@ namespace NG::typecheck
             switch (candidate->tag())
             {
             case typeinfo_tag::REFERENCE:
+                if (trait.name == HASH_TRAIT_NAME)
+                {
+                    return false;
+                }
                 return trait.name == COPY_TRAIT_NAME ||
                        typeSatisfiesTrait(static_cast<ReferenceType &>(*candidate).referencedType,
                                           trait, trait_impls_by_type, activeAutoTraits,
@@ -156,7 +168,11 @@ namespace NG::typecheck
                                           trait, trait_impls_by_type, activeAutoTraits,
                                           activeDerivedTraitImplKeys, env);
             case typeinfo_tag::VECTOR:
-                return false;
+                // Vectors hash by content but are neither Copy nor Clone.
+                return trait.name == HASH_TRAIT_NAME &&
+                       typeSatisfiesTrait(static_cast<VectorType &>(*candidate).elementType,
+                                          trait, trait_impls_by_type, activeAutoTraits,
+                                          activeDerivedTraitImplKeys, env);
             default:
                 break;
             }
@@ -175,20 +191,15 @@ namespace NG::typecheck
             return false;
         }
         auto &custom = static_cast<CustomizedType &>(*candidate);
-        if (auto implIt = trait_impls_by_type.find(custom.name); implIt != trait_impls_by_type.end())
+        if (hasTraitImpl(trait_impls_by_type, custom.name, trait.name, env))
         {
-            if (std::ranges::any_of(implIt->second, [&](const Str &implemented) {
-                return implemented == trait.name || traitImplies(implemented, trait.name, env);
-            }))
-            {
-                return true;
-            }
+            return true;
         }
         if (activeDerivedTraitImplKeys.contains(custom.name + "::" + trait.name))
         {
             return true;
         }
-        if (trait.name == COPY_TRAIT_NAME || trait.name == CLONE_TRAIT_NAME)
+        if (trait.name == COPY_TRAIT_NAME || trait.name == CLONE_TRAIT_NAME || trait.name == HASH_TRAIT_NAME)
         {
             return false;
         }
@@ -206,7 +217,7 @@ namespace NG::typecheck
     }
 
     auto typeCanDeriveTrait(const CheckingRef<TypeInfo> &type, const Str &traitName,
-                            const Map<Str, Vec<Str>> &trait_impls_by_type,
+                            const TraitImplIndex &trait_impls_by_type,
                             const TypeEnvironment &env,
                             Set<Str> &seen) -> bool
     {
@@ -220,6 +231,10 @@ namespace NG::typecheck
         switch (candidate->tag())
         {
         case typeinfo_tag::REFERENCE:
+            if (traitName == HASH_TRAIT_NAME)
+            {
+                return false;
+            }
             return traitName == COPY_TRAIT_NAME ||
                    typeCanDeriveTrait(static_cast<const ReferenceType &>(*candidate).referencedType,
                                       traitName, trait_impls_by_type, env, seen);
@@ -234,19 +249,23 @@ namespace NG::typecheck
         case typeinfo_tag::SPAN:
             return typeCanDeriveTrait(static_cast<const SpanType &>(*candidate).elementType,
                                       traitName, trait_impls_by_type, env, seen);
+        case typeinfo_tag::VECTOR:
+            return traitName == HASH_TRAIT_NAME &&
+                   typeCanDeriveTrait(static_cast<const VectorType &>(*candidate).elementType,
+                                      traitName, trait_impls_by_type, env, seen);
         default:
             break;
         }
         auto custom = std::dynamic_pointer_cast<CustomizedType>(candidate);
         if (!custom) return false;
-        if (auto implIt = trait_impls_by_type.find(custom->name); implIt != trait_impls_by_type.end())
+        if (hasTraitImpl(trait_impls_by_type, custom->name, traitName, env))
         {
-            if (std::ranges::any_of(implIt->second, [&](const Str &implemented) {
-                return implemented == traitName || traitImplies(implemented, traitName, env);
-            }))
-            {
-                return true;
-            }
+            return true;
+        }
+        if (traitName == HASH_TRAIT_NAME)
+        {
+            // Hash is derive-only, so a field type hashes only if it derived Hash itself.
+            return false;
         }
         if (!seen.insert(custom->name + "::" + traitName).second) return true;
         for (auto &[methodName, _] : custom->memberFunctions)
@@ -256,6 +275,73 @@ namespace NG::typecheck
         return true;
     }
 
+    auto typeMayNeedDrop(const CheckingRef<TypeInfo> &type, const TraitImplIndex &trait_impls_by_type,
+                         const TypeEnvironment &env, Set<Str> &seen) -> bool
+    {
+        auto candidate = unwrap(type);
+        if (!candidate) return true;
+        if (isPrimitive(candidate->tag()) || candidate->tag() == typeinfo_tag::UNIT ||
+            candidate->tag() == typeinfo_tag::NONE || candidate->tag() == typeinfo_tag::BOTTOM ||
+            candidate->tag() == typeinfo_tag::BOOL || candidate->tag() == typeinfo_tag::STRING ||
+            candidate->tag() == typeinfo_tag::RANGE)
+        {
+            return false;
+        }
+        auto any = [&](const Vec<CheckingRef<TypeInfo>> &types) {
+            return std::ranges::any_of(types, [&](const auto &element) {
+                return typeMayNeedDrop(element, trait_impls_by_type, env, seen);
+            });
+        };
+        switch (candidate->tag())
+        {
+        case typeinfo_tag::TUPLE:
+            return any(static_cast<const TupleType &>(*candidate).elementTypes);
+        case typeinfo_tag::VARARGS:
+            return any(static_cast<const VarargsType &>(*candidate).elementTypes);
+        case typeinfo_tag::UNION:
+            return any(static_cast<const UnionType &>(*candidate).types);
+        case typeinfo_tag::VARIANT:
+            return any(static_cast<const VariantType &>(*candidate).payloadTypes);
+        case typeinfo_tag::ARRAY:
+            return typeMayNeedDrop(static_cast<const ArrayType &>(*candidate).elementType, trait_impls_by_type, env,
+                                   seen);
+        case typeinfo_tag::SPAN:
+            return typeMayNeedDrop(static_cast<const SpanType &>(*candidate).elementType, trait_impls_by_type, env,
+                                   seen);
+        case typeinfo_tag::VECTOR:
+            return typeMayNeedDrop(static_cast<const VectorType &>(*candidate).elementType, trait_impls_by_type, env,
+                                   seen);
+        case typeinfo_tag::NEW_TYPE:
+            return typeMayNeedDrop(static_cast<const NewTypeType &>(*candidate).wrappedType, trait_impls_by_type, env,
+                                   seen);
+        case typeinfo_tag::TAGGED_UNION:
+        {
+            const auto &unionType = static_cast<const TaggedUnionType &>(*candidate);
+            if (!seen.insert(unionType.repr()).second) return false;
+            return std::ranges::any_of(unionType.variants, [&](const auto &variant) { return any(variant.second); });
+        }
+        case typeinfo_tag::CUSTOMIZED:
+            break;
+        default:
+            // References, trait objects, functions and unresolved generics may hold anything.
+            return true;
+        }
+        auto custom = std::dynamic_pointer_cast<CustomizedType>(candidate);
+        if (!custom || custom->nativeOpaque || custom->abstract) return true;
+        auto head = custom->name.substr(0, custom->name.find('<'));
+        if (custom->traitMemberFunctions.contains(DROP_TRAIT_NAME) ||
+            hasTraitImpl(trait_impls_by_type, custom->name, DROP_TRAIT_NAME, env) ||
+            hasTraitImpl(trait_impls_by_type, head, DROP_TRAIT_NAME, env))
+        {
+            return true;
+        }
+        // A recursive field adds no destructor the other fields do not already have.
+        if (!seen.insert(custom->repr()).second) return false;
+        return std::ranges::any_of(custom->properties, [&](const auto &property) {
+            return typeMayNeedDrop(property.second, trait_impls_by_type, env, seen);
+        });
+    }
+
     auto isObjectSafeTrait(const TraitType &trait) -> bool
     {
         for (auto &[name, type] : trait.methods)
@@ -0,0 +1,269 @@
+#include <typecheck/type_interner.hpp>
+
+#include <algorithm>
+#include <charconv>
+
+namespace NG::typecheck
+{
+  namespace
+  {
+    auto nominalTag(typeinfo_tag tag) -> bool
+    {
+      switch (tag)
+      {
+      case typeinfo_tag::CUSTOMIZED:
+      case typeinfo_tag::TRAIT:
+      case typeinfo_tag::TYPE_ALIAS:
+      case typeinfo_tag::NEW_TYPE:
+      case typeinfo_tag::TAGGED_UNION:
+      case typeinfo_tag::VARIANT:
+        return true;
+      default:
+        return false;
+      }
+    }
+
+    /**
+     * Keys are built from the tag, scalar payloads and the identity of the (already canonical) children:
+     * interned children by id, anything else by address. Interned nodes own their children, so an
+     * address in a live key cannot be reused by another object.
+     */
+    struct KeyBuilder
+    {
+      Str key;
+
+      explicit KeyBuilder(typeinfo_tag tag) { number(static_cast<uint64_t>(tag)); }
+
+      void number(uint64_t value)
+      {
+        char buffer[24];
+        auto [end, _] = std::to_chars(buffer, buffer + sizeof(buffer), value);
+        key.append(buffer, end);
+        key += ';';
+      }
+
+      void text(const Str &value)
+      {
+        number(value.size());
+        key += value;
+      }
+
+      void child(const CheckingRef<TypeInfo> &type)
+      {
+        if (!type)
+        {
+          key += "_;";
+        }
+        else if (type->internId != 0)
+        {
+          key += '#';
+          number(type->internId);
+        }
+        else
+        {
+          key += '@';
+          number(reinterpret_cast<uintptr_t>(type.get()));
+        }
+      }
+
+      void children(const Vec<CheckingRef<TypeInfo>> &types)
+      {
+        number(types.size());
+        for (const auto &type : types)
+        {
+          child(type);
+        }
+      }
+    };
+
+    /**
+     * A repr can be cached when no child repr can change afterwards: children are either interned with a
+     * cacheable repr themselves, or nominal types whose repr is their name.
+     */
+    auto stableChildRepr(const CheckingRef<TypeInfo> &type, auto &&cacheable) -> bool
+    {
+      return !type || (type->internId != 0 ? cacheable(*type) : nominalTag(type->tag()));
+    }
+  } // namespace
+
+  auto TypeInterner::internable(const TypeInfo &type) -> bool
+  {
+    if (dynamic_cast<const Untyped *>(&type) || dynamic_cast<const PrimitiveType *>(&type))
+    {
+      return true;
+    }
+    switch (type.tag())
+    {
+    case typeinfo_tag::ARRAY:
+    case typeinfo_tag::VECTOR:
+    case typeinfo_tag::SPAN:
+    case typeinfo_tag::RANGE:
+    case typeinfo_tag::TUPLE:
+    case typeinfo_tag::REFERENCE:
+    case typeinfo_tag::UNION:
+    case typeinfo_tag::VARARGS:
+    case typeinfo_tag::CONST_VALUE:
+    case typeinfo_tag::TYPE_CONSTRUCTOR_APPLICATION:
+      return true;
+    default:
+      return false;
+    }
+  }
+
+  auto TypeInterner::canonicalize(const CheckingRef<TypeInfo> &type) -> CheckingRef<TypeInfo>
+  {
+    auto internAll = [this](const Vec<CheckingRef<TypeInfo>> &types) {
+      Vec<CheckingRef<TypeInfo>> result;
+      result.reserve(types.size());
+      for (const auto &element : types)
+      {
+        result.push_back(intern(element));
+      }
+      return result;
+    };
+
+    // Each branch builds the key from canonical children first and only allocates a node on a miss.
+    auto lookupOrInsert = [this](Str key, auto makeNode, auto childrenCacheable) -> CheckingRef<TypeInfo> {
+      {
+        std::lock_guard lock{mutex};
+        if (auto it = table.find(key); it != table.end())
+        {
+          return it->second;
+        }
+      }
+      CheckingRef<TypeInfo> node = makeNode();
+      node->reprCacheable = childrenCacheable();
+      std::lock_guard lock{mutex};
+      auto [it, inserted] = table.try_emplace(std::move(key), node);
+      if (inserted)
+      {
+        node->internId = ++nextId;
+      }
+      return it->second;
+    };
+    auto cacheable = [](const TypeInfo &child) { return child.reprCacheable; };
+    auto always = [] { return true; };
+
+    if (dynamic_cast<const Untyped *>(type.get()))
+    {
+      return lookupOrInsert(KeyBuilder{typeinfo_tag::UNTYPED}.key, [] { return makecheck<Untyped>(); }, always);
+    }
+    if (auto primitive = dynamic_cast<const PrimitiveType *>(type.get()))
+    {
+      KeyBuilder key{typeinfo_tag::PRIMITIVE};
+      key.number(static_cast<uint64_t>(primitive->type));
+      auto tag = primitive->type;
+      return lookupOrInsert(std::move(key.key), [tag] { return makecheck<PrimitiveType>(tag); }, always);
+    }
+
+    auto unary = [&](const CheckingRef<TypeInfo> &element, auto makeNode) {
+      auto canonical = intern(element);
+      KeyBuilder key{type->tag()};
+      key.child(canonical);
+      return lookupOrInsert(
+          std::move(key.key), [&] { return makeNode(canonical); },
+          [&] { return stableChildRepr(canonical, cacheable); });
+    };
+    auto nary = [&](const Vec<CheckingRef<TypeInfo>> &elements, auto makeNode) {
+      auto canonical = internAll(elements);
+      KeyBuilder key{type->tag()};
+      key.children(canonical);
+      return lookupOrInsert(
+          std::move(key.key), [&] { return makeNode(canonical); },
+          [&] {
+            return std::all_of(canonical.begin(), canonical.end(),
+                               [&](const auto &element) { return stableChildRepr(element, cacheable); });
+          });
+    };
+
+    switch (type->tag())
+    {
+    case typeinfo_tag::ARRAY:
+    {
+      const auto &array = static_cast<const ArrayType &>(*type);
+      auto element = intern(array.elementType);
+      auto length = intern(array.length);
+      KeyBuilder key{typeinfo_tag::ARRAY};
+      key.child(element);
+      key.child(length);
+      return lookupOrInsert(
+          std::move(key.key), [&] { return makecheck<ArrayType>(element, length); },
+          [&] { return stableChildRepr(element, cacheable) && stableChildRepr(length, cacheable); });
+    }
+    case typeinfo_tag::VECTOR:
+      return unary(static_cast<const VectorType &>(*type).elementType,
+                   [](auto canonical) { return makecheck<VectorType>(std::move(canonical)); });
+    case typeinfo_tag::SPAN:
+      return unary(static_cast<const SpanType &>(*type).elementType,
+                   [](auto canonical) { return makecheck<SpanType>(std::move(canonical)); });
+    case typeinfo_tag::RANGE:
+      return unary(static_cast<const RangeType &>(*type).elementType,
+                   [](auto canonical) { return makecheck<RangeType>(std::move(canonical)); });
+    case typeinfo_tag::REFERENCE:
+      return unary(static_cast<const ReferenceType &>(*type).referencedType,
+                   [](auto canonical) { return makecheck<ReferenceType>(std::move(canonical)); });
+    case typeinfo_tag::TUPLE:
+      return nary(static_cast<const TupleType &>(*type).elementTypes,
+                  [](auto canonical) { return makecheck<TupleType>(std::move(canonical)); });
+    case typeinfo_tag::UNION:
+      return nary(static_cast<const UnionType &>(*type).types,
+                  [](auto canonical) { return makecheck<UnionType>(std::move(canonical)); });
+    case typeinfo_tag::VARARGS:
+      return nary(static_cast<const VarargsType &>(*type).elementTypes,
+                  [](auto canonical) { return makecheck<VarargsType>(std::move(canonical)); });
+    case typeinfo_tag::CONST_VALUE:
+    {
+      const auto &constant = static_cast<const ConstValueType &>(*type);
+      KeyBuilder key{typeinfo_tag::CONST_VALUE};
+      key.text(constant.value);
+      key.text(constant.valueType);
+      key.number(constant.isParam ? 1 : 0);
+      return lookupOrInsert(
+          std::move(key.key),
+          [&] { return makecheck<ConstValueType>(constant.value, constant.valueType, constant.isParam); }, always);
+    }
+    case typeinfo_tag::TYPE_CONSTRUCTOR_APPLICATION:
+    {
+      const auto &application = static_cast<const TypeConstructorApplicationType &>(*type);
+      auto constructor = intern(application.constructorType);
+      auto arguments = internAll(application.typeArgs);
+      KeyBuilder key{typeinfo_tag::TYPE_CONSTRUCTOR_APPLICATION};
+      key.child(constructor);
+      key.children(arguments);
+      // The constructor may be a generic definition or parameter whose repr is not just a name.
+      return lookupOrInsert(
+          std::move(key.key), [&] { return makecheck<TypeConstructorApplicationType>(constructor, arguments); },
+          [] { return false; });
+    }
+    default:
+      return type;
+    }
+  }
+
+  auto TypeInterner::intern(const CheckingRef<TypeInfo> &type) -> CheckingRef<TypeInfo>
+  {
+    if (!type || type->internId != 0 || !internable(*type))
+    {
+      return type;
+    }
+    return canonicalize(type);
+  }
+
+  auto TypeInterner::size() const -> size_t
+  {
+    std::lock_guard lock{mutex};
+    return table.size();
+  }
+
+  auto TypeInterner::global() -> TypeInterner &
+  {
+    static TypeInterner interner;
+    return interner;
+  }
+
+  auto intern_type(const CheckingRef<TypeInfo> &type) -> CheckingRef<TypeInfo>
+  {
+    return TypeInterner::global().intern(type);
+  }
+
+} // namespace NG::typecheck
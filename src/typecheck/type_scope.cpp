@@ -0,0 +1,140 @@
+#include <typecheck/type_scope.hpp>
+
+namespace NG::typecheck
+{
+  namespace
+  {
+    /**
+     * Chains longer than this are partially squashed when a new frame is pushed.
+     */
+    constexpr size_t MAX_SCOPE_DEPTH = 32;
+  } // namespace
+
+  TypeScope::TypeScope(Map<Str, std::shared_ptr<TypeInfo>> bindings) : top(std::make_shared<Frame>())
+  {
+    top->bindings = std::move(bindings);
+  }
+
+  auto TypeScope::writableTop() -> Frame &
+  {
+    if (top && top.use_count() == 1)
+    {
+      return *top;
+    }
+    auto frame = std::make_shared<Frame>();
+    if (top && top->depth >= MAX_SCOPE_DEPTH)
+    {
+      // Fold the inner half of the chain into the new frame. Inner frames are usually small block and
+      // generic scopes, while the outer ones hold the module and prelude symbols.
+      std::shared_ptr<const Frame> outer = top;
+      for (size_t i = 0; i < MAX_SCOPE_DEPTH / 2; ++i)
+      {
+        for (const auto &[name, type] : outer->bindings)
+        {
+          frame->bindings.emplace(name, type);
+        }
+        outer = outer->parent;
+      }
+      frame->parent = std::move(outer);
+    }
+    else
+    {
+      frame->parent = top;
+    }
+    frame->depth = frame->parent ? frame->parent->depth + 1 : 1;
+    top = std::move(frame);
+    return *top;
+  }
+
+  auto TypeScope::find(const Str &name) const -> const_iterator
+  {
+    for (const Frame *frame = top.get(); frame != nullptr; frame = frame->parent.get())
+    {
+      if (auto it = frame->bindings.find(name); it != frame->bindings.end())
+      {
+        return {top.get(), frame, it};
+      }
+    }
+    return end();
+  }
+
+  auto TypeScope::begin() const -> const_iterator
+  {
+    if (!top)
+    {
+      return end();
+    }
+    const_iterator it{top.get(), top.get(), top->bindings.begin()};
+    it.settle();
+    return it;
+  }
+
+  auto TypeScope::operator[](const Str &name) -> std::shared_ptr<TypeInfo> &
+  {
+    auto visible = find(name);
+    if (visible != end() && visible.frame == top.get() && top.use_count() == 1)
+    {
+      return top->bindings.find(name)->second;
+    }
+    auto type = visible != end() ? visible->second : nullptr;
+    return writableTop().bindings.try_emplace(name, std::move(type)).first->second;
+  }
+
+  void TypeScope::insert_or_assign(const Str &name, std::shared_ptr<TypeInfo> type)
+  {
+    writableTop().bindings.insert_or_assign(name, std::move(type));
+  }
+
+  auto TypeScope::flatten() const -> Map<Str, std::shared_ptr<TypeInfo>>
+  {
+    Map<Str, std::shared_ptr<TypeInfo>> flat;
+    for (const Frame *frame = top.get(); frame != nullptr; frame = frame->parent.get())
+    {
+      for (const auto &[name, type] : frame->bindings)
+      {
+        flat.emplace(name, type);
+      }
+    }
+    return flat;
+  }
+
+  auto TypeScope::const_iterator::shadowed() const -> bool
+  {
+    for (const Frame *inner = innermost; inner != frame; inner = inner->parent.get())
+    {
+      if (inner->bindings.contains(entry->first))
+      {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  void TypeScope::const_iterator::settle()
+  {
+    while (frame != nullptr)
+    {
+      while (entry != frame->bindings.end() && shadowed())
+      {
+        ++entry;
+      }
+      if (entry != frame->bindings.end())
+      {
+        return;
+      }
+      frame = frame->parent.get();
+      if (frame != nullptr)
+      {
+        entry = frame->bindings.begin();
+      }
+    }
+  }
+
+  auto TypeScope::const_iterator::operator++() -> const_iterator &
+  {
+    ++entry;
+    settle();
+    return *this;
+  }
+
+} // namespace NG::typecheck
@@ -11,10 +11,15 @@
 #include <typecheck/trait_registry.hpp>
 #include <typecheck/receiver_effect_collector.hpp>
 #include <typecheck/mangling.hpp>
+#include <typecheck/type_interner.hpp>
+#include <typecheck/module_interface.hpp>
 #include <typecheck/typecheck.hpp>
 #include <runtime/value_access.hpp>
 #include <module.hpp>
+#include <orgasm/module.hpp>
 #include <parser.hpp>
+#include <sysdep/mapped_file.hpp>
+#include <sysdep/thread_pool.hpp>
 #include <algorithm>
 #include <cctype>
 #include <filesystem>
@@ -39,6 +44,7 @@ namespace NG::typecheck
     CheckingRef<TypeInfo> expectedType;
     Str currentModuleId = "default";
     Str activeGenericInstanceName;
+    Vec<std::function<void()>> *pendingBodyChecks = nullptr; ///< Set while a module registers its definitions.
 
     // ── Static global state ─────────────────────────────────────────────
     inline static Map<Str, Vec<TypeAliasDef *>> activeTypeAliasSpecializations{};
@@ -51,6 +57,17 @@ namespace NG::typecheck
     inline static Set<Str> preludeAutoTraits{};
     inline static Set<Str> activeDerivedTraitImplKeys{};
     inline static Vec<ASTRef<ASTNode>> retainedPreludeImportAsts{};
+    struct GenericInstanceLog
+    {
+      Vec<std::shared_ptr<GenericFunctionInstance>> instances; ///< In first-use order.
+      Set<Str> symbols;                                        ///< Mangled names of `instances`.
+    };
+    inline static GenericInstanceLog activeGenericInstances{};
+    /// Log of the body being checked on this thread while module bodies are checked in parallel.
+    inline static thread_local GenericInstanceLog *bodyGenericInstances = nullptr;
+    inline static Vec<GenericFunctionInstance *> checkingGenericInstances{}; ///< Instances whose bodies are being checked.
+    /// Held while instantiating generic functions and types, whose caches are shared between bodies.
+    inline static std::recursive_mutex genericInstantiationMutex{};
 
     // ── Module artifacts ────────────────────────────────────────────────
     struct TraitImplRecord
@@ -78,14 +95,37 @@ namespace NG::typecheck
     Set<Str> matchedSelectedTraitImpls;
     Vec<Str> modulePaths;
     inline static Map<Str, ModuleArtifacts> moduleArtifactsById{};
+    inline static Map<Str, Str> moduleInterfaceHashes{}; ///< Interface hashes of modules checked or restored.
+    /// Interfaces in the loaded prelude snapshot, by module ID.
+    inline static Map<Str, std::string_view> snapshotInterfaces{};
+    /// Entries of the current prelude snapshot image, in check order.
+    inline static Vec<PreludeSnapshotEntry> snapshotImage{};
+    /// Mapped or written snapshot images. Replaced images are kept, since views into them may be in use.
+    inline static Vec<std::shared_ptr<const void>> snapshotBackings{};
+    inline static std::mutex snapshotMutex; ///< Guards the snapshot state once the prelude is checked.
+    /// Receives the interface of every module checked or restored while the prelude snapshot is built.
+    inline static Vec<std::pair<Str, Str>> *collectedInterfaces = nullptr;
     inline static Set<Str> activeModuleChecks{};
+    /// What checking a module left in the statics above, for checks importing it to take instead.
+    struct SharedModuleCheck
+    {
+      ModuleArtifacts artifacts;
+      Str interfaceHash;
+      Map<Str, Vec<TypeAliasDef *>> typeAliasSpecializations;
+      Map<Str, Vec<ConstDef *>> constPredicates;
+      Map<Str, Vec<FunctionDef *>> constFunctions;
+      Set<Str> autoTraits;
+      Set<Str> derivedTraitImplKeys;
+    };
+    /// Modules passed to `share_module_check`, by module ID. Kept across checks until cleared.
+    inline static Map<Str, SharedModuleCheck> sharedModuleChecks{};
 
     // ── Convenience aliases to env/traits members ───────────────────────
     // These allow existing code to work without mass-renaming locals -> env.locals
-    Map<Str, CheckingRef<TypeInfo>> &locals = env.locals;
+    TypeScope &locals = env.locals;
     Set<Str> &movedBindings = env.movedBindings;
     bool &allowMovedLvalueRead = env.allowMovedLvalueRead;
-    Map<Str, Vec<Str>> &trait_impls_by_type = traits.trait_impls_by_type;
+    TraitImplIndex &trait_impls_by_type = traits.trait_impls_by_type;
     Set<Str> &autoTraitNames = traits.autoTraitNames;
     Set<Str> &derivedTraitImplKeys = traits.derivedTraitImplKeys;
     Set<Str> &importedSymbolNames = env.importedSymbolNames;
@@ -99,8 +139,10 @@ namespace NG::typecheck
     static constexpr const char *COPY_TRAIT_NAME = "Copy";
     static constexpr const char *CLONE_TRAIT_NAME = "Clone";
     static constexpr const char *DROP_TRAIT_NAME = "Drop";
+    static constexpr const char *HASH_TRAIT_NAME = "Hash";
+    static constexpr size_t MIN_PARALLEL_BODY_CHECKS = 8; ///< Fewer queued bodies are checked serially.
 
-    explicit TypeChecker(Map<Str, CheckingRef<TypeInfo>> locals, Vec<CheckingRef<TypeInfo>> contextRequirement = {},
+    explicit TypeChecker(TypeScope locals, Vec<CheckingRef<TypeInfo>> contextRequirement = {},
                          CheckingRef<TypeInfo> expectedType = nullptr, Set<Str> movedBindings = {},
                          bool allowMovedLvalueRead = false, Str activeGenericInstanceName = "",
                          Vec<Str> modulePaths = {})
@@ -264,6 +306,47 @@ namespace NG::typecheck
       return sequenceElementType(type) != nullptr;
     }
 
+    /**
+     * @brief Returns the type of a growable-vector member, or null if `memberName` is not one.
+     *
+     * Mutating members write their receiver in place, so they carry a write effect on it.
+     */
+    static auto vectorMemberType(const VectorType &vectorType, const Str &memberName) -> CheckingRef<FunctionType>
+    {
+      auto unit = makecheck<PrimitiveType>(typeinfo_tag::UNIT);
+      auto index = makecheck<PrimitiveType>(typeinfo_tag::I32);
+      CheckingRef<FunctionType> member;
+      if (memberName == "capacity")
+      {
+        return makecheck<FunctionType>(makecheck<PrimitiveType>(typeinfo_tag::U32), Vec<CheckingRef<TypeInfo>>{});
+      }
+      if (memberName == "push")
+      {
+        member = makecheck<FunctionType>(unit, Vec<CheckingRef<TypeInfo>>{vectorType.elementType});
+      }
+      else if (memberName == "pop")
+      {
+        member = makecheck<FunctionType>(vectorType.elementType, Vec<CheckingRef<TypeInfo>>{});
+      }
+      else if (memberName == "clear")
+      {
+        member = makecheck<FunctionType>(unit, Vec<CheckingRef<TypeInfo>>{});
+      }
+      else if (memberName == "insert")
+      {
+        member = makecheck<FunctionType>(unit, Vec<CheckingRef<TypeInfo>>{index, vectorType.elementType});
+      }
+      else if (memberName == "truncate" || memberName == "reserve")
+      {
+        member = makecheck<FunctionType>(unit, Vec<CheckingRef<TypeInfo>>{index});
+      }
+      if (member)
+      {
+        member->placeEffects = {{PlaceEffectKind::Read, ""}, {PlaceEffectKind::Write, ""}};
+      }
+      return member;
+    }
+
     void rejectBorrowConflict(const Str &operation, const Str &place, TokenPosition pos) const
     {
       if (auto borrowed = borrowedConflict(movedBindings, place); borrowed.has_value())
@@ -587,7 +670,7 @@ namespace NG::typecheck
 
     static auto isBuiltinLifecycleTraitName(const Str &name) -> bool
     {
-      return name == COPY_TRAIT_NAME || name == CLONE_TRAIT_NAME || name == DROP_TRAIT_NAME;
+      return name == COPY_TRAIT_NAME || name == CLONE_TRAIT_NAME || name == DROP_TRAIT_NAME || name == HASH_TRAIT_NAME;
     }
 
     static auto unitType() -> CheckingRef<TypeInfo>
@@ -627,13 +710,18 @@ namespace NG::typecheck
       {
         trait->methods["drop"] = makecheck<FunctionType>(unitType(), Vec<CheckingRef<TypeInfo>>{refSelfType()});
       }
+      else if (trait->name == HASH_TRAIT_NAME)
+      {
+        trait->methods["hash"] = makecheck<FunctionType>(makecheck<PrimitiveType>(typeinfo_tag::U64),
+                                                         Vec<CheckingRef<TypeInfo>>{refSelfType()});
+      }
       trait->allMethods = trait->methods;
       return trait;
     }
 
     void installBuiltinLifecycleTraits()
     {
-      for (const auto &name : Vec<Str>{COPY_TRAIT_NAME, CLONE_TRAIT_NAME, DROP_TRAIT_NAME})
+      for (const auto &name : Vec<Str>{COPY_TRAIT_NAME, CLONE_TRAIT_NAME, DROP_TRAIT_NAME, HASH_TRAIT_NAME})
       {
         if (!locals.contains(name))
         {
@@ -659,6 +747,16 @@ namespace NG::typecheck
                        isRefSelfTypeAnnotation(param->annotatedType.get()));
     }
 
+    /**
+     * @brief Whether a member function declares a `ref<Self>` receiver, through which it may edit the receiver.
+     */
+    static auto declaresRefReceiver(const CheckingRef<TypeInfo> &memberType) -> bool
+    {
+      auto funType = std::dynamic_pointer_cast<FunctionType>(memberType);
+      return funType && !funType->parametersType.empty() && funType->parametersType.front() &&
+             funType->parametersType.front()->tag() == typeinfo_tag::REFERENCE;
+    }
+
     static auto isObjectSafeTraitMethod(const FunctionType &methodType) -> bool
     {
       if (methodType.parametersType.empty() || !is_ref_self_type(methodType.parametersType.front()))
@@ -987,9 +1085,8 @@ namespace NG::typecheck
       FunctionDef *best = genericDef.funcDef.get();
       size_t bestSpecificity = 0;
       bool found = false;
-      for (auto &candidateRef : genericDef.overloads)
+      for (auto *candidate : genericOverloadCandidates(genericDef, argumentTypes))
       {
-        auto *candidate = candidateRef.get();
         if (!candidate)
         {
           continue;
@@ -1023,9 +1120,37 @@ namespace NG::typecheck
       return nullptr;
     }
 
+    /**
+     * Selects the overload for a call, reusing earlier selections for the same argument types. Overload
+     * sets with `where` clauses are not cached, since impls registered later can change the outcome.
+     */
+    auto selectGenericFunctionCandidateCached(GenericDefType &genericDef,
+                                              const Vec<CheckingRef<TypeInfo>> &argumentTypes,
+                                              const Str &argumentKey, size_t explicitGenericArgCount) -> FunctionDef *
+    {
+      if (genericDef.overloads.size() == 1)
+      {
+        return selectGenericFunctionCandidate(genericDef, argumentTypes, explicitGenericArgCount);
+      }
+      auto key = argumentKey + '/' + std::to_string(explicitGenericArgCount);
+      if (auto cached = genericDef.selectedOverloads.find(key); cached != genericDef.selectedOverloads.end())
+      {
+        return cached->second.first;
+      }
+      auto *selected = selectGenericFunctionCandidate(genericDef, argumentTypes, explicitGenericArgCount);
+      const bool cacheable = std::ranges::none_of(genericDef.overloads, [](const auto &overload) {
+        return overload && !overload->whereBounds.empty();
+      });
+      if (cacheable)
+      {
+        genericDef.selectedOverloads.emplace(std::move(key), std::make_pair(selected, argumentTypes));
+      }
+      return selected;
+    }
+
     auto resolveAliasSpecializationBody(const TypeAliasDef &specialization,
                                         const Map<Str, CheckingRef<TypeInfo>> &bindings,
-                                        const Map<Str, CheckingRef<TypeInfo>> &scope,
+                                        const TypeScope &scope,
                                         const Str &instanceName) -> CheckingRef<TypeInfo>
     {
       if (specialization.deleted)
@@ -1285,7 +1410,7 @@ namespace NG::typecheck
                                      implDef->pos);
     }
 
-    void addGenericParamsToScope(Map<Str, CheckingRef<TypeInfo>> &scope,
+    void addGenericParamsToScope(TypeScope &scope,
                                  const Vec<ASTRef<GenericParam>> &genericParams) const
     {
       for (auto &gp : genericParams)
@@ -1302,7 +1427,7 @@ namespace NG::typecheck
       }
     }
 
-    void addWhereBoundsToScope(Map<Str, CheckingRef<TypeInfo>> &scope,
+    void addWhereBoundsToScope(const TypeScope &scope,
                                const Vec<ASTRef<TraitBound>> &bounds) const
     {
       for (auto &bound : bounds)
@@ -1332,7 +1457,7 @@ namespace NG::typecheck
     }
 
     auto resolveConstPredicateTypeArg(TypeAnnotation *annotation,
-                                      const Map<Str, CheckingRef<TypeInfo>> &scope) -> CheckingRef<TypeInfo>
+                                      const TypeScope &scope) -> CheckingRef<TypeInfo>
     {
       if (!annotation)
       {
@@ -1757,7 +1882,7 @@ namespace NG::typecheck
       }
     }
 
-    auto functionTypeFor(FunctionDef *funDef, const Map<Str, CheckingRef<TypeInfo>> &scope) -> CheckingRef<FunctionType>
+    auto functionTypeFor(FunctionDef *funDef, const TypeScope &scope) -> CheckingRef<FunctionType>
     {
       TypeChecker checker{scope};
       Vec<CheckingRef<TypeInfo>> paramTypes;
@@ -1861,6 +1986,12 @@ namespace NG::typecheck
       return NG::typecheck::typeCanDeriveTrait(type, traitName, trait_impls_by_type, env, seen);
     }
 
+    auto typeMayNeedDrop(const CheckingRef<TypeInfo> &type) const -> bool
+    {
+      Set<Str> seen;
+      return NG::typecheck::typeMayNeedDrop(type, trait_impls_by_type, env, seen);
+    }
+
     auto typeSatisfiesTrait(const CheckingRef<TypeInfo> &type, const TraitType &trait) const -> bool
     {
       // Handle Sequence trait specially (requires TypeChecker state for isSequenceType)
@@ -1952,6 +2083,7 @@ namespace NG::typecheck
       {
         throw TypeCheckingException("Generic type parameter packs are not supported for type declarations yet");
       }
+      std::lock_guard instantiationLock{genericInstantiationMutex};
 
       if (typeArgs.size() != genericDef.typeParamNames.size())
       {
@@ -2033,7 +2165,7 @@ namespace NG::typecheck
         return resultType;
       }
 
-      Map<Str, CheckingRef<TypeInfo>> instLocals = genericDef.capturedLocals;
+      TypeScope instLocals = genericDef.capturedLocals;
       for (size_t i = 0; i < genericDef.typeParamNames.size(); ++i)
       {
         instLocals[genericDef.typeParamNames[i]] = typeArgs[i];
@@ -2779,6 +2911,74 @@ namespace NG::typecheck
     void visit(CompileUnit *compileUnit) override { compileUnit->module->accept(this); }
 
     // ── Module-level type checking ──────────────────────────────────────
+    /**
+     * Checks a function or method body now, or queues it while a module is registering its definitions.
+     */
+    void checkBody(std::function<void()> check)
+    {
+      if (pendingBodyChecks)
+      {
+        pendingBodyChecks->push_back(std::move(check));
+      }
+      else
+      {
+        check();
+      }
+    }
+
+    /**
+     * Runs queued body checks on a thread pool. The outcome matches running them in order: the error of
+     * the first failing body is rethrown, and generic instances are recorded in the order the bodies
+     * would have used them.
+     */
+    static void runBodyChecks(Vec<std::function<void()>> &checks)
+    {
+      auto workers = std::min(NG::System::ThreadPool::default_concurrency(), checks.size());
+      if (checks.size() < MIN_PARALLEL_BODY_CHECKS || workers < 2)
+      {
+        for (auto &check : checks)
+        {
+          check();
+        }
+        return;
+      }
+      Vec<GenericInstanceLog> logs(checks.size());
+      Vec<std::exception_ptr> errors(checks.size());
+      {
+        NG::System::ThreadPool pool{workers};
+        for (size_t i = 0; i < checks.size(); ++i)
+        {
+          pool.submit([&, i] {
+            bodyGenericInstances = &logs[i];
+            try
+            {
+              checks[i]();
+            }
+            catch (...)
+            {
+              errors[i] = std::current_exception();
+            }
+            bodyGenericInstances = nullptr;
+          });
+        }
+        pool.wait();
+      }
+      for (auto &error : errors)
+      {
+        if (error)
+        {
+          std::rethrow_exception(error);
+        }
+      }
+      for (auto &log : logs)
+      {
+        for (auto &instance : log.instances)
+        {
+          recordGenericInstance(instance);
+        }
+      }
+    }
+
     void visit(Module *module) override
     {
       installBuiltinLifecycleTraits();
@@ -2801,6 +3001,7 @@ namespace NG::typecheck
             typeParamNames.push_back(gp->name);
           }
           locals[traitDef->traitName] = makecheck<TraitType>(traitDef->traitName, typeParamNames, currentModuleId);
+          TraitImplIndex::traitGraphChanged();
         }
         else if (auto constDef = dynamic_ast_cast<ConstDef>(def))
         {
@@ -2821,7 +3022,7 @@ namespace NG::typecheck
           if (!funDef->genericParams.empty())
           {
             auto validateGenericFunctionAnnotations = [&](FunctionDef *target) {
-              Map<Str, CheckingRef<TypeInfo>> genericLocals = locals;
+              TypeScope genericLocals = locals;
               addGenericParamsToScope(genericLocals, target->genericParams);
               addWhereBoundsToScope(genericLocals, target->whereBounds);
               for (auto param : target->params)
@@ -2836,6 +3037,10 @@ namespace NG::typecheck
             if (auto existing = std::dynamic_pointer_cast<GenericDefType>(locals[funDef->funName]))
             {
               existing->overloads.push_back(funDef);
+              indexGenericOverloads(*existing);
+              // Earlier calls may prefer the new overload now.
+              existing->selectedOverloads.clear();
+              existing->instantiations.clear();
               validateGenericFunctionAnnotations(funDef.get());
               continue;
             }
@@ -2852,6 +3057,7 @@ namespace NG::typecheck
             genericDef->typeParamKindArities = genericParamKindArities(funDef->genericParams);
             genericDef->typeParamKindVariadicTails =
                 genericParamKindVariadicTails(funDef->genericParams);
+            indexGenericOverloads(*genericDef);
             locals[funDef->funName] = genericDef;
 
             // Register generic type params in a temporary scope so parameter
@@ -2863,19 +3069,26 @@ namespace NG::typecheck
           }
 
           Vec<CheckingRef<TypeInfo>> paramTypes;
-          TypeChecker checker{locals};
-          for (auto param : funDef->params)
-          {
-            param->accept(&checker);
-            paramTypes.push_back(checker.result);
-          }
-
           CheckingRef<TypeInfo> returnType = makecheck<Untyped>();
-          if (funDef->returnType)
+          try
           {
             TypeChecker checker{locals};
-            funDef->returnType->accept(&checker);
-            returnType = checker.result;
+            for (auto param : funDef->params)
+            {
+              param->accept(&checker);
+              paramTypes.push_back(checker.result);
+            }
+            if (funDef->returnType)
+            {
+              TypeChecker checker{locals};
+              funDef->returnType->accept(&checker);
+              returnType = checker.result;
+            }
+          }
+          catch (const TypeCheckingException &)
+          {
+            // Imported types are not in scope yet; visit(FunctionDef) registers the signature instead.
+            continue;
           }
 
           auto funcType = makecheck<FunctionType>(returnType, paramTypes);
@@ -3054,14 +3267,30 @@ namespace NG::typecheck
           validateUseImplDecl(useImpl.get());
         }
       }
-      for (auto def : module->definitions)
+      // Definitions are registered in order; their bodies only need the registered signatures, so they
+      // are queued and checked afterwards, in parallel when there are enough of them.
+      Vec<std::function<void()>> bodyChecks;
+      pendingBodyChecks = &bodyChecks;
+      try
       {
-        if (dynamic_ast_cast<TraitDef>(def) || dynamic_ast_cast<UseImplDecl>(def))
+        for (auto def : module->definitions)
         {
-          continue;
+          if (dynamic_ast_cast<TraitDef>(def) || dynamic_ast_cast<UseImplDecl>(def))
+          {
+            continue;
+          }
+          def->accept(this);
         }
-        def->accept(this);
       }
+      catch (...)
+      {
+        // A serial run would have failed on an earlier body first.
+        pendingBodyChecks = nullptr;
+        runBodyChecks(bodyChecks);
+        throw;
+      }
+      pendingBodyChecks = nullptr;
+      runBodyChecks(bodyChecks);
       for (const auto &[traitName, selections] : selectedTraitImpls)
       {
         for (auto *selection : selections)
@@ -3085,7 +3314,10 @@ namespace NG::typecheck
         stmt->accept(this);
       }
       publishModuleArtifacts(module);
-      type_index.merge(locals);
+      for (const auto &[name, type] : locals)
+      {
+        type_index.emplace(name, type);
+      }
       result = makecheck<Untyped>();
     }
 
@@ -3138,39 +3370,41 @@ namespace NG::typecheck
         customType->memberFunctions[memFn->funName] = funType;
 
         // Check member function body
-        TypeChecker bodyChecker{methodScope};
+        auto bodyChecker = std::make_shared<TypeChecker>(methodScope);
         if (!hasExplicitReceiver)
         {
-          bodyChecker.locals.insert_or_assign("self", customType);
+          bodyChecker->locals.insert_or_assign("self", customType);
           // Flatten properties into body scope for legacy implicit-receiver methods.
           for (auto &&[name, type] : customType->properties)
           {
-            bodyChecker.locals.insert_or_assign(name, type);
+            bodyChecker->locals.insert_or_assign(name, type);
           }
         }
         for (size_t i = 0; i < memFn->params.size(); ++i)
         {
           auto paramIndex = i + (hasExplicitReceiver ? 0 : 1);
-          bodyChecker.locals.insert_or_assign(memFn->params[i]->paramName,
-                                              unwrap(funType->parametersType[paramIndex]));
+          bodyChecker->locals.insert_or_assign(memFn->params[i]->paramName,
+                                               unwrap(funType->parametersType[paramIndex]));
         }
-        bodyChecker.contextRequirement = funType->parametersType;
+        bodyChecker->contextRequirement = funType->parametersType;
 
         if (memFn->body)
         {
-          memFn->body->accept(&bodyChecker);
-          auto bodyReturnType = bodyChecker.result;
-          if (!bodyReturnType)
-          {
-            bodyReturnType = makecheck<PrimitiveType>(typeinfo_tag::UNIT);
-          }
-          if (bodyReturnType->tag() != typeinfo_tag::UNTYPED && returnType->tag() != typeinfo_tag::UNTYPED &&
-              !typeMatch(*returnType, *bodyReturnType))
-          {
-            throw TypeCheckingException("Return Type Mismatch: " + bodyReturnType->repr() + " to " +
-                                            returnType->repr(),
-                                        memFn->pos);
-          }
+          checkBody([bodyChecker, method = memFn.get(), returnType] {
+            method->body->accept(bodyChecker.get());
+            auto bodyReturnType = bodyChecker->result;
+            if (!bodyReturnType)
+            {
+              bodyReturnType = makecheck<PrimitiveType>(typeinfo_tag::UNIT);
+            }
+            if (bodyReturnType->tag() != typeinfo_tag::UNTYPED && returnType->tag() != typeinfo_tag::UNTYPED &&
+                !typeMatch(*returnType, *bodyReturnType))
+            {
+              throw TypeCheckingException("Return Type Mismatch: " + bodyReturnType->repr() + " to " +
+                                              returnType->repr(),
+                                          method->pos);
+            }
+          });
         }
       }
 
@@ -3184,9 +3418,9 @@ namespace NG::typecheck
           throw TypeCheckingException("derive target is not a trait: " + derivedTraitAnnotation->repr(),
                                       derivedTraitAnnotation->pos);
         }
-        if (trait->name != COPY_TRAIT_NAME && trait->name != CLONE_TRAIT_NAME)
+        if (trait->name != COPY_TRAIT_NAME && trait->name != CLONE_TRAIT_NAME && trait->name != HASH_TRAIT_NAME)
         {
-          throw TypeCheckingException("derive currently supports Copy and Clone only: " + trait->name,
+          throw TypeCheckingException("derive currently supports Copy, Clone and Hash only: " + trait->name,
                                       derivedTraitAnnotation->pos);
         }
         auto derivedKey = customType->name + "::" + trait->name;
@@ -3195,18 +3429,14 @@ namespace NG::typecheck
           throw TypeCheckingException("Duplicate derive for trait '" + trait->name + "' on type '" +
                                       customType->name + "'", derivedTraitAnnotation->pos);
         }
-        if (auto implIt = trait_impls_by_type.find(customType->name);
-            implIt != trait_impls_by_type.end() &&
-            std::ranges::find(implIt->second, trait->name) != implIt->second.end())
+        if (trait_impls_by_type.hasDirectImpl(customType->name, trait->name))
         {
           throw TypeCheckingException("derive conflicts with explicit impl for trait '" + trait->name +
                                       "' on type '" + customType->name + "'", derivedTraitAnnotation->pos);
         }
         if (trait->name == COPY_TRAIT_NAME)
         {
-          if (auto implIt = trait_impls_by_type.find(customType->name);
-              implIt != trait_impls_by_type.end() &&
-              std::ranges::find(implIt->second, DROP_TRAIT_NAME) != implIt->second.end())
+          if (trait_impls_by_type.hasDirectImpl(customType->name, DROP_TRAIT_NAME))
           {
             throw TypeCheckingException("Copy cannot be derived for Drop type '" + customType->name + "'",
                                         derivedTraitAnnotation->pos);
@@ -3223,11 +3453,7 @@ namespace NG::typecheck
         }
         derivedTraitImplKeys.insert(derivedKey);
         activeDerivedTraitImplKeys.insert(derivedKey);
-        auto &implTraits = trait_impls_by_type[customType->name];
-        if (std::ranges::find(implTraits, trait->name) == implTraits.end())
-        {
-          implTraits.push_back(trait->name);
-        }
+        trait_impls_by_type.add(customType->name, trait->name);
         if (trait->name == CLONE_TRAIT_NAME)
         {
           auto cloneType =
@@ -3239,12 +3465,23 @@ namespace NG::typecheck
             customType->memberFunctions["clone"] = cloneType;
           }
         }
+        if (trait->name == HASH_TRAIT_NAME)
+        {
+          auto hashType = makecheck<FunctionType>(makecheck<PrimitiveType>(typeinfo_tag::U64),
+                                                  Vec<CheckingRef<TypeInfo>>{makecheck<ReferenceType>(customType)});
+          customType->traitMemberFunctions[HASH_TRAIT_NAME]["hash"] = hashType;
+          customType->memberFunctions[HASH_TRAIT_NAME + Str{"::hash"}] = hashType;
+          if (!customType->memberFunctions.contains("hash"))
+          {
+            customType->memberFunctions["hash"] = hashType;
+          }
+        }
       }
     }
 
     void visit(ConstDef *constDef) override
     {
-      Map<Str, CheckingRef<TypeInfo>> constScope = locals;
+      TypeScope constScope = locals;
       addGenericParamsToScope(constScope, constDef->genericParams);
 
       TypeChecker returnChecker{constScope};
@@ -3312,7 +3549,7 @@ namespace NG::typecheck
                                           "' must match the reserved builtin shape",
                                       traitDef->pos);
         }
-        Map<Str, CheckingRef<TypeInfo>> traitScope = locals;
+        TypeScope traitScope = locals;
         traitScope["Self"] = makecheck<GenericParamType>("Self", traitDef->traitName);
         for (auto &&method : traitDef->methods)
         {
@@ -3356,7 +3593,7 @@ namespace NG::typecheck
         locals[traitDef->traitName] = trait;
       }
 
-      Map<Str, CheckingRef<TypeInfo>> traitScope = locals;
+      TypeScope traitScope = locals;
       addGenericParamsToScope(traitScope, traitDef->genericParams);
       traitScope["Self"] = makecheck<GenericParamType>("Self", traitDef->traitName);
       trait->superTraits.clear();
@@ -3371,6 +3608,7 @@ namespace NG::typecheck
         }
         trait->superTraits.push_back(superTrait);
       }
+      TraitImplIndex::traitGraphChanged();
 
       trait->methods.clear();
       trait->defaultMethods.clear();
@@ -3426,7 +3664,7 @@ namespace NG::typecheck
 
     void visit(ImplDef *implDef) override
     {
-      Map<Str, CheckingRef<TypeInfo>> implScope = locals;
+      TypeScope implScope = locals;
       addGenericParamsToScope(implScope, implDef->genericParams);
       addWhereBoundsToScope(implScope, implDef->whereBounds);
       {
@@ -3451,6 +3689,11 @@ namespace NG::typecheck
         throw TypeCheckingException("Impl target must be a structural or native opaque type: " +
                                     implDef->targetType->repr(), implDef->pos);
       }
+      if (trait->name == HASH_TRAIT_NAME)
+      {
+        // Hash tables hash keys structurally, so a hand-written hash could disagree with equality.
+        throw TypeCheckingException("Hash can only be derived: " + customType->name, implDef->pos);
+      }
       auto implKey = customType->name + "::" + trait->name;
       if (derivedTraitImplKeys.contains(implKey))
       {
@@ -3510,11 +3753,7 @@ namespace NG::typecheck
         }
       }
 
-      auto &implTraits = trait_impls_by_type[customType->name];
-      if (std::ranges::find(implTraits, trait->name) == implTraits.end())
-      {
-        implTraits.push_back(trait->name);
-      }
+      trait_impls_by_type.add(customType->name, trait->name);
 
       for (auto &&method : implDef->methods)
       {
@@ -3523,31 +3762,36 @@ namespace NG::typecheck
         customType->traitMemberFunctions[trait->name][method->funName] = funType;
         customType->memberFunctions[traitMethodName] = funType;
 
-        TypeChecker bodyChecker{implScope};
-        bodyChecker.trait_impls_by_type = trait_impls_by_type;
+        auto bodyChecker = std::make_shared<TypeChecker>(implScope);
+        bodyChecker->trait_impls_by_type = trait_impls_by_type;
         for (size_t i = 0; i < method->params.size(); ++i)
         {
-          bodyChecker.locals.insert_or_assign(method->params[i]->paramName, unwrap(funType->parametersType[i]));
+          bodyChecker->locals.insert_or_assign(method->params[i]->paramName, unwrap(funType->parametersType[i]));
         }
-        bodyChecker.contextRequirement = funType->parametersType;
+        bodyChecker->contextRequirement = funType->parametersType;
         if (funType->returnType->tag() != typeinfo_tag::UNTYPED)
         {
-          bodyChecker.expectedType = funType->returnType;
+          bodyChecker->expectedType = funType->returnType;
         }
         if (method->body)
         {
-          method->body->accept(&bodyChecker);
-          auto bodyReturnType = bodyChecker.result ? bodyChecker.result : makecheck<PrimitiveType>(typeinfo_tag::UNIT);
-          if (bodyReturnType->tag() != typeinfo_tag::UNTYPED && funType->returnType->tag() != typeinfo_tag::UNTYPED &&
-              !typeMatch(*funType->returnType, *bodyReturnType))
-          {
-            throw TypeCheckingException("Return Type Mismatch: " + bodyReturnType->repr() + " to " +
-                                            funType->returnType->repr(),
-                                        method->pos);
-          }
+          checkBody([bodyChecker, method = method.get(), funType] {
+            method->body->accept(bodyChecker.get());
+            auto bodyReturnType =
+                bodyChecker->result ? bodyChecker->result : makecheck<PrimitiveType>(typeinfo_tag::UNIT);
+            if (bodyReturnType->tag() != typeinfo_tag::UNTYPED && funType->returnType->tag() != typeinfo_tag::UNTYPED &&
+                !typeMatch(*funType->returnType, *bodyReturnType))
+            {
+              throw TypeCheckingException("Return Type Mismatch: " + bodyReturnType->repr() + " to " +
+                                              funType->returnType->repr(),
+                                          method->pos);
+            }
+          });
         }
       }
 
+      // Default methods are checked in place: their bodies are shared by every impl of the trait.
+
       for (auto &&[methodName, defaultMethod] : trait->allDefaultMethods)
       {
         if (methods.contains(methodName))
@@ -3703,28 +3947,31 @@ namespace NG::typecheck
       {
         bodyExpectedType = funcInfo.returnType;
       }
-      TypeChecker bodyChecker{locals, {}, bodyExpectedType};
+      auto bodyChecker = std::make_shared<TypeChecker>(locals, Vec<CheckingRef<TypeInfo>>{}, bodyExpectedType);
       for (size_t i = 0; i < funDef->params.size(); ++i)
       {
-        bodyChecker.locals.insert_or_assign(funDef->params[i]->paramName, unwrap(funcInfo.parametersType[i]));
+        bodyChecker->locals.insert_or_assign(funDef->params[i]->paramName, unwrap(funcInfo.parametersType[i]));
       }
-      bodyChecker.contextRequirement = funcInfo.parametersType;
+      bodyChecker->contextRequirement = funcInfo.parametersType;
 
       if (funDef->body)
       {
-        funDef->body->accept(&bodyChecker);
-        auto bodyReturnType = bodyChecker.result;
-        if (!bodyReturnType)
-        {
-          bodyReturnType = makecheck<PrimitiveType>(typeinfo_tag::UNIT);
-        }
-        if (bodyReturnType->tag() != typeinfo_tag::UNTYPED && funcInfo.returnType->tag() != typeinfo_tag::UNTYPED &&
-            !typeMatches(*funcInfo.returnType, *bodyReturnType))
-        {
-          throw TypeCheckingException("Return Type Mismatch: " + bodyReturnType->repr() + " to " +
-                                          funcInfo.returnType->repr(),
-                                      funDef->pos);
-        }
+        checkBody([this, bodyChecker, funDef, funType] {
+          auto &funcInfo = static_cast<FunctionType &>(*funType);
+          funDef->body->accept(bodyChecker.get());
+          auto bodyReturnType = bodyChecker->result;
+          if (!bodyReturnType)
+          {
+            bodyReturnType = makecheck<PrimitiveType>(typeinfo_tag::UNIT);
+          }
+          if (bodyReturnType->tag() != typeinfo_tag::UNTYPED && funcInfo.returnType->tag() != typeinfo_tag::UNTYPED &&
+              !typeMatches(*funcInfo.returnType, *bodyReturnType))
+          {
+            throw TypeCheckingException("Return Type Mismatch: " + bodyReturnType->repr() + " to " +
+                                            funcInfo.returnType->repr(),
+                                        funDef->pos);
+          }
+        });
       }
       result = funType;
     }
@@ -3745,7 +3992,7 @@ namespace NG::typecheck
 
     void visit(CompoundStatement *compoundStatement) override
     {
-      auto outerNames = scopeNames(locals);
+      auto outerScope = locals;
       TypeChecker checker{locals, contextRequirement, expectedType, movedBindings, allowMovedLvalueRead,
                           activeGenericInstanceName};
       CheckingRef<TypeInfo> returnType = nullptr;
@@ -3777,7 +4024,7 @@ namespace NG::typecheck
           }
         }
       }
-      movedBindings = filterMovedBindings(checker.movedBindings, outerNames);
+      movedBindings = filterMovedBindings(checker.movedBindings, outerScope);
       result = returnType;
     }
 
@@ -3888,22 +4135,22 @@ namespace NG::typecheck
           }
           if (condResult.value())
           {
-            auto outerNames = scopeNames(locals);
+            auto outerScope = locals;
             TypeChecker thenChecker{locals, contextRequirement, expectedType, movedBindings, allowMovedLvalueRead,
                                     activeGenericInstanceName};
             thenChecker.trait_impls_by_type = trait_impls_by_type;
             ifStatement->consequence->accept(&thenChecker);
-            movedBindings = filterMovedBindings(thenChecker.movedBindings, outerNames);
+            movedBindings = filterMovedBindings(thenChecker.movedBindings, outerScope);
             result = thenChecker.result;
           }
           else if (ifStatement->alternative)
           {
-            auto outerNames = scopeNames(locals);
+            auto outerScope = locals;
             TypeChecker elseChecker{locals, contextRequirement, expectedType, movedBindings, allowMovedLvalueRead,
                                     activeGenericInstanceName};
             elseChecker.trait_impls_by_type = trait_impls_by_type;
             ifStatement->alternative->accept(&elseChecker);
-            movedBindings = filterMovedBindings(elseChecker.movedBindings, outerNames);
+            movedBindings = filterMovedBindings(elseChecker.movedBindings, outerScope);
             result = elseChecker.result;
           }
           else
@@ -3924,8 +4171,8 @@ namespace NG::typecheck
         throw TypeCheckingException("Condition expression must be boolean: " + ifStatement->testing->repr(),
                                     ifStatement->testing->pos);
       }
-      auto outerNames = scopeNames(locals);
-      auto entryMovedBindings = filterMovedBindings(condChecker.movedBindings, outerNames);
+      auto outerScope = locals;
+      auto entryMovedBindings = filterMovedBindings(condChecker.movedBindings, outerScope);
       CheckingRef<TypeInfo> returnType = nullptr;
       if (ifStatement->consequence)
       {
@@ -3934,7 +4181,7 @@ namespace NG::typecheck
         ifStatement->consequence->accept(&thenChecker);
         returnType = thenChecker.result;
         result = returnType;
-        movedBindings = filterMovedBindings(thenChecker.movedBindings, outerNames);
+        movedBindings = filterMovedBindings(thenChecker.movedBindings, outerScope);
       }
       if (ifStatement->alternative)
       {
@@ -3963,7 +4210,7 @@ namespace NG::typecheck
           result = consequenceType;
         }
         auto thenMovedBindings = ifStatement->consequence ? movedBindings : entryMovedBindings;
-        auto elseMovedBindings = filterMovedBindings(elseChecker.movedBindings, outerNames);
+        auto elseMovedBindings = filterMovedBindings(elseChecker.movedBindings, outerScope);
         thenMovedBindings.insert(elseMovedBindings.begin(), elseMovedBindings.end());
         movedBindings = std::move(thenMovedBindings);
       }
@@ -3975,7 +4222,7 @@ namespace NG::typecheck
 
     void visit(LoopStatement *loopStatement) override
     {
-      auto outerNames = scopeNames(locals);
+      auto outerScope = locals;
       TypeChecker checker{locals, {}, nullptr, movedBindings, allowMovedLvalueRead, activeGenericInstanceName};
       Vec<CheckingRef<TypeInfo>> paramTypes;
       for (auto binding : loopStatement->bindings)
@@ -3999,7 +4246,7 @@ namespace NG::typecheck
       }
       checker.contextRequirement = paramTypes;
       loopStatement->loopBody->accept(&checker);
-      movedBindings = filterMovedBindings(checker.movedBindings, outerNames);
+      movedBindings = filterMovedBindings(checker.movedBindings, outerScope);
       result = checker.result;
     }
 
@@ -4571,6 +4818,12 @@ namespace NG::typecheck
 
     // ── Type annotation resolution ──────────────────────────────────────
     void visit(TypeAnnotation *annotation) override
+    {
+      resolveAnnotation(annotation);
+      result = intern_type(result);
+    }
+
+    void resolveAnnotation(TypeAnnotation *annotation)
     {
       if (annotation->constLiteral)
       {
@@ -5470,6 +5723,7 @@ namespace NG::typecheck
       Str memberName = idAccExpr->accessor->repr();
 
       CheckingRef<TypeInfo> memberType = makecheck<Untyped>();
+      bool receiverByRef = false;
       auto numericMemberIndex = [&]() -> std::optional<size_t> {
         if (memberName.empty() ||
             !std::ranges::all_of(memberName, [](unsigned char ch) { return std::isdigit(ch) != 0; }))
@@ -5529,6 +5783,30 @@ namespace NG::typecheck
                 elementType, Vec<CheckingRef<TypeInfo>>{primaryType, makecheck<PrimitiveType>(typeinfo_tag::I32)});
           }
         }
+        else if (tag == typeinfo_tag::VECTOR)
+        {
+          if (auto vectorMember = vectorMemberType(static_cast<VectorType &>(*primaryType), memberName))
+          {
+            Vec<CheckingRef<TypeInfo>> argumentTypes;
+            TypeChecker argChecker{locals, {}, nullptr, movedBindings, false, activeGenericInstanceName};
+            for (auto &argument : idAccExpr->arguments)
+            {
+              argument->accept(&argChecker);
+              argumentTypes.push_back(argChecker.result);
+            }
+            movedBindings = argChecker.movedBindings;
+            if (!functionApplyWithCoercions(*vectorMember, argumentTypes))
+            {
+              throw TypeCheckingException("Invalid argument types for vector member " + memberName + ": " +
+                                              vectorMember->repr(),
+                                          idAccExpr->pos);
+            }
+            memberType = vectorMember;
+            receiverByRef = std::ranges::any_of(vectorMember->placeEffects, [](const PlaceEffect &effect) {
+              return effect.kind == PlaceEffectKind::Write;
+            });
+          }
+        }
       }
 
       if (primaryType && primaryType->tag() == typeinfo_tag::CUSTOMIZED)
@@ -5544,11 +5822,12 @@ namespace NG::typecheck
         }
         if (customPtr->properties.contains(memberName))
         {
-          memberType = customPtr->properties[memberName];
+          memberType = customPtr->properties.at(memberName);
         }
         else if (customPtr->memberFunctions.contains(memberName))
         {
-          memberType = customPtr->memberFunctions[memberName];
+          memberType = customPtr->memberFunctions.at(memberName);
+          receiverByRef = declaresRefReceiver(memberType);
         }
         if (!customPtr->properties.contains(memberName))
         {
@@ -5573,7 +5852,8 @@ namespace NG::typecheck
           }
           if (traitCandidates.size() == 1 && !customPtr->memberFunctions.contains(memberName))
           {
-            memberType = customPtr->traitMemberFunctions[traitCandidates.front()][memberName];
+            memberType = customPtr->traitMemberFunctions.at(traitCandidates.front()).at(memberName);
+            receiverByRef = declaresRefReceiver(memberType);
           }
         }
       }
@@ -5590,6 +5870,7 @@ namespace NG::typecheck
             if (methods.contains(memberName))
             {
               memberType = methods[memberName];
+              receiverByRef = declaresRefReceiver(memberType);
             }
           }
         }
@@ -5630,6 +5911,16 @@ namespace NG::typecheck
         }
       }
 
+      // The compiler hands such members the receiver place itself rather than a copy.
+      if (activeGenericInstanceName.empty())
+      {
+        idAccExpr->receiverByRef = receiverByRef;
+      }
+      else
+      {
+        idAccExpr->receiverByRefByInstance[activeGenericInstanceName] = receiverByRef;
+      }
+
       if (!idAccExpr->arguments.empty() ||
           (idAccExpr->pos.line != 0)) // Hack to detect if it's potentially a call
       {
@@ -5804,13 +6095,13 @@ namespace NG::typecheck
           {
             throw TypeCheckingException("Unknown property '" + name + "' for type " + customType->name, expr->pos);
           }
-          checker.expectedType = customType->properties[name];
+          checker.expectedType = customType->properties.at(name);
           expr->accept(&checker);
           if (checker.result->tag() != typeinfo_tag::UNTYPED &&
-              !typeMatch(*customType->properties[name], *checker.result))
+              !typeMatch(*customType->properties.at(name), *checker.result))
           {
             throw TypeCheckingException("Property type mismatch for '" + name + "': " + checker.result->repr() +
-                                            " to " + customType->properties[name]->repr(),
+                                            " to " + customType->properties.at(name)->repr(),
                                         expr->pos);
           }
         }
@@ -5953,6 +6244,16 @@ namespace NG::typecheck
           }
         }
         result = it->second;
+        // The compiler moves a last read instead of copying it only when no destructor can be involved.
+        const bool mayDrop = typeMayNeedDrop(result);
+        if (activeGenericInstanceName.empty())
+        {
+          id->readMayDrop = mayDrop;
+        }
+        else
+        {
+          id->readMayDropByInstance[activeGenericInstanceName] = mayDrop;
+        }
       }
       else if (hasWildcardImportFlag())
       {
@@ -6030,69 +6331,464 @@ namespace NG::typecheck
       throw TypeCheckingException("Invalid cast from " + exprType->repr() + " to " + targetType->repr(), castExpr->pos);
     }
 
-    auto loadModuleArtifacts(const ImportDecl &importDecl, const Str &moduleId) -> ModuleArtifacts
+    // ── Module interfaces ───────────────────────────────────────────────
+    static auto moduleOf(const ASTRef<ASTNode> &ast) -> ASTRef<Module>
     {
-      if (auto cached = moduleArtifactsById.find(moduleId); cached != moduleArtifactsById.end())
+      if (auto compileUnit = dynamic_ast_cast<CompileUnit>(ast))
       {
-        return cached->second;
+        return compileUnit->module;
       }
-      auto &registry = NG::module::get_module_registry();
-      const bool forceSourceLoad =
-          std::ranges::find(modulePaths, "[force-source-module-loader]") != modulePaths.end();
-      if (!activeModuleChecks.insert(moduleId).second)
+      return dynamic_ast_cast<Module>(ast);
+    }
+
+    /**
+     * Returns what importers record about `moduleId` to decide whether their interface is still valid:
+     * its interface hash, or the hash of its source when it has no interface.
+     */
+    static auto dependencyFingerprint(const Str &moduleId) -> Str
+    {
+      if (auto known = moduleInterfaceHashes.find(moduleId); known != moduleInterfaceHashes.end())
       {
-        return {};
+        return known->second;
       }
-      struct ActiveGuard
+      auto moduleInfo = NG::module::get_module_registry().queryModuleById(moduleId);
+      if (moduleInfo && moduleInfo->bytecodeModule)
       {
-        Str moduleId;
-        ~ActiveGuard()
-        {
-          TypeChecker::activeModuleChecks.erase(moduleId);
-        }
-      } guard{moduleId};
-
-      auto moduleInfo = registry.queryModuleById(moduleId);
-      if (forceSourceLoad)
+        return "ngo:" + moduleInfo->bytecodeModule->sourceHash;
+      }
+      if (moduleInfo && !moduleInfo->moduleSourceHash.empty())
       {
-        moduleInfo = {};
+        return "src:" + moduleInfo->moduleSourceHash;
       }
-      if (!moduleInfo || !moduleInfo->moduleAst)
+      return "";
+    }
+
+    /**
+     * Encodes the interface of the module this checker has just checked. `base` is the scope the module
+     * was checked in; bindings it already had are not part of the module. Returns an empty string for
+     * modules an interface cannot describe.
+     */
+    auto encodeModuleInterface(const NG::module::ModuleInfo &moduleInfo, const TypeScope &base) -> Str
+    {
+      auto module = moduleOf(moduleInfo.moduleAst);
+      if (!module)
       {
-        NG::module::FileBasedExternalModuleLoader loader{modulePaths};
-        moduleInfo = loader.load(importDecl.modulePath);
-        if (moduleInfo)
+        return "";
+      }
+      Map<const ASTNode *, InterfaceAstRef> definitions;
+      auto indexDefinitions = [&definitions](const Str &moduleId, const Module &owner) {
+        for (uint32_t i = 0; i < owner.definitions.size(); ++i)
         {
-          if (forceSourceLoad && moduleInfo->moduleAst)
+          definitions.emplace(owner.definitions[i].get(), InterfaceAstRef{moduleId, i});
+          if (auto traitDef = dynamic_ast_cast<TraitDef>(owner.definitions[i]))
           {
-            retainedPreludeImportAsts.push_back(moduleInfo->moduleAst);
+            for (uint32_t j = 0; j < traitDef->methods.size(); ++j)
+            {
+              definitions.emplace(traitDef->methods[j].get(), InterfaceAstRef{moduleId, i, j});
+            }
           }
-          registry.addModuleInfo(moduleInfo);
         }
-      }
-      if (!moduleInfo || !moduleInfo->moduleAst)
+      };
+      indexDefinitions(currentModuleId, *module);
+      for (const auto &importedId : importedModuleIds)
       {
-        if (!forceSourceLoad)
+        auto imported = NG::module::get_module_registry().queryModuleById(importedId);
+        if (auto importedModule = imported ? moduleOf(imported->moduleAst) : nullptr)
         {
-          if (auto artifact = registry.queryArtifactById(moduleId); artifact && hasPublishedTypeMetadata(*artifact))
-          {
-            auto artifacts = toLocalModuleArtifacts(*artifact);
-            moduleArtifactsById[moduleId] = artifacts;
-            return artifacts;
-          }
+          indexDefinitions(importedId, *importedModule);
         }
-        return {};
       }
 
-      TypeChecker checker{locals, {}, nullptr, {}, false, "", modulePaths};
-      checker.currentModuleId = moduleInfo->moduleId.empty() ? moduleId : moduleInfo->moduleId;
-      moduleInfo->moduleAst->accept(&checker);
-      moduleInfo->moduleTypeIndex = checker.type_index;
-
-      if (auto artifact = registry.queryArtifactById(checker.currentModuleId); artifact && hasPublishedTypeMetadata(*artifact))
+      ModuleInterface moduleInterface;
+      moduleInterface.moduleId = currentModuleId;
+      moduleInterface.sourceHash = moduleInfo.moduleSourceHash;
+      for (const auto &imp : module->imports)
       {
-        auto artifacts = toLocalModuleArtifacts(*artifact);
-        moduleArtifactsById[checker.currentModuleId] = artifacts;
+        auto importedId = importedModuleId(*imp);
+        moduleInterface.dependencies.emplace_back(importedId, dependencyFingerprint(importedId));
+      }
+      // Imported bindings are kept as well: a module can import a name it also defines, and the import
+      // may be the module's own definition coming back through a dependency checked in its scope.
+      for (const auto &[name, type] : locals)
+      {
+        if (name == WILDCARD_IMPORT_KEY)
+        {
+          continue;
+        }
+        if (auto outer = base.find(name); outer != base.end() && outer->second == type)
+        {
+          continue;
+        }
+        moduleInterface.symbols.emplace_back(name, type);
+      }
+      for (const auto &[name, type] : base)
+      {
+        // Overloads added to an imported generic live on the imported object, outside the interface.
+        auto generic = std::dynamic_pointer_cast<GenericDefType>(type);
+        if (generic && std::ranges::any_of(generic->overloads, [&](const auto &overload) {
+              auto location = definitions.find(overload.get());
+              return location != definitions.end() && location->second.moduleId == currentModuleId;
+            }))
+        {
+          return "";
+        }
+      }
+      std::ranges::sort(moduleInterface.symbols, {}, [](const auto &symbol) -> const Str & { return symbol.first; });
+      for (const auto &impl : localTraitImpls)
+      {
+        if (impl.moduleId != currentModuleId || !impl.definition)
+        {
+          continue;
+        }
+        auto location = definitions.find(impl.definition);
+        if (location == definitions.end() || location->second.moduleId != currentModuleId)
+        {
+          return "";
+        }
+        moduleInterface.impls.push_back(InterfaceImpl{
+            .traitName = impl.traitName,
+            .targetPattern = impl.targetPattern,
+            .genericParamNames = {impl.genericParamNames.begin(), impl.genericParamNames.end()},
+            .whereBounds = impl.whereBounds,
+            .methods = impl.methods,
+            .definition = location->second.definition,
+        });
+        std::ranges::sort(moduleInterface.impls.back().genericParamNames);
+      }
+      moduleInterface.derivedTraitImplKeys = {derivedTraitImplKeys.begin(), derivedTraitImplKeys.end()};
+      std::ranges::sort(moduleInterface.derivedTraitImplKeys);
+      moduleInterface.autoTraits = {autoTraitNames.begin(), autoTraitNames.end()};
+      std::ranges::sort(moduleInterface.autoTraits);
+
+      Str bytes;
+      try
+      {
+        bytes = encode_module_interface(moduleInterface, [&definitions](const ASTNode *node) -> std::optional<InterfaceAstRef> {
+          auto location = definitions.find(node);
+          return location == definitions.end() ? std::nullopt : std::optional{location->second};
+        });
+      }
+      catch (const TypeCheckingException &)
+      {
+        // Modules the interface cannot describe are simply checked again next time.
+        return "";
+      }
+      moduleInterfaceHashes[currentModuleId] = moduleInterface.interfaceHash;
+      return bytes;
+    }
+
+    /**
+     * Restores the module from its encoded interface instead of checking it: its imports are processed
+     * as usual, then the stored bindings, impls and compile-time definitions are installed and published.
+     * Returns false when the interface is out of date or corrupt; only the imports have been loaded then.
+     */
+    auto restoreModuleInterface(const NG::module::ModuleInfo &moduleInfo, std::string_view bytes) -> bool
+    {
+      auto module = moduleOf(moduleInfo.moduleAst);
+      if (!module)
+      {
+        return false;
+      }
+      auto &registry = NG::module::get_module_registry();
+      ModuleInterface moduleInterface;
+      try
+      {
+        auto header = decode_module_interface_header(bytes);
+        if (header.moduleId != currentModuleId ||
+            header.sourceHash != moduleInfo.moduleSourceHash)
+        {
+          return false;
+        }
+        // Imports are loaded (and cached) first: their current interfaces decide whether this one is valid.
+        Vec<std::pair<Str, Str>> dependencies;
+        for (const auto &imp : module->imports)
+        {
+          auto importedId = importedModuleId(*imp);
+          loadModuleArtifacts(*imp, importedId);
+          dependencies.emplace_back(importedId, dependencyFingerprint(importedId));
+        }
+        if (dependencies != header.dependencies)
+        {
+          return false;
+        }
+        ModuleInterfaceResolver resolver{
+            .type = [&](typeinfo_tag, const Str &owner, const Str &name) -> CheckingRef<TypeInfo> {
+              if (auto artifact = owner.empty() ? nullptr : registry.queryArtifactById(owner))
+              {
+                if (auto found = artifact->typeIndex.find(name); found != artifact->typeIndex.end())
+                {
+                  return found->second;
+                }
+              }
+              auto found = locals.find(name);
+              return found == locals.end() ? nullptr : found->second;
+            },
+            .definition = [&](const InterfaceAstRef &ref) -> ASTRef<ASTNode> {
+              auto owner = module;
+              if (ref.moduleId != currentModuleId)
+              {
+                auto ownerInfo = registry.queryModuleById(ref.moduleId);
+                owner = ownerInfo ? moduleOf(ownerInfo->moduleAst) : nullptr;
+              }
+              if (!owner || ref.definition >= owner->definitions.size())
+              {
+                return nullptr;
+              }
+              auto definition = owner->definitions[ref.definition];
+              if (ref.member == InterfaceAstRef::NO_MEMBER)
+              {
+                return definition;
+              }
+              auto traitDef = dynamic_ast_cast<TraitDef>(definition);
+              return traitDef && ref.member < traitDef->methods.size() ? traitDef->methods[ref.member] : nullptr;
+            },
+        };
+        moduleInterface = decode_module_interface(bytes, resolver);
+      }
+      catch (const std::exception &)
+      {
+        return false;
+      }
+      Vec<ImplDef *> implDefs;
+      for (const auto &impl : moduleInterface.impls)
+      {
+        auto implDef = impl.definition < module->definitions.size()
+                           ? dynamic_ast_cast<ImplDef>(module->definitions[impl.definition])
+                           : nullptr;
+        if (!implDef)
+        {
+          return false;
+        }
+        implDefs.push_back(implDef.get());
+      }
+
+      installBuiltinLifecycleTraits();
+      for (auto def : module->definitions)
+      {
+        if (auto useImpl = dynamic_ast_cast<UseImplDecl>(def))
+        {
+          useImpl->accept(this);
+        }
+      }
+      for (auto imp : module->imports)
+      {
+        imp->accept(this);
+      }
+      for (const auto &[name, type] : moduleInterface.symbols)
+      {
+        locals.insert_or_assign(name, type);
+      }
+      for (const auto &[name, type] : moduleInterface.symbols)
+      {
+        if (auto generic = std::dynamic_pointer_cast<GenericDefType>(type); generic && generic->moduleId == currentModuleId)
+        {
+          generic->capturedLocals = locals;
+        }
+        else if (auto genericType = std::dynamic_pointer_cast<GenericTypeDef>(type);
+                 genericType && genericType->moduleId == currentModuleId)
+        {
+          genericType->capturedLocals = locals;
+        }
+      }
+      for (auto def : module->definitions)
+      {
+        if (auto typeAlias = dynamic_ast_cast<TypeAliasDef>(def); typeAlias && typeAlias->specializationPattern)
+        {
+          activeTypeAliasSpecializations[typeAlias->aliasName].push_back(typeAlias.get());
+        }
+        else if (auto constDef = dynamic_ast_cast<ConstDef>(def))
+        {
+          activeConstPredicates[constDef->constName].push_back(constDef.get());
+        }
+        else if (auto funDef = dynamic_ast_cast<FunctionDef>(def); funDef && funDef->constEval)
+        {
+          activeConstFunctions[funDef->funName].push_back(funDef.get());
+        }
+      }
+      for (const auto &key : moduleInterface.derivedTraitImplKeys)
+      {
+        derivedTraitImplKeys.insert(key);
+        activeDerivedTraitImplKeys.insert(key);
+      }
+      for (const auto &name : moduleInterface.autoTraits)
+      {
+        autoTraitNames.insert(name);
+        activeAutoTraits.insert(name);
+      }
+      for (size_t i = 0; i < moduleInterface.impls.size(); ++i)
+      {
+        auto &impl = moduleInterface.impls[i];
+        localTraitImpls.push_back(TraitImplRecord{
+            .traitName = impl.traitName,
+            .targetPattern = impl.targetPattern,
+            .moduleId = currentModuleId,
+            .genericParamNames = {impl.genericParamNames.begin(), impl.genericParamNames.end()},
+            .whereBounds = impl.whereBounds,
+            .methods = impl.methods,
+            .definition = implDefs[i],
+            .pos = implDefs[i]->pos,
+        });
+        attachTraitImplMethods(localTraitImpls.back(), true);
+      }
+      publishModuleArtifacts(module.get());
+      for (const auto &[name, type] : locals)
+      {
+        type_index.emplace(name, type);
+      }
+      moduleInterfaceHashes[currentModuleId] = moduleInterface.interfaceHash;
+      return true;
+    }
+
+    /**
+     * Checks the module, or restores it from the prelude snapshot or its interface file when they are
+     * current. A checked module has its interface file rewritten.
+     */
+    void checkOrRestoreModule(const NG::module::ModuleInfo &moduleInfo, const TypeScope &base)
+    {
+      auto collect = [this](std::string_view bytes) {
+        if (collectedInterfaces)
+        {
+          collectedInterfaces->emplace_back(currentModuleId, Str{bytes});
+        }
+      };
+      if (auto snapshot = snapshotInterfaces.find(currentModuleId);
+          snapshot != snapshotInterfaces.end() && restoreModuleInterface(moduleInfo, snapshot->second))
+      {
+        collect(snapshot->second);
+        return;
+      }
+      auto path = module_interface_path(currentModuleId, moduleInfo.moduleAbsolutePath);
+      std::error_code error;
+      if (!path.empty() && std::filesystem::exists(path, error))
+      {
+        try
+        {
+          NG::System::MappedFile file{path};
+          if (restoreModuleInterface(moduleInfo, file.view()))
+          {
+            collect(file.view());
+            return;
+          }
+        }
+        catch (const RuntimeException &)
+        {
+          // An unreadable interface is rebuilt below.
+        }
+      }
+      moduleInfo.moduleAst->accept(this);
+      if (path.empty() && !collectedInterfaces)
+      {
+        return;
+      }
+      auto bytes = encodeModuleInterface(moduleInfo, base);
+      if (!bytes.empty())
+      {
+        if (!path.empty())
+        {
+          write_module_interface_file(path, bytes);
+        }
+        collect(bytes);
+      }
+    }
+
+    /**
+     * Installs what the shared check of a module left behind, as checking the module again would.
+     */
+    static auto adoptSharedModuleCheck(const Str &moduleId, const SharedModuleCheck &shared) -> ModuleArtifacts
+    {
+      auto merge = [](auto &active, const auto &definitions) {
+        for (const auto &[name, defs] : definitions)
+        {
+          auto &known = active[name];
+          for (auto def : defs)
+          {
+            if (std::ranges::find(known, def) == known.end())
+            {
+              known.push_back(def);
+            }
+          }
+        }
+      };
+      merge(activeTypeAliasSpecializations, shared.typeAliasSpecializations);
+      merge(activeConstPredicates, shared.constPredicates);
+      merge(activeConstFunctions, shared.constFunctions);
+      activeAutoTraits.insert(shared.autoTraits.begin(), shared.autoTraits.end());
+      activeDerivedTraitImplKeys.insert(shared.derivedTraitImplKeys.begin(), shared.derivedTraitImplKeys.end());
+      if (!shared.interfaceHash.empty())
+      {
+        moduleInterfaceHashes[moduleId] = shared.interfaceHash;
+      }
+      moduleArtifactsById[moduleId] = shared.artifacts;
+      return shared.artifacts;
+    }
+
+    auto loadModuleArtifacts(const ImportDecl &importDecl, const Str &moduleId) -> ModuleArtifacts
+    {
+      if (auto cached = moduleArtifactsById.find(moduleId); cached != moduleArtifactsById.end())
+      {
+        return cached->second;
+      }
+      if (auto shared = sharedModuleChecks.find(moduleId); shared != sharedModuleChecks.end())
+      {
+        return adoptSharedModuleCheck(moduleId, shared->second);
+      }
+      auto &registry = NG::module::get_module_registry();
+      const bool forceSourceLoad =
+          std::ranges::find(modulePaths, "[force-source-module-loader]") != modulePaths.end();
+      if (!activeModuleChecks.insert(moduleId).second)
+      {
+        return {};
+      }
+      struct ActiveGuard
+      {
+        Str moduleId;
+        ~ActiveGuard()
+        {
+          TypeChecker::activeModuleChecks.erase(moduleId);
+        }
+      } guard{moduleId};
+
+      auto moduleInfo = registry.queryModuleById(moduleId);
+      if (forceSourceLoad)
+      {
+        moduleInfo = {};
+      }
+      if (!moduleInfo || !moduleInfo->moduleAst)
+      {
+        NG::module::FileBasedExternalModuleLoader loader{modulePaths};
+        moduleInfo = loader.load(importDecl.modulePath);
+        if (moduleInfo)
+        {
+          if (forceSourceLoad && moduleInfo->moduleAst)
+          {
+            retainedPreludeImportAsts.push_back(moduleInfo->moduleAst);
+          }
+          registry.addModuleInfo(moduleInfo);
+        }
+      }
+      if (!moduleInfo || !moduleInfo->moduleAst)
+      {
+        if (!forceSourceLoad)
+        {
+          if (auto artifact = registry.queryArtifactById(moduleId); artifact && hasPublishedTypeMetadata(*artifact))
+          {
+            auto artifacts = toLocalModuleArtifacts(*artifact);
+            moduleArtifactsById[moduleId] = artifacts;
+            return artifacts;
+          }
+        }
+        return {};
+      }
+
+      TypeChecker checker{locals, {}, nullptr, {}, false, "", modulePaths};
+      checker.currentModuleId = moduleInfo->moduleId.empty() ? moduleId : moduleInfo->moduleId;
+      checker.checkOrRestoreModule(*moduleInfo, locals);
+      moduleInfo->moduleTypeIndex = checker.type_index;
+
+      if (auto artifact = registry.queryArtifactById(checker.currentModuleId); artifact && hasPublishedTypeMetadata(*artifact))
+      {
+        auto artifacts = toLocalModuleArtifacts(*artifact);
+        moduleArtifactsById[checker.currentModuleId] = artifacts;
         if (checker.currentModuleId != moduleId)
         {
           moduleArtifactsById[moduleId] = artifacts;
@@ -6111,6 +6807,57 @@ namespace NG::typecheck
       return {};
     }
 
+    /**
+     * Adds the methods of a trait impl checked in another module to its target type. With `onlyMissing`,
+     * targets that already carry the trait's methods are left alone.
+     */
+    void attachTraitImplMethods(const TraitImplRecord &impl, bool onlyMissing = false)
+    {
+      CheckingRef<TypeInfo> targetType;
+      if (impl.definition)
+      {
+        auto targetScope = locals;
+        addGenericParamsToScope(targetScope, impl.definition->genericParams);
+        TypeChecker targetChecker{targetScope, {}, nullptr, {}, false, "", modulePaths};
+        impl.definition->targetType->accept(&targetChecker);
+        targetType = targetChecker.result;
+      }
+      else
+      {
+        targetType = type_from_repr(impl.targetPattern);
+      }
+      auto unwrappedTarget = unwrap(targetType);
+      if (!unwrappedTarget || unwrappedTarget->tag() != typeinfo_tag::CUSTOMIZED)
+      {
+        return;
+      }
+      auto customPtr = std::static_pointer_cast<CustomizedType>(unwrappedTarget);
+      if (auto localTarget = locals.find(customPtr->name); localTarget != locals.end())
+      {
+        auto unwrappedLocal = unwrap(localTarget->second);
+        if (unwrappedLocal && unwrappedLocal->tag() == typeinfo_tag::CUSTOMIZED)
+        {
+          customPtr = std::static_pointer_cast<CustomizedType>(unwrappedLocal);
+        }
+      }
+      if (onlyMissing && customPtr->traitMemberFunctions.contains(impl.traitName))
+      {
+        return;
+      }
+      trait_impls_by_type.add(customPtr->name, impl.traitName);
+      auto traitIt = locals.find(impl.traitName);
+      if (traitIt != locals.end() && traitIt->second && traitIt->second->tag() == typeinfo_tag::TRAIT)
+      {
+        auto &trait = static_cast<TraitType &>(*traitIt->second);
+        auto &methods = trait.allMethods.empty() ? trait.methods : trait.allMethods;
+        for (const auto &[methodName, methodType] : methods)
+        {
+          customPtr->traitMemberFunctions[trait.name][methodName] = methodType;
+          customPtr->memberFunctions[trait.name + "::" + methodName] = methodType;
+        }
+      }
+    }
+
     void importCheckedModuleArtifacts(const ImportDecl &importDecl, const Str & /*moduleId*/,
                                       const ModuleArtifacts &artifacts)
     {
@@ -6205,59 +6952,19 @@ namespace NG::typecheck
         {
           continue;
         }
-        CheckingRef<TypeInfo> targetType;
-        if (impl.definition)
-        {
-          auto targetScope = locals;
-          addGenericParamsToScope(targetScope, impl.definition->genericParams);
-          TypeChecker targetChecker{targetScope, {}, nullptr, {}, false, "", modulePaths};
-          impl.definition->targetType->accept(&targetChecker);
-          targetType = targetChecker.result;
-        }
-        else
-        {
-          targetType = type_from_repr(impl.targetPattern);
-        }
-        auto unwrappedTarget = unwrap(targetType);
-        if (!unwrappedTarget || unwrappedTarget->tag() != typeinfo_tag::CUSTOMIZED)
-        {
-          continue;
-        }
-        auto customPtr = std::static_pointer_cast<CustomizedType>(unwrappedTarget);
-        if (auto localTarget = locals.find(customPtr->name); localTarget != locals.end())
-        {
-          auto unwrappedLocal = unwrap(localTarget->second);
-          if (unwrappedLocal && unwrappedLocal->tag() == typeinfo_tag::CUSTOMIZED)
-          {
-            customPtr = std::static_pointer_cast<CustomizedType>(unwrappedLocal);
-          }
-        }
-        auto &implTraits = trait_impls_by_type[customPtr->name];
-        if (std::ranges::find(implTraits, impl.traitName) == implTraits.end())
-        {
-          implTraits.push_back(impl.traitName);
-        }
-        auto traitIt = locals.find(impl.traitName);
-        if (traitIt != locals.end() && traitIt->second && traitIt->second->tag() == typeinfo_tag::TRAIT)
-        {
-          auto &trait = static_cast<TraitType &>(*traitIt->second);
-          auto &methods = trait.allMethods.empty() ? trait.methods : trait.allMethods;
-          for (const auto &[methodName, methodType] : methods)
-          {
-            customPtr->traitMemberFunctions[trait.name][methodName] = methodType;
-            customPtr->memberFunctions[trait.name + "::" + methodName] = methodType;
-          }
-        }
+        attachTraitImplMethods(impl);
       }
     }
 
+    static auto importedModuleId(const ImportDecl &importDecl) -> Str
+    {
+      auto moduleId = moduleIdFromPath(importDecl.modulePath);
+      return moduleId.empty() ? importDecl.module : moduleId;
+    }
+
     void visit(ImportDecl *importDecl) override
     {
-      auto moduleId = moduleIdFromPath(importDecl->modulePath);
-      if (moduleId.empty())
-      {
-        moduleId = importDecl->module;
-      }
+      auto moduleId = importedModuleId(*importDecl);
       if (!importDecl->alias.empty())
       {
         importAliases[importDecl->alias] = moduleId;
@@ -6338,8 +7045,8 @@ namespace NG::typecheck
       TypeChecker checker{locals, {}, nullptr, movedBindings};
       switchStmt->scrutinee->accept(&checker);
       auto scrutineeType = checker.result;
-      auto outerNames = scopeNames(locals);
-      auto entryMovedBindings = filterMovedBindings(checker.movedBindings, outerNames);
+      auto outerScope = locals;
+      auto entryMovedBindings = filterMovedBindings(checker.movedBindings, outerScope);
 
       if (!scrutineeType || scrutineeType->tag() == typeinfo_tag::UNTYPED)
       {
@@ -6350,7 +7057,7 @@ namespace NG::typecheck
           TypeChecker caseChecker{locals, {}, nullptr, entryMovedBindings, allowMovedLvalueRead,
                                   activeGenericInstanceName};
           c.body->accept(&caseChecker);
-          auto caseMovedBindings = filterMovedBindings(caseChecker.movedBindings, outerNames);
+          auto caseMovedBindings = filterMovedBindings(caseChecker.movedBindings, outerScope);
           mergedMovedBindings.insert(caseMovedBindings.begin(), caseMovedBindings.end());
         }
         movedBindings = std::move(mergedMovedBindings);
@@ -6416,7 +7123,7 @@ namespace NG::typecheck
         }
 
         c.body->accept(&caseChecker);
-        auto caseMovedBindings = filterMovedBindings(caseChecker.movedBindings, outerNames);
+        auto caseMovedBindings = filterMovedBindings(caseChecker.movedBindings, outerScope);
         mergedMovedBindings.insert(caseMovedBindings.begin(), caseMovedBindings.end());
       }
 
@@ -6958,8 +7665,28 @@ namespace NG::typecheck
       }
       movedBindings = argChecker.movedBindings;
 
-      auto *funcDef = selectGenericFunctionCandidate(
-          genericDef, argumentTypes, funCall->genericArgs.empty() ? Str::npos : funCall->genericArgs.size());
+      std::lock_guard instantiationLock{genericInstantiationMutex};
+      // Explicit generic arguments are part of the call, not of its argument types, so such calls only
+      // share instances by instantiated name below.
+      auto argumentKey = argumentTypesKey(argumentTypes);
+      Str instantiationKey;
+      if (funCall->genericArgs.empty())
+      {
+        instantiationKey = argumentKey + '|' + argumentTypesKey({expectedType});
+        if (auto cached = genericDef.instantiations.find(instantiationKey); cached != genericDef.instantiations.end())
+        {
+          // Trait impls belong to the program being checked, so a cached instance is re-validated.
+          const auto &instantiation = cached->second;
+          checkGenericInstanceBounds(*instantiation.instance->definition, instantiation.substitution,
+                                     instantiation.typeArguments, funCall->pos);
+          useGenericInstance(instantiation.instance, funCall);
+          return instantiation.instance->returnType;
+        }
+      }
+
+      auto *funcDef = selectGenericFunctionCandidateCached(
+          genericDef, argumentTypes, argumentKey,
+          funCall->genericArgs.empty() ? Str::npos : funCall->genericArgs.size());
       if (!funcDef)
       {
         throw TypeCheckingException("No matching generic function overload: " + genericDef.name, funCall->pos);
@@ -7284,64 +8011,29 @@ namespace NG::typecheck
           substitution[name] = makecheck<Untyped>();
         }
       }
-      {
-        TypeChecker whereChecker{locals};
-        whereChecker.trait_impls_by_type = trait_impls_by_type;
-        for (auto &[name, type] : substitution)
-        {
-          whereChecker.locals[name] = type;
-        }
-        whereChecker.validateWherePredicates(funcDef->whereBounds, funCall->pos);
-      }
-
       Vec<CheckingRef<TypeInfo>> instantiatedArgs;
       instantiatedArgs.reserve(typeParamNames.size());
       for (const auto &name : typeParamNames)
       {
-        instantiatedArgs.push_back(substitution[name]);
+        instantiatedArgs.push_back(intern_type(substitution[name]));
       }
-      for (size_t pi = 0; pi < typeParamNames.size(); ++pi)
+      checkGenericInstanceBounds(*funcDef, substitution, instantiatedArgs, funCall->pos);
+      Str instanceName = formatTypeInstanceName(genericDef.name, instantiatedArgs);
+      if (auto existing = genericDef.instances.find(instanceName); existing != genericDef.instances.end())
       {
-        const auto &name = typeParamNames[pi];
-        Str bound;
-        if (pi < funcDef->genericParams.size())
-        {
-          bound = typeParamBoundName(*funcDef->genericParams[pi]);
-        }
-        if (bound.empty())
-        {
-          if (substitution[name] && substitution[name]->tag() == typeinfo_tag::GENERIC_PARAM)
-          {
-            bound = static_cast<GenericParamType &>(*substitution[name]).bound;
-          }
-        }
-        if (!bound.empty())
+        auto instance = existing->second;
+        useGenericInstance(instance, funCall);
+        if (!instantiationKey.empty() &&
+            std::ranges::find(checkingGenericInstances, instance.get()) == checkingGenericInstances.end())
         {
-          auto traitIt = locals.find(bound);
-          if (traitIt != locals.end() && traitIt->second && traitIt->second->tag() == typeinfo_tag::TRAIT)
-          {
-            auto &trait = static_cast<TraitType &>(*traitIt->second);
-            if (pi < instantiatedArgs.size() && !typeSatisfiesTrait(instantiatedArgs[pi], trait))
-            {
-              throw TypeCheckingException("Type '" + instantiatedArgs[pi]->repr() + "' does not implement trait '" +
-                                              trait.name + "'",
-                                          funCall->pos);
-            }
-          }
+          genericDef.instantiations.emplace(
+              std::move(instantiationKey),
+              GenericInstantiation{.keyTypes = instantiationKeyTypes(argumentTypes, expectedType),
+                                   .substitution = substitution,
+                                   .typeArguments = instantiatedArgs,
+                                   .instance = instance});
         }
-      }
-      Str instanceName = formatTypeInstanceName(genericDef.name, instantiatedArgs);
-      funCall->genericInstanceName = instanceName;
-      funCall->mangledCalleeName =
-          mangle_symbol(MangledSymbolKind::Function, genericDef.moduleId, genericDef.name, instantiatedArgs);
-      funCall->resolvedCalleeName = funCall->mangledCalleeName;
-      if (!activeGenericInstanceName.empty())
-      {
-        funCall->mangledCalleeNameByInstance[activeGenericInstanceName] = funCall->mangledCalleeName;
-      }
-      if (genericDef.instances.contains(instanceName))
-      {
-        return genericDef.instances.at(instanceName);
+        return instance->returnType;
       }
 
       // 4. Resolve the return type with substitution
@@ -7356,14 +8048,25 @@ namespace NG::typecheck
         funcDef->returnType->accept(&retChecker);
         returnType = retChecker.result;
       }
-      genericDef.instances[instanceName] = returnType;
+      auto instance = std::make_shared<GenericFunctionInstance>(GenericFunctionInstance{
+          .genericName = genericDef.name,
+          .instanceName = instanceName,
+          .mangledName =
+              mangle_symbol(MangledSymbolKind::Function, genericDef.moduleId, genericDef.name, instantiatedArgs),
+          .definition = funcDef,
+          .returnType = returnType,
+      });
+      genericDef.instances[instanceName] = instance;
+      auto recordedCount = genericInstanceLog().instances.size();
+      useGenericInstance(instance, funCall);
+      checkingGenericInstances.push_back(instance.get());
       try
       {
 
       // 5. Type-check the function body with substituted types
       TypeChecker bodyChecker{locals};
       bodyChecker.trait_impls_by_type = trait_impls_by_type;
-      bodyChecker.activeGenericInstanceName = funCall->mangledCalleeName;
+      bodyChecker.activeGenericInstanceName = instance->mangledName;
       for (auto &[name, type] : substitution)
       {
         bodyChecker.locals[name] = type;
@@ -7483,15 +8186,168 @@ namespace NG::typecheck
         }
       }
 
-      genericDef.instances[instanceName] = returnType;
+      checkingGenericInstances.pop_back();
+      instance->returnType = returnType;
+      if (!instantiationKey.empty())
+      {
+        genericDef.instantiations.emplace(
+            std::move(instantiationKey),
+            GenericInstantiation{.keyTypes = instantiationKeyTypes(argumentTypes, expectedType),
+                                 .substitution = substitution,
+                                 .typeArguments = instantiatedArgs,
+                                 .instance = instance});
+      }
       return returnType;
       }
       catch (...)
       {
+        checkingGenericInstances.pop_back();
+        forgetGenericInstancesSince(recordedCount);
+        if (!checkingGenericInstances.empty() && !checkingGenericInstances.back()->uses.empty() &&
+            checkingGenericInstances.back()->uses.back() == instance)
+        {
+          checkingGenericInstances.back()->uses.pop_back();
+        }
         genericDef.instances.erase(instanceName);
         throw;
       }
     }
+
+    /**
+     * Checks the trait bounds and where predicates of `funcDef` for one set of type arguments.
+     */
+    void checkGenericInstanceBounds(FunctionDef &funcDef, const Map<Str, CheckingRef<TypeInfo>> &substitution,
+                                    const Vec<CheckingRef<TypeInfo>> &typeArguments, const TokenPosition &pos)
+    {
+      {
+        TypeChecker whereChecker{locals};
+        whereChecker.trait_impls_by_type = trait_impls_by_type;
+        for (auto &[name, type] : substitution)
+        {
+          whereChecker.locals[name] = type;
+        }
+        whereChecker.validateWherePredicates(funcDef.whereBounds, pos);
+      }
+      for (size_t pi = 0; pi < funcDef.genericParams.size() && pi < typeArguments.size(); ++pi)
+      {
+        Str bound = typeParamBoundName(*funcDef.genericParams[pi]);
+        if (bound.empty())
+        {
+          auto subIt = substitution.find(funcDef.genericParams[pi]->name);
+          if (subIt != substitution.end() && subIt->second && subIt->second->tag() == typeinfo_tag::GENERIC_PARAM)
+          {
+            bound = static_cast<GenericParamType &>(*subIt->second).bound;
+          }
+        }
+        if (!bound.empty())
+        {
+          auto traitIt = locals.find(bound);
+          if (traitIt != locals.end() && traitIt->second && traitIt->second->tag() == typeinfo_tag::TRAIT)
+          {
+            auto &trait = static_cast<TraitType &>(*traitIt->second);
+            if (!typeSatisfiesTrait(typeArguments[pi], trait))
+            {
+              throw TypeCheckingException("Type '" + typeArguments[pi]->repr() + "' does not implement trait '" +
+                                              trait.name + "'",
+                                          pos);
+            }
+          }
+        }
+      }
+    }
+
+    /**
+     * The (interned) types an instantiation key is built from, held by the cache entry so that the
+     * addresses in its key stay in use.
+     */
+    static auto instantiationKeyTypes(const Vec<CheckingRef<TypeInfo>> &argumentTypes,
+                                      const CheckingRef<TypeInfo> &expectedType) -> Vec<CheckingRef<TypeInfo>>
+    {
+      Vec<CheckingRef<TypeInfo>> keyTypes;
+      keyTypes.reserve(argumentTypes.size() + 1);
+      for (const auto &type : argumentTypes)
+      {
+        keyTypes.push_back(intern_type(type));
+      }
+      keyTypes.push_back(intern_type(expectedType));
+      return keyTypes;
+    }
+
+    /**
+     * Builds a cache key from the identities of interned types. Types that are not interned are keyed by
+     * address, so cache entries must hold them (see `instantiationKeyTypes`).
+     */
+    static auto argumentTypesKey(const Vec<CheckingRef<TypeInfo>> &argumentTypes) -> Str
+    {
+      Str key;
+      auto append = [&key](const CheckingRef<TypeInfo> &type) {
+        if (!type)
+        {
+          key += "_;";
+          return;
+        }
+        key += type->internId != 0 ? '#' : '@';
+        key += std::to_string(type->internId != 0 ? type->internId : reinterpret_cast<uintptr_t>(type.get()));
+        key += ';';
+      };
+      for (const auto &type : argumentTypes)
+      {
+        append(intern_type(type));
+      }
+      return key;
+    }
+
+    /**
+     * Points `funCall` at `instance` and records the instance as used by the program being checked.
+     */
+    void useGenericInstance(const std::shared_ptr<GenericFunctionInstance> &instance, FunCallExpression *funCall)
+    {
+      funCall->genericInstanceName = instance->instanceName;
+      funCall->mangledCalleeName = instance->mangledName;
+      funCall->resolvedCalleeName = instance->mangledName;
+      if (!activeGenericInstanceName.empty())
+      {
+        funCall->mangledCalleeNameByInstance[activeGenericInstanceName] = instance->mangledName;
+      }
+      if (!checkingGenericInstances.empty() && checkingGenericInstances.back() != instance.get())
+      {
+        checkingGenericInstances.back()->uses.push_back(instance);
+      }
+      recordGenericInstance(instance);
+    }
+
+    /**
+     * Adds `instance` and everything its body uses to the instances of the current run. Instances reused
+     * from an earlier run replay the uses recorded when their body was checked.
+     */
+    static void recordGenericInstance(const std::shared_ptr<GenericFunctionInstance> &instance)
+    {
+      auto &log = genericInstanceLog();
+      if (!log.symbols.insert(instance->mangledName).second)
+      {
+        return;
+      }
+      log.instances.push_back(instance);
+      for (const auto &used : instance->uses)
+      {
+        recordGenericInstance(used);
+      }
+    }
+
+    static void forgetGenericInstancesSince(size_t count)
+    {
+      auto &log = genericInstanceLog();
+      while (log.instances.size() > count)
+      {
+        log.symbols.erase(log.instances.back()->mangledName);
+        log.instances.pop_back();
+      }
+    }
+
+    static auto genericInstanceLog() -> GenericInstanceLog &
+    {
+      return bodyGenericInstances ? *bodyGenericInstances : activeGenericInstances;
+    }
   };
 
   namespace
@@ -7650,10 +8506,14 @@ namespace NG::typecheck
 
   CheckingRef<TypeInfo> type_from_repr(const Str &repr)
   {
-    return type_from_repr_impl(repr);
+    return intern_type(type_from_repr_impl(repr));
   }
 
-  TypeIndex type_check(ASTRef<ASTNode> ast, TypeIndex initial_index, Vec<Str> module_paths)
+  /**
+   * Clears the state a previous check left in the checker statics. With `withPrelude`, the compile-time
+   * definitions and auto traits of the prelude are active again.
+   */
+  static void reset_check_state(bool withPrelude)
   {
     TypeChecker::activeTypeAliasSpecializations.clear();
     TypeChecker::activeConstPredicates.clear();
@@ -7661,14 +8521,22 @@ namespace NG::typecheck
     TypeChecker::activeAutoTraits.clear();
     TypeChecker::activeDerivedTraitImplKeys.clear();
     TypeChecker::moduleArtifactsById.clear();
+    TypeChecker::moduleInterfaceHashes.clear();
     TypeChecker::activeModuleChecks.clear();
-    if (!initial_index.empty())
+    TypeChecker::activeGenericInstances = {};
+    TypeChecker::checkingGenericInstances.clear();
+    if (withPrelude)
     {
       TypeChecker::activeTypeAliasSpecializations = TypeChecker::preludeTypeAliasSpecializations;
       TypeChecker::activeConstPredicates = TypeChecker::preludeConstPredicates;
       TypeChecker::activeConstFunctions = TypeChecker::preludeConstFunctions;
       TypeChecker::activeAutoTraits = TypeChecker::preludeAutoTraits;
     }
+  }
+
+  TypeIndex type_check(ASTRef<ASTNode> ast, TypeIndex initial_index, Vec<Str> module_paths)
+  {
+    reset_check_state(!initial_index.empty());
     TypeChecker checker{initial_index, {}, nullptr, {}, false, "", std::move(module_paths)};
     checker.type_index = initial_index;
     ast->accept(&checker);
@@ -7676,6 +8544,177 @@ namespace NG::typecheck
     return checker.type_index;
   }
 
+  const Vec<std::shared_ptr<GenericFunctionInstance>> &generic_function_instances()
+  {
+    return TypeChecker::activeGenericInstances.instances;
+  }
+
+  void share_module_check(const Str &moduleId)
+  {
+    auto artifacts = TypeChecker::moduleArtifactsById.find(moduleId);
+    if (artifacts == TypeChecker::moduleArtifactsById.end())
+    {
+      return;
+    }
+    auto interfaceHash = TypeChecker::moduleInterfaceHashes.find(moduleId);
+    TypeChecker::sharedModuleChecks.insert_or_assign(
+        moduleId, TypeChecker::SharedModuleCheck{
+                      .artifacts = artifacts->second,
+                      .interfaceHash = interfaceHash == TypeChecker::moduleInterfaceHashes.end()
+                                           ? Str{}
+                                           : interfaceHash->second,
+                      .typeAliasSpecializations = TypeChecker::activeTypeAliasSpecializations,
+                      .constPredicates = TypeChecker::activeConstPredicates,
+                      .constFunctions = TypeChecker::activeConstFunctions,
+                      .autoTraits = TypeChecker::activeAutoTraits,
+                      .derivedTraitImplKeys = TypeChecker::activeDerivedTraitImplKeys,
+                  });
+  }
+
+  void clear_shared_module_checks()
+  {
+    TypeChecker::sharedModuleChecks.clear();
+  }
+
+  /**
+   * Makes `image` the current prelude snapshot and writes it to `path`.
+   */
+  static void publishPreludeSnapshot(const Str &path, Str image)
+  {
+    auto owned = std::make_shared<const Str>(std::move(image));
+    write_module_interface_file(path, *owned);
+    TypeChecker::snapshotImage = decode_prelude_snapshot(*owned);
+    TypeChecker::snapshotBackings.push_back(owned);
+    TypeChecker::snapshotInterfaces.clear();
+    for (const auto &entry : TypeChecker::snapshotImage)
+    {
+      TypeChecker::snapshotInterfaces.emplace(entry.moduleId, entry.interface);
+    }
+  }
+
+  TypeIndex check_prelude(ASTRef<ASTNode> ast, const Str &source, const Str &path, Vec<Str> module_paths)
+  {
+    reset_check_state(false);
+    auto snapshotPath = prelude_snapshot_path();
+    std::unique_lock snapshotLock{TypeChecker::snapshotMutex};
+    TypeChecker::snapshotInterfaces.clear();
+    TypeChecker::snapshotImage.clear();
+    TypeChecker::snapshotBackings.clear();
+    Vec<PreludeSnapshotEntry> snapshotEntries;
+    std::error_code error;
+    if (!snapshotPath.empty() && std::filesystem::exists(snapshotPath, error))
+    {
+      try
+      {
+        auto mapped = std::make_shared<NG::System::MappedFile>(snapshotPath);
+        snapshotEntries = decode_prelude_snapshot(mapped->view());
+        TypeChecker::snapshotBackings.push_back(std::move(mapped));
+      }
+      catch (const RuntimeException &)
+      {
+        snapshotEntries.clear();
+      }
+    }
+    // The snapshot stays mapped, so modules of the prelude imported again later are restored from it too.
+    for (const auto &entry : snapshotEntries)
+    {
+      TypeChecker::snapshotInterfaces.emplace(entry.moduleId, entry.interface);
+    }
+    snapshotLock.unlock();
+
+    Vec<std::pair<Str, Str>> collected;
+    struct CollectGuard
+    {
+      ~CollectGuard()
+      {
+        TypeChecker::collectedInterfaces = nullptr;
+      }
+    } guard;
+    TypeChecker::collectedInterfaces = snapshotPath.empty() ? nullptr : &collected;
+
+    auto module = TypeChecker::moduleOf(ast);
+    TypeChecker checker{TypeScope{}, {}, nullptr, {}, false, "", std::move(module_paths)};
+    if (!module)
+    {
+      ast->accept(&checker);
+      return checker.type_index;
+    }
+    checker.currentModuleId = module->name;
+    NG::module::ModuleInfo preludeInfo{
+        .moduleId = module->name,
+        .moduleName = module->name,
+        .moduleSourceHash = NG::orgasm::bytecode_source_hash(source),
+        .moduleAst = ast,
+        .moduleAbsolutePath = path,
+    };
+    checker.checkOrRestoreModule(preludeInfo, TypeScope{});
+
+    const bool current = collected.size() == snapshotEntries.size() &&
+                         std::ranges::equal(collected, snapshotEntries, [](const auto &lhs, const auto &rhs) {
+                           return lhs.first == rhs.moduleId && lhs.second == rhs.interface;
+                         });
+    snapshotLock.lock();
+    if (TypeChecker::collectedInterfaces && current)
+    {
+      TypeChecker::snapshotImage = std::move(snapshotEntries);
+    }
+    else if (TypeChecker::collectedInterfaces)
+    {
+      Vec<PreludeSnapshotEntry> entries;
+      for (const auto &[moduleId, bytes] : collected)
+      {
+        PreludeSnapshotEntry entry{.moduleId = moduleId, .interface = bytes};
+        // Bytecode is checked against its build key when it is used, so it outlives interface changes.
+        auto previous = std::ranges::find(snapshotEntries, moduleId, &PreludeSnapshotEntry::moduleId);
+        if (previous != snapshotEntries.end())
+        {
+          entry.bytecodeKey = previous->bytecodeKey;
+          entry.bytecode = previous->bytecode;
+        }
+        entries.push_back(std::move(entry));
+      }
+      publishPreludeSnapshot(snapshotPath, encode_prelude_snapshot(entries));
+    }
+    return checker.type_index;
+  }
+
+  auto prelude_snapshot_contains(const Str &moduleId) -> bool
+  {
+    std::lock_guard lock{TypeChecker::snapshotMutex};
+    return std::ranges::find(TypeChecker::snapshotImage, moduleId, &PreludeSnapshotEntry::moduleId) !=
+           TypeChecker::snapshotImage.end();
+  }
+
+  auto prelude_snapshot_bytecode(const Str &moduleId, const Str &buildKey) -> std::string_view
+  {
+    std::lock_guard lock{TypeChecker::snapshotMutex};
+    auto entry = std::ranges::find(TypeChecker::snapshotImage, moduleId, &PreludeSnapshotEntry::moduleId);
+    if (entry == TypeChecker::snapshotImage.end() || buildKey.empty() || entry->bytecodeKey != buildKey)
+    {
+      return {};
+    }
+    return entry->bytecode;
+  }
+
+  void store_prelude_snapshot_bytecode(const Str &moduleId, const Str &buildKey, std::string_view bytecode)
+  {
+    auto path = prelude_snapshot_path();
+    std::lock_guard lock{TypeChecker::snapshotMutex};
+    auto entry = std::ranges::find(TypeChecker::snapshotImage, moduleId, &PreludeSnapshotEntry::moduleId);
+    if (path.empty() || buildKey.empty() || entry == TypeChecker::snapshotImage.end() ||
+        (entry->bytecodeKey == buildKey && entry->bytecode == bytecode))
+    {
+      return;
+    }
+    auto entries = TypeChecker::snapshotImage;
+    auto &updated = entries[static_cast<size_t>(entry - TypeChecker::snapshotImage.begin())];
+    updated.bytecodeKey = buildKey;
+    updated.bytecode = bytecode;
+    publishPreludeSnapshot(path, encode_prelude_snapshot(entries));
+  }
+
+  static Str preludeFingerprint;
+
   TypeIndex build_prelude_type_index()
   {
     static TypeIndex cachedResult;
@@ -7707,16 +8746,33 @@ namespace NG::typecheck
 
       try
       {
-        std::ifstream file{preludePath};
-        std::string source{std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>()};
+        NG::System::MappedFile source{preludePath.string()};
 
         using namespace NG::parsing;
-        auto ast = Parser(ParseState(Lexer(LexState{source}).lex())).parse(preludePath.string());
+        auto ast = Parser(ParseState(std::make_shared<Lexer>(LexState::borrowing(source.view()))))
+                       .parse(preludePath.string());
 
         if (ast)
         {
           TypeChecker::retainedPreludeImportAsts.clear();
-          result = type_check(ast, {}, libPaths);
+          NG::module::prefetch_module_imports(ast, libPaths);
+          result = check_prelude(ast, Str{source.view()}, fs::absolute(preludePath).string(), libPaths);
+          // Every module the prelude loaded is still in the artifact table of the check.
+          Vec<Str> loadedIds;
+          for (const auto &[moduleId, _artifacts] : TypeChecker::moduleArtifactsById)
+          {
+            loadedIds.push_back(moduleId);
+          }
+          std::ranges::sort(loadedIds);
+          Str fingerprint = NG::orgasm::bytecode_source_hash(source.view());
+          for (const auto &moduleId : loadedIds)
+          {
+            if (auto moduleInfo = NG::module::get_module_registry().queryModuleById(moduleId))
+            {
+              fingerprint += ";" + moduleId + ":" + moduleInfo->moduleSourceHash;
+            }
+          }
+          preludeFingerprint = NG::orgasm::bytecode_source_hash(fingerprint);
           TypeChecker::preludeTypeAliasSpecializations = TypeChecker::activeTypeAliasSpecializations;
           TypeChecker::preludeConstPredicates = TypeChecker::activeConstPredicates;
           TypeChecker::preludeConstFunctions = TypeChecker::activeConstFunctions;
@@ -7734,4 +8790,10 @@ namespace NG::typecheck
 
     return initSucceeded ? cachedResult : TypeIndex{};
   }
+
+  auto prelude_fingerprint() -> Str
+  {
+    build_prelude_type_index();
+    return preludeFingerprint;
+  }
 } // namespace NG::typecheck
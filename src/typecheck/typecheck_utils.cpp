@@ -30,6 +30,9 @@ namespace NG::typecheck
         const auto &ua = unwrapAlias(a);
         const auto &ub = unwrapAlias(b);
 
+        // Interned types are equal exactly when they are the same node.
+        if (&ua == &ub && ua.internId != 0) return true;
+
         // Allow unit literal to match any custom (struct) type — acts like null
         auto isUnit = [](const TypeInfo &t) {
             if (auto p = dynamic_cast<const PrimitiveType *>(&t))
@@ -56,7 +59,7 @@ namespace NG::typecheck
 
     // ── Type display and lookup helpers ────────────────────────────────
 
-    auto findTaggedVariant(const Map<Str, CheckingRef<TypeInfo>> &locals, const Str &variantName)
+    auto findTaggedVariant(const TypeScope &locals, const Str &variantName)
         -> std::optional<TaggedVariantLookup>
     {
         std::optional<TaggedVariantLookup> found;
@@ -89,7 +92,7 @@ namespace NG::typecheck
         return found;
     }
 
-    auto widenVariantToUnionType(const Map<Str, CheckingRef<TypeInfo>> &locals, CheckingRef<TypeInfo> type)
+    auto widenVariantToUnionType(const TypeScope &locals, CheckingRef<TypeInfo> type)
         -> CheckingRef<TypeInfo>
     {
         auto unwrapped = unwrap(type);
@@ -451,14 +454,7 @@ namespace NG::typecheck
 
     // ── Scope utilities ─────────────────────────────────────────────────
 
-    auto scopeNames(const Map<Str, CheckingRef<TypeInfo>> &scope) -> Set<Str>
-    {
-        Set<Str> names;
-        for (const auto &[name, _] : scope) names.insert(name);
-        return names;
-    }
-
-    auto filterMovedBindings(const Set<Str> &moved, const Set<Str> &allowed) -> Set<Str>
+    auto filterMovedBindings(const Set<Str> &moved, const TypeScope &allowed) -> Set<Str>
     {
         Set<Str> filtered;
         for (const auto &name : moved)
@@ -228,13 +228,15 @@ namespace NG::typecheck
   // UnionType — matches if other is one of the member types
   auto UnionType::repr() const -> Str
   {
-    Str out;
-    for (size_t i = 0; i < types.size(); ++i)
-    {
-      if (i > 0) out += " | ";
-      out += types[i]->repr();
-    }
-    return out;
+    return memoizedRepr([this] {
+      Str out;
+      for (size_t i = 0; i < types.size(); ++i)
+      {
+        if (i > 0) out += " | ";
+        out += types[i]->repr();
+      }
+      return out;
+    });
   }
 
   auto UnionType::match(const TypeInfo &other) const -> bool
@@ -254,11 +256,12 @@ namespace NG::typecheck
 
   auto ReferenceType::repr() const -> Str
   {
-    return "ref<" + nestedTypeRepr(referencedType) + ">";
+    return memoizedRepr([this] { return "ref<" + nestedTypeRepr(referencedType) + ">"; });
   }
 
   auto ReferenceType::match(const TypeInfo &other) const -> bool
   {
+    if (this == &other) return true;
     if (other.tag() == typeinfo_tag::UNTYPED) return true;
     if (auto otherRef = dynamic_cast<const ReferenceType *>(&other))
     {
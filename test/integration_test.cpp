@@ -15,43 +15,6 @@ namespace fs = std::filesystem;
 
 namespace
 {
-struct ScopedEnvVar
-{
-  Str name;
-  Str previous;
-  bool hadPrevious = false;
-
-  ScopedEnvVar(Str name, const Str &value) : name(std::move(name))
-  {
-    if (const char *existing = std::getenv(this->name.c_str()))
-    {
-      previous = existing;
-      hadPrevious = true;
-    }
-#ifdef _WIN32
-    _putenv_s(this->name.c_str(), value.c_str());
-#else
-    setenv(this->name.c_str(), value.c_str(), 1);
-#endif
-  }
-
-  ~ScopedEnvVar()
-  {
-#ifdef _WIN32
-    _putenv_s(name.c_str(), hadPrevious ? previous.c_str() : "");
-#else
-    if (hadPrevious)
-    {
-      setenv(name.c_str(), previous.c_str(), 1);
-    }
-    else
-    {
-      unsetenv(name.c_str());
-    }
-#endif
-  }
-};
-
 struct SourceModuleFixture
 {
   fs::path root;
@@ -189,6 +152,14 @@ TEST_CASE("should run numbered examples", "[Integration]")
       "example/57.ranges_slicing_pipeline.ng",
       "example/58.fold_expressions.ng",
       "example/59.std_list_sequence.ng",
+      "example/60.array_kernels.ng",
+      "example/61.hash_collections.ng",
+      "example/62.ordered_collections.ng",
+      "example/63.sorting.ng",
+      "example/64.list_deque.ng",
+      "example/65.string_builder.ng",
+      "example/66.text_slices.ng",
+      "example/67.regex.ng",
       "example/50.partial_move.ng",
       "example/51.partial_move_drop.ng",
   };
@@ -0,0 +1,149 @@
+#include "../test.hpp"
+
+#include <module.hpp>
+#include <orgasm/compiler.hpp>
+#include <orgasm/vm.hpp>
+#include <intp/runtime_numerals.hpp>
+#include <typecheck/typecheck.hpp>
+
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+
+using namespace NG;
+using namespace NG::runtime;
+
+namespace fs = std::filesystem;
+
+namespace
+{
+  struct ModuleGraphFixture
+  {
+    fs::path root = fs::temp_directory_path() /
+                    ("ng_module_loader_" +
+                     std::to_string(std::chrono::steady_clock::now().time_since_epoch().count()));
+
+    ModuleGraphFixture()
+    {
+      NG::module::clear_module_loader_cache();
+      NG::module::get_module_registry().clear();
+      fs::create_directories(root);
+
+      write("pkg/leaf.ng", R"(
+        module pkg.leaf exports *;
+        fun leaf() -> i32 {
+          return 1;
+        }
+      )");
+      write("pkg/left.ng", R"(
+        module pkg.left exports *;
+        import pkg.leaf (*);
+        fun left() -> i32 {
+          return leaf() + 10;
+        }
+      )");
+      write("pkg/right.ng", R"(
+        module pkg.right exports *;
+        import pkg.leaf (*);
+        fun right() -> i32 {
+          return leaf() + 100;
+        }
+      )");
+      write("pkg/top.ng", R"(
+        module pkg.top exports *;
+        import pkg.left (*);
+        import pkg.right (*);
+        fun top() -> i32 {
+          return left() + right();
+        }
+      )");
+    }
+
+    ~ModuleGraphFixture()
+    {
+      NG::module::clear_module_loader_cache();
+      NG::module::get_module_registry().clear();
+      fs::remove_all(root);
+    }
+
+    void write(const fs::path &relative, const Str &source) const
+    {
+      auto target = root / relative;
+      fs::create_directories(target.parent_path());
+      std::ofstream out{target};
+      REQUIRE(out.good());
+      out << source;
+    }
+
+    auto paths() const -> Vec<Str>
+    {
+      return {root.string()};
+    }
+  };
+} // namespace
+
+TEST_CASE("module loader should prefetch transitive imports into the registry", "[ModuleLoader]")
+{
+  ModuleGraphFixture fixture;
+  NG::module::FileBasedExternalModuleLoader loader{fixture.paths()};
+
+  auto top = loader.load({"pkg", "top"});
+  REQUIRE(top != nullptr);
+
+  auto &registry = NG::module::get_module_registry();
+  for (const Str moduleId : {"pkg.left", "pkg.right", "pkg.leaf"})
+  {
+    auto moduleInfo = registry.queryModuleById(moduleId);
+    REQUIRE(moduleInfo != nullptr);
+    REQUIRE(moduleInfo->moduleAst != nullptr);
+  }
+  REQUIRE(loader.load({"pkg", "leaf"}) == registry.queryModuleById("pkg.leaf"));
+}
+
+TEST_CASE("module loader prefetch should leave broken imports to the importing site", "[ModuleLoader]")
+{
+  ModuleGraphFixture fixture;
+  fixture.write("pkg/broken.ng", R"(
+    module pkg.broken exports *;
+    fun broken( -> i32 {
+  )");
+  fixture.write("pkg/uses_broken.ng", R"(
+    module pkg.uses_broken exports *;
+    import pkg.leaf (*);
+    import pkg.broken (*);
+  )");
+  NG::module::FileBasedExternalModuleLoader loader{fixture.paths()};
+
+  REQUIRE(loader.load({"pkg", "uses_broken"}) != nullptr);
+
+  auto &registry = NG::module::get_module_registry();
+  REQUIRE(registry.queryModuleById("pkg.leaf") != nullptr);
+  REQUIRE(registry.queryModuleById("pkg.broken") == nullptr);
+  REQUIRE_THROWS_AS(loader.load({"pkg", "broken"}), ParseException);
+}
+
+TEST_CASE("compiler and vm should run programs over a prefetched module graph", "[ModuleLoader][OrgasmTest]")
+{
+  ModuleGraphFixture fixture;
+
+  auto ast = parse(R"(
+    import pkg.top (*);
+    fun main() -> i32 {
+      return top();
+    }
+  )");
+  REQUIRE(ast != nullptr);
+
+  NG::module::prefetch_module_imports(ast, fixture.paths());
+  REQUIRE(NG::module::get_module_registry().queryModuleById("pkg.leaf") != nullptr);
+
+  NG::typecheck::type_check(ast, {}, fixture.paths());
+  NG::orgasm::Compiler compiler{fixture.paths()};
+  auto bytecode = compiler.compile(dynamic_ast_cast<CompileUnit>(ast));
+
+  NG::orgasm::VM vm{fixture.paths()};
+  auto result = vm.run(bytecode);
+  REQUIRE(read_numeric_cell_as<int32_t>(result) == 112);
+
+  destroyast(ast);
+}
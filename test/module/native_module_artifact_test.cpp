@@ -22,43 +22,6 @@ namespace fs = std::filesystem;
 
 namespace
 {
-  struct ScopedEnvVar
-  {
-    Str name;
-    Str previous;
-    bool hadPrevious = false;
-
-    ScopedEnvVar(Str name, const Str &value) : name(std::move(name))
-    {
-      if (const char *existing = std::getenv(this->name.c_str()))
-      {
-        previous = existing;
-        hadPrevious = true;
-      }
-#ifdef _WIN32
-      _putenv_s(this->name.c_str(), value.c_str());
-#else
-      setenv(this->name.c_str(), value.c_str(), 1);
-#endif
-    }
-
-    ~ScopedEnvVar()
-    {
-#ifdef _WIN32
-      _putenv_s(name.c_str(), hadPrevious ? previous.c_str() : "");
-#else
-      if (hadPrevious)
-      {
-        setenv(name.c_str(), previous.c_str(), 1);
-      }
-      else
-      {
-        unsetenv(name.c_str());
-      }
-#endif
-    }
-  };
-
   struct NativeSourceFixture
   {
     fs::path root;
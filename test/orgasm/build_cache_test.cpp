@@ -0,0 +1,298 @@
+#include "../test.hpp"
+#include <chrono>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <module.hpp>
+#include <orgasm/build_cache.hpp>
+#include <orgasm/build_driver.hpp>
+#include <typecheck/typecheck.hpp>
+
+using namespace NG::orgasm;
+
+namespace
+{
+struct BuildCacheFixture
+{
+  std::filesystem::path root;
+
+  BuildCacheFixture()
+      : root(std::filesystem::temp_directory_path() /
+             ("ng_build_cache_" + std::to_string(std::chrono::steady_clock::now().time_since_epoch().count())))
+  {
+    std::filesystem::create_directories(root / "src");
+    setenv("NG_CACHE_DIR", (root / "cache").c_str(), 1);
+    reset();
+  }
+
+  ~BuildCacheFixture()
+  {
+    unsetenv("NG_CACHE_DIR");
+    reset();
+    std::filesystem::remove_all(root);
+  }
+
+  // Each build should start like a fresh process, with only the cache directory carried over.
+  static void reset()
+  {
+    NG::module::clear_module_loader_cache();
+    NG::module::get_module_registry().clear();
+  }
+
+  void write(const std::filesystem::path &relative, const Str &source) const
+  {
+    auto target = root / "src" / relative;
+    std::filesystem::create_directories(target.parent_path());
+    std::ofstream out{target};
+    REQUIRE(out.good());
+    out << source;
+  }
+
+  auto paths() const -> Vec<Str> { return {(root / "src").string()}; }
+
+  auto load(const Vec<Str> &modulePath) const -> std::shared_ptr<NG::module::ModuleInfo>
+  {
+    NG::module::FileBasedExternalModuleLoader loader{paths()};
+    auto moduleInfo = loader.load(modulePath);
+    REQUIRE(moduleInfo != nullptr);
+    NG::module::get_module_registry().addModuleInfo(moduleInfo);
+    return moduleInfo;
+  }
+
+  auto key(const Vec<Str> &modulePath) const -> Str
+  {
+    reset();
+    return module_build_key(*load(modulePath), paths());
+  }
+
+  auto cacheFile(const Str &key) const -> std::filesystem::path
+  {
+    return root / "cache" / key.substr(0, 2) / (key + ".ngo");
+  }
+
+  auto build(const Str &source) const -> BuildReport
+  {
+    reset();
+    auto ast = parse(source);
+    REQUIRE(ast != nullptr);
+    auto report = build_program(ast, source, (root / "src" / "main.ng").string(), paths(), {}, (root / "out").string());
+    destroyast(ast);
+    return report;
+  }
+};
+
+constexpr auto LEAF_SOURCE = R"(
+  module pkg.leaf exports *;
+  fun answer() -> i32 = 42;
+)";
+
+constexpr auto MID_SOURCE = R"(
+  module pkg.mid exports *;
+  import pkg.leaf (*);
+  fun twice() -> i32 = answer() * 2;
+)";
+
+constexpr auto OTHER_SOURCE = R"(
+  module pkg.other exports *;
+  fun other() -> i32 = 1;
+)";
+} // namespace
+
+TEST_CASE("build cache should reuse compiled modules", "[OrgasmTest][Module][BuildCache]")
+{
+  BuildCacheFixture fixture;
+  fixture.write("pkg/leaf.ng", LEAF_SOURCE);
+  fixture.write("pkg/mid.ng", MID_SOURCE);
+
+  auto key = fixture.key({"pkg", "mid"});
+  REQUIRE_FALSE(key.empty());
+  REQUIRE(fixture.key({"pkg", "mid"}) == key);
+
+  fixture.reset();
+  auto cold = compile_source_module(*fixture.load({"pkg", "mid"}), fixture.paths());
+  auto file = fixture.cacheFile(key);
+  REQUIRE(std::filesystem::exists(file));
+
+  // A cache hit does not write the file again, so an old timestamp survives the warm build.
+  auto stamp = std::filesystem::file_time_type::clock::now() - std::chrono::hours(1);
+  std::filesystem::last_write_time(file, stamp);
+  fixture.reset();
+  auto warm = compile_source_module(*fixture.load({"pkg", "mid"}), fixture.paths());
+  REQUIRE(std::filesystem::last_write_time(file) == stamp);
+  REQUIRE(warm.name == cold.name);
+  REQUIRE(warm.exports == cold.exports);
+  REQUIRE(warm.functions.size() == cold.functions.size());
+}
+
+TEST_CASE("build cache keys should follow the import graph", "[OrgasmTest][Module][BuildCache]")
+{
+  BuildCacheFixture fixture;
+  fixture.write("pkg/leaf.ng", LEAF_SOURCE);
+  fixture.write("pkg/mid.ng", MID_SOURCE);
+  fixture.write("pkg/other.ng", OTHER_SOURCE);
+
+  auto leaf = fixture.key({"pkg", "leaf"});
+  auto mid = fixture.key({"pkg", "mid"});
+  auto other = fixture.key({"pkg", "other"});
+
+  fixture.write("pkg/leaf.ng", Str{LEAF_SOURCE} + "\n  fun extra() -> i32 = 0;\n");
+  REQUIRE(fixture.key({"pkg", "leaf"}) != leaf);
+  REQUIRE(fixture.key({"pkg", "mid"}) != mid);
+  REQUIRE(fixture.key({"pkg", "other"}) == other);
+}
+
+TEST_CASE("build cache should ignore corrupt entries", "[OrgasmTest][Module][BuildCache][Failure]")
+{
+  BuildCacheFixture fixture;
+  fixture.write("pkg/leaf.ng", LEAF_SOURCE);
+
+  fixture.reset();
+  (void)compile_source_module(*fixture.load({"pkg", "leaf"}), fixture.paths());
+  auto key = fixture.key({"pkg", "leaf"});
+  auto file = fixture.cacheFile(key);
+  REQUIRE(std::filesystem::exists(file));
+  auto size = std::filesystem::file_size(file);
+  std::filesystem::resize_file(file, size / 2);
+
+  REQUIRE_FALSE(load_cached_module(key).has_value());
+  fixture.reset();
+  (void)compile_source_module(*fixture.load({"pkg", "leaf"}), fixture.paths());
+  REQUIRE(std::filesystem::file_size(file) == size);
+}
+
+TEST_CASE("prelude snapshots should carry the bytecode of their modules",
+          "[OrgasmTest][Module][BuildCache][PreludeSnapshot]")
+{
+  BuildCacheFixture fixture;
+  // Build keys include the fingerprint of the real prelude, which must not be checked against this snapshot.
+  (void)NG::typecheck::prelude_fingerprint();
+  ScopedEnvVar noCache{"NG_CACHE_DIR", ""};
+  ScopedEnvVar snapshotPath{"NG_PRELUDE_SNAPSHOT", (fixture.root / "prelude.ngs").string()};
+  fixture.write("pkg/leaf.ng", LEAF_SOURCE);
+  fixture.write("my/prelude.ng", R"(
+    module my.prelude exports *;
+    import pkg.leaf (*);
+    fun doubled() -> i32 = answer() * 2;
+  )");
+
+  // Each check starts like a fresh process, with only the snapshot image carried over.
+  auto checkPrelude = [&] {
+    fixture.reset();
+    auto path = fixture.root / "src" / "my" / "prelude.ng";
+    std::ifstream in{path};
+    Str source{std::istreambuf_iterator<char>{in}, {}};
+    auto ast = parse(source);
+    REQUIRE(ast != nullptr);
+    (void)NG::typecheck::check_prelude(ast, source, path.string(), fixture.paths());
+    destroyast(ast);
+    auto leaf = NG::module::get_module_registry().queryModuleById("pkg.leaf");
+    REQUIRE(leaf != nullptr);
+    return leaf;
+  };
+
+  auto leaf = checkPrelude();
+  REQUIRE(NG::typecheck::prelude_snapshot_contains("pkg.leaf"));
+  auto key = module_build_key(*leaf, fixture.paths());
+  REQUIRE(NG::typecheck::prelude_snapshot_bytecode("pkg.leaf", key).empty());
+  auto cold = compile_source_module(*leaf, fixture.paths());
+  REQUIRE_FALSE(NG::typecheck::prelude_snapshot_bytecode("pkg.leaf", key).empty());
+
+  // The next process loads the module from the image without rewriting it.
+  leaf = checkPrelude();
+  REQUIRE_FALSE(NG::typecheck::prelude_snapshot_bytecode("pkg.leaf", key).empty());
+  auto snapshot = fixture.root / "prelude.ngs";
+  auto stamp = std::filesystem::file_time_type::clock::now() - std::chrono::hours(1);
+  std::filesystem::last_write_time(snapshot, stamp);
+  auto warm = compile_source_module(*leaf, fixture.paths());
+  REQUIRE(std::filesystem::last_write_time(snapshot) == stamp);
+  REQUIRE(warm.name == cold.name);
+  REQUIRE(warm.exports == cold.exports);
+  REQUIRE(warm.functions.size() == cold.functions.size());
+
+  // A changed module has a new build key, so its old bytecode is not used.
+  fixture.write("pkg/leaf.ng", Str{LEAF_SOURCE} + "\n  fun extra() -> i32 = 0;\n");
+  leaf = checkPrelude();
+  auto changedKey = module_build_key(*leaf, fixture.paths());
+  REQUIRE(changedKey != key);
+  REQUIRE(NG::typecheck::prelude_snapshot_bytecode("pkg.leaf", changedKey).empty());
+  auto changed = compile_source_module(*leaf, fixture.paths());
+  REQUIRE(changed.exports.contains("extra"));
+  REQUIRE_FALSE(NG::typecheck::prelude_snapshot_bytecode("pkg.leaf", changedKey).empty());
+}
+
+TEST_CASE("build driver should build imported modules before their importers", "[OrgasmTest][Module][BuildCache]")
+{
+  BuildCacheFixture fixture;
+  fixture.write("pkg/leaf.ng", LEAF_SOURCE);
+  fixture.write("pkg/mid.ng", MID_SOURCE);
+  fixture.write("pkg/other.ng", OTHER_SOURCE);
+  constexpr auto MAIN_SOURCE = R"(
+    import pkg.mid (*);
+    import pkg.other (*);
+    import pkg.leaf (*);
+    val total = twice() + other() + answer();
+  )";
+
+  auto cold = fixture.build(MAIN_SOURCE);
+  Vec<Str> order;
+  for (const auto &module : cold.modules)
+  {
+    REQUIRE_FALSE(module.cached);
+    order.push_back(module.moduleId);
+  }
+  REQUIRE(order.size() == 4);
+  auto position = [&](const Str &moduleId) { return std::ranges::find(order, moduleId) - order.begin(); };
+  REQUIRE(position("pkg.leaf") < position("pkg.mid"));
+  REQUIRE(order.back() == std::filesystem::absolute(fixture.root / "src" / "main.ng").lexically_normal().string());
+  REQUIRE(std::filesystem::exists(fixture.root / "out" / "pkg" / "leaf.ngo"));
+  REQUIRE(std::filesystem::exists(fixture.root / "out" / "main.ngo"));
+  REQUIRE(read_bytecode_module((fixture.root / "out" / "pkg" / "mid.ngo").string(), "pkg.mid").exports.contains("twice"));
+
+  auto warm = fixture.build(MAIN_SOURCE);
+  REQUIRE(warm.modules.size() == 4);
+  for (const auto &module : warm.modules)
+  {
+    REQUIRE(module.cached);
+  }
+
+  fixture.write("pkg/leaf.ng", Str{LEAF_SOURCE} + "\n  fun extra() -> i32 = 0;\n");
+  auto edited = fixture.build(MAIN_SOURCE);
+  for (const auto &module : edited.modules)
+  {
+    REQUIRE(module.cached == (module.moduleId == "pkg.other"));
+  }
+}
+
+TEST_CASE("build driver should reject import cycles", "[OrgasmTest][Module][BuildCache][Failure]")
+{
+  BuildCacheFixture fixture;
+  fixture.write("pkg/alpha.ng", "module pkg.alpha exports *;\nimport pkg.beta (*);\nfun a() -> i32 = 1;\n");
+  fixture.write("pkg/beta.ng", "module pkg.beta exports *;\nimport pkg.alpha (*);\nfun b() -> i32 = 2;\n");
+
+  REQUIRE_THROWS_AS(fixture.build("import pkg.alpha (*);\nval x = a();\n"), RuntimeException);
+}
+
+TEST_CASE("build driver should share checked modules with their importers", "[OrgasmTest][Module][BuildCache]")
+{
+  BuildCacheFixture fixture;
+  // The predicate is private, yet instantiating `requireRef` in an importer still evaluates it.
+  fixture.write("pkg/bounds.ng", R"(
+    module pkg.bounds exports (requireRef);
+    const is_ref_arg<T>: bool = false;
+    const<T> is_ref_arg<ref<T>>: bool = true;
+    fun requireRef<T>(value: T) -> i32 where is_ref_arg<T> = 1;
+  )");
+  fixture.write("pkg/large.ng", R"(
+    module pkg.large exports *;
+    import pkg.bounds (requireRef);
+    fun large() -> i32 {
+      val n = 7;
+      return requireRef(ref n);
+    }
+  )");
+
+  auto report = fixture.build("import pkg.large (*);\nimport pkg.bounds (*);\nval m = 2;\nval total = large() + requireRef(ref m);\n");
+  REQUIRE(report.modules.size() == 3);
+  REQUIRE(read_bytecode_module((fixture.root / "out" / "pkg" / "large.ngo").string(), "pkg.large").exports.contains("large"));
+  REQUIRE_THROWS_AS(fixture.build("import pkg.bounds (*);\nval small = requireRef(3);\n"), TypeCheckingException);
+}
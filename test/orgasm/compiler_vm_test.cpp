@@ -1,10 +1,12 @@
 #include "../test.hpp"
 #include <algorithm>
+#include <array>
 #include <chrono>
 #include <filesystem>
 #include <fstream>
 #include <module.hpp>
 #include <orgasm/compiler.hpp>
+#include <orgasm/session.hpp>
 #include <orgasm/vm.hpp>
 #include <intp/runtime_numerals.hpp>
 #include <typecheck/typecheck.hpp>
@@ -223,6 +225,53 @@ TEST_CASE("compiler and vm should call imported source module through canonical
   destroyast(ast);
 }
 
+TEST_CASE("compiler should compile imported struct members and generic natives into the importer",
+          "[OrgasmTest][ModuleArtifact]")
+{
+  SourceModuleFixture fixture;
+  fixture.write("pkg/table.ng", R"(
+    module pkg.table exports *;
+    type HashTable<K, V> = native;
+    fun hashTable<K, V>(withValues: bool) -> HashTable<K, V> = native;
+    fun hashTableInsert<K, V>(table: ref<HashTable<K, V>>, key: K, value: V) -> bool = native;
+    fun hashTableSize<K, V>(table: ref<HashTable<K, V>>) -> u32 = native;
+    fun distinctKeys() -> u32 {
+      val table: HashTable<i32, i32> = hashTable<i32, i32>(true);
+      hashTableInsert(ref table, 1, 10);
+      hashTableInsert(ref table, 2, 20);
+      hashTableInsert(ref table, 1, 30);
+      return hashTableSize(ref table);
+    }
+    type Tally {
+      count: i32;
+      fun doubled(self: ref<Self>) -> i32 {
+        return self.count * 2;
+      }
+    }
+  )");
+  auto ast = parse(R"(
+    import pkg.table (*);
+    fun main() -> i32 {
+      val tally = new Tally { count: 20 };
+      if (distinctKeys() == 2u32) {
+        return tally.doubled();
+      }
+      return 0;
+    }
+  )");
+  REQUIRE(ast != nullptr);
+
+  Compiler compiler{fixture.paths()};
+  auto bytecode = compiler.compile(dynamic_ast_cast<CompileUnit>(ast));
+
+  VM vm{fixture.paths()};
+  NG::library::prelude::register_vm_natives(vm);
+  auto result = vm.run(bytecode);
+  REQUIRE(result_i32(result) == 40);
+
+  destroyast(ast);
+}
+
 TEST_CASE("compiler should reject conflicting imported source symbols",
           "[OrgasmTest][ModuleArtifact]")
 {
@@ -632,6 +681,307 @@ TEST_CASE("compiler and vm should copy array bindings by default", "[OrgasmTest]
   destroyast(ast);
 }
 
+TEST_CASE("compiler should move the last use of a local instead of copying it", "[OrgasmTest][RefMove]")
+{
+  auto ast = parse(R"(
+        fun total(xs: [i32]) -> i32 {
+            return xs[0] + xs[1];
+        }
+        fun relay(xs: [i32]) -> i32 {
+            val ys = xs;
+            return total(ys);
+        }
+        fun looped(xs: [i32]) -> i32 {
+            val acc = 0;
+            loop i = 0 {
+                acc := acc + total(xs);
+                if (i < 2) {
+                    next i + 1;
+                }
+            }
+            return acc;
+        }
+        fun borrowed(xs: [i32]) -> i32 {
+            val view = ref xs;
+            return total(xs);
+        }
+        fun mutate(xs: [i32]) -> i32 {
+            xs[0] := 9;
+            return xs[0];
+        }
+        fun main() {
+            val arr = [1, 2];
+            val changed = mutate(arr);
+            val unchanged = arr[0] * 1000;
+            return unchanged + (changed * 100) + relay(arr) + looped(arr) + borrowed(arr);
+        }
+    )");
+  REQUIRE(ast != nullptr);
+
+  Compiler compiler;
+  auto bytecode = compiler.compile(dynamic_ast_cast<CompileUnit>(ast));
+
+  auto takes = [&](const Str &name, uint16_t slot) {
+    const auto &code = bytecode.functions[static_cast<size_t>(bytecode.findFunction(name))].code;
+    const std::array<uint8_t, 3> take{static_cast<uint8_t>(OpCode::TAKE_LOCAL), static_cast<uint8_t>(slot & 0xFFU),
+                                      static_cast<uint8_t>(slot >> 8U)};
+    return !std::ranges::search(code, take).empty();
+  };
+  REQUIRE(takes("relay", 0));
+  REQUIRE(takes("relay", 1));
+  REQUIRE_FALSE(takes("total", 0));
+  REQUIRE_FALSE(takes("looped", 0));
+  REQUIRE_FALSE(takes("borrowed", 0));
+  REQUIRE_FALSE(takes("main", 0));
+
+  VM vm;
+  auto result = vm.run(bytecode);
+
+  REQUIRE(result_i32(result) == 1000 + 900 + 3 + 9 + 3);
+
+  destroyast(ast);
+}
+
+TEST_CASE("compiler should copy last reads of values that may have a destructor", "[OrgasmTest][RefMove]")
+{
+  auto ast = parse(R"(
+        type Tracked {
+            id: i32;
+        }
+        impl Drop for Tracked {
+            fun drop(self: ref<Self>) -> unit {
+            }
+        }
+        type Box<T> {
+            value: T;
+        }
+        fun count(items: [(i32, Tracked)]) -> u32 {
+            return items.size();
+        }
+        fun relay(items: [(i32, Tracked)]) -> u32 {
+            val copy = items;
+            return count(copy);
+        }
+        fun handle(tracked: ref<Tracked>) -> i32 {
+            val other = tracked;
+            return other.id;
+        }
+        fun unbox<T>(box: Box<T>) -> T {
+            val inner = box;
+            return inner.value;
+        }
+        fun plain(pairs: [(i32, string)]) -> u32 {
+            val copy = pairs;
+            return copy.size();
+        }
+        fun main() {
+            val tracked = new Tracked { id: 1 };
+            val items: [(i32, Tracked)] = [];
+            relay(items);
+            plain([(1, "a"), (2, "b")]);
+            handle(tracked);
+            unbox(*new Box<i32> { value: 2 });
+            unbox(*new Box<Tracked> { value: *tracked });
+        }
+    )");
+  REQUIRE(ast != nullptr);
+
+  Compiler compiler;
+  auto bytecode = compiler.compile(dynamic_ast_cast<CompileUnit>(ast));
+
+  auto takes = [](const Function &function) {
+    const std::array<uint8_t, 1> take{static_cast<uint8_t>(OpCode::TAKE_LOCAL)};
+    return !std::ranges::search(function.code, take).empty();
+  };
+  auto named = [&](const Str &name) -> const Function & {
+    return bytecode.functions[static_cast<size_t>(bytecode.findFunction(name))];
+  };
+  REQUIRE_FALSE(takes(named("relay")));
+  REQUIRE_FALSE(takes(named("handle")));
+  REQUIRE(takes(named("plain")));
+  Vec<Str> movingInstances;
+  Vec<Str> copyingInstances;
+  for (const auto &function : bytecode.functions)
+  {
+    if (function.name.find("unbox") != Str::npos)
+    {
+      (takes(function) ? movingInstances : copyingInstances).push_back(function.name);
+    }
+  }
+  REQUIRE(movingInstances.size() == 1);
+  REQUIRE(movingInstances.front().find("i32") != Str::npos);
+  REQUIRE(std::ranges::any_of(copyingInstances, [](const Str &name) { return name.find("Tracked") != Str::npos; }));
+
+  destroyast(ast);
+}
+
+TEST_CASE("vm should grow vectors in place through their members", "[OrgasmTest][Array]")
+{
+  auto ast = parse(R"(
+        fun gather(n: i32) -> [i32] {
+            val xs: [i32] = [];
+            xs.reserve(n);
+            loop i = 0 {
+                if (i < n) {
+                    xs.push(i);
+                    next i + 1;
+                }
+            }
+            return xs;
+        }
+        fun main() {
+            val xs = gather(100);
+            if (xs.capacity() < 100u32) {
+                return 0;
+            }
+            xs.insert(0, 7);
+            val last = xs.pop();
+            xs.truncate(2);
+            val kept = xs[0] * 10;
+            val total = kept + xs[1];
+            xs.clear();
+            if (xs.size() == 0u32) {
+                return total + last;
+            }
+            return 0;
+        }
+    )");
+  REQUIRE(ast != nullptr);
+
+  Compiler compiler;
+  auto bytecode = compiler.compile(dynamic_ast_cast<CompileUnit>(ast));
+  VM vm;
+  auto result = vm.run(bytecode);
+
+  REQUIRE(result_i32(result) == 70 + 0 + 99);
+
+  destroyast(ast);
+}
+
+TEST_CASE("compiler should pass receivers by place only to members that edit them", "[OrgasmTest][RefMove]")
+{
+  auto ast = parse(R"(
+        type Counter {
+            count: i32;
+            fun push(self: Self, amount: i32) -> i32 {
+                self.count := self.count + amount;
+                return self.count;
+            }
+        }
+        type Tally {
+            count: i32;
+            fun bump(self: ref<Self>, amount: i32) -> i32 {
+                self.count := self.count + amount;
+                return self.count;
+            }
+        }
+        type Score {
+            count: i32;
+            fun bump(self: Self, amount: i32) -> i32 {
+                self.count := self.count + amount;
+                return self.count;
+            }
+        }
+        fun gather<T>(value: T) -> [T] {
+            val xs: [T] = [];
+            xs.push(value);
+            xs.push(value);
+            return xs;
+        }
+        fun main() -> i32 {
+            val counter = *new Counter { count: 1 };
+            counter.push(10);
+            val tally = *new Tally { count: 1 };
+            tally.bump(10);
+            val score = *new Score { count: 1 };
+            score.bump(10);
+            val gathered = gather(4);
+            return (counter.count * 1000) + (tally.count * 10) + score.count + gathered[1];
+        }
+    )");
+  REQUIRE(ast != nullptr);
+
+  Compiler compiler;
+  auto bytecode = compiler.compile(dynamic_ast_cast<CompileUnit>(ast));
+  VM vm;
+  auto result = vm.run(bytecode);
+
+  // Only the vector members and Tally's ref<Self> receiver see the caller's value.
+  REQUIRE(result_i32(result) == 1000 + 110 + 1 + 4);
+
+  destroyast(ast);
+}
+
+TEST_CASE("vm should index packed primitive arrays in place", "[OrgasmTest][Array]")
+{
+  auto ast = parse(R"(
+        fun main() {
+            val xs = [1, 2, 3, 4];
+            xs[1] := 20;
+            val ys = xs;
+            ys[0] := 100;
+            val r = ref xs[2];
+            *r := 30;
+            xs[3] := xs[3] + ys[0];
+            return xs[0] + xs[1] + xs[2] + xs[3];
+        }
+    )");
+  REQUIRE(ast != nullptr);
+
+  Compiler compiler;
+  auto bytecode = compiler.compile(dynamic_ast_cast<CompileUnit>(ast));
+  VM vm;
+  auto result = vm.run(bytecode);
+
+  REQUIRE(result_i32(result) == 1 + 20 + 30 + 104);
+
+  destroyast(ast);
+}
+
+TEST_CASE("compiler should lower recognized folds to array kernels", "[OrgasmTest][Fold]")
+{
+  auto ast = parse(R"(
+        fun plus(a: i32, b: i32) -> i32 = a + b;
+        fun smaller(a: i32, b: i32) -> i32 {
+            if (b < a) {
+                return b;
+            }
+            return a;
+        }
+        fun larger(a: i32, b: i32) -> i32 {
+            if (a < b) {
+                return b;
+            } else {
+                return a;
+            }
+        }
+        fun minus(a: i32, b: i32) -> i32 = a - b;
+        fun main() {
+            val xs = [4, 9, 2, 7];
+            val total = plus(0, xs...);
+            val least = smaller(100, xs...);
+            val most = larger(xs..., 0);
+            val difference = minus(xs..., 0);
+            return (total * 10000) + (least * 1000) + (most * 100) + difference;
+        }
+    )");
+  REQUIRE(ast != nullptr);
+
+  Compiler compiler;
+  auto bytecode = compiler.compile(dynamic_ast_cast<CompileUnit>(ast));
+  const auto &code = bytecode.functions[static_cast<size_t>(bytecode.findFunction("main"))].code;
+  REQUIRE(std::ranges::count(code, static_cast<uint8_t>(OpCode::FOLD_KERNEL_CALL)) == 3);
+  REQUIRE(std::ranges::count(code, static_cast<uint8_t>(OpCode::FOLD_RIGHT_CALL)) == 1);
+
+  VM vm;
+  auto result = vm.run(bytecode);
+
+  // minus is not lowered and folds from the right: 4 - (9 - (2 - (7 - 0))).
+  REQUIRE(result_i32(result) == 22 * 10000 + 2 * 1000 + 9 * 100 - 10);
+
+  destroyast(ast);
+}
+
 TEST_CASE("compiler and vm should alias heap object bindings from new", "[OrgasmTest][RefMove]")
 {
   auto ast = parse(R"(
@@ -2146,3 +2496,37 @@ TEST_CASE("vm should throw on PUSH_BOOL with truncated operand", "[OrgasmTest][V
   VM vm;
   REQUIRE_THROWS_AS(vm.run(module), RuntimeException);
 }
+
+TEST_CASE("repl session should keep definitions and globals between inputs", "[OrgasmTest][Repl]")
+{
+  Map<Str, Str> files;
+
+  ReplSession session{{}, {"writeFile"}};
+  session.vm().register_native_raw("writeFile", [&files](const Vec<RuntimeRef<StorageCell>> &args) -> RuntimeRef<StorageCell> {
+    files[runtime_string_value(args.at(0))] = runtime_string_value(args.at(1));
+    return unit_cell();
+  });
+
+  session.evaluate(parse("val greeting = \"hello\";"));
+  session.evaluate(parse("fun greet(name: string) -> string { return greeting + \", \" + name; }"));
+  session.evaluate(parse("writeFile(\"memory://first\", greet(\"repl\"));"));
+
+  REQUIRE_THROWS_AS(session.evaluate(parse("val again = missing;")), TypeCheckingException);
+  REQUIRE_FALSE(session.types().contains("again"));
+
+  // The compiler rejects typeof outside type queries after the type checker accepted it.
+  REQUIRE_THROWS_AS(session.evaluate(parse("val kind = typeof(1);")), RuntimeException);
+  REQUIRE_FALSE(session.types().contains("kind"));
+  REQUIRE_THROWS_AS(session.evaluate(parse("val kindName = kind;")), TypeCheckingException);
+
+  REQUIRE_THROWS_AS(session.evaluate(parse("val items = [1, 2];\nval third = items[2];")), RuntimeException);
+  REQUIRE_FALSE(session.types().contains("items"));
+  REQUIRE_FALSE(session.types().contains("third"));
+  REQUIRE_THROWS_AS(session.evaluate(parse("val copy = third;")), TypeCheckingException);
+
+  session.evaluate(parse("val again = greet(\"again\");"));
+  session.evaluate(parse("writeFile(\"memory://second\", again);"));
+
+  REQUIRE(files.at("memory://first") == "hello, repl");
+  REQUIRE(files.at("memory://second") == "hello, again");
+}
@@ -104,3 +104,11 @@ TEST_CASE("Orgasm example 56.stdlib_modules.ng", "[OrgasmExample]") { runOrgasmE
 TEST_CASE("Orgasm example 57.ranges_slicing_pipeline.ng", "[OrgasmExample]") { runOrgasmExample("example/57.ranges_slicing_pipeline.ng"); }
 TEST_CASE("Orgasm example 58.fold_expressions.ng", "[OrgasmExample]") { runOrgasmExample("example/58.fold_expressions.ng"); }
 TEST_CASE("Orgasm example 59.std_list_sequence.ng", "[OrgasmExample]") { runOrgasmExample("example/59.std_list_sequence.ng"); }
+TEST_CASE("Orgasm example 60.array_kernels.ng", "[OrgasmExample]") { runOrgasmExample("example/60.array_kernels.ng"); }
+TEST_CASE("Orgasm example 61.hash_collections.ng", "[OrgasmExample]") { runOrgasmExample("example/61.hash_collections.ng"); }
+TEST_CASE("Orgasm example 62.ordered_collections.ng", "[OrgasmExample]") { runOrgasmExample("example/62.ordered_collections.ng"); }
+TEST_CASE("Orgasm example 63.sorting.ng", "[OrgasmExample]") { runOrgasmExample("example/63.sorting.ng"); }
+TEST_CASE("Orgasm example 64.list_deque.ng", "[OrgasmExample]") { runOrgasmExample("example/64.list_deque.ng"); }
+TEST_CASE("Orgasm example 65.string_builder.ng", "[OrgasmExample]") { runOrgasmExample("example/65.string_builder.ng"); }
+TEST_CASE("Orgasm example 66.text_slices.ng", "[OrgasmExample]") { runOrgasmExample("example/66.text_slices.ng"); }
+TEST_CASE("Orgasm example 67.regex.ng", "[OrgasmExample]") { runOrgasmExample("example/67.regex.ng"); }
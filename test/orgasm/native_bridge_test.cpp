@@ -26,6 +26,7 @@ TEST_CASE("native bridge converts primitive values", "[OrgasmTest][NativeBridge]
   REQUIRE(from_ng<double>(to_ng(2.5)) == 2.5);
   REQUIRE(from_ng<bool>(to_ng(true)));
   REQUIRE(from_ng<Str>(to_ng("ng")) == "ng");
+  REQUIRE(runtime_string_value(to_ng(std::string_view{"view"})) == "view");
 
   Str moved = "moved";
   REQUIRE(runtime_string_value(to_ng(std::move(moved))) == "moved");
@@ -47,6 +48,14 @@ TEST_CASE("native bridge wraps lambdas and void returns", "[OrgasmTest][NativeBr
   auto greeting = greet({to_ng("ng"), to_ng(true)});
   REQUIRE(runtime_string_value(greeting) == "ng!");
 
+  auto text = to_ng("borrowed text");
+  auto borrowed = wrap_native([&text](std::string_view value) -> bool {
+    return value.data() == runtime_string_view(text).data();
+  });
+  REQUIRE(runtime_value_bool(borrowed({text})));
+  auto trimmed = wrap_native([](std::string_view value) -> std::string_view { return value.substr(0, 8); });
+  REQUIRE(runtime_string_value(trimmed({text})) == "borrowed");
+
   bool called = false;
   auto mark = wrap_native([&called]() { called = true; });
   auto unit = mark({});
@@ -191,4 +191,41 @@ TEST_CASE("accept should give descriptive error at EOF", "[ParserTest][Error]")
 {
   // Previously threw generic "Error: end of file" instead of descriptive parse error
   parseInvalid("fun foo() { return", "Unexpected end of file");
-}
\ No newline at end of file
+}
+
+TEST_CASE("streaming parse should match eager parse", "[ParserTest][Streaming]")
+{
+  Str source = R"(
+        type Pair<T> { property left: T; property right: T; }
+        val table = [1, 2, 3, 4, 5, 6, 7, 8];
+        fun first(p: Pair<Pair<i32>>) -> i32 { return p.left.left; }
+    )";
+  auto eager = parse(source);
+  auto streamed = Parser(ParseState(std::make_shared<Lexer>(LexState::borrowing(source)))).parse("[noname]");
+  REQUIRE(eager != nullptr);
+  REQUIRE(streamed != nullptr);
+  REQUIRE(eager->repr() == streamed->repr());
+  destroyast(eager);
+  destroyast(streamed);
+}
+
+TEST_CASE("streaming parse state should revert within the committed window", "[ParserTest][Streaming]")
+{
+  Str source = "val a = 1; val b = 2;";
+  ParseState state{std::make_shared<Lexer>(LexState::borrowing(source))};
+
+  state.next(3);
+  REQUIRE(state->repr == "1");
+  state.revert(1);
+  REQUIRE(state->repr == "a");
+
+  state.next(4);
+  REQUIRE(state->type == TokenType::KEYWORD_VAL);
+  state.commit();
+  REQUIRE(state.tokens.size() == 1);
+  REQUIRE_THROWS_AS(state.revert(0), ParseException);
+
+  state.next(5);
+  REQUIRE(state.eof());
+  REQUIRE(state.lastToken.type == TokenType::SEMICOLON);
+}
@@ -163,6 +163,24 @@ TEST_CASE("array and string header layouts describe dynamic payload headers", "[
   REQUIRE(stringLayout.containsPointers);
 }
 
+TEST_CASE("packed array layouts use the element stride", "[RuntimeTest][BufferRuntime]")
+{
+  auto element = TypeLayout{.name = "i16", .kind = LayoutKind::INLINE_VALUE, .size = 2, .alignment = 2};
+  auto layout = make_packed_array_layout(element);
+
+  REQUIRE(layout.name == "Array.packed");
+  REQUIRE(layout.kind == LayoutKind::DYNAMIC);
+  REQUIRE(layout.size == 2);
+  REQUIRE(layout.alignment == 2);
+  REQUIRE_FALSE(layout.containsPointers);
+  REQUIRE(layout.triviallyCopyable);
+
+  auto *field = packed_array_element_field(layout);
+  REQUIRE(field != nullptr);
+  REQUIRE(field->name == "i16");
+  REQUIRE(packed_array_element_field(make_array_header_layout()) == nullptr);
+}
+
 TEST_CASE("heap store allocates typed array and string headers", "[RuntimeTest][BufferRuntime]")
 {
   HeapStore heap;
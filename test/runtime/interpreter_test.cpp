@@ -1071,3 +1071,22 @@ TEST_CASE("interpreter const if should keep decisions through nested generic cal
   delete intp;
   destroyast(ast);
 }
+
+TEST_CASE("interpreter should keep a local reachable after a by-value member call", "[InterpreterTest]")
+{
+  interpret(R"(
+        type Counter {
+            count: i32;
+            fun read(self: Self) -> i32 {
+                return self.count;
+            }
+        }
+        fun main() -> i32 {
+            val counter = *new Counter { count: 3 };
+            val first = counter.read();
+            counter.count := counter.count + first;
+            return counter.read();
+        }
+        assert(main() == 6);
+        )");
+}
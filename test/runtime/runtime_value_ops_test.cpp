@@ -1,15 +1,24 @@
 #include "../test.hpp"
 #include <intp/runtime.hpp>
 #include <intp/runtime_numerals.hpp>
+#include <runtime/array_kernels.hpp>
 #include <runtime/array_layout_access.hpp>
+#include <runtime/btree.hpp>
+#include <runtime/chunk_list.hpp>
+#include <runtime/hash_table.hpp>
 #include <runtime/index_layout_access.hpp>
 #include <runtime/native_marshaling.hpp>
+#include <runtime/regex.hpp>
 #include <runtime/struct_layout_access.hpp>
 #include <runtime/string_layout_access.hpp>
+#include <runtime/text_slices.hpp>
 #include <runtime/tuple_layout_access.hpp>
 #include <runtime/value_access.hpp>
 #include <runtime/value_ops.hpp>
 
+#include <filesystem>
+#include <fstream>
+
 using namespace NG::runtime;
 using namespace NG::runtime::native;
 using namespace NG::runtime::ops;
@@ -735,6 +744,418 @@ TEST_CASE("array layout access reads and writes indexed elements", "[RuntimeTest
   REQUIRE(read_inline_cell_bytes<int32_t>(slotted) == 12);
 }
 
+TEST_CASE("primitive arrays pack their elements into contiguous bytes", "[RuntimeTest][LayoutObjects]")
+{
+  auto array = make_runtime_array_cell({numeral_cell_from_value<int32_t>(1), numeral_cell_from_value<int32_t>(2),
+                                        numeral_cell_from_value<int32_t>(3)});
+  REQUIRE(runtime_array_is_packed(array));
+  REQUIRE(array->opaqueRefs.empty());
+  REQUIRE(array->bytes.size() == 3 * sizeof(int32_t));
+  REQUIRE(array->layout.name == "Array.packed");
+  REQUIRE(array->layout.size == sizeof(int32_t));
+  REQUIRE(runtime_value_show(array) == "[1, 2, 3]");
+
+  runtime_index_write(array, numeral_cell_from_value<int32_t>(1), numeral_cell_from_value<int32_t>(20));
+  REQUIRE(runtime_array_is_packed(array));
+  REQUIRE(read_inline_cell_bytes<int32_t>(runtime_index_read(array, numeral_cell_from_value<int32_t>(1))) == 20);
+  REQUIRE(read_inline_cell_bytes<int32_t>(runtime_index_read(array, make_runtime_from_end_index(1))) == 3);
+
+  auto copy = clone_runtime_storage_cell(array);
+  REQUIRE(runtime_array_is_packed(copy));
+  REQUIRE(value_equals(copy, array));
+
+  auto mixed = make_runtime_array_cell({numeral_cell_from_value<int32_t>(1), numeral_cell_from_value<int64_t>(2)});
+  REQUIRE_FALSE(runtime_array_is_packed(mixed));
+  REQUIRE(runtime_array_length(mixed) == 2);
+
+  // A write of another type and an element reference both fall back to element slots.
+  array_write_element(copy, 0, numeral_cell_from_value<int64_t>(7));
+  REQUIRE_FALSE(runtime_array_is_packed(copy));
+  REQUIRE(runtime_value_show(copy) == "[7, 20, 3]");
+
+  auto slot = array_element_slot(array, 2);
+  REQUIRE_FALSE(runtime_array_is_packed(array));
+  runtime_copy_storage_cell(slot, numeral_cell_from_value<int32_t>(30));
+  REQUIRE(runtime_value_show(array) == "[1, 20, 30]");
+}
+
+TEST_CASE("array kernels agree across SIMD levels", "[RuntimeTest][ArrayKernels]")
+{
+  using namespace NG::runtime::kernels;
+  using NG::System::Cpu::SimdLevel;
+
+  Vec<RuntimeRef<StorageCell>> ints;
+  Vec<RuntimeRef<StorageCell>> floats;
+  for (int32_t i = 0; i < 37; ++i)
+  {
+    ints.push_back(numeral_cell_from_value<int32_t>((i * 7) % 23 - 11));
+    floats.push_back(numeral_cell_from_value<double>(0.1 * i));
+  }
+  auto xs = make_runtime_array_cell(ints);
+  auto fs = make_runtime_array_cell(floats);
+  auto threshold = array_fill(xs, numeral_cell_from_value<int32_t>(0));
+
+  Vec<Str> results;
+  for (auto level : {SimdLevel::Scalar, SimdLevel::Sse2, SimdLevel::Avx2})
+  {
+    set_simd_level(level);
+    results.push_back(runtime_value_show(array_sum(xs)) + " " + runtime_value_show(array_min(xs)) + " " +
+                      runtime_value_show(array_max(xs)) + " " + runtime_value_show(array_dot(xs, xs)) + " " +
+                      runtime_value_show(array_sum(fs)) + " " + std::to_string(array_index_of(xs, ints[20])) + " " +
+                      std::to_string(array_count(xs, numeral_cell_from_value<int32_t>(-11))) + " " +
+                      runtime_value_show(array_prefix_sum(xs)) + " " +
+                      runtime_value_show(array_compare(xs, threshold, Comparison::Less)));
+  }
+  set_simd_level(NG::System::Cpu::detected_simd_level());
+
+  REQUIRE(results[0] == results[1]);
+  REQUIRE(results[0] == results[2]);
+  REQUIRE(read_inline_cell_bytes<int32_t>(array_sum(xs)) == 0);
+  REQUIRE(array_count(xs, numeral_cell_from_value<int32_t>(-11)) == 2);
+  REQUIRE(read_inline_cell_bytes<int32_t>(array_min(xs)) == -11);
+  REQUIRE(read_inline_cell_bytes<int32_t>(array_max(xs)) == 11);
+  REQUIRE(array_index_of(xs, numeral_cell_from_value<int32_t>(100)) == -1);
+  REQUIRE(runtime_array_is_packed(array_scale(xs, numeral_cell_from_value<int32_t>(3))));
+  REQUIRE(runtime_value_show(array_add(make_runtime_array_cell({numeral_cell_from_value<uint8_t>(200)}),
+                                       make_runtime_array_cell({numeral_cell_from_value<uint8_t>(100)}))) == "[44]");
+
+  auto extremes = make_runtime_array_cell({numeral_cell_from_value<int32_t>(std::numeric_limits<int32_t>::max()),
+                                           numeral_cell_from_value<int32_t>(1)});
+  REQUIRE_THROWS_AS(array_sum(extremes), RuntimeException);
+  REQUIRE_THROWS_AS(array_scale(extremes, numeral_cell_from_value<int32_t>(2)), RuntimeException);
+  REQUIRE_THROWS_AS(array_dot(xs, extremes), RuntimeException);
+  REQUIRE_THROWS_AS(array_min(make_runtime_array_cell({})), RuntimeException);
+  REQUIRE_THROWS_AS(array_sum(make_runtime_array_cell({make_runtime_string("no")})), RuntimeException);
+  REQUIRE(read_inline_cell_bytes<int32_t>(array_sum(make_runtime_array_cell({}))) == 0);
+
+  auto seed = numeral_cell_from_value<int32_t>(std::numeric_limits<int32_t>::max());
+  auto offsets = make_runtime_array_cell({numeral_cell_from_value<int32_t>(-1), numeral_cell_from_value<int32_t>(1)});
+  // Mixed signs keep the fold order: left to right stays in range, right to left overflows on its first step.
+  REQUIRE(read_inline_cell_bytes<int32_t>(fold_with_kernel(FoldKernel::Sum, seed, offsets, false)) ==
+          std::numeric_limits<int32_t>::max());
+  REQUIRE_THROWS_AS(fold_with_kernel(FoldKernel::Sum, seed, offsets, true), RuntimeException);
+  REQUIRE(read_inline_cell_bytes<int32_t>(fold_with_kernel(FoldKernel::Min, numeral_cell_from_value<int32_t>(0), xs,
+                                                           false)) == -11);
+  REQUIRE(fold_with_kernel(FoldKernel::Min, numeral_cell_from_value<double>(0), fs, false) == nullptr);
+  REQUIRE(fold_with_kernel(FoldKernel::Sum, numeral_cell_from_value<int64_t>(0), xs, false) == nullptr);
+}
+
+TEST_CASE("array sorts agree between radix, comparison and generic paths", "[RuntimeTest][ArrayKernels]")
+{
+  using namespace NG::runtime::kernels;
+
+  // 500 elements take the radix path, the first 40 the comparison path.
+  Vec<RuntimeRef<StorageCell>> ints;
+  Vec<int64_t> expected;
+  for (int64_t i = 0; i < 500; ++i)
+  {
+    auto value = (i * 7919) % 1009 - 504 + (i % 3 == 0 ? std::numeric_limits<int32_t>::min() / 2 : 0);
+    ints.push_back(numeral_cell_from_value<int64_t>(value));
+    expected.push_back(value);
+  }
+  std::ranges::sort(expected);
+  auto sorted = array_sort(make_runtime_array_cell(ints), false);
+  REQUIRE(runtime_array_is_packed(sorted));
+  auto descending = array_sort(make_runtime_array_cell(ints), true, true);
+  for (size_t i = 0; i < expected.size(); ++i)
+  {
+    REQUIRE(read_inline_cell_bytes<int64_t>(runtime_array_slots(sorted)[i]) == expected[i]);
+    REQUIRE(read_inline_cell_bytes<int64_t>(runtime_array_slots(descending)[expected.size() - 1 - i]) == expected[i]);
+  }
+  Vec<RuntimeRef<StorageCell>> few(ints.begin(), ints.begin() + 40);
+  auto fewSorted = runtime_array_slots(array_sort(make_runtime_array_cell(few), false));
+  REQUIRE(std::ranges::is_sorted(fewSorted, {}, [](const auto &cell) { return read_inline_cell_bytes<int64_t>(cell); }));
+
+  auto xs = make_runtime_array_cell(ints);
+  REQUIRE(runtime_value_show(array_partial_sort(xs, 2)) ==
+          "[" + std::to_string(expected[0]) + ", " + std::to_string(expected[1]) + "]");
+  REQUIRE(read_inline_cell_bytes<int64_t>(array_nth_element(xs, 250)) == expected[250]);
+  REQUIRE_THROWS_AS(array_nth_element(xs, 500), RuntimeException);
+  REQUIRE(runtime_value_show(array_sort(make_runtime_array_cell({make_runtime_boolean(true), make_runtime_boolean(false),
+                                                                 make_runtime_boolean(true)}),
+                                        false)) == "[false, true, true]");
+  REQUIRE_THROWS_AS(array_sort(make_runtime_array_cell({numeral_cell_from_value<double>(1.0),
+                                                        numeral_cell_from_value<double>(std::nan(""))}),
+                               false),
+                    RuntimeException);
+
+  // Tuples compare element by element; the stable sorts keep equal keys in their original order.
+  auto pair = [](int32_t key, const char *tag) {
+    return make_runtime_tuple_cell({numeral_cell_from_value<int32_t>(key), make_runtime_string(tag)});
+  };
+  auto pairs = make_runtime_array_cell({pair(2, "b"), pair(1, "z"), pair(2, "a"), pair(1, "c")});
+  REQUIRE(runtime_value_show(array_sort(pairs, false)) == "[(1, c), (1, z), (2, a), (2, b)]");
+  Vec<RuntimeRef<StorageCell>> keys;
+  for (const auto &item : runtime_array_slots(pairs))
+  {
+    keys.push_back(runtime_cell_slot_ref(item, 0));
+  }
+  REQUIRE(runtime_value_show(array_sort_by_keys(pairs, keys)) == "[(1, z), (1, c), (2, b), (2, a)]");
+  size_t comparisons = 0;
+  auto byTag = array_sort_with(pairs, [&](const auto &left, const auto &right) {
+    ++comparisons;
+    return value_less_than(runtime_cell_slot_ref(left, 1), runtime_cell_slot_ref(right, 1));
+  });
+  REQUIRE(runtime_value_show(byTag) == "[(2, a), (2, b), (1, c), (1, z)]");
+  REQUIRE(comparisons <= 5);
+  REQUIRE_THROWS_AS(array_sort(make_runtime_array_cell({make_runtime_string("a"), numeral_cell_from_value<int32_t>(1)}),
+                               true),
+                    RuntimeException);
+}
+
+TEST_CASE("hash tables keep dense entries across growth and removal", "[RuntimeTest][HashTable]")
+{
+  auto map = make_runtime_hash_table_cell(true);
+  for (int32_t i = 0; i < 1000; ++i)
+  {
+    REQUIRE(hash_table_insert(map, numeral_cell_from_value<int32_t>(i), numeral_cell_from_value<int32_t>(i * 2)));
+  }
+  REQUIRE(hash_table_size(map) == 1000);
+  REQUIRE_FALSE(hash_table_insert(map, numeral_cell_from_value<int32_t>(7), numeral_cell_from_value<int32_t>(-7)));
+  REQUIRE(runtime_value_show(hash_table_value(map, *hash_table_find(map, numeral_cell_from_value<int32_t>(7)))) ==
+          "-7");
+
+  for (int32_t i = 0; i < 1000; i += 2)
+  {
+    REQUIRE(hash_table_remove(map, numeral_cell_from_value<int32_t>(i)));
+  }
+  REQUIRE_FALSE(hash_table_remove(map, numeral_cell_from_value<int32_t>(0)));
+  REQUIRE(hash_table_size(map) == 500);
+  for (size_t i = 0; i < hash_table_size(map); ++i)
+  {
+    auto key = hash_table_key(map, i);
+    REQUIRE(read_inline_cell_bytes<int32_t>(key) % 2 == 1);
+    REQUIRE(hash_table_find(map, key) == i);
+  }
+  REQUIRE_FALSE(hash_table_find(map, numeral_cell_from_value<int32_t>(998)).has_value());
+
+  // Keys hash like they compare: 2.0 finds the integer key 2.
+  auto set = make_runtime_hash_table_cell(false);
+  hash_table_insert(set, numeral_cell_from_value<int32_t>(2), nullptr);
+  hash_table_insert(set, make_runtime_string("two"), nullptr);
+  REQUIRE(hash_table_find(set, numeral_cell_from_value<double>(2.0)).has_value());
+  REQUIRE(hash_table_find(set, make_runtime_string("two")).has_value());
+  REQUIRE_THROWS_AS(hash_table_value(set, 0), RuntimeException);
+  REQUIRE_THROWS_AS(hash_table_key(set, 2), RuntimeException);
+
+  auto copy = clone_runtime_storage_cell(set, StorageClass::TEMPORARY);
+  hash_table_insert(copy, numeral_cell_from_value<int32_t>(3), nullptr);
+  REQUIRE(hash_table_size(set) == 2);
+  REQUIRE(hash_table_size(copy) == 3);
+  REQUIRE(runtime_value_show(set) == "{2, two}");
+
+  hash_table_clear(copy);
+  REQUIRE(hash_table_size(copy) == 0);
+  REQUIRE_FALSE(hash_table_find(copy, numeral_cell_from_value<int32_t>(2)).has_value());
+}
+
+TEST_CASE("hash tables hash native keys by their contents", "[RuntimeTest][HashTable]")
+{
+  auto makeSet = [](std::initializer_list<int32_t> items) {
+    auto set = make_runtime_hash_table_cell(false);
+    for (auto item : items)
+    {
+      hash_table_insert(set, numeral_cell_from_value<int32_t>(item), nullptr);
+    }
+    return set;
+  };
+  auto makeList = [](std::initializer_list<int32_t> items) {
+    auto list = make_runtime_chunk_list_cell();
+    for (auto item : items)
+    {
+      chunk_list_push_back(list, numeral_cell_from_value<int32_t>(item));
+    }
+    return list;
+  };
+
+  // Equal tables hash alike whatever order their entries were inserted in.
+  REQUIRE(value_hash(makeSet({1, 2, 3})) == value_hash(makeSet({3, 1, 2})));
+  REQUIRE(value_hash(makeSet({1, 2, 3})) != value_hash(makeSet({1, 2, 4})));
+  REQUIRE(value_hash(makeList({1, 2})) != value_hash(makeList({2, 1})));
+
+  auto tree = make_runtime_btree_cell(true);
+  btree_insert(tree, numeral_cell_from_value<int32_t>(1), make_runtime_string("a"));
+  auto otherTree = clone_runtime_storage_cell(tree, StorageClass::TEMPORARY);
+  REQUIRE(value_hash(tree) == value_hash(otherTree));
+  btree_insert(otherTree, numeral_cell_from_value<int32_t>(1), make_runtime_string("b"));
+  REQUIRE(value_hash(tree) != value_hash(otherTree));
+
+  auto sets = make_runtime_hash_table_cell(false);
+  for (int32_t i = 0; i < 64; ++i)
+  {
+    REQUIRE(hash_table_insert(sets, makeSet({i, i + 1}), nullptr));
+    REQUIRE(hash_table_insert(sets, makeList({i, i + 1}), nullptr));
+  }
+  REQUIRE_FALSE(hash_table_insert(sets, makeSet({11, 10}), nullptr));
+  REQUIRE(hash_table_find(sets, makeList({10, 11})).has_value());
+  REQUIRE_FALSE(hash_table_find(sets, makeList({11, 10})).has_value());
+
+  // A regex only equals itself, so no copy of it could find it again as a key.
+  REQUIRE_THROWS_AS(value_hash(make_runtime_regex_cell("a+")), RuntimeException);
+  REQUIRE_THROWS_AS(hash_table_insert(sets, make_runtime_regex_cell("a+"), nullptr), RuntimeException);
+}
+
+TEST_CASE("btrees keep keys sorted across splits, merges and shared ranges", "[RuntimeTest][BTree]")
+{
+  auto map = make_runtime_btree_cell(true);
+  for (int32_t i = 0; i < 2000; ++i)
+  {
+    auto key = (i * 7919) % 2000;
+    REQUIRE(btree_insert(map, numeral_cell_from_value<int32_t>(key), numeral_cell_from_value<int32_t>(key * 2)));
+  }
+  REQUIRE(btree_size(map) == 2000);
+  REQUIRE_FALSE(btree_insert(map, numeral_cell_from_value<int32_t>(7), numeral_cell_from_value<int32_t>(-7)));
+  REQUIRE(runtime_value_show(btree_value(map, 7)) == "-7");
+  for (size_t i = 0; i < btree_size(map); ++i)
+  {
+    REQUIRE(read_inline_cell_bytes<int32_t>(btree_key(map, i)) == static_cast<int32_t>(i));
+  }
+
+  auto range = make_runtime_btree_range_cell(map, numeral_cell_from_value<int32_t>(100),
+                                             numeral_cell_from_value<int32_t>(110));
+  auto copy = clone_runtime_storage_cell(map, StorageClass::TEMPORARY);
+  for (int32_t i = 0; i < 2000; i += 2)
+  {
+    REQUIRE(btree_remove(map, numeral_cell_from_value<int32_t>(i)));
+  }
+  REQUIRE_FALSE(btree_remove(map, numeral_cell_from_value<int32_t>(0)));
+  REQUIRE(btree_size(map) == 1000);
+  for (size_t i = 0; i < btree_size(map); ++i)
+  {
+    REQUIRE(read_inline_cell_bytes<int32_t>(btree_key(map, i)) == static_cast<int32_t>(2 * i + 1));
+  }
+  REQUIRE(btree_rank(map, numeral_cell_from_value<int32_t>(500)) == 250);
+  REQUIRE_FALSE(btree_find(map, numeral_cell_from_value<int32_t>(500)).has_value());
+
+  // The copy and the range still see the entries from before the removals.
+  REQUIRE(btree_size(copy) == 2000);
+  REQUIRE(btree_range_size(range) == 10);
+  REQUIRE(runtime_value_show(btree_range_key(range, 0)) == "100");
+  REQUIRE(runtime_value_show(btree_range_value(range, 9)) == "218");
+
+  auto set = make_runtime_btree_cell(false);
+  btree_insert(set, make_runtime_tuple_cell({numeral_cell_from_value<int32_t>(1), make_runtime_string("b")}), nullptr);
+  btree_insert(set, make_runtime_tuple_cell({numeral_cell_from_value<int32_t>(1), make_runtime_string("a")}), nullptr);
+  btree_insert(set, make_runtime_tuple_cell({numeral_cell_from_value<int32_t>(0), make_runtime_string("z")}), nullptr);
+  REQUIRE(runtime_value_show(set) == "{(0, z), (1, a), (1, b)}");
+  REQUIRE_THROWS_AS(btree_value(set, 0), RuntimeException);
+  REQUIRE_THROWS_AS(btree_insert(set, make_runtime_string("x"), nullptr), RuntimeException);
+
+  btree_clear(copy);
+  REQUIRE(btree_size(copy) == 0);
+}
+
+TEST_CASE("chunk lists push and pop at both ends across chunks and shared copies", "[RuntimeTest][ChunkList]")
+{
+  auto list = make_runtime_chunk_list_cell();
+  for (int32_t i = 0; i < 500; ++i)
+  {
+    chunk_list_push_back(list, numeral_cell_from_value<int32_t>(i));
+    chunk_list_push_front(list, numeral_cell_from_value<int32_t>(-i - 1));
+  }
+  REQUIRE(chunk_list_size(list) == 1000);
+  for (size_t i = 0; i < chunk_list_size(list); ++i)
+  {
+    REQUIRE(read_inline_cell_bytes<int32_t>(chunk_list_get(list, i)) == static_cast<int32_t>(i) - 500);
+  }
+
+  auto copy = clone_runtime_storage_cell(list, StorageClass::TEMPORARY);
+  for (int32_t i = 0; i < 300; ++i)
+  {
+    REQUIRE(read_inline_cell_bytes<int32_t>(chunk_list_pop_front(list)) == i - 500);
+  }
+  REQUIRE(read_inline_cell_bytes<int32_t>(chunk_list_pop_back(list)) == 499);
+  chunk_list_set(list, 0, numeral_cell_from_value<int32_t>(42));
+  REQUIRE(chunk_list_size(list) == 699);
+  REQUIRE(runtime_value_show(chunk_list_get(list, 0)) == "42");
+  REQUIRE(runtime_value_show(chunk_list_get(list, 698)) == "498");
+
+  // The copy still sees the elements from before the changes.
+  REQUIRE(chunk_list_size(copy) == 1000);
+  REQUIRE(runtime_value_show(chunk_list_get(copy, 0)) == "-500");
+  REQUIRE(runtime_value_show(chunk_list_get(copy, 300)) == "-200");
+  REQUIRE(runtime_value_show(chunk_list_get(copy, 999)) == "499");
+
+  while (chunk_list_size(list) != 0)
+  {
+    chunk_list_pop_back(list);
+  }
+  REQUIRE_THROWS_AS(chunk_list_pop_front(list), RuntimeException);
+  REQUIRE_THROWS_AS(chunk_list_get(copy, 1000), RuntimeException);
+  chunk_list_push_front(list, make_runtime_string("a"));
+  chunk_list_push_back(list, make_runtime_string("b"));
+  REQUIRE(runtime_value_show(list) == "[a, b]");
+
+  chunk_list_clear(copy);
+  REQUIRE(chunk_list_size(copy) == 0);
+}
+
+TEST_CASE("text slices find pieces on demand and read file lines across chunks", "[RuntimeTest][TextSlices]")
+{
+  auto parts = make_runtime_split_slices_cell(make_runtime_string("a,,b,c"), ",");
+  REQUIRE(runtime_value_show(text_slices_get(parts, 1)).empty());
+  REQUIRE(runtime_value_show(text_slices_get(parts, 3)) == "c");
+  REQUIRE(runtime_value_show(text_slices_get(parts, 0)) == "a");
+  REQUIRE(text_slices_size(parts) == 4);
+  REQUIRE_FALSE(text_slices_has(parts, 4));
+  REQUIRE_THROWS_AS(text_slices_get(parts, 4), RuntimeException);
+
+  auto words = make_runtime_token_slices_cell(make_runtime_string("  one\ttwo  three "), " \t");
+  REQUIRE(runtime_value_show(words) == "[one, two, three]");
+
+  auto path = std::filesystem::temp_directory_path() / "ng_text_slices_test.txt";
+  Str longLine(200000, 'x');
+  {
+    std::ofstream file(path, std::ios::binary);
+    file << "first\r\n" << longLine << "\n\nlast";
+  }
+  auto lines = make_runtime_file_lines_cell(path.string());
+  REQUIRE(runtime_value_show(text_slices_get(lines, 0)) == "first");
+  REQUIRE(runtime_value_show(text_slices_get(lines, 1)) == longLine);
+  auto copy = clone_runtime_storage_cell(lines, StorageClass::TEMPORARY);
+  REQUIRE(runtime_value_show(text_slices_get(lines, 3)) == "last");
+  REQUIRE(text_slices_size(lines) == 4);
+  // The copy keeps its own position and reads back from the start.
+  REQUIRE(runtime_value_show(text_slices_get(copy, 0)) == "first");
+  REQUIRE(runtime_value_show(text_slices_get(copy, 2)).empty());
+  std::filesystem::remove(path);
+
+  REQUIRE_THROWS_AS(make_runtime_file_lines_cell(path.string()), RuntimeException);
+}
+
+TEST_CASE("regexes find leftmost matches, captures and replacements in linear time", "[RuntimeTest][Regex]")
+{
+  auto date = make_runtime_regex_cell("(\\d{4})-(\\d\\d)(?:-(\\d\\d))?");
+  REQUIRE(regex_group_count(date) == 3);
+  REQUIRE(regex_matches(date, "due 2024-03-15"));
+  REQUIRE_FALSE(regex_matches(date, "due 24-03"));
+  REQUIRE(regex_search(date, "on 2024-03 and 2025-01-02") == Vec<int64_t>{3, 10, 3, 7, 8, 10, -1, -1});
+  REQUIRE(regex_search(date, "on 2024-03 and 2025-01-02", 4) == Vec<int64_t>{15, 25, 15, 19, 20, 22, 23, 25});
+  REQUIRE(regex_search(date, "none").empty());
+  REQUIRE(regex_replace_all(date, "2024-03-15, 2025-01", "$3.$2.$1$$") == "15.03.2024$, .01.2025$");
+
+  // Leftmost-first: earlier alternatives and greedy or lazy choices win, as with backtracking.
+  REQUIRE(regex_search(make_runtime_regex_cell("a|ab"), "ab") == Vec<int64_t>{0, 1});
+  REQUIRE(regex_search(make_runtime_regex_cell("<.+?>"), "<a><b>") == Vec<int64_t>{0, 3});
+  REQUIRE(regex_search(make_runtime_regex_cell("^\\w+$"), "two words").empty());
+  REQUIRE(regex_search(make_runtime_regex_cell("\\bor\\b"), "word or") == Vec<int64_t>{5, 7});
+  REQUIRE(regex_replace_all(make_runtime_regex_cell("x*"), "abc", "-") == "-a-b-c-");
+  REQUIRE(regex_replace_all(make_runtime_regex_cell("[^a-c\\s]+"), "ab xyz c", "_") == "ab _ c");
+
+  // A pattern that backtracks exponentially stays linear.
+  REQUIRE_FALSE(regex_matches(make_runtime_regex_cell("^(a+)+$"), Str(5000, 'a') + "b"));
+
+  auto matches = make_runtime_regex_slices_cell(make_runtime_string("k1=v1; k2=v2"), make_runtime_regex_cell("\\w+=\\w+"));
+  REQUIRE(runtime_value_show(matches) == "[k1=v1, k2=v2]");
+  REQUIRE(text_slices_size(matches) == 2);
+
+  REQUIRE(regex_match_cached("fun main", "^fun\\s+\\w+$"));
+  REQUIRE(regex_match_cached("fun main", "^fun\\s+\\w+$"));
+  REQUIRE_THROWS_AS(make_runtime_regex_cell("(a"), RuntimeException);
+  REQUIRE_THROWS_AS(make_runtime_regex_cell("a**"), RuntimeException);
+  REQUIRE_THROWS_AS(regex_match_cached("aa", "(a)\\1"), RuntimeException);
+}
+
 TEST_CASE("tuple layout access reads members and indexed elements", "[RuntimeTest][LayoutObjects]")
 {
   auto tuple = make_runtime_tuple_cell({numeral_cell_from_value<int32_t>(7), make_runtime_string("two")});
@@ -775,6 +1196,38 @@ TEST_CASE("string layout access reads code units and header-backed length", "[Ru
   REQUIRE(read_inline_cell_bytes<int32_t>(second) == 50);
 }
 
+TEST_CASE("string concatenation appends in place to the string that ends its buffer", "[RuntimeTest][String]")
+{
+  auto text = make_runtime_string(Str(300, 'a'));
+  for (int i = 0; i < 100; ++i)
+  {
+    text = value_add(text, make_runtime_string("bc"));
+  }
+  REQUIRE(string_length(text) == 500);
+  REQUIRE(text->opaqueRefs.size() == 1);
+  auto buffer = text->opaqueRefs.front();
+
+  // A copy shares the buffer; appending to both keeps each one's own payload.
+  auto copy = clone_runtime_storage_cell(text, StorageClass::TEMPORARY);
+  REQUIRE(copy->opaqueRefs.front() == buffer);
+  auto left = value_add(text, make_runtime_string("x"));
+  auto right = value_add(copy, make_runtime_string("y"));
+  REQUIRE(left->opaqueRefs.front() == buffer);
+  REQUIRE(right->opaqueRefs.front() != buffer);
+  REQUIRE(runtime_string_value(left).substr(498) == "bcx");
+  REQUIRE(runtime_string_value(right).substr(498) == "bcy");
+  REQUIRE(runtime_string_value(text) == runtime_string_value(copy));
+  REQUIRE(value_order(left, right) == Orders::LT);
+
+  auto small = make_runtime_string("ab");
+  runtime_string_reserve(small, 1024);
+  auto grown = value_add(small, make_runtime_string("c"));
+  REQUIRE(grown->opaqueRefs.front() == small->opaqueRefs.front());
+  REQUIRE(runtime_string_value(grown) == "abc");
+  REQUIRE(runtime_string_value(small) == "ab");
+  REQUIRE(runtime_value_show(value_add(make_runtime_string("n="), numeral_cell_from_value<int32_t>(4))) == "n=4");
+}
+
 TEST_CASE("dynamic runtime types expose header layouts", "[RuntimeTest][LayoutObjects]")
 {
   auto arrayType = array_runtime_type();
@@ -791,7 +1244,8 @@ TEST_CASE("dynamic runtime types expose header layouts", "[RuntimeTest][LayoutOb
 
 TEST_CASE("array and string runtime values sync header cells", "[RuntimeTest][LayoutObjects]")
 {
-  auto array = make_runtime_array_cell({numeral_cell_from_value<int32_t>(1), numeral_cell_from_value<int32_t>(2)});
+  // Primitive elements would be packed; strings keep the slot-backed header layout.
+  auto array = make_runtime_array_cell({make_runtime_string("one"), make_runtime_string("two")});
   auto string = make_runtime_string("hello");
 
   const auto &arrayLayout = array->layout;
@@ -808,7 +1262,7 @@ TEST_CASE("array and string runtime values sync header cells", "[RuntimeTest][La
   REQUIRE(runtime_string_value(string) == "hello");
 
   auto appended =
-      value_lshift(array, numeral_cell_from_value<int32_t>(3));
+      value_lshift(array, make_runtime_string("three"));
   string = make_runtime_string("hello!");
 
   REQUIRE(runtime_is_array_value(appended));
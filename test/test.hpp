@@ -9,6 +9,7 @@
 #include <parser.hpp>
 #include <token.hpp>
 
+#include <cstdlib>
 #include <format>
 
 using namespace NG;
@@ -47,4 +48,44 @@ inline ASTRef<ASTNode> parse(const Str &source, const Str &moduleName = "[noname
 inline ASTRef<ASTNode> parseInvalid(const Str &source, const Str &errMsg)
 {
   return parse(source, "[noname]", errMsg);
-}
\ No newline at end of file
+}
+
+/**
+ * Sets an environment variable for the lifetime of the object and restores its previous value.
+ */
+struct ScopedEnvVar
+{
+  Str name;
+  Str previous;
+  bool hadPrevious = false;
+
+  ScopedEnvVar(Str name, const Str &value) : name(std::move(name))
+  {
+    if (const char *existing = std::getenv(this->name.c_str()))
+    {
+      previous = existing;
+      hadPrevious = true;
+    }
+#ifdef _WIN32
+    _putenv_s(this->name.c_str(), value.c_str());
+#else
+    setenv(this->name.c_str(), value.c_str(), 1);
+#endif
+  }
+
+  ~ScopedEnvVar()
+  {
+#ifdef _WIN32
+    _putenv_s(name.c_str(), hadPrevious ? previous.c_str() : "");
+#else
+    if (hadPrevious)
+    {
+      setenv(name.c_str(), previous.c_str(), 1);
+    }
+    else
+    {
+      unsetenv(name.c_str());
+    }
+#endif
+  }
+};
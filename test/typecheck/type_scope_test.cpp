@@ -0,0 +1,78 @@
+#include "typecheck_utils.hpp"
+#include <typecheck/type_scope.hpp>
+
+namespace
+{
+  auto visibleNames(const TypeScope &scope) -> Set<Str>
+  {
+    Set<Str> names;
+    for (const auto &[name, _] : scope)
+    {
+      REQUIRE(names.insert(name).second);
+    }
+    return names;
+  }
+} // namespace
+
+TEST_CASE("TypeScope child scopes should not leak into their parent", "[TypeCheck][TypeScope]")
+{
+  auto i32 = makecheck<PrimitiveType>(typeinfo_tag::I32);
+  auto str = makecheck<PrimitiveType>(typeinfo_tag::STRING);
+  TypeScope global{Map<Str, CheckingRef<TypeInfo>>{{"x", i32}, {"y", i32}}};
+
+  TypeScope block = global;
+  REQUIRE(block.depth() == 1);
+  block.insert_or_assign("x", str);
+  block["z"] = str;
+  REQUIRE(block.depth() == 2);
+
+  REQUIRE(block.find("x")->second == str);
+  REQUIRE(block.find("y")->second == i32);
+  REQUIRE(global.find("x")->second == i32);
+  REQUIRE_FALSE(global.contains("z"));
+  REQUIRE(visibleNames(block) == Set<Str>{"x", "y", "z"});
+  REQUIRE(visibleNames(global) == Set<Str>{"x", "y"});
+
+  // Reading through operator[] copies the outer binding into the scope without changing the outer one.
+  REQUIRE(block["y"] == i32);
+  block["y"] = str;
+  REQUIRE(global.find("y")->second == i32);
+}
+
+TEST_CASE("TypeScope should write in place while it owns its innermost frame", "[TypeCheck][TypeScope]")
+{
+  TypeScope scope;
+  REQUIRE(scope.find("x") == scope.end());
+  scope["x"] = makecheck<PrimitiveType>(typeinfo_tag::I32);
+  scope.insert_or_assign("y", makecheck<PrimitiveType>(typeinfo_tag::BOOL));
+  REQUIRE(scope.depth() == 1);
+
+  {
+    TypeScope snapshot = scope;
+    scope.insert_or_assign("z", makecheck<PrimitiveType>(typeinfo_tag::BOOL));
+    REQUIRE(scope.depth() == 2);
+    REQUIRE_FALSE(snapshot.contains("z"));
+  }
+  scope.insert_or_assign("w", makecheck<PrimitiveType>(typeinfo_tag::BOOL));
+  REQUIRE(scope.depth() == 2);
+  REQUIRE(visibleNames(scope) == Set<Str>{"x", "y", "z", "w"});
+}
+
+TEST_CASE("TypeScope should squash long chains without changing bindings", "[TypeCheck][TypeScope]")
+{
+  TypeScope scope{Map<Str, CheckingRef<TypeInfo>>{{"root", makecheck<PrimitiveType>(typeinfo_tag::UNIT)}}};
+  Vec<TypeScope> snapshots;
+  for (int i = 0; i < 100; ++i)
+  {
+    snapshots.push_back(scope);
+    scope.insert_or_assign("v" + std::to_string(i % 10), makecheck<PrimitiveType>(typeinfo_tag::I32));
+    scope.insert_or_assign("last", makecheck<ConstValueType>(std::to_string(i)));
+  }
+
+  REQUIRE(scope.depth() <= 33);
+  REQUIRE(visibleNames(scope).size() == 12);
+  REQUIRE(scope.find("last")->second->repr() == "99");
+  REQUIRE(snapshots[50].find("last")->second->repr() == "49");
+  REQUIRE_FALSE(snapshots[5].contains("v5"));
+  REQUIRE(scope.flatten().size() == 12);
+}
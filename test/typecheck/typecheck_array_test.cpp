@@ -232,3 +232,27 @@ TEST_CASE("range expressions and slice syntax replace legacy std.array helpers",
   typecheck_failure("val xs = range(0, 3);", "Unknown type for object: range");
   typecheck_failure("val xs = [1, 2, 3]; val ys = slice(xs, 0, 2);", "Unknown type for object: slice");
 }
+
+TEST_CASE("should type check growable vector members", "[TypeCheck][Array]")
+{
+  auto ast = parse(R"(
+            val xs: i32 vector = [1, 2];
+            xs.reserve(8);
+            xs.push(3);
+            xs.insert(0, 4);
+            val last = xs.pop();
+            val capacity = xs.capacity();
+            xs.truncate(1);
+            xs.clear();
+        )");
+
+  REQUIRE(ast != nullptr);
+  auto index = type_check(ast);
+  check_type_tag(*index["last"], typeinfo_tag::I32);
+  check_type_tag(*index["capacity"], typeinfo_tag::U32);
+  destroyast(ast);
+
+  typecheck_failure("val xs: i32 vector = [1]; xs.push(\"two\");", "Invalid argument types for vector member push");
+  typecheck_failure("val xs: i32 vector = [1]; xs.insert(0);", "Invalid argument types for vector member insert");
+  typecheck_failure("val xs: i32 vector = [1]; val view = ref xs; xs.push(2);", "Cannot assign borrowed place");
+}
@@ -154,3 +154,54 @@ TEST_CASE("should fail on function body type-checking", "[Function][TypeCheck][F
   typecheck_failure("fun f(x: int) -> int { if(true) {return 1;} return false; }",
                     "Mismatched return types in compound statement");
 }
+
+TEST_CASE("function bodies checked in parallel should match a serial check", "[Function][TypeCheck][Parallel]")
+{
+  Str source = R"(
+    fun id<T>(x: T) -> T = x;
+    fun twice<T>(x: T) -> T = id(id(x));
+    type Counter { count: int; }
+    trait Show { fun show(self: ref<Self>) -> int; }
+    impl Show for Counter { fun show(self: ref<Self>) -> int { return id(self.count); } }
+  )";
+  for (int i = 0; i < 24; ++i)
+  {
+    auto n = std::to_string(i);
+    source += i % 3 == 0   ? "fun check" + n + "(x: int) -> int { return id(x) + " + n + "; }\n"
+              : i % 3 == 1 ? "fun check" + n + "(b: bool) -> bool = twice(b);\n"
+                           : "fun check" + n + "(c: Counter) -> int = twice(c.count);\n";
+  }
+
+  auto checkWith = [&](const char *jobs, const Str &extra) {
+    ScopedEnvVar scopedJobs{"NG_JOBS", jobs};
+    auto ast = parse(source + extra);
+    REQUIRE(ast != nullptr);
+    Vec<Str> names;
+    Str error;
+    try
+    {
+      auto index = type_check(ast);
+      REQUIRE(index["check23"]->repr() == "fun (Counter) -> i32");
+      for (const auto &instance : generic_function_instances())
+      {
+        names.push_back(instance->instanceName);
+      }
+    }
+    catch (TypeCheckingException &ex)
+    {
+      error = ex.what();
+    }
+    destroyast(ast);
+    return std::make_pair(names, error);
+  };
+
+  auto serial = checkWith("1", "");
+  REQUIRE(serial.first == Vec<Str>{"id<i32>", "twice<bool>", "id<bool>", "twice<i32>"});
+  REQUIRE(checkWith("4", "") == serial);
+
+  // The first failing body in declaration order is reported, whichever worker finishes first.
+  auto failing = "fun g1() -> bool { return 1; }\nfun g2() -> int { return true; }\n";
+  auto serialError = checkWith("1", failing).second;
+  REQUIRE_THAT(serialError, ContainsSubstring("i32 to bool"));
+  REQUIRE(checkWith("4", failing).second == serialError);
+}
@@ -1,5 +1,6 @@
 #include "typecheck_utils.hpp"
 #include <module.hpp>
+#include <typecheck/overload_resolver.hpp>
 
 TEST_CASE("generic function definition should type check", "[TypeCheck][Generic]")
 {
@@ -95,6 +96,111 @@ TEST_CASE("generic function mangling uses definition module and module-qualified
   destroyast(ast);
 }
 
+TEST_CASE("generic function instances should be checked once and recorded for the compiler",
+          "[TypeCheck][Generic][Instances]")
+{
+  auto instanceNames = [] {
+    Vec<Str> names;
+    for (const auto &instance : generic_function_instances())
+    {
+      names.push_back(instance->instanceName);
+    }
+    return names;
+  };
+
+  auto ast = parse(R"(
+    fun id<T>(x: T) -> T = x;
+    fun twice<T>(x: T) -> T = id(id(x));
+    val a = twice(1);
+    val b = twice(2);
+    val c = id(true);
+  )");
+
+  REQUIRE(ast != nullptr);
+  auto index = type_check(ast);
+  REQUIRE(instanceNames() == Vec<Str>{"twice<i32>", "id<i32>", "id<bool>"});
+
+  auto &twice = static_cast<GenericDefType &>(*index["twice"]);
+  REQUIRE(twice.instances.size() == 1);
+  REQUIRE(twice.instantiations.size() == 1);
+  auto instance = twice.instances.at("twice<i32>");
+  REQUIRE(twice.instantiations.begin()->second.instance == instance);
+  REQUIRE(instance->returnType->repr() == "i32");
+  REQUIRE(instance->uses.size() >= 1);
+  REQUIRE(instance->uses.front()->instanceName == "id<i32>");
+
+  // A later check reusing the definitions replays the instances the cached body needs.
+  auto next = parse(R"(
+    val d = twice(3);
+  )");
+  REQUIRE(next != nullptr);
+  type_check(next, index);
+  REQUIRE(instanceNames() == Vec<Str>{"twice<i32>", "id<i32>"});
+  REQUIRE(twice.instances.size() == 1);
+
+  destroyast(next);
+  destroyast(ast);
+}
+
+TEST_CASE("generic instance cache should stay correct across checks sharing its definitions",
+          "[TypeCheck][Generic][Instances]")
+{
+  auto prelude = parse(R"(
+    trait Show {
+      fun show(self: ref<Self>) -> string;
+    }
+
+    type Plain {
+      property value: i32;
+    }
+
+    fun id<T>(x: T) -> T = x;
+    fun render<T: Show>(x: T) -> T = x;
+  )");
+  REQUIRE(prelude != nullptr);
+  auto index = type_check(prelude);
+
+  // Each check declares its own Cell, so types from an earlier check may be freed and their addresses reused.
+  for (int round = 0; round < 16; ++round)
+  {
+    auto fieldType = round % 2 == 0 ? Str{"i32"} : Str{"bool"};
+    auto fieldValue = round % 2 == 0 ? Str{"1"} : Str{"true"};
+    auto next = parse("type Cell { property value: " + fieldType + "; }\n" +
+                      "val v = id(new Cell { value: " + fieldValue + " }).value;\n");
+    REQUIRE(next != nullptr);
+    auto checked = type_check(next, index);
+    REQUIRE(checked["v"]->repr() == fieldType);
+    destroyast(next);
+  }
+
+  auto implemented = parse(R"(
+    impl Show for Plain {
+      fun show(self: ref<Self>) -> string {
+        return "plain";
+      }
+    }
+
+    val shown = render(new Plain { value: 1 });
+  )");
+  REQUIRE(implemented != nullptr);
+  type_check(implemented, index);
+
+  // The bound is resolved in the calling program, so the cached render<Plain> must be checked again.
+  auto missing = parse(R"(
+    trait Show {
+      fun describe(self: ref<Self>) -> string;
+    }
+
+    val shown = render(new Plain { value: 1 });
+  )");
+  REQUIRE(missing != nullptr);
+  REQUIRE_THROWS_AS(type_check(missing, index), TypeCheckingException);
+
+  destroyast(missing);
+  destroyast(implemented);
+  destroyast(prelude);
+}
+
 TEST_CASE("generic function with multiple type params", "[TypeCheck][Generic]")
 {
   auto ast = parse(R"(
@@ -534,6 +640,42 @@ TEST_CASE("deleted primary type alias should reject matching type use",
   )", "deleted");
 }
 
+TEST_CASE("generic overloads should be bucketed by arity and first parameter type constructor",
+          "[TypeCheck][Generic][Overload]")
+{
+  auto ast = parse(R"(
+    type Box<T> {
+      property value: T;
+    }
+
+    fun<T> describe(value: T) -> i32 = 0;
+    fun<T> describe(value: Box<T>) -> string = "box";
+    fun<T> describe(value: ref<T>) -> bool = true;
+    fun<T> describe(value: T, extra: i32) -> i32 = extra;
+
+    val box: Box<bool> = unit;
+    val plain = describe(1);
+    val boxed = describe(box);
+    val pair = describe(1, 2);
+  )");
+  REQUIRE(ast != nullptr);
+
+  auto index = type_check(ast);
+  check_type_tag(*index["plain"], typeinfo_tag::I32);
+  check_type_tag(*index["boxed"], typeinfo_tag::STRING);
+  check_type_tag(*index["pair"], typeinfo_tag::I32);
+
+  auto &describe = static_cast<GenericDefType &>(*index["describe"]);
+  REQUIRE(describe.overloadBuckets.indexed == 4);
+  REQUIRE(describe.overloadBuckets.byArity.at(1).size() == 3);
+  REQUIRE(describe.overloadBuckets.byArity.at(2).at("").size() == 1);
+  REQUIRE(genericOverloadCandidates(describe, {PrimitiveType::from("i32")}).size() == 1);
+  REQUIRE(genericOverloadCandidates(describe, {index["box"]}).size() == 2);
+  REQUIRE(describe.selectedOverloads.size() == 3);
+
+  destroyast(ast);
+}
+
 TEST_CASE("deleted generic function overload should reject exact matching calls",
           "[TypeCheck][Generic][Delete][Failure]")
 {
@@ -1607,3 +1749,54 @@ TEST_CASE("const generic arguments should reject type values and missing array l
     val bad: array<i32> = [1];
   )", "Fixed array type expects 2 generic arguments");
 }
+
+TEST_CASE("generic inference should bind parameters named in a generic field's instance name",
+          "[TypeCheck][Generic]")
+{
+  auto ast = parse(R"(
+    type Holder<A, B> {
+      first: A;
+      second: B;
+    }
+    fun secondOf<A, B>(holder: ref<Holder<A, B>>) -> B {
+      return holder.second;
+    }
+    type Wrapper<K, V> {
+      inner: Holder<K, V>;
+
+      fun entry(self: ref<Self>) -> (K, V) {
+        return (self.inner.first, secondOf(ref self.inner));
+      }
+    }
+    val wrapper = new Wrapper<string, i32> { inner: *new Holder<string, i32> { first: "one", second: 1 } };
+    val entry: (string, i32) = wrapper.entry();
+  )");
+  REQUIRE(ast != nullptr);
+
+  REQUIRE_NOTHROW(type_check(ast));
+
+  destroyast(ast);
+}
+
+TEST_CASE("generic inference should read primitive instance arguments when a module shadows their name",
+          "[TypeCheck][Generic][Module]")
+{
+  auto preludeTypes = NG::typecheck::build_prelude_type_index();
+  auto ast = parse(R"(
+    import "std.string" (*);
+    type Pair<K, V> {
+      key: K;
+      value: V;
+    }
+    fun valueOf<K, V>(pair: Pair<K, V>) -> V {
+      return pair.value;
+    }
+    val pair = new Pair<i32, string> { key: 1, value: "one" };
+    val text: string = valueOf(*pair);
+  )");
+  REQUIRE(ast != nullptr);
+
+  REQUIRE_NOTHROW(type_check(ast, preludeTypes, {"lib", "../lib"}));
+
+  destroyast(ast);
+}
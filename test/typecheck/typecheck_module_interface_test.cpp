@@ -0,0 +1,220 @@
+#include "typecheck_utils.hpp"
+#include <typecheck/module_interface.hpp>
+#include <module.hpp>
+#include <chrono>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+
+namespace
+{
+  struct InterfaceFixture
+  {
+    std::filesystem::path root;
+    ScopedEnvVar modulePath;
+    ScopedEnvVar interfaceDir;
+    ScopedEnvVar preludeSnapshot;
+
+    InterfaceFixture()
+        : root(std::filesystem::temp_directory_path() /
+               ("ng_module_interface_" +
+                std::to_string(std::chrono::steady_clock::now().time_since_epoch().count()))),
+          modulePath("NG_MODULE_PATH", (root / "src").string()),
+          interfaceDir("NG_INTERFACE_DIR", (root / "ngi").string()),
+          preludeSnapshot("NG_PRELUDE_SNAPSHOT", (root / "prelude.ngs").string())
+    {
+      std::filesystem::create_directories(root / "src");
+      reset();
+    }
+
+    ~InterfaceFixture()
+    {
+      reset();
+      std::filesystem::remove_all(root);
+    }
+
+    // Each check should start like a fresh process, with only the interface files carried over.
+    static void reset()
+    {
+      NG::module::clear_module_loader_cache();
+      NG::module::get_module_registry().clear();
+    }
+
+    void write(const std::filesystem::path &relative, const Str &source) const
+    {
+      auto target = root / "src" / relative;
+      std::filesystem::create_directories(target.parent_path());
+      std::ofstream out{target};
+      REQUIRE(out.good());
+      out << source;
+    }
+
+    auto interfaceFile(const Str &moduleId, const std::filesystem::path &relative) const -> std::filesystem::path
+    {
+      auto source = std::filesystem::absolute(root / "src" / relative).string();
+      return module_interface_path(moduleId, source);
+    }
+
+    auto checkPrelude(const std::filesystem::path &relative) const -> Map<Str, Str>
+    {
+      reset();
+      auto path = root / "src" / relative;
+      std::ifstream in{path};
+      Str source{std::istreambuf_iterator<char>{in}, {}};
+      auto ast = parse(source);
+      REQUIRE(ast != nullptr);
+      Map<Str, Str> reprs;
+      for (const auto &[name, type] : check_prelude(ast, source, path.string(), {"[force-module-loader]"}))
+      {
+        reprs.emplace(name, type ? type->repr() : "");
+      }
+      destroyast(ast);
+      return reprs;
+    }
+
+    auto check(const Str &source) const -> Map<Str, CheckingRef<TypeInfo>>
+    {
+      reset();
+      auto ast = parse(source);
+      REQUIRE(ast != nullptr);
+      auto index = type_check(ast, {}, {"[force-module-loader]"});
+      destroyast(ast);
+      return index;
+    }
+  };
+
+  constexpr auto BASE_SOURCE = R"(
+    module pkg.base exports *;
+    type Box {
+      property value: i32;
+    }
+    trait Show {
+      fun show(self: ref<Self>) -> string;
+      fun loud(self: ref<Self>) -> string {
+        return self.show() + "!";
+      }
+    }
+    impl Show for Box {
+      fun show(self: ref<Self>) -> string {
+        return "box";
+      }
+    }
+    fun wrap<T>(value: T) -> (T, i32) = (value, 1);
+    fun unbox(box: Box) -> i32 = box.value;
+  )";
+
+  constexpr auto IMPORTER_SOURCE = R"(
+    import pkg.base (*);
+    val box = new Box { value: 1 };
+    val shown = box.loud();
+    val wrapped = wrap(true);
+    val number = unbox(box);
+  )";
+
+  void check_importer(Map<Str, CheckingRef<TypeInfo>> &index)
+  {
+    REQUIRE(index.contains("shown"));
+    check_type_tag(*index["shown"], typeinfo_tag::STRING);
+    REQUIRE(index.contains("wrapped"));
+    REQUIRE(index["wrapped"]->repr() == "(bool, i32)");
+    REQUIRE(index.contains("number"));
+    check_type_tag(*index["number"], typeinfo_tag::I32);
+  }
+} // namespace
+
+TEST_CASE("source modules should be restored from their interface files",
+          "[TypeCheck][ModuleInterface]")
+{
+  InterfaceFixture fixture;
+  fixture.write("pkg/base.ng", BASE_SOURCE);
+
+  auto cold = fixture.check(IMPORTER_SOURCE);
+  check_importer(cold);
+
+  auto file = fixture.interfaceFile("pkg.base", "pkg/base.ng");
+  REQUIRE(std::filesystem::exists(file));
+
+  // A restored interface is not written again, so an old timestamp survives the warm check.
+  auto stamp = std::filesystem::file_time_type::clock::now() - std::chrono::hours(1);
+  std::filesystem::last_write_time(file, stamp);
+
+  auto warm = fixture.check(IMPORTER_SOURCE);
+  check_importer(warm);
+  REQUIRE(std::filesystem::last_write_time(file) == stamp);
+  REQUIRE(warm["wrapped"]->repr() == cold["wrapped"]->repr());
+}
+
+TEST_CASE("module interfaces should be rebuilt when the source changes",
+          "[TypeCheck][ModuleInterface]")
+{
+  InterfaceFixture fixture;
+  fixture.write("pkg/base.ng", BASE_SOURCE);
+  (void)fixture.check(IMPORTER_SOURCE);
+
+  auto file = fixture.interfaceFile("pkg.base", "pkg/base.ng");
+  REQUIRE(std::filesystem::exists(file));
+  auto stamp = std::filesystem::file_time_type::clock::now() - std::chrono::hours(1);
+  std::filesystem::last_write_time(file, stamp);
+
+  fixture.write("pkg/base.ng", Str{BASE_SOURCE} + "\n    fun extra() -> string = \"extra\";\n");
+  auto index = fixture.check(R"(
+    import pkg.base (*);
+    val text = extra();
+  )");
+  REQUIRE(index.contains("text"));
+  check_type_tag(*index["text"], typeinfo_tag::STRING);
+  REQUIRE(std::filesystem::last_write_time(file) != stamp);
+}
+
+TEST_CASE("corrupt module interfaces should fall back to checking the source",
+          "[TypeCheck][ModuleInterface][Failure]")
+{
+  InterfaceFixture fixture;
+  fixture.write("pkg/base.ng", BASE_SOURCE);
+  (void)fixture.check(IMPORTER_SOURCE);
+
+  auto file = fixture.interfaceFile("pkg.base", "pkg/base.ng");
+  REQUIRE(std::filesystem::exists(file));
+  auto size = std::filesystem::file_size(file);
+  std::filesystem::resize_file(file, size / 2);
+
+  auto index = fixture.check(IMPORTER_SOURCE);
+  check_importer(index);
+  REQUIRE(std::filesystem::file_size(file) == size);
+
+  REQUIRE_THROWS_AS(decode_module_interface_header("NGI"), RuntimeException);
+}
+
+TEST_CASE("prelude snapshots should restore the prelude and its imports",
+          "[TypeCheck][ModuleInterface][PreludeSnapshot]")
+{
+  InterfaceFixture fixture;
+  ScopedEnvVar noInterfaces{"NG_INTERFACE_DIR", ""};
+  fixture.write("pkg/base.ng", BASE_SOURCE);
+  fixture.write("my/prelude.ng", R"(
+    module my.prelude exports *;
+    export import pkg.base (*);
+    fun greet(name: string) -> string {
+      return name + new Box { value: 1 }.loud();
+    }
+    val answer: i32 = unbox(new Box { value: 42 });
+  )");
+
+  auto cold = fixture.checkPrelude("my/prelude.ng");
+  REQUIRE(cold.contains("greet"));
+  REQUIRE(cold.contains("wrap"));
+  auto snapshot = fixture.root / "prelude.ngs";
+  REQUIRE(std::filesystem::exists(snapshot));
+
+  auto stamp = std::filesystem::file_time_type::clock::now() - std::chrono::hours(1);
+  std::filesystem::last_write_time(snapshot, stamp);
+  auto warm = fixture.checkPrelude("my/prelude.ng");
+  REQUIRE(warm == cold);
+  REQUIRE(std::filesystem::last_write_time(snapshot) == stamp);
+
+  // A changed import invalidates its own entry and the prelude's.
+  fixture.write("pkg/base.ng", Str{BASE_SOURCE} + "\n    fun extra() -> string = \"extra\";\n");
+  auto changed = fixture.checkPrelude("my/prelude.ng");
+  REQUIRE(changed.contains("extra"));
+  REQUIRE(std::filesystem::last_write_time(snapshot) != stamp);
+}
@@ -1,5 +1,7 @@
 #include "typecheck_utils.hpp"
+#include <typecheck/trait_registry.hpp>
 #include <module.hpp>
+#include <orgasm/module.hpp>
 #include <chrono>
 #include <cstdlib>
 #include <filesystem>
@@ -28,7 +30,7 @@ namespace
       NG::module::get_module_registry().addModuleInfo(runtime::makert<NG::module::ModuleInfo>(NG::module::ModuleInfo{
           .moduleId = name,
           .moduleName = name,
-          .moduleSource = source,
+          .moduleSourceHash = NG::orgasm::bytecode_source_hash(source),
           .moduleAst = ast,
           .moduleAbsolutePath = name,
           .moduleLoadingLocation = "memory",
@@ -41,43 +43,6 @@ namespace
     }
   };
 
-  struct ScopedEnvVar
-  {
-    Str name;
-    Str previous;
-    bool hadPrevious = false;
-
-    ScopedEnvVar(Str name, const Str &value) : name(std::move(name))
-    {
-      if (const char *existing = std::getenv(this->name.c_str()))
-      {
-        previous = existing;
-        hadPrevious = true;
-      }
-#ifdef _WIN32
-      _putenv_s(this->name.c_str(), value.c_str());
-#else
-      setenv(this->name.c_str(), value.c_str(), 1);
-#endif
-    }
-
-    ~ScopedEnvVar()
-    {
-#ifdef _WIN32
-      _putenv_s(name.c_str(), hadPrevious ? previous.c_str() : "");
-#else
-      if (hadPrevious)
-      {
-        setenv(name.c_str(), previous.c_str(), 1);
-      }
-      else
-      {
-        unsetenv(name.c_str());
-      }
-#endif
-    }
-  };
-
   struct SourceModuleFixture
   {
     std::filesystem::path root;
@@ -1163,6 +1128,52 @@ TEST_CASE("Drop impl should conflict with derived Copy", "[TypeCheck][Traits][De
   )", "Drop impl conflicts with derived Copy");
 }
 
+TEST_CASE("derived Hash should satisfy Hash bounds and expose hash", "[TypeCheck][Traits][Derive]")
+{
+  auto ast = parse(R"(
+    type Point: derive(Hash) {
+      x: i32;
+      name: string;
+    }
+
+    fun accept_hash<T: Hash>() -> unit {
+    }
+
+    accept_hash<Point>();
+    accept_hash<(i32, string)>();
+    val digest = new Point { x: 1, name: "a" }.hash();
+  )");
+  REQUIRE(ast != nullptr);
+
+  auto index = type_check(ast);
+  REQUIRE(index.contains("digest"));
+  REQUIRE(index["digest"]->tag() == typeinfo_tag::U64);
+
+  destroyast(ast);
+}
+
+TEST_CASE("Hash should be derive-only", "[TypeCheck][Traits][Derive][Failure]")
+{
+  typecheck_failure(R"(
+    type Point {
+      x: i32;
+    }
+
+    impl Hash for Point {
+      fun hash(self: ref<Self>) -> u64 = 1;
+    }
+  )", "Hash can only be derived: Point");
+  typecheck_failure(R"(
+    type Plain {
+      x: i32;
+    }
+
+    type Keyed: derive(Hash) {
+      inner: Plain;
+    }
+  )", "does not satisfy Hash");
+}
+
 TEST_CASE("auto traits should structurally satisfy generic bounds", "[TypeCheck][Traits][Auto]")
 {
   auto ast = parse(R"(
@@ -1194,3 +1205,58 @@ TEST_CASE("auto traits should reject methods", "[TypeCheck][Traits][Auto][Failur
     }
   )", "auto trait cannot declare methods");
 }
+
+TEST_CASE("trait impl index should memoize super-trait queries until new impls", "[TypeCheck][Traits][Index]")
+{
+  TraitImplIndex index;
+  int walks = 0;
+  auto implies = [&](const Str &candidate, const Str &required) {
+    ++walks;
+    return candidate == "Ord" && required == "Eq";
+  };
+
+  REQUIRE(index.add("Point", "Show"));
+  REQUIRE_FALSE(index.add("Point", "Show"));
+  REQUIRE(index.implements("Point", "Show", implies));
+  REQUIRE(walks == 0);
+
+  REQUIRE_FALSE(index.implements("Point", "Eq", implies));
+  REQUIRE_FALSE(index.implements("Point", "Eq", implies));
+  REQUIRE(walks == 1);
+
+  TraitImplIndex child = index;
+  REQUIRE(child.add("Point", "Ord"));
+  REQUIRE(child.implements("Point", "Eq", implies));
+  REQUIRE(child.typesImplementing("Ord") == Set<Str>{"Point"});
+  REQUIRE(walks == 3);
+
+  // The parent keeps its own impls and answers.
+  REQUIRE_FALSE(index.implements("Point", "Eq", implies));
+  REQUIRE(index.traitsOf("Point") == Vec<Str>{"Show"});
+  REQUIRE(walks == 3);
+}
+
+TEST_CASE("trait impl index should forget memoized answers when the trait graph changes",
+          "[TypeCheck][Traits][Index]")
+{
+  TraitImplIndex index;
+  bool showImpliesEq = false;
+  auto implies = [&](const Str &candidate, const Str &required) {
+    return showImpliesEq && candidate == "Show" && required == "Eq";
+  };
+
+  REQUIRE(index.add("Point", "Show"));
+  REQUIRE_FALSE(index.implements("Point", "Eq", implies));
+
+  // Show gains Eq as a super-trait without any impl being registered.
+  showImpliesEq = true;
+  REQUIRE_FALSE(index.implements("Point", "Eq", implies));
+  TraitImplIndex::traitGraphChanged();
+  REQUIRE(index.implements("Point", "Eq", implies));
+
+  TraitImplIndex child = index;
+  showImpliesEq = false;
+  TraitImplIndex::traitGraphChanged();
+  REQUIRE_FALSE(child.implements("Point", "Eq", implies));
+  REQUIRE_FALSE(index.implements("Point", "Eq", implies));
+}
@@ -0,0 +1,70 @@
+#include "typecheck_utils.hpp"
+#include <typecheck/type_interner.hpp>
+
+TEST_CASE("TypeInterner shares one node per structural type", "[TypeCheck][TypeInterner]")
+{
+  TypeInterner interner;
+
+  auto i32Array = interner.intern(makecheck<ArrayType>(makecheck<PrimitiveType>(typeinfo_tag::I32)));
+  auto sameArray = interner.intern(makecheck<ArrayType>(makecheck<PrimitiveType>(typeinfo_tag::I32)));
+  auto stringArray = interner.intern(makecheck<ArrayType>(makecheck<PrimitiveType>(typeinfo_tag::STRING)));
+
+  REQUIRE(i32Array == sameArray);
+  REQUIRE(i32Array != stringArray);
+  REQUIRE(i32Array->internId != 0);
+  REQUIRE(i32Array->internId != stringArray->internId);
+  REQUIRE(static_cast<ArrayType &>(*i32Array).elementType->internId != 0);
+  REQUIRE(i32Array->repr() == "array<i32, ?>");
+  REQUIRE(interner.intern(i32Array) == i32Array);
+
+  auto tuple = interner.intern(makecheck<TupleType>(Vec<CheckingRef<TypeInfo>>{
+      makecheck<PrimitiveType>(typeinfo_tag::BOOL), makecheck<ArrayType>(makecheck<PrimitiveType>(typeinfo_tag::I32))}));
+  REQUIRE(static_cast<TupleType &>(*tuple).elementTypes[1] == i32Array);
+  REQUIRE(tuple->repr() == "(bool, array<i32, ?>)");
+  REQUIRE(interner.size() == 6);
+}
+
+TEST_CASE("TypeInterner keeps mutable types by identity", "[TypeCheck][TypeInterner]")
+{
+  TypeInterner interner;
+
+  auto point = makecheck<CustomizedType>("Point");
+  auto function = makecheck<FunctionType>(makecheck<PrimitiveType>(typeinfo_tag::UNIT), Vec<CheckingRef<TypeInfo>>{});
+
+  REQUIRE(interner.intern(point) == point);
+  REQUIRE(point->internId == 0);
+  REQUIRE(interner.intern(function) == function);
+
+  auto pointRef = interner.intern(makecheck<ReferenceType>(point));
+  REQUIRE(interner.intern(makecheck<ReferenceType>(point)) == pointRef);
+  REQUIRE(interner.intern(makecheck<ReferenceType>(makecheck<CustomizedType>("Point"))) != pointRef);
+
+  auto callbacks = interner.intern(makecheck<VectorType>(function));
+  REQUIRE(callbacks->repr() == "vector<fun () -> unit>");
+  function->returnType = makecheck<PrimitiveType>(typeinfo_tag::I32);
+  REQUIRE(callbacks->repr() == "vector<fun () -> i32>");
+}
+
+TEST_CASE("type checker should intern annotated parameter types", "[TypeCheck][TypeInterner]")
+{
+  auto ast = parse(R"(
+    fun first(xs: vector<i32>) -> i32 {
+      return xs[0];
+    }
+    fun second(ys: vector<i32>) -> i32 {
+      return ys[1];
+    }
+  )");
+
+  REQUIRE(ast != nullptr);
+
+  auto index = type_check(ast);
+
+  auto &first = static_cast<FunctionType &>(*index["first"]);
+  auto &second = static_cast<FunctionType &>(*index["second"]);
+  REQUIRE(first.parametersType[0]->internId != 0);
+  REQUIRE(first.parametersType[0] == second.parametersType[0]);
+  REQUIRE(first.returnType == PrimitiveType::from("i32"));
+
+  destroyast(ast);
+}